@@ -0,0 +1,469 @@
+// Standard headers
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Google benchmark headers
+#include <benchmark/benchmark.h>
+
+// Project headers
+#include <config_store.h>
+#include <message_publisher.h>
+#include <message_wrapper.h>
+
+/*!
+ * Micro benchmarks of the reception path: frame extraction, log parsing, ROS message conversion and publication.
+ * Inputs are generated with the sbgECom log writers so no device is needed.
+ */
+namespace
+{
+//---------------------------------------------------------------------//
+//- Synthetic data generation                                         -//
+//---------------------------------------------------------------------//
+
+/*!
+ * Logs of a typical INS output, in their usual order within a main loop.
+ */
+const SbgEComMsgId LOG_MIX[] =
+{
+  SBG_ECOM_LOG_IMU_DATA,
+  SBG_ECOM_LOG_EKF_EULER,
+  SBG_ECOM_LOG_EKF_QUAT,
+  SBG_ECOM_LOG_EKF_NAV,
+  SBG_ECOM_LOG_MAG,
+  SBG_ECOM_LOG_GPS1_POS,
+  SBG_ECOM_LOG_UTC_TIME,
+  SBG_ECOM_LOG_STATUS,
+};
+
+/*!
+ * Fill a log with plausible values.
+ *
+ * \param[in] msg_id            Log id.
+ * \param[in] time_stamp        Device time stamp (us).
+ * \return                      Log data.
+ */
+SbgBinaryLogData createLogData(SbgEComMsgId msg_id, uint32_t time_stamp)
+{
+  SbgBinaryLogData log_data;
+
+  memset(&log_data, 0, sizeof(log_data));
+
+  switch (msg_id)
+  {
+  case SBG_ECOM_LOG_IMU_DATA:
+    log_data.imuData.timeStamp          = time_stamp;
+    log_data.imuData.accelerometers[2]  = -9.81f;
+    log_data.imuData.gyroscopes[0]      = 0.01f;
+    log_data.imuData.temperature        = 25.0f;
+    log_data.imuData.deltaVelocity[2]   = -9.81f;
+    log_data.imuData.deltaAngle[0]      = 0.01f;
+    break;
+
+  case SBG_ECOM_LOG_EKF_EULER:
+    log_data.ekfEulerData.timeStamp     = time_stamp;
+    log_data.ekfEulerData.euler[2]      = 1.2f;
+    break;
+
+  case SBG_ECOM_LOG_EKF_QUAT:
+    log_data.ekfQuatData.timeStamp      = time_stamp;
+    log_data.ekfQuatData.quaternion[0]  = 0.825f;
+    log_data.ekfQuatData.quaternion[3]  = 0.565f;
+    break;
+
+  case SBG_ECOM_LOG_EKF_NAV:
+    log_data.ekfNavData.timeStamp       = time_stamp;
+    log_data.ekfNavData.velocity[0]     = 1.5f;
+    log_data.ekfNavData.position[0]     = 48.8566;
+    log_data.ekfNavData.position[1]     = 2.3522;
+    log_data.ekfNavData.position[2]     = 35.0;
+    break;
+
+  case SBG_ECOM_LOG_MAG:
+    log_data.magData.timeStamp          = time_stamp;
+    log_data.magData.magnetometers[0]   = 0.5f;
+    break;
+
+  case SBG_ECOM_LOG_GPS1_POS:
+    log_data.gpsPosData.timeStamp       = time_stamp;
+    log_data.gpsPosData.latitude        = 48.8566;
+    log_data.gpsPosData.longitude       = 2.3522;
+    log_data.gpsPosData.altitude        = 35.0;
+    log_data.gpsPosData.numSvUsed       = 12;
+    break;
+
+  case SBG_ECOM_LOG_UTC_TIME:
+    log_data.utcData.timeStamp          = time_stamp;
+    log_data.utcData.year               = 2020;
+    log_data.utcData.month              = 3;
+    log_data.utcData.day                = 13;
+    break;
+
+  case SBG_ECOM_LOG_STATUS:
+    log_data.statusData.timeStamp       = time_stamp;
+    break;
+
+  default:
+    break;
+  }
+
+  return log_data;
+}
+
+/*!
+ * Write the payload of a log.
+ *
+ * \param[in] msg_id            Log id.
+ * \param[in] ref_log_data      Log data.
+ * \param[in] ref_stream        Output stream.
+ */
+void writeLogPayload(SbgEComMsgId msg_id, const SbgBinaryLogData &ref_log_data, SbgStreamBuffer &ref_stream)
+{
+  switch (msg_id)
+  {
+  case SBG_ECOM_LOG_IMU_DATA:
+    sbgEComBinaryLogWriteImuData(&ref_stream, &ref_log_data.imuData);
+    break;
+
+  case SBG_ECOM_LOG_EKF_EULER:
+    sbgEComBinaryLogWriteEkfEulerData(&ref_stream, &ref_log_data.ekfEulerData);
+    break;
+
+  case SBG_ECOM_LOG_EKF_QUAT:
+    sbgEComBinaryLogWriteEkfQuatData(&ref_stream, &ref_log_data.ekfQuatData);
+    break;
+
+  case SBG_ECOM_LOG_EKF_NAV:
+    sbgEComBinaryLogWriteEkfNavData(&ref_stream, &ref_log_data.ekfNavData);
+    break;
+
+  case SBG_ECOM_LOG_MAG:
+    sbgEComBinaryLogWriteMagData(&ref_stream, &ref_log_data.magData);
+    break;
+
+  case SBG_ECOM_LOG_GPS1_POS:
+    sbgEComBinaryLogWriteGpsPosData(&ref_stream, &ref_log_data.gpsPosData);
+    break;
+
+  case SBG_ECOM_LOG_UTC_TIME:
+    sbgEComBinaryLogWriteUtcData(&ref_stream, &ref_log_data.utcData);
+    break;
+
+  case SBG_ECOM_LOG_STATUS:
+    sbgEComBinaryLogWriteStatusData(&ref_stream, &ref_log_data.statusData);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/*!
+ * Generate the payload of a log.
+ *
+ * \param[in] msg_id            Log id.
+ * \return                      Payload.
+ */
+std::vector<uint8_t> generatePayload(SbgEComMsgId msg_id)
+{
+  uint8_t         buffer[SBG_ECOM_MAX_PAYLOAD_SIZE];
+  SbgStreamBuffer stream;
+
+  sbgStreamBufferInitForWrite(&stream, buffer, sizeof(buffer));
+  writeLogPayload(msg_id, createLogData(msg_id, 1000), stream);
+
+  return std::vector<uint8_t>(buffer, buffer + sbgStreamBufferGetLength(&stream));
+}
+
+/*!
+ * Generate a byte stream of consecutive frames.
+ *
+ * \param[in] num_loops         Number of main loops, each one holds all the logs of the mix.
+ * \param[in] noise_ratio       Ratio of frames preceded by garbage bytes or with a corrupted byte, between 0 and 1.
+ * \return                      Byte stream.
+ */
+std::vector<uint8_t> generateFrameStream(size_t num_loops, double noise_ratio)
+{
+  std::vector<uint8_t>                    stream_data;
+  std::vector<uint8_t>                    frame(SBG_ECOM_MAX_BUFFER_SIZE);
+  std::mt19937                            generator(42);
+  std::uniform_real_distribution<double>  noise_distribution(0.0, 1.0);
+  std::uniform_int_distribution<int>      byte_distribution(0, 255);
+
+  for (size_t loop = 0; loop < num_loops; loop++)
+  {
+    for (SbgEComMsgId msg_id : LOG_MIX)
+    {
+      SbgStreamBuffer stream;
+      size_t          cursor;
+
+      sbgStreamBufferInitForWrite(&stream, frame.data(), frame.size());
+      sbgEComStartFrameGeneration(&stream, SBG_ECOM_CLASS_LOG_ECOM_0, msg_id, &cursor);
+      writeLogPayload(msg_id, createLogData(msg_id, static_cast<uint32_t>(loop * 5000)), stream);
+      sbgEComFinalizeFrameGeneration(&stream, cursor);
+
+      size_t frame_size = sbgStreamBufferGetLength(&stream);
+
+      if (noise_distribution(generator) < noise_ratio)
+      {
+        if (noise_distribution(generator) < 0.5)
+        {
+          for (int i = 0; i < 16; i++)
+          {
+            stream_data.push_back(static_cast<uint8_t>(byte_distribution(generator)));
+          }
+        }
+        else
+        {
+          frame[frame_size / 2] ^= 0x5A;
+        }
+      }
+
+      stream_data.insert(stream_data.end(), frame.begin(), frame.begin() + frame_size);
+    }
+  }
+
+  return stream_data;
+}
+
+//---------------------------------------------------------------------//
+//- Replay interface                                                  -//
+//---------------------------------------------------------------------//
+
+/*!
+ * Interface reading a byte stream in a loop, by chunks of limited size.
+ */
+struct ReplaySource
+{
+  const std::vector<uint8_t>  *p_data;
+  size_t                      offset;
+  size_t                      chunk_size;
+};
+
+SbgErrorCode replayRead(SbgInterface *p_handle, void *p_buffer, size_t *p_read_bytes, size_t bytes_to_read)
+{
+  ReplaySource  *p_source = static_cast<ReplaySource*>(p_handle->handle);
+  size_t        size;
+
+  if (p_source->offset == p_source->p_data->size())
+  {
+    p_source->offset = 0;
+  }
+
+  size = std::min(std::min(bytes_to_read, p_source->chunk_size), p_source->p_data->size() - p_source->offset);
+  memcpy(p_buffer, p_source->p_data->data() + p_source->offset, size);
+
+  p_source->offset  += size;
+  *p_read_bytes     = size;
+
+  return SBG_NO_ERROR;
+}
+
+SbgErrorCode replayWrite(SbgInterface *p_handle, const void *p_buffer, size_t bytes_to_write)
+{
+  SBG_UNUSED_PARAMETER(p_handle);
+  SBG_UNUSED_PARAMETER(p_buffer);
+  SBG_UNUSED_PARAMETER(bytes_to_write);
+
+  return SBG_NO_ERROR;
+}
+
+//---------------------------------------------------------------------//
+//- Benchmarks                                                        -//
+//---------------------------------------------------------------------//
+
+/*!
+ * Extract frames from a byte stream.
+ * Arguments: noise ratio in percent, maximum number of bytes returned by each interface read.
+ */
+void BM_ProtocolReceive(benchmark::State &ref_state)
+{
+  std::vector<uint8_t>  stream_data = generateFrameStream(256, ref_state.range(0) / 100.0);
+  std::vector<uint8_t>  payload(SBG_ECOM_MAX_PAYLOAD_SIZE);
+  ReplaySource          source = { &stream_data, 0, static_cast<size_t>(ref_state.range(1)) };
+  SbgInterface          interface;
+  SbgEComProtocol       protocol;
+  SbgEComProtocolStats  stats;
+
+  sbgInterfaceZeroInit(&interface);
+  interface.handle      = &source;
+  interface.pReadFunc   = replayRead;
+  interface.pWriteFunc  = replayWrite;
+
+  sbgEComProtocolInit(&protocol, &interface);
+
+  for (auto _ : ref_state)
+  {
+    uint8_t       msg_class;
+    uint8_t       msg_id;
+    size_t        payload_size;
+    SbgErrorCode  error_code;
+
+    do
+    {
+      error_code = sbgEComProtocolReceive(&protocol, &msg_class, &msg_id, payload.data(), &payload_size, payload.size());
+    } while (error_code != SBG_NO_ERROR);
+
+    benchmark::DoNotOptimize(payload_size);
+  }
+
+  sbgEComProtocolGetStats(&protocol, &stats);
+  ref_state.SetBytesProcessed(stats.bytesReceived);
+  ref_state.counters["crc_errors"]  = stats.crcErrors;
+  ref_state.counters["resyncs"]     = stats.resyncs;
+}
+BENCHMARK(BM_ProtocolReceive)
+  ->ArgNames({"noise_pct", "chunk"})
+  ->Args({0, SBG_ECOM_MAX_BUFFER_SIZE})
+  ->Args({5, SBG_ECOM_MAX_BUFFER_SIZE})
+  ->Args({0, 7});
+
+/*!
+ * Parse a log payload.
+ * Argument: log id.
+ */
+void BM_BinaryLogParse(benchmark::State &ref_state)
+{
+  SbgEComMsgId          msg_id  = static_cast<SbgEComMsgId>(ref_state.range(0));
+  std::vector<uint8_t>  payload = generatePayload(msg_id);
+  SbgBinaryLogData      log_data;
+
+  for (auto _ : ref_state)
+  {
+    benchmark::DoNotOptimize(sbgEComBinaryLogParse(SBG_ECOM_CLASS_LOG_ECOM_0, msg_id, payload.data(), payload.size(), &log_data));
+    benchmark::ClobberMemory();
+  }
+
+  ref_state.SetBytesProcessed(ref_state.iterations() * payload.size());
+}
+BENCHMARK(BM_BinaryLogParse)
+  ->ArgName("log_id")
+  ->Arg(SBG_ECOM_LOG_IMU_DATA)
+  ->Arg(SBG_ECOM_LOG_EKF_EULER)
+  ->Arg(SBG_ECOM_LOG_EKF_QUAT)
+  ->Arg(SBG_ECOM_LOG_EKF_NAV)
+  ->Arg(SBG_ECOM_LOG_MAG)
+  ->Arg(SBG_ECOM_LOG_GPS1_POS)
+  ->Arg(SBG_ECOM_LOG_UTC_TIME)
+  ->Arg(SBG_ECOM_LOG_STATUS);
+
+/*!
+ * Convert an IMU log to the SBG IMU message.
+ */
+void BM_FillSbgImuDataMessage(benchmark::State &ref_state)
+{
+  sbg::MessageWrapper           message_wrapper;
+  sbg_driver::msg::SbgImuData   imu_message;
+  SbgBinaryLogData              log_data = createLogData(SBG_ECOM_LOG_IMU_DATA, 1000);
+
+  for (auto _ : ref_state)
+  {
+    message_wrapper.fillSbgImuDataMessage(log_data.imuData, imu_message);
+    benchmark::DoNotOptimize(imu_message);
+  }
+}
+BENCHMARK(BM_FillSbgImuDataMessage);
+
+/*!
+ * Build an odometry message from the IMU and EKF messages, without TF broadcast.
+ */
+void BM_FillRosOdoMessage(benchmark::State &ref_state)
+{
+  sbg::MessageWrapper             message_wrapper;
+  sbg_driver::msg::SbgImuData     imu_message;
+  sbg_driver::msg::SbgEkfNav      ekf_nav_message;
+  sbg_driver::msg::SbgEkfQuat     ekf_quat_message;
+  sbg_driver::msg::SbgEkfEuler    ekf_euler_message;
+  nav_msgs::msg::Odometry         odometry_message;
+
+  message_wrapper.fillSbgImuDataMessage(createLogData(SBG_ECOM_LOG_IMU_DATA, 1000).imuData, imu_message);
+  message_wrapper.fillSbgEkfNavMessage(createLogData(SBG_ECOM_LOG_EKF_NAV, 1000).ekfNavData, ekf_nav_message);
+  message_wrapper.fillSbgEkfQuatMessage(createLogData(SBG_ECOM_LOG_EKF_QUAT, 1000).ekfQuatData, ekf_quat_message);
+  message_wrapper.fillSbgEkfEulerMessage(createLogData(SBG_ECOM_LOG_EKF_EULER, 1000).ekfEulerData, ekf_euler_message);
+
+  message_wrapper.setOdomPublishTf(false);
+
+  for (auto _ : ref_state)
+  {
+    message_wrapper.fillRosOdoMessage(imu_message, ekf_nav_message, ekf_quat_message, ekf_euler_message, odometry_message);
+    benchmark::DoNotOptimize(odometry_message);
+  }
+}
+BENCHMARK(BM_FillRosOdoMessage);
+
+/*!
+ * Convert a geodetic position to UTM coordinates.
+ */
+void BM_LLtoUTM(benchmark::State &ref_state)
+{
+  sbg::MessageWrapper message_wrapper;
+  double              latitude = 48.8566;
+  double              northing;
+  double              easting;
+
+  for (auto _ : ref_state)
+  {
+    benchmark::DoNotOptimize(latitude);
+    message_wrapper.LLtoUTM(latitude, 2.3522, 31, northing, easting);
+    benchmark::DoNotOptimize(northing);
+    benchmark::DoNotOptimize(easting);
+  }
+}
+BENCHMARK(BM_LLtoUTM);
+
+/*!
+ * Publish each log of the mix through the message publisher, with all the SBG and ROS standard publishers created.
+ * Nothing subscribes to the topics, so this measures the driver conversion and the RMW publication cost.
+ * Select the RMW with the RMW_IMPLEMENTATION environment variable.
+ */
+void BM_MessagePublisherPublish(benchmark::State &ref_state)
+{
+  std::vector<rclcpp::Parameter>  parameters;
+  std::vector<SbgBinaryLogData>   logs;
+  sbg::ConfigStore                config_store;
+  sbg::MessagePublisher           message_publisher;
+
+  parameters.emplace_back("ipConf.ipAddress", "127.0.0.1");
+  parameters.emplace_back("output.ros_standard", true);
+
+  for (const char *p_key : { "output.log_status", "output.log_imu_data", "output.log_ekf_euler", "output.log_ekf_quat",
+                             "output.log_ekf_nav", "output.log_utc_time", "output.log_mag", "output.log_gps1_pos" })
+  {
+    parameters.emplace_back(p_key, static_cast<int>(SBG_ECOM_OUTPUT_MODE_DIV_2));
+  }
+
+  rclcpp::Node node("sbg_driver_benchmarks", rclcpp::NodeOptions().parameter_overrides(parameters).automatically_declare_parameters_from_overrides(true));
+
+  config_store.loadFromRosNodeHandle(node);
+  message_publisher.initPublishers(node, config_store);
+
+  for (SbgEComMsgId msg_id : LOG_MIX)
+  {
+    logs.push_back(createLogData(msg_id, 1000));
+  }
+
+  for (auto _ : ref_state)
+  {
+    for (size_t i = 0; i < logs.size(); i++)
+    {
+      message_publisher.publish(SBG_ECOM_CLASS_LOG_ECOM_0, LOG_MIX[i], logs[i]);
+    }
+  }
+
+  ref_state.SetItemsProcessed(ref_state.iterations() * logs.size());
+}
+BENCHMARK(BM_MessagePublisherPublish);
+}
+
+int main(int argc, char **argv)
+{
+  benchmark::Initialize(&argc, argv);
+  rclcpp::init(argc, argv);
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  rclcpp::shutdown();
+
+  return 0;
+}
@@ -1,4 +1,5 @@
 ﻿#include "sbgInterfaceUdp.h"
+#include <network/sbgNetwork.h>
 
 #ifdef WIN32
 	#include <winsock2.h>
@@ -161,6 +162,7 @@ SbgErrorCode sbgInterfaceUdpCreate(SbgInterface *pHandle, sbgIpAddress remoteAdd
 	SbgInterfaceUdp		*pNewUdpHandle;
 	SOCKADDR_IN			 bindAddress;
 	SOCKET				 newUdpSocket;
+	uint32				 reuseAddress;
 	
 	assert(pHandle);
 
@@ -219,6 +221,12 @@ SbgErrorCode sbgInterfaceUdpCreate(SbgInterface *pHandle, sbgIpAddress remoteAdd
 						bindAddress.sin_addr.s_addr = INADDR_ANY;
 						bindAddress.sin_port = htons((uint16_t)localPort);
 
+						//
+						// A multicast group port can be shared by several interfaces on the same host
+						//
+						reuseAddress = (sbgIpAddressIsMulticast(remoteAddr)?true:false);
+						setsockopt(newUdpSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuseAddress, sizeof(reuseAddress));
+
 						//
 						// Bind this socket to all ip addresses on the input port
 						//
@@ -419,6 +427,66 @@ SbgErrorCode sbgInterfaceUdpAllowBroadcast(SbgInterface *pHandle, bool allowBroa
 	return errorCode;
 }
 
+/*!
+ *	Join a multicast group, so the datagrams sent to this group on the local port are received.
+ *	\param[in]	pInterface						Pointer on a valid UDP interface created using sbgInterfaceUdpCreate.
+ *	\param[in]	groupAddr						Multicast group IP address to join.
+ *	\return										SBG_NO_ERROR if the multicast group has been joined.
+ */
+SbgErrorCode sbgInterfaceUdpJoinMulticast(SbgInterface *pHandle, sbgIpAddress groupAddr)
+{
+	SbgErrorCode			 errorCode = SBG_NO_ERROR;
+	SbgInterfaceUdp			*pUdpHandle;
+	SOCKET					 udpSocket;
+	struct ip_mreq			 membership;
+
+	assert(pHandle);
+	assert(pHandle->type == SBG_IF_TYPE_ETH_UDP);
+
+	//
+	// Get the UDP handle
+	//
+	pUdpHandle = (SbgInterfaceUdp*)pHandle->handle;
+
+	if (!sbgIpAddressIsMulticast(groupAddr))
+	{
+		//
+		// Only multicast group addresses can be joined
+		//
+		errorCode = SBG_INVALID_PARAMETER;
+	}
+	else if (pUdpHandle->pUdpSocket)
+	{
+		//
+		// Get the UDP socket
+		//
+		udpSocket = *((SOCKET*)pUdpHandle->pUdpSocket);
+
+		//
+		// Join the group on the default multicast interface
+		//
+		membership.imr_multiaddr.s_addr = groupAddr;				// Warning: the sbgIpAddress value is always stored in network endianness (ie big endian)
+		membership.imr_interface.s_addr = INADDR_ANY;
+
+		if (setsockopt(udpSocket, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char*)&membership, sizeof(membership)) != NO_ERROR)
+		{
+			//
+			// Unable to join the multicast group
+			//
+			errorCode = SBG_ERROR;
+		}
+	}
+	else
+	{
+		//
+		// No valid UDP socket found
+		//
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
 //----------------------------------------------------------------------//
 //- Internal interfaces write/read implementations                     -//
 //----------------------------------------------------------------------//
@@ -95,6 +95,18 @@ SBG_COMMON_LIB_API SbgErrorCode sbgInterfaceUdpDestroy(SbgInterface *pHandle);
  */
 SBG_COMMON_LIB_API SbgErrorCode sbgInterfaceUdpAllowBroadcast(SbgInterface *pHandle, bool allowBroadcast);
 
+/*!
+ * Join a multicast group, so the datagrams sent to this group on the local port are received.
+ *
+ * Several interfaces on the same host can listen to a multicast group port if they are created
+ * with this group as their remote address.
+ *
+ * \param[in]	pInterface						Pointer on a valid UDP interface created using sbgInterfaceUdpCreate.
+ * \param[in]	groupAddr						Multicast group IP address to join.
+ * \return										SBG_NO_ERROR if the multicast group has been joined.
+ */
+SBG_COMMON_LIB_API SbgErrorCode sbgInterfaceUdpJoinMulticast(SbgInterface *pHandle, sbgIpAddress groupAddr);
+
 /*!
  * Try to write some data to an interface.
  *
@@ -230,6 +230,23 @@ SBG_INLINE bool sbgIpAddressValid(sbgIpAddress ipAddress)
 	}
 }
 
+/*!
+ * Check if an IpV4 address is a multicast group address. The ip address format is A.B.C.D and A should respect 224 <= A < 240
+ * \param[in]	ipAddress						The ip address stored in an uint32_t (host endianness).
+ * \return										true if the ip address is a multicast group.
+ */
+SBG_INLINE bool sbgIpAddressIsMulticast(sbgIpAddress ipAddress)
+{
+	if ((sbgIpAddrGetA(ipAddress) >= 224) && (sbgIpAddrGetA(ipAddress) < 240))
+	{
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
 /*!
  * Given an ip address and the netmask, returns true if this ip address is within the subnet.
  * \param[in]	ipAddress						The ip address stored in an uint32_t (host endianness).
@@ -29,10 +29,10 @@ SbgErrorCode sbgEComBinaryLogParseDebugData(SbgStreamBuffer *pInputStream, SbgLo
 
 	if (errorCode == SBG_NO_ERROR)
 	{
-		if (pOutputData->size <= SBG_ARRAY_SIZE(pOutputData->data))
+		if (pOutputData->size <= sbgStreamBufferGetSpace(pInputStream))
 		{
-			sbgStreamBufferReadBuffer(pInputStream, pOutputData->data, pOutputData->size);
-			errorCode = sbgStreamBufferGetLastError(pInputStream);
+			pOutputData->pData = (const uint8_t*)sbgStreamBufferGetCursor(pInputStream);
+			errorCode = sbgStreamBufferSeek(pInputStream, pOutputData->size, SB_SEEK_CUR_INC);
 		}
 		else
 		{
@@ -64,9 +64,9 @@ SbgErrorCode sbgEComBinaryLogWriteDebugData(SbgStreamBuffer *pOutputStream, cons
 	sbgStreamBufferWriteUint32LE(pOutputStream, pInputData->size);
 	sbgStreamBufferWriteUint32LE(pOutputStream, pInputData->totalSize);
 
-	if (pInputData->size <= SBG_ARRAY_SIZE(pInputData->data))
+	if (pInputData->size <= SBG_ECOM_LOG_DEBUG_MAX_DATA_SIZE)
 	{
-		sbgStreamBufferWriteBuffer(pOutputStream, pInputData->data, pInputData->size);
+		sbgStreamBufferWriteBuffer(pOutputStream, pInputData->pData, pInputData->size);
 		errorCode = sbgStreamBufferGetLastError(pOutputStream);
 	}
 	else
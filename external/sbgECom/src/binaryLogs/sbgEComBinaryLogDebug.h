@@ -36,6 +36,13 @@
 
 #include "../protocol/sbgEComProtocol.h"
 
+//----------------------------------------------------------------------//
+//- Log definitions                                                    -//
+//----------------------------------------------------------------------//
+
+#define SBG_ECOM_LOG_DEBUG_HEADER_SIZE		(4 * sizeof(uint32_t))												/*!< Size of the id, offset, size and totalSize fields written before the debug data. */
+#define SBG_ECOM_LOG_DEBUG_MAX_DATA_SIZE	(SBG_ECOM_MAX_PAYLOAD_SIZE - SBG_ECOM_LOG_DEBUG_HEADER_SIZE)		/*!< Maximum debug data size that fits in a single frame payload. */
+
 //----------------------------------------------------------------------//
 //- Log structure definitions                                          -//
 //----------------------------------------------------------------------//
@@ -52,7 +59,7 @@ typedef struct _SbgLogDebugData
 	uint32_t		 offset;									/*!< Offset of the debug log */
 	uint32_t		 size;										/*!< Debug frame size */
 	uint32_t		 totalSize;									/*!< Total size of the debug log */
-	uint8_t		 data[SBG_ECOM_MAX_PAYLOAD_SIZE - 16];		/*!< Debug data */
+	const uint8_t	*pData;										/*!< Debug data, references the received payload in place and is only valid during the log callback. */
 } SbgLogDebugData;
 
 //----------------------------------------------------------------------//
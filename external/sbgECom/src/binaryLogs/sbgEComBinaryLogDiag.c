@@ -11,6 +11,9 @@
 
 SbgErrorCode sbgEComBinaryLogParseDiagData(SbgStreamBuffer *pInputStream, SbgLogDiagData *pOutputData)
 {
+	size_t								 size;
+	const char							*pEnd;
+
 	assert(pInputStream);
 	assert(pOutputData);
 
@@ -18,8 +21,23 @@ SbgErrorCode sbgEComBinaryLogParseDiagData(SbgStreamBuffer *pInputStream, SbgLog
 	pOutputData->type			= (SbgDebugLogType)sbgStreamBufferReadUint8(pInputStream);
 	pOutputData->errorCode		= (SbgErrorCode)sbgStreamBufferReadUint8(pInputStream);
 
-	sbgStreamBufferReadBuffer(pInputStream, pOutputData->string, sbgStreamBufferGetSpace(pInputStream));
-	pOutputData->string[sizeof(pOutputData->string) - 1] = '\0';
+	//
+	// The string is referenced in place, its length is bounded by the payload as the terminating null character may be missing
+	//
+	size = sbgStreamBufferGetSpace(pInputStream);
+	pOutputData->pString		= (const char *)sbgStreamBufferGetCursor(pInputStream);
+	pEnd						= (const char *)memchr(pOutputData->pString, '\0', size);
+
+	if (pEnd)
+	{
+		pOutputData->stringLength = (size_t)(pEnd - pOutputData->pString);
+	}
+	else
+	{
+		pOutputData->stringLength = size;
+	}
+
+	sbgStreamBufferSeek(pInputStream, size, SB_SEEK_CUR_INC);
 
 	return sbgStreamBufferGetLastError(pInputStream);
 }
@@ -35,14 +53,14 @@ SbgErrorCode sbgEComBinaryLogWriteDiagData(SbgStreamBuffer *pOutputStream, const
 	sbgStreamBufferWriteUint8(pOutputStream, pInputData->type);
 	sbgStreamBufferWriteUint8(pOutputStream, pInputData->errorCode);
 
-	length = strlen(pInputData->string);
+	length = pInputData->stringLength;
 
-	if (length >= sizeof(pInputData->string))
+	if (length >= SBG_ECOM_LOG_DIAG_MAX_STRING_SIZE)
 	{
-		length = sizeof(pInputData->string) - 1;
+		length = SBG_ECOM_LOG_DIAG_MAX_STRING_SIZE - 1;
 	}
 
-	sbgStreamBufferWriteBuffer(pOutputStream, pInputData->string, length);
+	sbgStreamBufferWriteBuffer(pOutputStream, pInputData->pString, length);
 	sbgStreamBufferWriteUint8(pOutputStream, 0);
 
 	return sbgStreamBufferGetLastError(pOutputStream);
@@ -59,7 +59,8 @@ typedef struct _SbgLogDiagData
 	uint32_t							 timestamp;									/*!< Timestamp, in microseconds. */
 	SbgDebugLogType						 type;										/*!< Log type. */
 	SbgErrorCode						 errorCode;									/*!< Error code. */
-	char								 string[SBG_ECOM_LOG_DIAG_MAX_STRING_SIZE];	/*!< Log string, null-terminated. */
+	const char							*pString;									/*!< Log string, references the received payload in place and is only valid during the log callback. */
+	size_t								 stringLength;								/*!< Log string length in bytes, without the terminating null character. */
 } SbgLogDiagData;
 
 //----------------------------------------------------------------------//
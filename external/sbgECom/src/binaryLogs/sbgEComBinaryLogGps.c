@@ -258,10 +258,11 @@ SbgErrorCode sbgEComBinaryLogParseGpsRawData(SbgStreamBuffer *pInputStream, SbgL
 	if (payloadSize <= SBG_ECOM_GPS_RAW_MAX_BUFFER_SIZE)
 	{
 		//
-		// Copy the buffer
+		// Reference the buffer in place instead of copying it
 		//
-		errorCode = sbgStreamBufferReadBuffer(pInputStream, pOutputData->rawBuffer, payloadSize);
+		pOutputData->pRawBuffer = (const uint8_t*)sbgStreamBufferGetCursor(pInputStream);
 		pOutputData->bufferSize = payloadSize;
+		errorCode = sbgStreamBufferSeek(pInputStream, payloadSize, SB_SEEK_CUR_INC);
 	}
 	else
 	{
@@ -288,5 +289,5 @@ SbgErrorCode sbgEComBinaryLogWriteGpsRawData(SbgStreamBuffer *pOutputStream, con
 	//
 	// Write the buffer and return if any error has occurred
 	//
-	return sbgStreamBufferWriteBuffer(pOutputStream, pInputData->rawBuffer, pInputData->bufferSize);
+	return sbgStreamBufferWriteBuffer(pOutputStream, pInputData->pRawBuffer, pInputData->bufferSize);
 }
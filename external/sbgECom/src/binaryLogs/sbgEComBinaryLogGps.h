@@ -327,8 +327,8 @@ typedef struct _SbgLogGpsHdt
  */
 typedef struct _SbgLogGpsRaw
 {
-	uint8_t			rawBuffer[SBG_ECOM_GPS_RAW_MAX_BUFFER_SIZE];	/*!< Buffer that contains raw GPS data. */
-	size_t			bufferSize;										/*!< Raw buffer size in bytes. */
+	const uint8_t	*pRawBuffer;									/*!< Raw GPS data, references the received payload in place and is only valid during the log callback. */
+	size_t			 bufferSize;									/*!< Raw buffer size in bytes. */
 } SbgLogGpsRaw;
 
 //----------------------------------------------------------------------//
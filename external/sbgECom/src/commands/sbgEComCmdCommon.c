@@ -8,6 +8,7 @@
 /*!
  *	Wait until any command that is not a output log is recevied during a specific time out.
  *	All binary logs received during this time are handled trough the standard callback system.
+ *	Commands consumed by the receive command callback are not returned.
  *	\param[in]	pHandle					A valid sbgECom handle.
  *	\param[out]	pMsgClass				Pointer used to hold the received command class.
  *	\param[out]	pMsg					Pointer used to hold the received command ID.
@@ -59,6 +60,19 @@ SbgErrorCode sbgEComReceiveAnyCmd(SbgEComHandle *pHandle, uint8_t *pMsgClass, ui
 			//
 			if (sbgEComMsgClassIsALog((SbgEComClass)receivedMsgClass))
 			{
+				if (pHandle->pFrameStageCallback)
+				{
+					pHandle->pFrameStageCallback(pHandle, SBG_ECOM_FRAME_STAGE_RECEIVED, (SbgEComClass)receivedMsgClass, receivedMsg, pHandle->pFrameStageUserArg);
+				}
+
+				//
+				// Skip logs rejected by the log filter without parsing them
+				//
+				if (!sbgEComLogFilterIsEnabled(pHandle, (SbgEComClass)receivedMsgClass, receivedMsg))
+				{
+					continue;
+				}
+
 				//
 				// The received frame is a binary log one
 				//
@@ -69,6 +83,11 @@ SbgErrorCode sbgEComReceiveAnyCmd(SbgEComHandle *pHandle, uint8_t *pMsgClass, ui
 				//
 				if (errorCode == SBG_NO_ERROR)
 				{
+					if (pHandle->pFrameStageCallback)
+					{
+						pHandle->pFrameStageCallback(pHandle, SBG_ECOM_FRAME_STAGE_PARSED, (SbgEComClass)receivedMsgClass, receivedMsg, pHandle->pFrameStageUserArg);
+					}
+
 					//
 					// Test if we have a valid callback to handle received logs
 					//
@@ -87,6 +106,13 @@ SbgErrorCode sbgEComReceiveAnyCmd(SbgEComHandle *pHandle, uint8_t *pMsgClass, ui
 					//
 				}
 			}
+			else if ( (pHandle->pReceiveCmdCallback) && (pHandle->pReceiveCmdCallback(pHandle, receivedMsgClass, receivedMsg, payloadData, payloadSize, pHandle->pReceiveCmdUserArg)) )
+			{
+				//
+				// The received command has been consumed by the receive command callback so keep waiting
+				//
+				continue;
+			}
 			else
 			{
 				//
@@ -81,6 +81,7 @@ typedef struct _SbgEComModelInfo
 /*!
  *	Wait until any command that is not a output log is recevied during a specific time out.
  *	All binary logs received during this time are handled trough the standard callback system.
+ *	Commands consumed by the receive command callback are not returned.
  *	\param[in]	pHandle					A valid sbgECom handle.
  *	\param[out]	pMsgClass				Pointer used to hold the received command class.
  *	\param[out]	pMsg					Pointer used to hold the received command ID.
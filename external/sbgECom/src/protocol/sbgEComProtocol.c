@@ -1,6 +1,40 @@
 ﻿#include "sbgEComProtocol.h"
 #include <crc/sbgCrc.h>
 
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Remove a whole frame located at the beginning of the reception buffer.
+ * \param[in]	pHandle					A valid protocol handle.
+ * \param[in]	frameSize				Size in bytes of the frame to remove.
+ */
+static void sbgEComProtocolDiscardFrame(SbgEComProtocol *pHandle, size_t frameSize)
+{
+	assert(pHandle);
+	assert(frameSize <= pHandle->rxBufferSize);
+
+	//
+	// Test if the reception buffer contains more than just the current frame
+	//
+	if (pHandle->rxBufferSize > frameSize)
+	{
+		//
+		// We remove the read frame but we keep the remaining data
+		//
+		pHandle->rxBufferSize = pHandle->rxBufferSize-frameSize;
+		memmove(pHandle->rxBuffer, pHandle->rxBuffer+frameSize, pHandle->rxBufferSize);
+	}
+	else
+	{
+		//
+		// We have parsed the whole received buffer so just empty it
+		//
+		pHandle->rxBufferSize = 0;
+	}
+}
+
 //----------------------------------------------------------------------//
 //- Communication protocol operations                                  -//
 //----------------------------------------------------------------------//
@@ -23,6 +57,11 @@ SbgErrorCode sbgEComProtocolInit(SbgEComProtocol *pHandle, SbgInterface *pInterf
 	//
 	pHandle->pLinkedInterface = pInterface;
 	pHandle->rxBufferSize = 0;
+	pHandle->pFrameFilterCallback = NULL;
+	pHandle->pFrameFilterUserArg = NULL;
+	pHandle->pReadCallback = NULL;
+	pHandle->pReadUserArg = NULL;
+	memset(&pHandle->stats, 0x00, sizeof(pHandle->stats));
 	
 	return errorCode;
 }
@@ -41,6 +80,8 @@ SbgErrorCode sbgEComProtocolClose(SbgEComProtocol *pHandle)
 	//
 	pHandle->pLinkedInterface = NULL;
 	pHandle->rxBufferSize = 0;
+	pHandle->pFrameFilterCallback = NULL;
+	pHandle->pFrameFilterUserArg = NULL;
 	
 	//
 	// Don't have to do anything
@@ -150,6 +191,7 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass
 	uint16_t			computedCrc;
 	size_t				i;
 	size_t				numBytesRead;
+	size_t				numBytesDiscarded;
 	uint8_t				receivedMsgClass;
 	uint8_t				receivedMsg;
 	size_t				payloadOffset;
@@ -178,8 +220,21 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass
 			// No error during reading so increment the number of bytes stored in the rx buffer
 			//
 			pHandle->rxBufferSize += numBytesRead;
+			pHandle->stats.bytesReceived += (uint32_t)numBytesRead;
+
+			if ( (pHandle->pReadCallback) && (numBytesRead > 0) )
+			{
+				pHandle->pReadCallback(numBytesRead, pHandle->pReadUserArg);
+			}
 		}
 	}
+	else
+	{
+		//
+		// The frames aren't processed fast enough and no data can be read until the buffer is emptied
+		//
+		pHandle->stats.rxBufferFull++;
+	}
 
 	//
 	// We have read all available data and stored them into the rx buffer
@@ -217,6 +272,9 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass
 						//
 						memmove(pHandle->rxBuffer, pHandle->rxBuffer+i, pHandle->rxBufferSize-i);
 						pHandle->rxBufferSize = pHandle->rxBufferSize-i;
+
+						pHandle->stats.bytesDiscarded += (uint32_t)i;
+						pHandle->stats.resyncs++;
 					}
 
 					//
@@ -297,6 +355,15 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass
 				//
 				if (sbgStreamBufferReadUint8(&inputStream) == SBG_ECOM_ETX)
 				{
+					//
+					// Drop the frame without checking its CRC if nobody is interested in it
+					//
+					if ( (pHandle->pFrameFilterCallback) && (!pHandle->pFrameFilterCallback(receivedMsgClass, receivedMsg, pHandle->pFrameFilterUserArg)) )
+					{
+						sbgEComProtocolDiscardFrame(pHandle, payloadSize+9);
+						continue;
+					}
+
 					//
 					// Go back at the beginning of the payload part
 					//
@@ -324,6 +391,8 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass
 					//
 					if (frameCrc == computedCrc)
 					{
+						pHandle->stats.framesReceived++;
+
 						//
 						// Extract the payload if needed
 						//
@@ -373,27 +442,15 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass
 						// We have an invalid frame CRC and we will directly return this error
 						//
 						errorCode = SBG_INVALID_CRC;
+
+						pHandle->stats.crcErrors++;
+						pHandle->stats.bytesDiscarded += (uint32_t)(payloadSize+9);
 					}
 
 					//
 					// We have read a whole valid frame so remove it from the buffer
-					// First, test if the reception buffer contains more than just the current frame
 					//
-					if (pHandle->rxBufferSize > payloadSize+9)
-					{
-						//
-						// We remove the read frame but we keep the remaining data
-						//
-						pHandle->rxBufferSize = pHandle->rxBufferSize-(payloadSize+9);
-						memmove(pHandle->rxBuffer, pHandle->rxBuffer+payloadSize+9, pHandle->rxBufferSize);
-					}
-					else
-					{
-						//
-						// We have parsed the whole received buffer so just empty it
-						//
-						pHandle->rxBufferSize = 0;
-					}
+					sbgEComProtocolDiscardFrame(pHandle, payloadSize+9);
 
 					//
 					// We have at least found a complete frame
@@ -401,11 +458,19 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass
 					return errorCode;
 				}
 			}
+			else
+			{
+				pHandle->stats.oversizePayloads++;
+			}
 				
 			//
 			// Frame size invalid or the found frame is invalid so we should have incorrectly detected a start of frame.
 			// Remove the SYNC 1 and SYNC 2 chars to retry to find a new frame
 			//
+			pHandle->stats.invalidFrames++;
+			pHandle->stats.bytesDiscarded += 2;
+			pHandle->stats.resyncs++;
+
 			pHandle->rxBufferSize -= 2;
 			memmove(pHandle->rxBuffer, pHandle->rxBuffer+2, pHandle->rxBufferSize);
 		}
@@ -419,6 +484,8 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass
 				//
 				// Report the SYNC char and discard all other bytes in the buffer
 				//
+				numBytesDiscarded = pHandle->rxBufferSize-1;
+
 				pHandle->rxBuffer[0] = SBG_ECOM_SYNC_1;
 				pHandle->rxBufferSize = 1;
 			}
@@ -427,9 +494,20 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass
 				//
 				// Discard the whole buffer
 				//
+				numBytesDiscarded = pHandle->rxBufferSize;
+
 				pHandle->rxBufferSize = 0;
 			}
 
+			//
+			// Account for the discarded bytes, if any, as a synchronization loss
+			//
+			if (numBytesDiscarded > 0)
+			{
+				pHandle->stats.bytesDiscarded += (uint32_t)numBytesDiscarded;
+				pHandle->stats.resyncs++;
+			}
+
 			//
 			// Unable to find a frame
 			//
@@ -443,6 +521,49 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass
 	return SBG_NOT_READY;
 }
 
+/*!
+ * Define the callback used to drop unwanted frames before their CRC is checked.
+ * Dropped frames are removed from the reception buffer and never returned by sbgEComProtocolReceive.
+ * \param[in]	pHandle					A valid protocol handle.
+ * \param[in]	pFrameFilterCallback	Frame filter callback or NULL to disable frame filtering.
+ * \param[in]	pUserArg				Optional user supplied argument passed to the callback.
+ */
+void sbgEComProtocolSetFrameFilter(SbgEComProtocol *pHandle, SbgEComProtocolFrameFilterFunc pFrameFilterCallback, void *pUserArg)
+{
+	assert(pHandle);
+
+	pHandle->pFrameFilterCallback = pFrameFilterCallback;
+	pHandle->pFrameFilterUserArg = pUserArg;
+}
+
+/*!
+ * Define the callback called right after some bytes have been read from the interface.
+ * It is used to time stamp the reception of the frames before they are extracted from the reception buffer.
+ * \param[in]	pHandle					A valid protocol handle.
+ * \param[in]	pReadCallback			Read callback or NULL to disable it.
+ * \param[in]	pUserArg				Optional user supplied argument passed to the callback.
+ */
+void sbgEComProtocolSetReadCallback(SbgEComProtocol *pHandle, SbgEComProtocolReadFunc pReadCallback, void *pUserArg)
+{
+	assert(pHandle);
+
+	pHandle->pReadCallback = pReadCallback;
+	pHandle->pReadUserArg = pUserArg;
+}
+
+/*!
+ * Get the link health counters cumulated since the protocol has been initialized.
+ * \param[in]	pHandle					A valid protocol handle.
+ * \param[out]	pStats					Pointer used to return the counters.
+ */
+void sbgEComProtocolGetStats(const SbgEComProtocol *pHandle, SbgEComProtocolStats *pStats)
+{
+	assert(pHandle);
+	assert(pStats);
+
+	*pStats = pHandle->stats;
+}
+
 //----------------------------------------------------------------------//
 //- Frame generation to stream buffer                                  -//
 //----------------------------------------------------------------------//
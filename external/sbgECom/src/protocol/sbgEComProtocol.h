@@ -44,14 +44,51 @@
 //- Communication protocol structs and definitions                     -//
 //----------------------------------------------------------------------//
 
+/*!
+ * Callback used to accept or reject a received frame before its CRC is checked.
+ * \param[in]	msgClass				Message class of the received frame.
+ * \param[in]	msg						Message id of the received frame.
+ * \param[in]	pUserArg				Optional user supplied argument.
+ * \return								TRUE if the frame has to be checked and returned, FALSE to silently drop it.
+ */
+typedef bool (*SbgEComProtocolFrameFilterFunc)(uint8_t msgClass, uint8_t msg, void *pUserArg);
+
+/*!
+ * Callback called right after some bytes have been read from the interface.
+ * \param[in]	numBytesRead			Number of bytes read from the interface.
+ * \param[in]	pUserArg				Optional user supplied argument.
+ */
+typedef void (*SbgEComProtocolReadFunc)(size_t numBytesRead, void *pUserArg);
+
+/*!
+ * Link health counters, cumulated since the protocol has been initialized.
+ * Counters are only updated by the thread calling sbgEComProtocolReceive and wrap around on overflow.
+ */
+typedef struct _SbgEComProtocolStats
+{
+	uint32_t						 bytesReceived;								/*!< Number of bytes read from the interface. */
+	uint32_t						 bytesDiscarded;							/*!< Number of bytes dropped because they didn't belong to a valid frame. */
+	uint32_t						 framesReceived;							/*!< Number of frames with a valid CRC. */
+	uint32_t						 resyncs;									/*!< Number of times bytes have been skipped to find a new start of frame. */
+	uint32_t						 crcErrors;									/*!< Number of frames dropped because of an invalid CRC. */
+	uint32_t						 invalidFrames;								/*!< Number of start of frames rejected before the CRC check, because of an invalid payload size or end of frame. */
+	uint32_t						 oversizePayloads;							/*!< Number of frame headers with a payload size above SBG_ECOM_MAX_PAYLOAD_SIZE. */
+	uint32_t						 rxBufferFull;								/*!< Number of reception attempts skipped because the reception buffer was full. */
+} SbgEComProtocolStats;
+
 /*!
  * Struct containing all protocol related data.
  */
 typedef struct _SbgEComProtocol
 {
-	SbgInterface		*pLinkedInterface;							/*!< Associated interface used by the protocol to read/write bytes. */
-	uint8_t				 rxBuffer[SBG_ECOM_MAX_BUFFER_SIZE];		/*!< The reception buffer. */
-	size_t				 rxBufferSize;								/*!< The current reception buffer size in bytes. */
+	SbgInterface					*pLinkedInterface;							/*!< Associated interface used by the protocol to read/write bytes. */
+	uint8_t							 rxBuffer[SBG_ECOM_MAX_BUFFER_SIZE];		/*!< The reception buffer. */
+	size_t							 rxBufferSize;								/*!< The current reception buffer size in bytes. */
+	SbgEComProtocolFrameFilterFunc	 pFrameFilterCallback;						/*!< Optional callback used to drop frames before the CRC check. */
+	void							*pFrameFilterUserArg;						/*!< Optional user supplied argument for the frame filter callback. */
+	SbgEComProtocolReadFunc			 pReadCallback;								/*!< Optional callback called after each read returning some bytes. */
+	void							*pReadUserArg;								/*!< Optional user supplied argument for the read callback. */
+	SbgEComProtocolStats			 stats;										/*!< Link health counters. */
 } SbgEComProtocol;
 
 //----------------------------------------------------------------------//
@@ -100,6 +137,31 @@ SbgErrorCode sbgEComProtocolSend(SbgEComProtocol *pHandle, uint8_t msgClass, uin
  */
 SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint8_t *pMsgClass, uint8_t *pMsg, void *pData, size_t *pSize, size_t maxSize);
 
+/*!
+ * Define the callback used to drop unwanted frames before their CRC is checked.
+ * Dropped frames are removed from the reception buffer and never returned by sbgEComProtocolReceive.
+ * \param[in]	pHandle					A valid protocol handle.
+ * \param[in]	pFrameFilterCallback	Frame filter callback or NULL to disable frame filtering.
+ * \param[in]	pUserArg				Optional user supplied argument passed to the callback.
+ */
+void sbgEComProtocolSetFrameFilter(SbgEComProtocol *pHandle, SbgEComProtocolFrameFilterFunc pFrameFilterCallback, void *pUserArg);
+
+/*!
+ * Define the callback called right after some bytes have been read from the interface.
+ * It is used to time stamp the reception of the frames before they are extracted from the reception buffer.
+ * \param[in]	pHandle					A valid protocol handle.
+ * \param[in]	pReadCallback			Read callback or NULL to disable it.
+ * \param[in]	pUserArg				Optional user supplied argument passed to the callback.
+ */
+void sbgEComProtocolSetReadCallback(SbgEComProtocol *pHandle, SbgEComProtocolReadFunc pReadCallback, void *pUserArg);
+
+/*!
+ * Get the link health counters cumulated since the protocol has been initialized.
+ * \param[in]	pHandle					A valid protocol handle.
+ * \param[out]	pStats					Pointer used to return the counters.
+ */
+void sbgEComProtocolGetStats(const SbgEComProtocol *pHandle, SbgEComProtocolStats *pStats);
+
 //----------------------------------------------------------------------//
 //- Frame generation to stream buffer                                  -//
 //----------------------------------------------------------------------//
@@ -6,6 +6,20 @@
 //- Private methods declarations                                       -//
 //----------------------------------------------------------------------//
 
+/*!
+ * Protocol frame filter used to drop rejected logs before the CRC check.
+ * \param[in]	msgClass						Message class of the received frame.
+ * \param[in]	msg								Message id of the received frame.
+ * \param[in]	pUserArg						sbgECom handle that owns the log filter.
+ * \return										TRUE if the frame has to be checked and returned.
+ */
+static bool sbgEComFrameFilterCallback(uint8_t msgClass, uint8_t msg, void *pUserArg)
+{
+	assert(pUserArg);
+
+	return sbgEComLogFilterIsEnabled((const SbgEComHandle*)pUserArg, (SbgEComClass)msgClass, (SbgEComMsgId)msg);
+}
+
 //----------------------------------------------------------------------//
 //- Public methods declarations                                        -//
 //----------------------------------------------------------------------//
@@ -30,6 +44,12 @@ SbgErrorCode sbgEComInit(SbgEComHandle *pHandle, SbgInterface *pInterface)
 		//
 		pHandle->pReceiveLogCallback	= NULL;
 		pHandle->pUserArg				= NULL;
+		pHandle->pFrameStageCallback	= NULL;
+		pHandle->pFrameStageUserArg		= NULL;
+		pHandle->pReceiveFrameCallback	= NULL;
+		pHandle->pReceiveFrameUserArg	= NULL;
+		pHandle->pReceiveCmdCallback	= NULL;
+		pHandle->pReceiveCmdUserArg		= NULL;
 
 		//
 		// Initialize the default number of trials and time out
@@ -37,6 +57,12 @@ SbgErrorCode sbgEComInit(SbgEComHandle *pHandle, SbgInterface *pInterface)
 		pHandle->numTrials			= 3;
 		pHandle->cmdDefaultTimeOut	= SBG_ECOM_DEFAULT_CMD_TIME_OUT;
 
+		//
+		// By default, all logs are parsed and forwarded to the callback
+		//
+		sbgEComLogFilterSetAll(pHandle, TRUE);
+		pHandle->logFilterMode		= SBG_ECOM_LOG_FILTER_AFTER_CRC;
+
 		//
 		// Initialize the protocol 
 		//
@@ -111,6 +137,27 @@ SbgErrorCode sbgEComHandleOneLog(SbgEComHandle *pHandle)
 		//
 		if (sbgEComMsgClassIsALog((SbgEComClass)receivedMsgClass))
 		{
+			if (pHandle->pFrameStageCallback)
+			{
+				pHandle->pFrameStageCallback(pHandle, SBG_ECOM_FRAME_STAGE_RECEIVED, (SbgEComClass)receivedMsgClass, (SbgEComMsgId)receivedMsg, pHandle->pFrameStageUserArg);
+			}
+
+			//
+			// Forward the raw payload, the log isn't parsed if it has been consumed
+			//
+			if ((pHandle->pReceiveFrameCallback) && (pHandle->pReceiveFrameCallback(pHandle, (SbgEComClass)receivedMsgClass, (SbgEComMsgId)receivedMsg, payloadData, payloadSize, pHandle->pReceiveFrameUserArg)))
+			{
+				return SBG_NO_ERROR;
+			}
+
+			//
+			// Skip logs rejected by the log filter without parsing them
+			//
+			if (!sbgEComLogFilterIsEnabled(pHandle, (SbgEComClass)receivedMsgClass, (SbgEComMsgId)receivedMsg))
+			{
+				return SBG_NO_ERROR;
+			}
+
 			//
 			// The received frame is a binary log one
 			//
@@ -121,6 +168,11 @@ SbgErrorCode sbgEComHandleOneLog(SbgEComHandle *pHandle)
 			//
 			if (errorCode == SBG_NO_ERROR)
 			{
+				if (pHandle->pFrameStageCallback)
+				{
+					pHandle->pFrameStageCallback(pHandle, SBG_ECOM_FRAME_STAGE_PARSED, (SbgEComClass)receivedMsgClass, (SbgEComMsgId)receivedMsg, pHandle->pFrameStageUserArg);
+				}
+
 				//
 				// Test if we have a valid callback to handle received logs
 				//
@@ -142,8 +194,12 @@ SbgErrorCode sbgEComHandleOneLog(SbgEComHandle *pHandle)
 		else
 		{
 			//
-			// We have received a command, it shouldn't happen
+			// We have received a command, forward it to the receive command callback if any
 			//
+			if (pHandle->pReceiveCmdCallback)
+			{
+				pHandle->pReceiveCmdCallback(pHandle, receivedMsgClass, receivedMsg, payloadData, payloadSize, pHandle->pReceiveCmdUserArg);
+			}
 		}
 	}
 	else if (errorCode != SBG_NOT_READY)
@@ -215,6 +271,51 @@ SbgErrorCode sbgEComSetReceiveLogCallback(SbgEComHandle *pHandle, SbgEComReceive
 	return errorCode;
 }
 
+/*!
+ *	Define the callback called at each processing stage of a received log.
+ *	When no callback is defined, the reception path is not instrumented at all.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pFrameStageCallback				Pointer on the callback to call, NULL to disable it.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ */
+void sbgEComSetFrameStageCallback(SbgEComHandle *pHandle, SbgEComFrameStageFunc pFrameStageCallback, void *pUserArg)
+{
+	assert(pHandle);
+
+	pHandle->pFrameStageCallback	= pFrameStageCallback;
+	pHandle->pFrameStageUserArg		= pUserArg;
+}
+
+/*!
+ *	Define the callback called with the payload of each valid log frame, before the log filter.
+ *	The log is neither filtered nor parsed if the callback consumes it.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pReceiveFrameCallback			Pointer on the callback to call, NULL to disable it.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ */
+void sbgEComSetReceiveFrameCallback(SbgEComHandle *pHandle, SbgEComReceiveFrameFunc pReceiveFrameCallback, void *pUserArg)
+{
+	assert(pHandle);
+
+	pHandle->pReceiveFrameCallback	= pReceiveFrameCallback;
+	pHandle->pReceiveFrameUserArg	= pUserArg;
+}
+
+/*!
+ *	Define the callback called with the payload of each command frame received, either by sbgEComHandle or while waiting for a synchronous command answer.
+ *	A command consumed by the callback is not returned to the synchronous command waiting for an answer.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pReceiveCmdCallback				Pointer on the callback to call, NULL to disable it.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ */
+void sbgEComSetReceiveCmdCallback(SbgEComHandle *pHandle, SbgEComReceiveCmdFunc pReceiveCmdCallback, void *pUserArg)
+{
+	assert(pHandle);
+
+	pHandle->pReceiveCmdCallback	= pReceiveCmdCallback;
+	pHandle->pReceiveCmdUserArg		= pUserArg;
+}
+
 /*!
  * Define the default number of trials that should be done when a command is send to the device as well as the time out.
  * \param[in]	pHandle							A valid sbgECom handle.
@@ -237,6 +338,99 @@ void sbgEComSetCmdTrialsAndTimeOut(SbgEComHandle *pHandle, uint32_t numTrials, u
 	pHandle->cmdDefaultTimeOut	= cmdDefaultTimeOut;
 }
 
+/*!
+ * Accept or reject all binary logs at once.
+ * \param[in]	pHandle							A valid sbgECom handle.
+ * \param[in]	enable							TRUE to parse and forward all logs, FALSE to drop all of them.
+ */
+void sbgEComLogFilterSetAll(SbgEComHandle *pHandle, bool enable)
+{
+	assert(pHandle);
+
+	memset(pHandle->logFilter, enable ? 0xFF : 0x00, sizeof(pHandle->logFilter));
+}
+
+/*!
+ * Accept or reject a single binary log.
+ * Rejected logs are neither parsed nor forwarded to the receive log callback.
+ * \param[in]	pHandle							A valid sbgECom handle.
+ * \param[in]	msgClass						Class of the log (only SBG_ECOM_CLASS_LOG_ECOM_0 and SBG_ECOM_CLASS_LOG_ECOM_1 can be filtered).
+ * \param[in]	msg								Message ID of the log.
+ * \param[in]	enable							TRUE to parse and forward this log, FALSE to drop it.
+ * \return										SBG_NO_ERROR if the filter has been updated.
+ */
+SbgErrorCode sbgEComLogFilterSet(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msg, bool enable)
+{
+	SbgErrorCode	errorCode = SBG_NO_ERROR;
+	uint32_t		mask;
+
+	assert(pHandle);
+
+	if (sbgEComMsgClassIsALog(msgClass))
+	{
+		mask = 1u << (msg % 32);
+
+		if (enable)
+		{
+			pHandle->logFilter[msgClass][msg / 32] |= mask;
+		}
+		else
+		{
+			pHandle->logFilter[msgClass][msg / 32] &= ~mask;
+		}
+	}
+	else
+	{
+		errorCode = SBG_INVALID_PARAMETER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ * Check if a binary log is accepted by the log filter.
+ * Messages from classes that can't be filtered are always accepted.
+ * \param[in]	pHandle							A valid sbgECom handle.
+ * \param[in]	msgClass						Class of the message.
+ * \param[in]	msg								Message ID.
+ * \return										TRUE if the message has to be parsed.
+ */
+bool sbgEComLogFilterIsEnabled(const SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msg)
+{
+	assert(pHandle);
+
+	if (sbgEComMsgClassIsALog(msgClass))
+	{
+		return (pHandle->logFilter[msgClass][msg / 32] & (1u << (msg % 32))) != 0;
+	}
+	else
+	{
+		return TRUE;
+	}
+}
+
+/*!
+ * Define when frames rejected by the log filter are dropped.
+ * Dropping frames before the CRC check saves the CRC computation, but a corrupted header may then discard valid data.
+ * \param[in]	pHandle							A valid sbgECom handle.
+ * \param[in]	mode							Log filter mode.
+ */
+void sbgEComLogFilterSetMode(SbgEComHandle *pHandle, SbgEComLogFilterMode mode)
+{
+	assert(pHandle);
+
+	pHandle->logFilterMode = mode;
+
+	if (mode == SBG_ECOM_LOG_FILTER_BEFORE_CRC)
+	{
+		sbgEComProtocolSetFrameFilter(&pHandle->protocolHandle, sbgEComFrameFilterCallback, pHandle);
+	}
+	else
+	{
+		sbgEComProtocolSetFrameFilter(&pHandle->protocolHandle, NULL, NULL);
+	}
+}
+
 /*!
  *	Convert an error code into a human readable string.
  *	\param[in]	errorCode						The errorCode to convert into a string.
@@ -71,6 +71,65 @@ typedef struct _SbgEComHandle SbgEComHandle;
  */
 typedef SbgErrorCode (*SbgEComReceiveLogFunc)(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msg, const SbgBinaryLogData *pLogData, void *pUserArg);
 
+/*!
+ * Processing stages of a received log, reported to the optional frame stage callback.
+ */
+typedef enum _SbgEComFrameStage
+{
+	SBG_ECOM_FRAME_STAGE_RECEIVED		= 0,			/*!< A valid log frame has been received, before the log filter is applied. */
+	SBG_ECOM_FRAME_STAGE_PARSED			= 1				/*!< The log has been parsed, just before the log callback is called. */
+} SbgEComFrameStage;
+
+/*!
+ *	Callback definition called at each processing stage of a received log, used to instrument the reception path.
+ *	\param[in]	pHandle									Valid handle on the sbgECom instance that has called this callback.
+ *	\param[in]	stage									Stage the log has reached.
+ *	\param[in]	msgClass								Class of the log.
+ *	\param[in]	msg										Message ID of the log.
+ *	\param[in]	pUserArg								Optional user supplied argument.
+ */
+typedef void (*SbgEComFrameStageFunc)(SbgEComHandle *pHandle, SbgEComFrameStage stage, SbgEComClass msgClass, SbgEComMsgId msg, void *pUserArg);
+
+/*!
+ *	Callback definition called with the payload of each valid log frame, before the log filter and the log parsing.
+ *	\param[in]	pHandle									Valid handle on the sbgECom instance that has called this callback.
+ *	\param[in]	msgClass								Class of the log.
+ *	\param[in]	msg										Message ID of the log.
+ *	\param[in]	pPayload								Log payload, only valid during the callback.
+ *	\param[in]	payloadSize								Log payload size in bytes.
+ *	\param[in]	pUserArg								Optional user supplied argument.
+ *	\return												TRUE if the log has been consumed and must not be parsed.
+ */
+typedef bool (*SbgEComReceiveFrameFunc)(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msg, const void *pPayload, size_t payloadSize, void *pUserArg);
+
+/*!
+ *	Callback definition called with the payload of each command frame received, before it is returned to a synchronous command.
+ *	\param[in]	pHandle									Valid handle on the sbgECom instance that has called this callback.
+ *	\param[in]	msgClass								Class of the command.
+ *	\param[in]	msg										Message ID of the command.
+ *	\param[in]	pPayload								Command payload, only valid during the callback.
+ *	\param[in]	payloadSize								Command payload size in bytes.
+ *	\param[in]	pUserArg								Optional user supplied argument.
+ *	\return												TRUE if the command has been consumed and must not be returned to a synchronous command.
+ */
+typedef bool (*SbgEComReceiveCmdFunc)(SbgEComHandle *pHandle, uint8_t msgClass, uint8_t msg, const void *pPayload, size_t payloadSize, void *pUserArg);
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define SBG_ECOM_LOG_FILTER_NUM_CLASSES		(2)										/*!< Number of log classes handled by the log filter (ECOM_0 and ECOM_1). */
+#define SBG_ECOM_LOG_FILTER_NUM_WORDS		(256/32)								/*!< Number of 32 bits words used to store one bit per message id. */
+
+/*!
+ * Define when frames rejected by the log filter are dropped.
+ */
+typedef enum _SbgEComLogFilterMode
+{
+	SBG_ECOM_LOG_FILTER_AFTER_CRC		= 0,			/*!< Rejected logs are dropped once the frame CRC has been validated (default). */
+	SBG_ECOM_LOG_FILTER_BEFORE_CRC		= 1				/*!< Rejected logs are dropped as soon as the frame header and ETX are read, without any CRC computation. */
+} SbgEComLogFilterMode;
+
 //----------------------------------------------------------------------//
 //- Structures definitions                                             -//
 //----------------------------------------------------------------------//
@@ -87,6 +146,18 @@ struct _SbgEComHandle
 	
 	uint32_t					 numTrials;					/*!< Number of trials when a command is sent (default is 3). */
 	uint32_t					 cmdDefaultTimeOut;			/*!< Default time out in ms to get an answer from the device (default 500 ms). */
+
+	uint32_t					 logFilter[SBG_ECOM_LOG_FILTER_NUM_CLASSES][SBG_ECOM_LOG_FILTER_NUM_WORDS];	/*!< One bit per log, set if the log has to be parsed and forwarded to the callback (default all set). */
+	SbgEComLogFilterMode		 logFilterMode;				/*!< Define when frames rejected by the log filter are dropped. */
+
+	SbgEComFrameStageFunc		 pFrameStageCallback;		/*!< Optional method called at each processing stage of a received log (default NULL). */
+	void						*pFrameStageUserArg;		/*!< Optional user supplied argument for the frame stage callback. */
+
+	SbgEComReceiveFrameFunc		 pReceiveFrameCallback;		/*!< Optional method called with the payload of each valid log frame (default NULL). */
+	void						*pReceiveFrameUserArg;		/*!< Optional user supplied argument for the receive frame callback. */
+
+	SbgEComReceiveCmdFunc		 pReceiveCmdCallback;		/*!< Optional method called with the payload of each command frame (default NULL). */
+	void						*pReceiveCmdUserArg;		/*!< Optional user supplied argument for the receive command callback. */
 };
 
 //----------------------------------------------------------------------//
@@ -131,6 +202,33 @@ SbgErrorCode sbgEComHandle(SbgEComHandle *pHandle);
  */
 SbgErrorCode sbgEComSetReceiveLogCallback(SbgEComHandle *pHandle, SbgEComReceiveLogFunc pReceiveLogCallback, void *pUserArg);
 
+/*!
+ *	Define the callback called at each processing stage of a received log.
+ *	When no callback is defined, the reception path is not instrumented at all.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pFrameStageCallback				Pointer on the callback to call, NULL to disable it.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ */
+void sbgEComSetFrameStageCallback(SbgEComHandle *pHandle, SbgEComFrameStageFunc pFrameStageCallback, void *pUserArg);
+
+/*!
+ *	Define the callback called with the payload of each valid log frame, before the log filter.
+ *	The log is neither filtered nor parsed if the callback consumes it.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pReceiveFrameCallback			Pointer on the callback to call, NULL to disable it.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ */
+void sbgEComSetReceiveFrameCallback(SbgEComHandle *pHandle, SbgEComReceiveFrameFunc pReceiveFrameCallback, void *pUserArg);
+
+/*!
+ *	Define the callback called with the payload of each command frame received, either by sbgEComHandle or while waiting for a synchronous command answer.
+ *	A command consumed by the callback is not returned to the synchronous command waiting for an answer.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pReceiveCmdCallback				Pointer on the callback to call, NULL to disable it.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ */
+void sbgEComSetReceiveCmdCallback(SbgEComHandle *pHandle, SbgEComReceiveCmdFunc pReceiveCmdCallback, void *pUserArg);
+
 /*!
  * Define the default number of trials that should be done when a command is send to the device as well as the time out.
  * \param[in]	pHandle							A valid sbgECom handle.
@@ -139,6 +237,42 @@ SbgErrorCode sbgEComSetReceiveLogCallback(SbgEComHandle *pHandle, SbgEComReceive
  */
 void sbgEComSetCmdTrialsAndTimeOut(SbgEComHandle *pHandle, uint32_t numTrials, uint32_t cmdDefaultTimeOut);
 
+/*!
+ * Accept or reject all binary logs at once.
+ * \param[in]	pHandle							A valid sbgECom handle.
+ * \param[in]	enable							TRUE to parse and forward all logs, FALSE to drop all of them.
+ */
+void sbgEComLogFilterSetAll(SbgEComHandle *pHandle, bool enable);
+
+/*!
+ * Accept or reject a single binary log.
+ * Rejected logs are neither parsed nor forwarded to the receive log callback.
+ * \param[in]	pHandle							A valid sbgECom handle.
+ * \param[in]	msgClass						Class of the log (only SBG_ECOM_CLASS_LOG_ECOM_0 and SBG_ECOM_CLASS_LOG_ECOM_1 can be filtered).
+ * \param[in]	msg								Message ID of the log.
+ * \param[in]	enable							TRUE to parse and forward this log, FALSE to drop it.
+ * \return										SBG_NO_ERROR if the filter has been updated.
+ */
+SbgErrorCode sbgEComLogFilterSet(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msg, bool enable);
+
+/*!
+ * Check if a binary log is accepted by the log filter.
+ * Messages from classes that can't be filtered are always accepted.
+ * \param[in]	pHandle							A valid sbgECom handle.
+ * \param[in]	msgClass						Class of the message.
+ * \param[in]	msg								Message ID.
+ * \return										TRUE if the message has to be parsed.
+ */
+bool sbgEComLogFilterIsEnabled(const SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msg);
+
+/*!
+ * Define when frames rejected by the log filter are dropped.
+ * Dropping frames before the CRC check saves the CRC computation, but a corrupted header may then discard valid data.
+ * \param[in]	pHandle							A valid sbgECom handle.
+ * \param[in]	mode							Log filter mode.
+ */
+void sbgEComLogFilterSetMode(SbgEComHandle *pHandle, SbgEComLogFilterMode mode);
+
 /*!
  *	Convert an error code into a human readable string.
  *	\param[in]	errorCode						The errorCode to convert into a string.
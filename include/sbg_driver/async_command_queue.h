@@ -0,0 +1,247 @@
+/*!
+*	\file         async_command_queue.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Send device commands without waiting for their answers.
+*
+*   The commands are sent once and kept pending, their answers are matched from the command frames
+*   received by sbgECom while the logs keep flowing, and the completions are called from handle().
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_ASYNC_COMMAND_QUEUE_H
+#define SBG_ROS_ASYNC_COMMAND_QUEUE_H
+
+// Standard headers
+#include <array>
+#include <deque>
+#include <vector>
+
+// SbgECom headers
+#include <sbgEComLib.h>
+
+/*!
+ * Maximum number of commands waiting for an answer at the same time.
+ */
+#define SBG_ASYNC_COMMAND_MAX_PENDING   (8)
+
+/*!
+ * Maximum number of command payload bytes echoed at the start of the answer payload.
+ */
+#define SBG_ASYNC_COMMAND_MAX_ECHO_SIZE (4)
+
+namespace sbg
+{
+/*!
+ * Answer that completes an asynchronous command.
+ */
+enum class AsyncAnswerType
+{
+  ACK     = 0,      /*!< An ACK frame for the command class and id. */
+  PAYLOAD = 1,      /*!< A frame with the command class, id and echo, an ACK for it is a negative answer. */
+};
+
+/*!
+ * Callback called when an asynchronous command is completed, either by an answer or by its time out.
+ *
+ * \param[in] error_code          SBG_NO_ERROR if the expected answer has been received, the device error code or SBG_TIME_OUT otherwise.
+ * \param[in] p_payload           Answer payload, only valid during the callback (nullptr if none).
+ * \param[in] payload_size        Answer payload size in bytes.
+ * \param[in] p_user_arg          User argument given with the command.
+ */
+typedef void (*AsyncCommandCallback)(SbgErrorCode error_code, const uint8_t *p_payload, size_t payload_size, void *p_user_arg);
+
+/*!
+ * Class to send device commands without waiting for their answers.
+ */
+class AsyncCommandQueue
+{
+private:
+
+  /*!
+   * Command waiting for its answer.
+   */
+  struct PendingCommand
+  {
+    bool                                                  in_use;         /*!< True if this slot holds a command waiting for an answer. */
+    uint8_t                                               msg_class;      /*!< Class of the command sent. */
+    uint8_t                                               msg;            /*!< Message ID of the command sent. */
+    AsyncAnswerType                                       answer_type;    /*!< Answer expected to complete the command. */
+    uint32_t                                              deadline;       /*!< Time in ms after which the command is completed with SBG_TIME_OUT. */
+    uint32_t                                              sequence;       /*!< Send sequence number, ACK answers are matched in this order. */
+    std::array<uint8_t, SBG_ASYNC_COMMAND_MAX_ECHO_SIZE>  echo;           /*!< Command payload bytes a payload answer must start with. */
+    size_t                                                echo_size;      /*!< Number of echoed bytes. */
+    AsyncCommandCallback                                  p_callback;     /*!< Function called when the command is completed. */
+    void                                                  *p_user_arg;    /*!< User argument for the callback. */
+  };
+
+  /*!
+   * Completed command waiting for its callback to be called.
+   */
+  struct Completion
+  {
+    AsyncCommandCallback  p_callback;     /*!< Function called for the completion. */
+    void                  *p_user_arg;    /*!< User argument for the callback. */
+    SbgErrorCode          error_code;     /*!< Command completion status. */
+    std::vector<uint8_t>  payload;        /*!< Copy of the answer payload. */
+  };
+
+  SbgEComHandle                                             &m_ref_sbg_com_handle_;
+  std::array<PendingCommand, SBG_ASYNC_COMMAND_MAX_PENDING> m_pending_commands_;
+  uint32_t                                                  m_sequence_;
+  std::deque<Completion>                                    m_completions_;
+
+  //---------------------------------------------------------------------//
+  //- Private methods                                                   -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Receive command callback of the sbgECom handle.
+   *
+   * \param[in] p_handle          SBG communication handle.
+   * \param[in] msg_class         Class of the received command.
+   * \param[in] msg               Message ID of the received command.
+   * \param[in] p_payload         Received command payload.
+   * \param[in] payload_size      Received command payload size in bytes.
+   * \param[in] p_user_arg        Asynchronous command queue.
+   * \return                      True if the command has answered a pending command.
+   */
+  static bool onCommandReceivedCallback(SbgEComHandle *p_handle, uint8_t msg_class, uint8_t msg, const void *p_payload, size_t payload_size, void *p_user_arg);
+
+  /*!
+   * Match a received command frame with the oldest pending command it answers.
+   *
+   * \param[in] msg_class         Class of the received command.
+   * \param[in] msg               Message ID of the received command.
+   * \param[in] p_payload         Received command payload.
+   * \param[in] payload_size      Received command payload size in bytes.
+   * \return                      True if the command has answered a pending command.
+   */
+  bool onCommandReceived(uint8_t msg_class, uint8_t msg, const uint8_t *p_payload, size_t payload_size);
+
+  /*!
+   * Find the oldest pending command with the given class and id.
+   * If an answer payload is given, only the commands waiting for a payload that starts with their echo are returned.
+   *
+   * \param[in] msg_class         Command class.
+   * \param[in] msg               Command id.
+   * \param[in] p_payload         Answer payload, nullptr to ignore the echo.
+   * \param[in] payload_size      Answer payload size in bytes.
+   * \return                      Pending command, nullptr if none.
+   */
+  PendingCommand *findOldest(uint8_t msg_class, uint8_t msg, const uint8_t *p_payload, size_t payload_size);
+
+  /*!
+   * Release a pending command and queue its completion.
+   *
+   * \param[in] ref_command       Pending command to complete.
+   * \param[in] error_code        Command completion status.
+   * \param[in] p_payload         Answer payload (can be nullptr).
+   * \param[in] payload_size      Answer payload size in bytes.
+   */
+  void complete(PendingCommand &ref_command, SbgErrorCode error_code, const uint8_t *p_payload, size_t payload_size);
+
+  /*!
+   * Complete with SBG_TIME_OUT the pending commands whose time out has expired.
+   */
+  void checkTimeOuts(void);
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Constructor, registers the queue as the receive command callback of the handle.
+   *
+   * \param[in] ref_sbg_com_handle SBG communication handle.
+   */
+  AsyncCommandQueue(SbgEComHandle &ref_sbg_com_handle);
+
+  /*!
+   * Default destructor, unregisters the receive command callback.
+   */
+  ~AsyncCommandQueue(void);
+
+  AsyncCommandQueue(const AsyncCommandQueue&) = delete;
+  AsyncCommandQueue& operator=(const AsyncCommandQueue&) = delete;
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Get the number of commands whose completion has not been called yet.
+   *
+   * \return                      Number of pending and completed but not yet dispatched commands.
+   */
+  size_t getNumPending(void) const;
+
+  /*!
+   * Check if all the pending command slots are used, so no command can be sent.
+   *
+   * \return                      True if SBG_ASYNC_COMMAND_MAX_PENDING commands are pending.
+   */
+  bool isFull(void) const;
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Send a command once and keep it pending until its answer is received or its time out expires.
+   *
+   * A payload answer completes the command only if it starts with the first echo_size bytes of the command,
+   * so commands with the same class and id can be answered out of order. ACK answers carry no echo and are
+   * matched in the order commands have been sent: after a time out, a late ACK may complete the wrong command.
+   *
+   * \param[in] msg_class         Class of the command.
+   * \param[in] msg               Message ID of the command.
+   * \param[in] p_data            Command payload (can be nullptr if size is 0).
+   * \param[in] size              Command payload size in bytes.
+   * \param[in] answer_type       Answer that completes the command.
+   * \param[in] echo_size         Number of command payload bytes echoed at the start of a payload answer.
+   * \param[in] time_out          Time out in ms.
+   * \param[in] p_callback        Function called from handle() when the command is completed.
+   * \param[in] p_user_arg        User argument passed to the callback.
+   * \return                      SBG_NO_ERROR if the command has been sent,
+   *                              SBG_INVALID_PARAMETER if echo_size is larger than the payload or SBG_ASYNC_COMMAND_MAX_ECHO_SIZE,
+   *                              SBG_BUFFER_OVERFLOW if SBG_ASYNC_COMMAND_MAX_PENDING commands are already pending.
+   */
+  SbgErrorCode send(uint8_t msg_class, uint8_t msg, const void *p_data, size_t size, AsyncAnswerType answer_type, size_t echo_size, uint32_t time_out, AsyncCommandCallback p_callback, void *p_user_arg);
+
+  /*!
+   * Receive the incoming frames, complete the expired commands and call the callbacks of the completed commands.
+   *
+   * The callbacks are only called from this method, never from inside a synchronous command,
+   * so they can send new commands.
+   */
+  void handle(void);
+};
+}
+
+#endif // SBG_ROS_ASYNC_COMMAND_QUEUE_H
@@ -37,12 +37,20 @@
 #define CONFIG_APPLIER_H
 
 // Standard headers
+#include <chrono>
 #include <limits>
 #include <string>
+#include <vector>
 
 // Project headers
+#include <async_command_queue.h>
 #include <config_store.h>
 
+/*!
+ * Maximum size of the device settings export, in bytes.
+ */
+#define SBG_CONFIG_EXPORT_MAX_SIZE    (32768)
+
 namespace sbg
 {
 /*!
@@ -52,8 +60,23 @@ class ConfigApplier
 {
 private:
 
-  bool            m_reboot_needed_;
-  SbgEComHandle&  m_ref_sbg_com_handle;
+  /*!
+   * Output configuration command sent through the asynchronous command API.
+   */
+  struct OutputCommand
+  {
+    const ConfigStore::SbgLogOutput *p_log_output;    /*!< Log output the command applies to. */
+    bool                            set;              /*!< True to set the output mode, false to read it. */
+    bool                            completed;        /*!< True once the device has answered or the command has timed out. */
+    SbgErrorCode                    error_code;       /*!< Command completion status. */
+    SbgEComOutputMode               device_mode;      /*!< Output mode read from the device. */
+  };
+
+  bool                m_reboot_needed_;
+  SbgEComHandle&      m_ref_sbg_com_handle;
+  AsyncCommandQueue&  m_ref_command_queue_;
+  bool                m_settings_hash_valid_;
+  uint64_t            m_settings_hash_;
 
   //---------------------------------------------------------------------//
   //- Private  methods                                                  -//
@@ -177,6 +200,53 @@ private:
    */
   void configureOutput(SbgEComOutputPort output_port, const ConfigStore::SbgLogOutput &ref_log_output);
 
+  /*!
+   * Completion callback of the asynchronous output configuration commands.
+   *
+   * \param[in] error_code        Command completion status.
+   * \param[in] p_payload         Answer payload.
+   * \param[in] payload_size      Answer payload size in bytes.
+   * \param[in] p_user_arg        Output command that has been completed.
+   */
+  static void onOutputCommandAnswer(SbgErrorCode error_code, const uint8_t *p_payload, size_t payload_size, void *p_user_arg);
+
+  /*!
+   * Send the output commands without waiting for each answer.
+   * Up to SBG_ASYNC_COMMAND_MAX_PENDING commands are in flight at the same time.
+   *
+   * \param[in] output_port       Output communication port.
+   * \param[in] ref_commands      Output commands to send, completed on return.
+   */
+  void pipelineOutputCommands(SbgEComOutputPort output_port, std::vector<OutputCommand> &ref_commands);
+
+  /*!
+   * Check if one of the output commands has timed out.
+   *
+   * \param[in] ref_commands      Completed output commands.
+   * \return                      True if a command has timed out.
+   */
+  static bool hasTimedOut(const std::vector<OutputCommand> &ref_commands);
+
+  /*!
+   * Configure the output for all the SBG logs.
+   * Current output modes are read with pipelined commands and only the modes that differ are set.
+   * Logs whose command has failed are configured again one by one, as well as all the logs answered
+   * by an ACK when a command of the same batch has timed out, since its late ACK may have been credited to another log.
+   *
+   * \param[in] output_port       Output communication port.
+   * \param[in] ref_log_outputs   Log outputs to configure.
+   * \throw                       Unable to configure an output.
+   */
+  void configureOutputs(SbgEComOutputPort output_port, const std::vector<ConfigStore::SbgLogOutput> &ref_log_outputs);
+
+  /*!
+   * Log the duration of a configuration phase and start the next one.
+   *
+   * \param[in] ref_phase_title     String to identify the configuration phase.
+   * \param[in] ref_phase_start     Start time of the phase, reset to now.
+   */
+  void reportPhaseDuration(const std::string &ref_phase_title, std::chrono::steady_clock::time_point &ref_phase_start) const;
+
 public:
 
   //---------------------------------------------------------------------//
@@ -187,8 +257,9 @@ public:
    * Default constructor.
    *
    * \param[in] ref_com_handle    SBG communication handle.
+   * \param[in] ref_command_queue Command queue of the device, the output configurations are pipelined through it.
    */
-  ConfigApplier(SbgEComHandle &ref_sbg_com_handle);
+  ConfigApplier(SbgEComHandle &ref_sbg_com_handle, AsyncCommandQueue &ref_command_queue);
 
   //---------------------------------------------------------------------//
   //- Parameters                                                        -//
@@ -209,6 +280,23 @@ public:
    * Save the configuration to the device.
    */
   void saveConfiguration(void);
+
+  /*!
+   * Export the whole device settings and hash them.
+   *
+   * \param[out] ref_hash          Hash of the exported settings.
+   * \return                       True if the settings have been exported.
+   */
+  bool exportSettingsHash(uint64_t &ref_hash);
+
+  /*!
+   * Get the hash of the device settings once the configuration has been applied, before they are saved.
+   * The hash is only computed if the configuration cache is enabled in the applied configuration.
+   *
+   * \param[out] ref_hash          Hash of the applied settings.
+   * \return                       True if the hash is available.
+   */
+  bool getAppliedSettingsHash(uint64_t &ref_hash) const;
 };
 }
 
@@ -54,6 +54,29 @@ namespace sbg
     INS_UNIX = 1,
   };
 
+  /*!
+   * Odometry position projection.
+   */
+  enum class OdomProjection
+  {
+    UTM = 0,
+    ENU = 1,
+  };
+
+  /*!
+   * IMU preintegration trigger.
+   */
+  enum class PreintegrationTrigger
+  {
+    NONE = 0,
+    INTERVAL = 1,
+    EVENT_A = 2,
+    EVENT_B = 3,
+    EVENT_C = 4,
+    EVENT_D = 5,
+    EVENT_E = 6,
+  };
+
 /*!
  * Class to handle the device configuration.
  */
@@ -84,6 +107,7 @@ private:
   bool                        m_upd_communication_;
 
   bool                        m_configure_through_ros_;
+  std::string                 m_conf_cache_file_;
 
   SbgEComInitConditionConf    m_init_condition_conf_;
   SbgEComModelInfo            m_motion_profile_model_info_;
@@ -112,6 +136,19 @@ private:
   TimeReference               m_time_reference_;
 
   uint32_t                    m_rate_frequency_;
+  bool                        m_lazy_parsing_;
+  bool                        m_filter_before_crc_;
+  bool                        m_latency_diagnostics_;
+  bool                        m_sequence_diagnostics_;
+  bool                        m_sequence_learn_new_data_;
+  uint32_t                    m_alignment_max_gap_;
+  uint32_t                    m_pose_history_size_;
+  bool                        m_event_pose_;
+  bool                        m_status_on_change_;
+  uint32_t                    m_status_heartbeat_;
+  bool                        m_raw_frames_;
+  uint32_t                    m_raw_frames_batch_size_;
+  std::string                 m_shared_memory_name_;
   std::string                 m_frame_id_;
   bool						  m_use_enu_;
 
@@ -120,6 +157,20 @@ private:
   std::string                 m_odom_frame_id_;
   std::string                 m_odom_base_frame_id_;
   std::string                 m_odom_init_frame_id_;
+  OdomProjection              m_odom_projection_;
+  uint32_t                    m_odom_tf_rate_;
+
+  PreintegrationTrigger       m_preintegration_trigger_;
+  uint32_t                    m_preintegration_period_;
+  double                      m_gyro_noise_density_;
+  double                      m_accel_noise_density_;
+
+  uint32_t                    m_sbg_imu_data_decimation_;
+  uint32_t                    m_imu_decimation_;
+
+  sbgIpAddress                m_relay_address_;
+  uint32_t                    m_relay_port_;
+  uint32_t                    m_relay_max_datagram_size_;
 
   //---------------------------------------------------------------------//
   //- Private  methods                                                  -//
@@ -151,6 +202,20 @@ private:
     }
   }
 
+  /*!
+   * Add a value to a configuration hash.
+   *
+   * \template  T                 Scalar type of the value.
+   * \param[in] hash              Current hash.
+   * \param[in] value             Value to add to the hash.
+   * \return                      Updated hash.
+   */
+  template <typename T>
+  static uint64_t hashValue(uint64_t hash, T value)
+  {
+    return hashBuffer(&value, sizeof(value), hash);
+  }
+
   /*!
    * Load driver parameters.
    *
@@ -165,6 +230,28 @@ private:
    */
   void loadOdomParameters(const rclcpp::Node& ref_node_handle);
 
+  /*!
+   * Load the IMU preintegration parameters.
+   *
+   * \param[in] ref_node_handle     ROS nodeHandle.
+   */
+  void loadImuPreintegrationParameters(const rclcpp::Node& ref_node_handle);
+
+  /*!
+   * Load the decimation factors of the reduced rate topics.
+   *
+   * \param[in] ref_node_handle     ROS nodeHandle.
+   */
+  void loadDecimationParameters(const rclcpp::Node& ref_node_handle);
+
+  /*!
+   * Load the multicast relay parameters.
+   *
+   * \param[in] ref_node_handle     ROS nodeHandle.
+   * \throw                         Invalid relay parameters.
+   */
+  void loadRelayParameters(const rclcpp::Node& ref_node_handle);
+
   /*!
    * Load interface communication parameters.
    *
@@ -296,6 +383,13 @@ public:
    */
   bool isInterfaceUdp(void) const;
 
+  /*!
+   * Get the file used to cache the last configuration applied to the device.
+   *
+   * \return                      Configuration cache file path, empty if the cache is disabled.
+   */
+  const std::string &getConfigurationCacheFile(void) const;
+
   /*!
    * Get the Ip address of the interface.
    *
@@ -444,6 +538,97 @@ public:
    */
   uint32_t getReadingRateFrequency(void) const;
 
+  /*!
+   * Check if only the logs with active subscribers have to be parsed.
+   *
+   * \return                      True if logs without any consumer are dropped before parsing.
+   */
+  bool getLazyParsing(void) const;
+
+  /*!
+   * Check if unwanted logs have to be dropped before their CRC is checked.
+   *
+   * \return                      True if the log filter is applied before the CRC check.
+   */
+  bool getFilterBeforeCrc(void) const;
+
+  /*!
+   * Check if the latency of each log has to be measured and published as diagnostics.
+   *
+   * \return                      True if the latency diagnostics are enabled.
+   */
+  bool getLatencyDiagnostics(void) const;
+
+  /*!
+   * Check if the device time stamps of each log have to be checked for missing, duplicate or out of order logs.
+   *
+   * \return                      True if the sequence diagnostics are enabled.
+   */
+  bool getSequenceDiagnostics(void) const;
+
+  /*!
+   * Check if the logs output on new data are expected at a regular rate, learned from their time stamps.
+   *
+   * \return                      True if the period of the new data outputs is learned.
+   */
+  bool getSequenceLearnNewData(void) const;
+
+  /*!
+   * Get the maximum time between two logs to interpolate the derived messages at the IMU time stamp.
+   *
+   * \return                      Maximum alignment gap (ms).
+   */
+  uint32_t getAlignmentMaxGap(void) const;
+
+  /*!
+   * Get the number of EKF nav and quaternion logs kept to query the pose at a given time.
+   *
+   * \return                      Pose history size, 0 if disabled.
+   */
+  uint32_t getPoseHistorySize(void) const;
+
+  /*!
+   * Returns true to publish the EKF pose interpolated at each event marker.
+   *
+   * \return                      True if the event poses are published.
+   */
+  bool getEventPose(void) const;
+
+  /*!
+   * Returns true to publish the status topics only when their status changes, or at the heartbeat period.
+   *
+   * \return                      True if the status topics are published on change.
+   */
+  bool getStatusOnChange(void) const;
+
+  /*!
+   * Get the period at which an unchanged status is published again.
+   *
+   * \return                      Status heartbeat period (ms), 0 to publish only on change.
+   */
+  uint32_t getStatusHeartbeat(void) const;
+
+  /*!
+   * Returns true to publish the received frames in batches on sbg/raw_frames instead of parsing them.
+   *
+   * \return                      True if the raw frames are published.
+   */
+  bool getRawFrames(void) const;
+
+  /*!
+   * Get the maximum number of frames per raw frames message.
+   *
+   * \return                      Raw frames batch size.
+   */
+  uint32_t getRawFramesBatchSize(void) const;
+
+  /*!
+   * Get the name of the shared memory segment the latest device state is exported to.
+   *
+   * \return                      Shared memory segment name, empty if disabled.
+   */
+  const std::string &getSharedMemoryName(void) const;
+
   /*!
    * Get the frame ID.
    *
@@ -472,6 +657,13 @@ public:
    */
    bool getOdomPublishTf(void) const;
 
+  /*!
+   * Get the maximum odometry TF broadcast rate.
+   *
+   * \return                      Maximum rate (Hz), 0 to broadcast every odometry sample.
+   */
+  uint32_t getOdomTfRate(void) const;
+
   /*!
    * Get the odometry frame ID.
    *
@@ -495,6 +687,83 @@ public:
    */
   const std::string &getOdomInitFrameId(void) const;
 
+  /*!
+   * Get the odometry position projection.
+   *
+   * \return                      Odometry projection.
+   */
+  OdomProjection getOdomProjection(void) const;
+
+  /*!
+   * Get the IMU preintegration trigger.
+   *
+   * \return                      Preintegration trigger, NONE if disabled.
+   */
+  PreintegrationTrigger getPreintegrationTrigger(void) const;
+
+  /*!
+   * Get the IMU preintegration interval, used with the INTERVAL trigger.
+   *
+   * \return                      Preintegration period (ms).
+   */
+  uint32_t getPreintegrationPeriod(void) const;
+
+  /*!
+   * Get the gyroscope noise density used for the preintegration covariance.
+   *
+   * \return                      Gyroscope noise density (rad/s/sqrt(Hz)).
+   */
+  double getGyroNoiseDensity(void) const;
+
+  /*!
+   * Get the accelerometer noise density used for the preintegration covariance.
+   *
+   * \return                      Accelerometer noise density (m/s^2/sqrt(Hz)).
+   */
+  double getAccelNoiseDensity(void) const;
+
+  /*!
+   * Get the decimation factor of the filtered SBG IMU data topic.
+   *
+   * \return                      Decimation factor, 0 or 1 if disabled.
+   */
+  uint32_t getSbgImuDataDecimation(void) const;
+
+  /*!
+   * Get the decimation factor of the filtered ROS IMU topic.
+   *
+   * \return                      Decimation factor, 0 or 1 if disabled.
+   */
+  uint32_t getImuDecimation(void) const;
+
+  /*!
+   * Returns true to relay the received frames to an UDP multicast group.
+   *
+   * \return                      True if the frames are relayed.
+   */
+  bool isRelayEnabled(void) const;
+
+  /*!
+   * Get the multicast group address the frames are relayed to.
+   *
+   * \return                      Relay multicast group address.
+   */
+  sbgIpAddress getRelayAddress(void) const;
+
+  /*!
+   * Get the multicast group port the frames are relayed to.
+   *
+   * \return                      Relay multicast group port.
+   */
+  uint32_t getRelayPort(void) const;
+
+  /*!
+   * Get the maximum size of the relayed datagrams.
+   *
+   * \return                      Maximum datagram size in bytes.
+   */
+  uint32_t getRelayMaxDatagramSize(void) const;
+
   /*!
    * Get the time reference.
    *
@@ -512,6 +781,24 @@ public:
    * \param[in] ref_node_handle   ROS nodeHandle.
    */
   void loadFromRosNodeHandle(const rclcpp::Node& ref_node_handle);
+
+  /*!
+   * Compute a hash of all the settings applied to the device by the ConfigApplier.
+   * Driver only parameters such as frame ids are not part of the hash.
+   *
+   * \return                      Device configuration hash.
+   */
+  uint64_t computeDeviceConfigHash(void) const;
+
+  /*!
+   * Compute the 64 bits FNV-1a hash of a buffer.
+   *
+   * \param[in] p_buffer          Buffer to hash.
+   * \param[in] size              Buffer size in bytes.
+   * \param[in] hash              Hash to continue, FNV-1a offset basis to start a new one.
+   * \return                      Buffer hash.
+   */
+  static uint64_t hashBuffer(const void *p_buffer, size_t size, uint64_t hash = 14695981039346656037ULL);
 };
 }
 
@@ -0,0 +1,295 @@
+/*!
+*	\file         decimation_filter.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Anti-aliased decimation of the IMU messages.
+*
+*   A linear phase low-pass FIR filter runs on the message values at the input rate and one
+*   output is computed every decimation factor inputs, on the message at the filter delay.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_DECIMATION_FILTER_H
+#define SBG_ROS_DECIMATION_FILTER_H
+
+// Standard headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+
+// SbgRos message headers
+#include "sbg_driver/msg/sbg_imu_data.hpp"
+
+namespace sbg
+{
+/*!
+ * Number of filtered values of an SBG IMU message: accelerometers, gyroscopes, temperature, delta velocity and delta angle.
+ */
+#define SBG_DECIMATION_IMU_DATA_VALUES  (13)
+
+/*!
+ * Number of filtered values of a ROS IMU message: angular velocity and linear acceleration.
+ */
+#define SBG_DECIMATION_IMU_VALUES       (6)
+
+/*!
+ * Get the filtered values of an SBG IMU message.
+ *
+ * \param[in] ref_message       SBG-ROS IMU message.
+ * \return                      Message values.
+ */
+std::array<double, SBG_DECIMATION_IMU_DATA_VALUES> getDecimatedValues(const sbg_driver::msg::SbgImuData &ref_message);
+
+/*!
+ * Set the filtered values of an SBG IMU message.
+ *
+ * \param[in] ref_values        Filtered values.
+ * \param[out] ref_message      SBG-ROS IMU message.
+ */
+void setDecimatedValues(const std::array<double, SBG_DECIMATION_IMU_DATA_VALUES> &ref_values, sbg_driver::msg::SbgImuData &ref_message);
+
+/*!
+ * Get the filtered values of a ROS IMU message, the orientation is not filtered.
+ *
+ * \param[in] ref_message       ROS IMU message.
+ * \return                      Message values.
+ */
+std::array<double, SBG_DECIMATION_IMU_VALUES> getDecimatedValues(const sensor_msgs::msg::Imu &ref_message);
+
+/*!
+ * Set the filtered values of a ROS IMU message.
+ *
+ * \param[in] ref_values        Filtered values.
+ * \param[out] ref_message      ROS IMU message.
+ */
+void setDecimatedValues(const std::array<double, SBG_DECIMATION_IMU_VALUES> &ref_values, sensor_msgs::msg::Imu &ref_message);
+
+/*!
+ * Low-pass FIR filter computing one output every decimation factor inputs.
+ *
+ * The window is a windowed sinc with 16 taps per decimation factor, cut at 80 % of the output Nyquist frequency.
+ * The inputs are stored twice in a ring so the window is always contiguous, and the products are accumulated
+ * over the values in the inner loop, which the compiler vectorizes.
+ */
+class DecimationFilter
+{
+private:
+
+  uint32_t              m_factor_;
+  size_t                m_value_count_;
+  size_t                m_tap_count_;
+  std::vector<double>   m_coefficients_;
+  std::vector<double>   m_history_;
+  size_t                m_position_;
+  size_t                m_input_count_;
+  uint32_t              m_phase_;
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor, the filter is disabled.
+   */
+  DecimationFilter(void);
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Set the decimation factor and compute the filter coefficients.
+   *
+   * \param[in] factor            Decimation factor, 0 or 1 to disable the filter.
+   * \param[in] value_count       Number of filtered values per input.
+   */
+  void setFactor(uint32_t factor, size_t value_count);
+
+  /*!
+   * Check if the filter is enabled.
+   *
+   * \return                      True if the decimation factor is above 1.
+   */
+  bool isEnabled(void) const;
+
+  /*!
+   * Get the filter delay.
+   *
+   * \return                      Delay of the outputs (inputs).
+   */
+  size_t getDelay(void) const;
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Drop the stored inputs, the next output is computed once the window is full again.
+   */
+  void reset(void);
+
+  /*!
+   * Add an input.
+   *
+   * \param[in] p_input           Input values.
+   * \param[out] p_output         Filtered values, set if an output is computed.
+   * \return                      True if an output is computed.
+   */
+  bool push(const double *p_input, double *p_output);
+};
+
+/*!
+ * Class to decimate a message stream, the filtered values replace the ones of the message at the filter delay.
+ *
+ * \template  T                 Message type, with a header.
+ * \template  N                 Number of filtered values of the message.
+ */
+template <typename T, size_t N>
+class MessageDecimator
+{
+private:
+
+  DecimationFilter  m_filter_;
+  std::vector<T>    m_delay_line_;
+  size_t            m_delay_first_;
+  size_t            m_delay_size_;
+  rclcpp::Time      m_last_stamp_;
+  int64_t           m_max_gap_;
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor, the decimation is disabled.
+   */
+  MessageDecimator(void):
+  m_delay_line_(1),
+  m_delay_first_(0),
+  m_delay_size_(0),
+  m_max_gap_(0)
+  {
+  }
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Set the decimation factor.
+   *
+   * \param[in] factor            Decimation factor, 0 or 1 to disable the decimation.
+   * \param[in] max_gap           Gap between two messages above which the filter restarts (ns).
+   */
+  void setFactor(uint32_t factor, int64_t max_gap)
+  {
+    m_filter_.setFactor(factor, N);
+    m_delay_line_.resize(m_filter_.getDelay() + 1);
+    m_delay_first_  = 0;
+    m_delay_size_   = 0;
+    m_max_gap_      = max_gap;
+  }
+
+  /*!
+   * Check if the decimation is enabled.
+   *
+   * \return                      True if the decimation factor is above 1.
+   */
+  bool isEnabled(void) const
+  {
+    return m_filter_.isEnabled();
+  }
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Add a message.
+   *
+   * The filter restarts if the message is too far from the previous one, as the window would mix unrelated data.
+   *
+   * \param[in] ref_message       Input message.
+   * \param[out] ref_output       Decimated message, set if an output is computed.
+   * \return                      True if an output is computed.
+   */
+  bool push(const T &ref_message, T &ref_output)
+  {
+    std::array<double, N> input;
+    std::array<double, N> output;
+    rclcpp::Time          stamp(ref_message.header.stamp);
+    int64_t               gap;
+
+    if (m_delay_size_ > 0)
+    {
+      gap = (stamp - m_last_stamp_).nanoseconds();
+
+      if ((gap > m_max_gap_) || (gap < -m_max_gap_))
+      {
+        m_filter_.reset();
+        m_delay_size_ = 0;
+      }
+    }
+
+    m_last_stamp_ = stamp;
+
+    //
+    // The delay line is a ring of the messages up to the filter delay, its slots are reused once it is full.
+    //
+    if (m_delay_size_ == m_delay_line_.size())
+    {
+      m_delay_first_ = (m_delay_first_ + 1) % m_delay_line_.size();
+      m_delay_size_--;
+    }
+
+    m_delay_line_[(m_delay_first_ + m_delay_size_) % m_delay_line_.size()] = ref_message;
+    m_delay_size_++;
+
+    input = getDecimatedValues(ref_message);
+
+    if (!m_filter_.push(input.data(), output.data()))
+    {
+      return false;
+    }
+
+    ref_output = m_delay_line_[m_delay_first_];
+    setDecimatedValues(output, ref_output);
+
+    return true;
+  }
+};
+}
+
+#endif // SBG_ROS_DECIMATION_FILTER_H
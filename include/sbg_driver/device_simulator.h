@@ -0,0 +1,290 @@
+/*!
+*	\file         device_simulator.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Simulate an SBG device on a pseudo terminal or a local UDP socket.
+*
+*   Synthetic logs are generated at configurable rates, optionally corrupted and sent
+*   in bursts, and the configuration commands used by the driver are answered from an
+*   in memory settings store, so the driver can be load tested without hardware.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_DEVICE_SIMULATOR_H
+#define SBG_ROS_DEVICE_SIMULATOR_H
+
+// Standard headers
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// SbgECom headers
+#include <sbgEComLib.h>
+
+namespace sbg
+{
+/*!
+ * Class to simulate an SBG device.
+ */
+class DeviceSimulator
+{
+public:
+
+  /*!
+   * Simulator configuration.
+   */
+  struct Config
+  {
+    bool                              use_udp;            /*!< True to use a local UDP socket, false to use a pseudo terminal. */
+    std::string                       pty_link;           /*!< Symbolic link created to the pseudo terminal, empty for none. */
+    sbgIpAddress                      udp_address;        /*!< Address of the driver host. */
+    uint32_t                          udp_in_port;        /*!< Port the driver sends commands to (driver ipConf.in_port). */
+    uint32_t                          udp_out_port;       /*!< Port the driver listens to (driver ipConf.out_port). */
+    std::map<SbgEComMsgId, double>    log_rates;          /*!< Initial rate of each simulated log (Hz). */
+    double                            corruption_ratio;   /*!< Ratio of frames corrupted or preceded by garbage, between 0 and 1. */
+    uint32_t                          burst_period;       /*!< Period at which frames are written in a single burst, 0 to write each loop (ms). */
+    uint32_t                          duration;           /*!< Simulation duration, 0 to run until interrupted (s). */
+    uint32_t                          serial_number;      /*!< Device serial number. */
+  };
+
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  /*!
+   * Simulated output of a single log.
+   */
+  struct SimulatedLog
+  {
+    double    rate;               /*!< Output rate, 0 if disabled (Hz). */
+    uint64_t  next_time;          /*!< Device time of the next output (us). */
+  };
+
+  Config                                  m_config_;
+  SbgInterface                            m_interface_;
+  int                                     m_pty_master_;
+  int                                     m_pty_slave_;
+  SbgEComProtocol                         m_protocol_;
+
+  std::map<SbgEComMsgId, SimulatedLog>    m_logs_;
+  std::map<uint8_t, std::vector<uint8_t>> m_settings_;
+  std::vector<uint8_t>                    m_export_buffer_;
+
+  std::vector<uint8_t>                    m_tx_buffer_;
+  std::vector<size_t>                     m_tx_frame_sizes_;
+  std::mt19937                            m_generator_;
+  Clock::time_point                       m_start_time_;
+  uint64_t                                m_last_flush_time_;
+
+  uint32_t                                m_frames_sent_;
+  uint32_t                                m_frames_corrupted_;
+  uint32_t                                m_commands_received_;
+  size_t                                  m_bytes_sent_;
+  size_t                                  m_bytes_dropped_;
+
+  //---------------------------------------------------------------------//
+  //- Private methods                                                   -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Open a pseudo terminal and create the configured link to it.
+   */
+  void openPty(void);
+
+  /*!
+   * Open the UDP interface.
+   */
+  void openUdp(void);
+
+  /*!
+   * Write callback of the pseudo terminal interface.
+   *
+   * \param[in] p_handle          Interface.
+   * \param[in] p_buffer          Data to write.
+   * \param[in] bytes_to_write    Number of bytes to write.
+   * \return                      SBG_NO_ERROR if all the bytes have been written.
+   */
+  static SbgErrorCode ptyWrite(SbgInterface *p_handle, const void *p_buffer, size_t bytes_to_write);
+
+  /*!
+   * Read callback of the pseudo terminal interface.
+   *
+   * \param[in] p_handle          Interface.
+   * \param[out] p_buffer         Buffer to fill.
+   * \param[out] p_read_bytes     Number of bytes read.
+   * \param[in] bytes_to_read     Maximum number of bytes to read.
+   * \return                      SBG_NO_ERROR if no error occurred.
+   */
+  static SbgErrorCode ptyRead(SbgInterface *p_handle, void *p_buffer, size_t *p_read_bytes, size_t bytes_to_read);
+
+  /*!
+   * Initialize the settings store with the device default settings.
+   */
+  void initSettings(void);
+
+  /*!
+   * Get the current device time.
+   *
+   * \return                      Time since the simulation start (us).
+   */
+  uint64_t getDeviceTime(void) const;
+
+  /*!
+   * Set the output rate of a log from an output mode.
+   *
+   * \param[in] msg_id            Log id.
+   * \param[in] output_mode       Output mode.
+   */
+  void setLogOutputMode(SbgEComMsgId msg_id, SbgEComOutputMode output_mode);
+
+  /*!
+   * Get the output mode matching the output rate of a log.
+   *
+   * \param[in] msg_id            Log id.
+   * \return                      Output mode.
+   */
+  SbgEComOutputMode getLogOutputMode(SbgEComMsgId msg_id) const;
+
+  /*!
+   * Serialize the settings store, used as the exported settings.
+   *
+   * \return                      Serialized settings.
+   */
+  std::vector<uint8_t> serializeSettings(void) const;
+
+  /*!
+   * Queue a log frame, written at the next flush.
+   *
+   * \param[in] msg_id            Log id.
+   * \param[in] device_time       Device time (us).
+   */
+  void queueLog(SbgEComMsgId msg_id, uint64_t device_time);
+
+  /*!
+   * Send a command answer immediately.
+   *
+   * \param[in] msg               Command id.
+   * \param[in] p_payload         Answer payload.
+   * \param[in] payload_size      Payload size in bytes.
+   */
+  void sendAnswer(uint8_t msg, const void *p_payload, size_t payload_size);
+
+  /*!
+   * Send an acknowledge immediately.
+   *
+   * \param[in] msg               Acknowledged command id.
+   * \param[in] error_code        Command result.
+   */
+  void sendAck(uint8_t msg, SbgErrorCode error_code);
+
+  /*!
+   * Handle a received command.
+   *
+   * \param[in] msg               Command id.
+   * \param[in] p_payload         Command payload.
+   * \param[in] payload_size      Payload size in bytes.
+   */
+  void handleCommand(uint8_t msg, const uint8_t *p_payload, size_t payload_size);
+
+  /*!
+   * Handle a settings export transfer command.
+   *
+   * \param[in] p_payload         Command payload.
+   * \param[in] payload_size      Payload size in bytes.
+   */
+  void handleExportSettings(const uint8_t *p_payload, size_t payload_size);
+
+  /*!
+   * Receive and handle all the pending commands.
+   */
+  void handleCommands(void);
+
+  /*!
+   * Queue the logs due at the given device time.
+   *
+   * \param[in] device_time       Device time (us).
+   */
+  void emitLogs(uint64_t device_time);
+
+  /*!
+   * Write the queued frames, one interface write per frame.
+   */
+  void flush(void);
+
+  /*!
+   * Print the transmission statistics.
+   *
+   * \param[in] elapsed_s         Duration since the last statistics (s).
+   */
+  void printStatistics(double elapsed_s);
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Constructor, opens the simulated device interface.
+   *
+   * \param[in] ref_config        Simulator configuration.
+   */
+  DeviceSimulator(const Config &ref_config);
+
+  /*!
+   * Default destructor.
+   */
+  ~DeviceSimulator(void);
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Get the id of a log from its configuration name.
+   *
+   * \param[in] ref_name          Log name, as in the driver output configuration without the log_ prefix (e.g. imu_data).
+   * \param[out] ref_msg_id       Log id.
+   * \return                      True if the name is known.
+   */
+  static bool getLogId(const std::string &ref_name, SbgEComMsgId &ref_msg_id);
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Run the simulation until the configured duration has elapsed or the stop flag is set.
+   *
+   * \param[in] ref_stop          Stop flag.
+   */
+  void run(const volatile bool &ref_stop);
+};
+}
+
+#endif // SBG_ROS_DEVICE_SIMULATOR_H
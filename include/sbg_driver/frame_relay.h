@@ -0,0 +1,118 @@
+/*!
+*	\file         frame_relay.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Relay the received log frames to an UDP multicast group.
+*
+*   The frames validated by the sbgECom protocol are framed again and sent in batched datagrams,
+*   so any number of drivers can receive the device stream from the group with an UDP interface.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_FRAME_RELAY_H
+#define SBG_ROS_FRAME_RELAY_H
+
+// Standard headers
+#include <array>
+
+// SbgECom headers
+#include <sbgEComLib.h>
+
+namespace sbg
+{
+/*!
+ * Class to relay the received log frames to an UDP multicast group.
+ */
+class FrameRelay
+{
+private:
+
+  SbgInterface                                    m_interface_;
+  bool                                            m_opened_;
+  std::array<uint8_t, SBG_ECOM_MAX_BUFFER_SIZE>   m_datagram_;
+  SbgStreamBuffer                                 m_datagram_stream_;
+  size_t                                          m_max_datagram_size_;
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   */
+  FrameRelay(void);
+
+  /*!
+   * Default destructor.
+   */
+  ~FrameRelay(void);
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Check if the frames are relayed.
+   *
+   * \return                      True if the relay interface is opened.
+   */
+  bool isEnabled(void) const;
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Open the relay interface.
+   *
+   * \param[in] group_address     Multicast group IP address.
+   * \param[in] port              Multicast group port.
+   * \param[in] max_datagram_size Maximum datagram size in bytes, larger frames are sent alone.
+   * \throw                       Unable to open the relay interface.
+   */
+  void open(sbgIpAddress group_address, uint32_t port, size_t max_datagram_size);
+
+  /*!
+   * Add a frame to the current datagram, the datagram is sent once full.
+   *
+   * \param[in] msg_class         Class of the log.
+   * \param[in] msg               Message ID of the log.
+   * \param[in] p_payload         Log payload.
+   * \param[in] payload_size      Log payload size in bytes.
+   */
+  void relayFrame(SbgEComClass msg_class, SbgEComMsgId msg, const void *p_payload, size_t payload_size);
+
+  /*!
+   * Send the frames of the current datagram, if any.
+   * A datagram that can't be sent is dropped, as if it was lost on the network.
+   */
+  void flush(void);
+};
+}
+
+#endif // SBG_ROS_FRAME_RELAY_H
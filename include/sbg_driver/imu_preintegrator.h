@@ -0,0 +1,161 @@
+/*!
+*	\file         imu_preintegrator.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Preintegration of the IMU logs between trigger events.
+*
+*   The coning and sculling outputs of the IMU logs are integrated into a rotation, velocity
+*   and position increment between two event markers or over a fixed interval, with the
+*   covariance of the increments, so a visual odometry front end doesn't need the IMU rate.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_IMU_PREINTEGRATOR_H
+#define SBG_ROS_IMU_PREINTEGRATOR_H
+
+// Standard headers
+#include <array>
+#include <deque>
+#include <utility>
+
+// SbgECom headers
+#include <sbgEComLib.h>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+
+// Project headers
+#include <config_store.h>
+
+// SbgRos message headers
+#include "sbg_driver/msg/sbg_imu_data.hpp"
+#include "sbg_driver/msg/sbg_imu_preintegration.hpp"
+
+namespace sbg
+{
+/*!
+ * Class to preintegrate the IMU logs between trigger events.
+ */
+class ImuPreintegrator
+{
+private:
+
+  /*!
+   * IMU log waiting for the end of its interval.
+   */
+  struct ImuSample
+  {
+    std_msgs::msg::Header   header;           /*!< Header of the IMU message. */
+    uint32_t                time_stamp;       /*!< Device time stamp (us). */
+    std::array<double, 3>   delta_angle;      /*!< Coning output (rad/s). */
+    std::array<double, 3>   delta_velocity;   /*!< Sculling output (m/s^2). */
+  };
+
+  PreintegrationTrigger   m_trigger_;
+  uint32_t                m_period_;
+  double                  m_gyro_noise_density_;
+  double                  m_accel_noise_density_;
+
+  std::deque<ImuSample>   m_samples_;
+  std::deque<uint32_t>    m_triggers_;
+  bool                    m_started_;
+  uint32_t                m_start_time_stamp_;
+
+  rclcpp::Publisher<sbg_driver::msg::SbgImuPreintegration, std::allocator<void>>::SharedPtr  m_preintegration_pub_;
+
+  /*!
+   * Integrate the IMU logs up to a trigger and publish the increments.
+   *
+   * The interval ends at the last IMU log at or before the trigger, which starts the next interval.
+   *
+   * \param[in] trigger_time_stamp  Device time stamp of the trigger (us).
+   */
+  void processTrigger(uint32_t trigger_time_stamp);
+
+  /*!
+   * Start a new interval at the last IMU log at or before a time stamp, the previous logs are dropped.
+   *
+   * \param[in] time_stamp          Device time stamp (us).
+   */
+  void startInterval(uint32_t time_stamp);
+
+  /*!
+   * Process the pending triggers covered by the received IMU logs.
+   */
+  void processTriggers(void);
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   */
+  ImuPreintegrator(void);
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Check if the preintegration is enabled.
+   *
+   * \return                        True if the IMU logs are preintegrated.
+   */
+  bool isEnabled(void) const;
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Enable the preintegration and create its publisher.
+   *
+   * \param[in] ref_ros_node_handle   ROS node.
+   * \param[in] ref_config_store      Config store.
+   */
+  void initPublishers(rclcpp::Node &ref_ros_node_handle, const ConfigStore &ref_config_store);
+
+  /*!
+   * Add an IMU log.
+   *
+   * \param[in] ref_imu_data        SBG-ROS IMU message.
+   */
+  void addImuData(const sbg_driver::msg::SbgImuData &ref_imu_data);
+
+  /*!
+   * Add an event marker log, its events trigger the preintegration if they are on the trigger pin.
+   *
+   * \param[in] channel             Sync in pin, 0 for A to 4 for E.
+   * \param[in] ref_event           SBG event log.
+   */
+  void addEvent(uint8_t channel, const SbgLogEvent &ref_event);
+};
+}
+
+#endif // SBG_ROS_IMU_PREINTEGRATOR_H
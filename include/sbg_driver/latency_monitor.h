@@ -0,0 +1,263 @@
+/*!
+*	\file         latency_monitor.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Measure the latency of each log between its reception and its publication.
+*
+*   Latencies are recorded per log id into lock free log-linear histograms and
+*   published periodically as a diagnostic array.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_LATENCY_MONITOR_H
+#define SBG_ROS_LATENCY_MONITOR_H
+
+// Standard headers
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+// SbgECom headers
+#include <sbgEComLib.h>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+
+namespace sbg
+{
+/*!
+ * Lock free histogram of durations in microseconds.
+ * Buckets are log-linear, with 8 sub-buckets per power of two, so values are known within 12.5%.
+ */
+class LatencyHistogram
+{
+public:
+
+  static constexpr size_t SUB_BUCKET_BITS = 3;
+  static constexpr size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+  static constexpr size_t BUCKET_COUNT = (32 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+private:
+
+  std::array<std::atomic<uint32_t>, BUCKET_COUNT> m_buckets_;
+  std::atomic<uint32_t>                           m_count_;
+  std::atomic<uint32_t>                           m_max_;
+
+  /*!
+   * Get the bucket holding a value.
+   *
+   * \param[in] value             Value in microseconds.
+   * \return                      Bucket index.
+   */
+  static size_t getBucketIndex(uint32_t value);
+
+  /*!
+   * Get the highest value stored in a bucket.
+   *
+   * \param[in] index             Bucket index.
+   * \return                      Bucket upper bound in microseconds.
+   */
+  static uint32_t getBucketUpperBound(size_t index);
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   */
+  LatencyHistogram(void);
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Get the number of recorded values.
+   *
+   * \return                      Number of values.
+   */
+  uint32_t getCount(void) const;
+
+  /*!
+   * Get the maximum recorded value.
+   *
+   * \return                      Maximum value in microseconds.
+   */
+  uint32_t getMax(void) const;
+
+  /*!
+   * Get a percentile of the recorded values.
+   *
+   * \param[in] percentile        Percentile to get, between 0 and 100.
+   * \return                      Upper bound of the bucket holding the percentile, in microseconds.
+   */
+  uint32_t getPercentile(double percentile) const;
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Record a value.
+   *
+   * \param[in] value             Value in microseconds.
+   */
+  void record(uint32_t value);
+
+  /*!
+   * Clear all the recorded values.
+   */
+  void reset(void);
+};
+
+/*!
+ * Class to measure the reception, parsing and publication latency of each log.
+ */
+class LatencyMonitor
+{
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  /*!
+   * Statistics of a single log id.
+   */
+  struct LogLatency
+  {
+    LatencyHistogram      parse;              /*!< Duration between the interface read of the frame and the end of the log parsing. */
+    LatencyHistogram      publish;            /*!< Duration of the ROS messages creation and publication. */
+    LatencyHistogram      total;              /*!< Duration between the interface read of the frame and the end of the publication. */
+    std::atomic<uint32_t> received;           /*!< Number of frames received, including the ones dropped by the log filter. */
+    std::atomic<uint32_t> published;          /*!< Number of logs published to at least one subscriber. */
+  };
+
+  std::array<std::atomic<LogLatency*>, 2 * 256> m_logs_;
+
+  Clock::time_point       m_read_time_;
+  Clock::time_point       m_received_time_;
+  Clock::time_point       m_parsed_time_;
+  Clock::time_point       m_last_publish_time_;
+
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray, std::allocator<void>>::SharedPtr m_diagnostics_pub_;
+
+  /*!
+   * Get the statistics of a log, created on first use.
+   *
+   * \param[in] msg_class         Log class.
+   * \param[in] msg               Log id.
+   * \return                      Log statistics, nullptr for non log classes.
+   */
+  LogLatency *getLogLatency(SbgEComClass msg_class, SbgEComMsgId msg);
+
+  /*!
+   * Get the duration between two time points in microseconds.
+   *
+   * \param[in] ref_start         Start time.
+   * \param[in] ref_end           End time.
+   * \return                      Duration in microseconds.
+   */
+  static uint32_t getDurationUs(const Clock::time_point &ref_start, const Clock::time_point &ref_end);
+
+  /*!
+   * Add the percentiles of a histogram to a diagnostic status.
+   *
+   * \param[in] ref_prefix        Key prefix.
+   * \param[in] ref_histogram     Histogram to report.
+   * \param[in] ref_status        Diagnostic status to fill.
+   */
+  static void addHistogramValues(const std::string &ref_prefix, const LatencyHistogram &ref_histogram, diagnostic_msgs::msg::DiagnosticStatus &ref_status);
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   */
+  LatencyMonitor(void);
+
+  /*!
+   * Default destructor.
+   */
+  ~LatencyMonitor(void);
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Create the diagnostics publisher.
+   *
+   * \param[in] ref_ros_node_handle   ROS node.
+   */
+  void initPublisher(rclcpp::Node &ref_ros_node_handle);
+
+  /*!
+   * Callback definition called right after some bytes have been read from the interface.
+   * The frames completed by these bytes are time stamped with the read time.
+   *
+   * \param[in] num_bytes_read    Number of bytes read from the interface.
+   * \param[in] p_user_arg        Latency monitor instance.
+   */
+  static void onBytesReadCallback(size_t num_bytes_read, void *p_user_arg);
+
+  /*!
+   * Callback definition called at each processing stage of a received log.
+   *
+   * \param[in] p_handle          Valid handle on the sbgECom instance that has called this callback.
+   * \param[in] stage             Stage the log has reached.
+   * \param[in] msg_class         Class of the log.
+   * \param[in] msg               Message ID of the log.
+   * \param[in] p_user_arg        Latency monitor instance.
+   */
+  static void onFrameStageCallback(SbgEComHandle *p_handle, SbgEComFrameStage stage, SbgEComClass msg_class, SbgEComMsgId msg, void *p_user_arg);
+
+  /*!
+   * Record the latencies of a log once it has been published.
+   *
+   * \param[in] msg_class         Class of the log.
+   * \param[in] msg               Message ID of the log.
+   * \param[in] delivered         True if the log has been published to at least one subscriber.
+   */
+  void onLogPublished(SbgEComClass msg_class, SbgEComMsgId msg, bool delivered);
+
+  /*!
+   * Publish the statistics gathered since the last call and reset them.
+   *
+   * \param[in] ref_stamp         Diagnostics time stamp.
+   */
+  void publishDiagnostics(const rclcpp::Time &ref_stamp);
+};
+}
+
+#endif // SBG_ROS_LATENCY_MONITOR_H
@@ -0,0 +1,245 @@
+/*!
+*	\file         mag_calibrator.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Magnetometers calibration services driven by asynchronous commands.
+*
+*   The calibration commands are sent through the device command queue, so the services answer
+*   as soon as a command is sent and the logs keep flowing while the device computes the calibration.
+*   The command results are logged and published as a diagnostic status.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+
+#ifndef SBG_ROS_MAG_CALIBRATOR_H
+#define SBG_ROS_MAG_CALIBRATOR_H
+
+// Standard headers
+#include <map>
+#include <string>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+#include <std_srvs/srv/trigger.hpp>
+
+// SbgECom headers
+#include <sbgEComLib.h>
+
+// Project headers
+#include <async_command_queue.h>
+#include <config_store.h>
+
+/*!
+ * Time out to compute the magnetometers calibration, the onboard computation can take some time (ms).
+ */
+#define SBG_MAG_CALIB_COMPUTE_TIME_OUT  (5000)
+
+namespace sbg
+{
+/*!
+ * Class to calibrate the magnetometers of the connected device.
+ */
+class MagCalibrator
+{
+private:
+
+  /*!
+   * Calibration command waiting for its answer.
+   */
+  enum class Command
+  {
+    NONE      = 0,      /*!< No command pending. */
+    START     = 1,      /*!< Start the calibration acquisition. */
+    COMPUTE   = 2,      /*!< Compute the calibration from the acquired points. */
+    SET_DATA  = 3,      /*!< Upload the calibration to the device. */
+    SAVE      = 4,      /*!< Save the device settings. */
+  };
+
+  //---------------------------------------------------------------------//
+  //- Static members definition                                         -//
+  //---------------------------------------------------------------------//
+
+  static std::map<SbgEComMagCalibQuality, std::string>    g_mag_calib_quality_;
+  static std::map<SbgEComMagCalibConfidence, std::string> g_mag_calib_confidence_;
+  static std::map<SbgEComMagCalibMode, std::string>       g_mag_calib_mode_;
+  static std::map<SbgEComMagCalibBandwidth, std::string>  g_mag_calib_bandwidth;
+
+  //---------------------------------------------------------------------//
+  //- Private variables                                                 -//
+  //---------------------------------------------------------------------//
+
+  SbgEComHandle             &m_ref_sbg_com_handle_;
+  AsyncCommandQueue         &m_ref_command_queue_;
+
+  SbgEComMagCalibMode       m_mag_calib_mode_;
+  SbgEComMagCalibBandwidth  m_mag_calib_bandwidth_;
+
+  Command                   m_pending_command_;
+  bool                      m_mag_calibration_ongoing_;
+  bool                      m_mag_calibration_done_;
+  SbgEComMagCalibResults    m_mag_calib_results_;
+
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr                                          m_calib_service_;
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr                                          m_calib_save_service_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticStatus, std::allocator<void>>::SharedPtr m_status_pub_;
+
+  //---------------------------------------------------------------------//
+  //- Private methods                                                   -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Completion callback of the calibration commands.
+   *
+   * \param[in] error_code        Command completion status.
+   * \param[in] p_payload         Answer payload (nullptr if none).
+   * \param[in] payload_size      Answer payload size in bytes.
+   * \param[in] p_user_arg        Magnetometers calibrator.
+   */
+  static void onCommandAnswerCallback(SbgErrorCode error_code, const uint8_t *p_payload, size_t payload_size, void *p_user_arg);
+
+  /*!
+   * Handle the completion of the pending calibration command.
+   *
+   * \param[in] error_code        Command completion status.
+   * \param[in] p_payload         Answer payload (nullptr if none).
+   * \param[in] payload_size      Answer payload size in bytes.
+   */
+  void onCommandAnswer(SbgErrorCode error_code, const uint8_t *p_payload, size_t payload_size);
+
+  /*!
+   * Send a calibration command, its answer is handled from the command queue handle.
+   *
+   * \param[in] command           Calibration command.
+   * \param[in] msg               Message ID of the command.
+   * \param[in] p_data            Command payload (can be nullptr if size is 0).
+   * \param[in] size              Command payload size in bytes.
+   * \param[in] answer_type       Answer that completes the command.
+   * \param[in] time_out          Time out in ms.
+   * \return                      SBG_NO_ERROR if the command has been sent.
+   */
+  SbgErrorCode sendCommand(Command command, uint8_t msg, const void *p_data, size_t size, AsyncAnswerType answer_type, uint32_t time_out);
+
+  /*!
+   * Read the calibration results from the answer to the compute command.
+   *
+   * \param[in] p_payload         Answer payload.
+   * \param[in] payload_size      Answer payload size in bytes.
+   * \return                      True if the payload holds complete results.
+   */
+  bool readCalibrationResults(const uint8_t *p_payload, size_t payload_size);
+
+  /*!
+   * Publish the result of a calibration command.
+   *
+   * \param[in] level             Diagnostic level.
+   * \param[in] ref_message       Result description.
+   */
+  void publishStatus(uint8_t level, const std::string &ref_message);
+
+  /*!
+   * Process the magnetometer calibration service, start or end the calibration.
+   *
+   * \param[in] ref_ros_request   ROS service request.
+   * \param[in] ref_ros_response  ROS service response.
+   */
+  void processMagCalibration(const std::shared_ptr<std_srvs::srv::Trigger::Request> ref_ros_request, std::shared_ptr<std_srvs::srv::Trigger::Response> ref_ros_response);
+
+  /*!
+   * Process the magnetometer calibration save service, upload the calibration to the device.
+   *
+   * \param[in] ref_ros_request   ROS service request.
+   * \param[in] ref_ros_response  ROS service response.
+   */
+  void saveMagCalibration(const std::shared_ptr<std_srvs::srv::Trigger::Request> ref_ros_request, std::shared_ptr<std_srvs::srv::Trigger::Response> ref_ros_response);
+
+  /*!
+   * Display magnetometers calibration status result.
+   */
+  void displayMagCalibrationStatusResult(void) const;
+
+  /*!
+   * Export magnetometers calibration results.
+   */
+  void exportMagCalibrationResults(void) const;
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   *
+   * \param[in] ref_sbg_com_handle  SBG communication handle.
+   * \param[in] ref_command_queue   Command queue of the device, handled by the device loop.
+   */
+  MagCalibrator(SbgEComHandle &ref_sbg_com_handle, AsyncCommandQueue &ref_command_queue);
+
+  MagCalibrator(const MagCalibrator&) = delete;
+  MagCalibrator& operator=(const MagCalibrator&) = delete;
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Check if a calibration command is waiting for its answer.
+   *
+   * \return                      True if a command is pending.
+   */
+  bool isCommandPending(void) const;
+
+  /*!
+   * Check if the calibration acquisition has been started.
+   *
+   * \return                      True if the calibration is ongoing.
+   */
+  bool isCalibrationOngoing(void) const;
+
+  /*!
+   * Check if a calibration has been computed.
+   *
+   * \return                      True if calibration results are available.
+   */
+  bool isCalibrationDone(void) const;
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Create the calibration services and the status publisher.
+   *
+   * \param[in] ref_ros_node_handle   ROS node.
+   * \param[in] ref_config_store      Store configuration.
+   */
+  void initServices(rclcpp::Node &ref_ros_node_handle, const ConfigStore &ref_config_store);
+};
+}
+
+#endif // SBG_ROS_MAG_CALIBRATOR_H
@@ -32,9 +32,19 @@
 #ifndef SBG_ROS_MESSAGE_PUBLISHER_H
 #define SBG_ROS_MESSAGE_PUBLISHER_H
 
+// Standard headers
+#include <algorithm>
+#include <array>
+#include <vector>
+
 // Project headers
 #include <config_store.h>
+#include <decimation_filter.h>
+#include <imu_preintegrator.h>
 #include <message_wrapper.h>
+#include <pose_history.h>
+#include <sequence_tracker.h>
+#include <time_aligned_buffer.h>
 
 namespace sbg
 {
@@ -66,12 +76,26 @@ private:
   rclcpp::Publisher<sbg_driver::msg::SbgEvent, std::allocator<void>>::SharedPtr         m_sbgEventE_pub_;
   rclcpp::Publisher<sbg_driver::msg::SbgImuShort, std::allocator<void>>::SharedPtr   	m_SbgImuShort_pub_;
   rclcpp::Publisher<sbg_driver::msg::SbgAirData, std::allocator<void>>::SharedPtr     	m_SbgAirData_pub_;
+  rclcpp::Publisher<sbg_driver::msg::SbgDvl, std::allocator<void>>::SharedPtr           m_sbgDvlBottomTrack_pub_;
+  rclcpp::Publisher<sbg_driver::msg::SbgDvl, std::allocator<void>>::SharedPtr           m_sbgDvlWaterTrack_pub_;
+  rclcpp::Publisher<sbg_driver::msg::SbgUsbl, std::allocator<void>>::SharedPtr          m_sbgUsbl_pub_;
+  rclcpp::Publisher<sbg_driver::msg::SbgDepth, std::allocator<void>>::SharedPtr         m_sbgDepth_pub_;
+  rclcpp::Publisher<sbg_driver::msg::SbgEvent, std::allocator<void>>::SharedPtr         m_sbgEventOutA_pub_;
+  rclcpp::Publisher<sbg_driver::msg::SbgEvent, std::allocator<void>>::SharedPtr         m_sbgEventOutB_pub_;
+  rclcpp::Publisher<sbg_driver::msg::SbgDiag, std::allocator<void>>::SharedPtr          m_sbgDiag_pub_;
+  rclcpp::Publisher<sbg_driver::msg::SbgEventPose, std::allocator<void>>::SharedPtr     m_event_pose_pub_;
 
   rclcpp::Publisher<sensor_msgs::msg::Imu, std::allocator<void>>::SharedPtr             m_imu_pub_;
-  sbg_driver::msg::SbgImuData  m_sbg_imu_message_;
-  sbg_driver::msg::SbgEkfQuat  m_sbg_ekf_quat_message_;
-  sbg_driver::msg::SbgEkfNav   m_sbg_ekf_nav_message_;
-  sbg_driver::msg::SbgEkfEuler m_sbg_ekf_euler_message_;
+  TimeAlignedBuffer<sbg_driver::msg::SbgImuData, 64>   m_imu_buffer_;
+  TimeAlignedBuffer<sbg_driver::msg::SbgEkfQuat, 64>   m_ekf_quat_buffer_;
+  TimeAlignedBuffer<sbg_driver::msg::SbgEkfNav, 64>    m_ekf_nav_buffer_;
+  TimeAlignedBuffer<sbg_driver::msg::SbgEkfEuler, 64>  m_ekf_euler_buffer_;
+  uint32_t                                              m_alignment_max_gap_;
+
+  rclcpp::Publisher<sbg_driver::msg::SbgImuData, std::allocator<void>>::SharedPtr       m_sbgImuDataDecimated_pub_;
+  rclcpp::Publisher<sensor_msgs::msg::Imu, std::allocator<void>>::SharedPtr             m_imu_decimated_pub_;
+  MessageDecimator<sbg_driver::msg::SbgImuData, SBG_DECIMATION_IMU_DATA_VALUES>         m_imu_data_decimator_;
+  MessageDecimator<sensor_msgs::msg::Imu, SBG_DECIMATION_IMU_VALUES>                    m_imu_decimator_;
 
   rclcpp::Publisher<sensor_msgs::msg::Temperature, std::allocator<void>>::SharedPtr     m_temp_pub_;
   rclcpp::Publisher<sensor_msgs::msg::MagneticField, std::allocator<void>>::SharedPtr   m_mag_pub_;
@@ -83,13 +107,116 @@ private:
   rclcpp::Publisher<nav_msgs::msg::Odometry, std::allocator<void>>::SharedPtr           m_odometry_pub_;
 
   MessageWrapper          m_message_wrapper_;
+
+  //
+  // Published messages, filled in place for each log so that their strings and arrays keep
+  // their capacity and the steady-state publishing does not allocate memory.
+  //
+  sbg_driver::msg::SbgStatus        m_sbg_status_message_;
+  sbg_driver::msg::SbgUtcTime       m_sbg_utc_message_;
+  sbg_driver::msg::SbgImuData       m_sbg_imu_message_;
+  sbg_driver::msg::SbgImuData       m_sbg_imu_decimated_message_;
+  sbg_driver::msg::SbgEkfEuler      m_sbg_ekf_euler_message_;
+  sbg_driver::msg::SbgEkfQuat       m_sbg_ekf_quat_message_;
+  sbg_driver::msg::SbgEkfNav        m_sbg_ekf_nav_message_;
+  sbg_driver::msg::SbgShipMotion    m_sbg_ship_motion_message_;
+  sbg_driver::msg::SbgMag           m_sbg_mag_message_;
+  sbg_driver::msg::SbgMagCalib      m_sbg_mag_calib_message_;
+  sbg_driver::msg::SbgGpsVel        m_sbg_gps_vel_message_;
+  sbg_driver::msg::SbgGpsPos        m_sbg_gps_pos_message_;
+  sbg_driver::msg::SbgGpsHdt        m_sbg_gps_hdt_message_;
+  sbg_driver::msg::SbgGpsRaw        m_gps_raw_message_;
+  sbg_driver::msg::SbgOdoVel        m_sbg_odo_vel_message_;
+  sbg_driver::msg::SbgEvent         m_sbg_event_message_;
+  sbg_driver::msg::SbgEventPose     m_event_pose_message_;
+  sbg_driver::msg::SbgImuShort      m_sbg_imu_short_message_;
+  sbg_driver::msg::SbgAirData       m_sbg_air_data_message_;
+  sbg_driver::msg::SbgDvl           m_sbg_dvl_message_;
+  sbg_driver::msg::SbgUsbl          m_sbg_usbl_message_;
+  sbg_driver::msg::SbgDepth         m_sbg_depth_message_;
+  sbg_driver::msg::SbgDiag          m_sbg_diag_message_;
+  sbg_driver::msg::SbgEkfQuat       m_aligned_ekf_quat_message_;
+  sbg_driver::msg::SbgEkfEuler      m_aligned_ekf_euler_message_;
+  sbg_driver::msg::SbgEkfNav        m_aligned_ekf_nav_message_;
+  sensor_msgs::msg::Imu             m_imu_message_;
+  sensor_msgs::msg::Imu             m_imu_decimated_message_;
+  sensor_msgs::msg::Temperature     m_temperature_message_;
+  sensor_msgs::msg::MagneticField   m_magnetic_message_;
+  sensor_msgs::msg::FluidPressure   m_fluid_pressure_message_;
+  sensor_msgs::msg::TimeReference   m_utc_reference_message_;
+  sensor_msgs::msg::NavSatFix       m_nav_sat_fix_message_;
+  geometry_msgs::msg::PointStamped  m_pos_ecef_message_;
+  geometry_msgs::msg::TwistStamped  m_velocity_message_;
+  nav_msgs::msg::Odometry           m_odometry_message_;
+
+  SequenceTracker         m_sequence_tracker_;
+  std::shared_ptr<PoseHistory>  m_pose_history_;
+
+  /*!
+   * Event waiting for the EKF logs after it to interpolate its pose.
+   */
+  struct PendingEvent
+  {
+    uint32_t  time_stamp;         /*!< Device time stamp of the event (us). */
+    uint8_t   channel;            /*!< Sync in pin, 0 for A to 4 for E. */
+    uint8_t   sub_event;          /*!< Event of the marker log, 0 for its time stamp and 1 to 4 for its time offsets. */
+  };
+
+  std::vector<PendingEvent>     m_pending_events_;
+  ImuPreintegrator              m_imu_preintegrator_;
   uint32_t                m_max_messages_;
   std::string             m_frame_id_;
+  bool                    m_odom_publish_tf_;
+
+  /*!
+   * Last published state of a status topic, to publish it only when its status changes.
+   */
+  struct StatusChange
+  {
+    bool                      published;      /*!< True once a message has been published. */
+    std::array<uint32_t, 3>   bitmasks;       /*!< Status bitmasks of the last published message. */
+    uint32_t                  time_stamp;     /*!< Device time stamp of the last published message (us). */
+  };
+
+  bool                    m_status_on_change_;
+  uint32_t                m_status_heartbeat_;
+  StatusChange            m_status_change_;
+  StatusChange            m_utc_status_change_;
 
   //---------------------------------------------------------------------//
   //- Private methods                                                   -//
   //---------------------------------------------------------------------//
 
+  /*!
+   * Check if a publisher is defined and has at least one subscriber.
+   *
+   * \template  T                       Publisher shared pointer type.
+   * \param[in] ref_publisher           Publisher to check.
+   * \return                            True if the publisher has subscribers.
+   */
+  template <typename T>
+  bool hasSubscribers(const T &ref_publisher) const
+  {
+    return ref_publisher && (ref_publisher->get_subscription_count() > 0);
+  }
+
+  /*!
+   * Check if the odometry output is consumed, either by subscribers or by the TF broadcast.
+   *
+   * \return                            True if odometry messages have to be computed.
+   */
+  bool isOdometryConsumed(void) const;
+
+  /*!
+   * Check if a status message has to be published, always true if the status topics aren't published on change.
+   *
+   * \param[in] ref_status_change       Last published state of the topic, updated if the message is published.
+   * \param[in] ref_bitmasks            Status bitmasks of the message.
+   * \param[in] time_stamp              Device time stamp of the message (us).
+   * \return                            True if the status changed or the heartbeat period elapsed.
+   */
+  bool isStatusPublished(StatusChange &ref_status_change, const std::array<uint32_t, 3> &ref_bitmasks, uint32_t time_stamp);
+
   /*!
    * Get the corresponding topic name output for the SBG output mode.
    *
@@ -117,26 +244,34 @@ private:
   void defineRosStandardPublishers(rclcpp::Node& ref_ros_node_handle, bool odom_enable);
 
   /*!
-   * Publish a received SBG IMU log.
+   * Define the decimated IMU publishers, from the SBG and standard IMU publishers.
    *
-   * \param[in] ref_sbg_log             SBG log.
+   * \param[in] ref_ros_node_handle     Ros Node to advertise the publisher.
+   * \param[in] ref_config_store        Config store.
    */
-  void publishIMUData(const SbgBinaryLogData &ref_sbg_log);
+  void initDecimatedPublishers(rclcpp::Node& ref_ros_node_handle, const ConfigStore &ref_config_store);
 
   /*!
-   * Process a ROS Velocity standard message.
+   * Publish a received SBG IMU log.
+   *
+   * \param[in] ref_sbg_log             SBG log.
    */
-  void processRosVelMessage(void);
+  void publishIMUData(const SbgBinaryLogData &ref_sbg_log);
 
   /*!
-   * Process a ROS IMU standard message.
+   * Check if the IMU logs have to be buffered to compute the ROS IMU, velocity or odometry standard messages.
+   *
+   * \return                            True if a derived standard message is published.
    */
-  void processRosImuMessage(void);
+  bool hasAlignedPublishers(void) const;
 
   /*!
-   * Process a ROS odometry standard message.
+   * Publish the ROS IMU, velocity and odometry standard messages of the buffered IMU logs.
+   *
+   * The EKF logs are matched or interpolated at the time stamp of each IMU log. An IMU log
+   * waits for the EKF logs after it, at most for the alignment maximum gap.
    */
-  void processRosOdoMessage(void);
+  void processAlignedMessages(void);
 
   /*!
    * Publish a received SBG Magnetic log.
@@ -159,6 +294,29 @@ private:
    */
   void publishEkfNavigationData(const SbgBinaryLogData &ref_sbg_log);
 
+  /*!
+   * Publish a received SBG EkfQuat log.
+   *
+   * \param[in] ref_sbg_log             SBG log.
+   */
+  void publishEkfQuaternionData(const SbgBinaryLogData &ref_sbg_log);
+
+  /*!
+   * Publish a received SBG event marker log, and queue its events to publish their pose.
+   *
+   * \param[in] ref_event_pub           Event publisher of the sync in pin.
+   * \param[in] channel                 Sync in pin, 0 for A to 4 for E.
+   * \param[in] ref_sbg_log             SBG log.
+   */
+  void publishEventData(const rclcpp::Publisher<sbg_driver::msg::SbgEvent, std::allocator<void>>::SharedPtr &ref_event_pub, uint8_t channel, const SbgBinaryLogData &ref_sbg_log);
+
+  /*!
+   * Publish the pose of the queued events covered by the EKF logs history.
+   *
+   * An event waits for the EKF logs after it, and is dropped if the EKF logs around it are missing.
+   */
+  void processEventPoses(void);
+
   /*!
    * Publish a received SBG UTC log.
    *
@@ -184,6 +342,13 @@ public:
    */
   MessagePublisher(void);
 
+  /*!
+   * Constructor for a device node in a namespace.
+   *
+   * \param[in] ref_node_namespace      Namespace of the device node.
+   */
+  MessagePublisher(const std::string &ref_node_namespace);
+
   //---------------------------------------------------------------------//
   //- Operations                                                        -//
   //---------------------------------------------------------------------//
@@ -204,6 +369,30 @@ public:
    * \param[in] ref_sbg_log             SBG binary log.
    */
   void publish(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_id, const SbgBinaryLogData &ref_sbg_log);
+
+  /*!
+   * Set the reception time of the next logs, used instead of the current time for the ROS time stamps.
+   *
+   * \param[in] ref_stamp               Reception time of the next logs.
+   */
+  void setReceptionStamp(const rclcpp::Time &ref_stamp);
+
+  /*!
+   * Check if a received SbgLog would be used by at least one publisher with subscribers.
+   * Logs feeding ROS standard messages are consumed as soon as one of these messages is.
+   *
+   * \param[in] sbg_msg_class           Class ID of the SBG message.
+   * \param[in] sbg_msg_id              Id of the SBG message.
+   * \return                            True if the log has to be parsed.
+   */
+  bool isLogConsumed(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_id) const;
+
+  /*!
+   * Publish the log sequence statistics gathered since the last call, if the sequence diagnostics are enabled.
+   *
+   * \param[in] ref_stamp               Diagnostics time stamp.
+   */
+  void publishSequenceDiagnostics(const rclcpp::Time &ref_stamp);
 };
 }
 
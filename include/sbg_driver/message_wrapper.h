@@ -41,6 +41,7 @@
 // Sbg header
 #include <sbg_matrix3.h>
 #include <config_store.h>
+#include <pose_history.h>
 
 // ROS headers
 #include <rclcpp/rclcpp.hpp>
@@ -75,6 +76,11 @@
 #include "sbg_driver/msg/sbg_event.hpp"
 #include "sbg_driver/msg/sbg_imu_short.hpp"
 #include "sbg_driver/msg/sbg_air_data.hpp"
+#include "sbg_driver/msg/sbg_dvl.hpp"
+#include "sbg_driver/msg/sbg_usbl.hpp"
+#include "sbg_driver/msg/sbg_depth.hpp"
+#include "sbg_driver/msg/sbg_diag.hpp"
+#include "sbg_driver/msg/sbg_event_pose.hpp"
 
 namespace sbg
 {
@@ -84,6 +90,7 @@ typedef struct _UTM0
 	double			northing;
 	double			altitude;
 	int				zone;
+	double			central_meridian;
 } UTM0;
 
 /*!
@@ -104,12 +111,22 @@ private:
   bool                                m_is_first;
   rclcpp::Time                        m_ros_time_init;
   uint32_t                            m_clock_time_init;
+  bool                                m_use_reception_stamp_;
+  rclcpp::Time                        m_reception_stamp_;
+  rclcpp::Clock::SharedPtr            m_clock_;
 
   bool                                m_odom_enable_;
   bool                                m_odom_publish_tf_;
   std::string                         m_odom_frame_id_;
   std::string                         m_odom_base_frame_id_;
   std::string                         m_odom_init_frame_id_;
+  OdomProjection                      m_odom_projection_;
+  bool                                m_enu_origin_valid_;
+  SbgVector3d                         m_ecef_origin_;
+  SbgMatrix3d                         m_ecef_to_enu_;
+  uint32_t                            m_odom_tf_period_;
+  bool                                m_odom_tf_sent_;
+  uint32_t                            m_last_odom_tf_timestamp_;
 
   //---------------------------------------------------------------------//
   //- Internal methods                                                  -//
@@ -140,14 +157,26 @@ private:
   double computeMeridian(int zone_number) const;
 
   /*!
-   * Create a ROS message header.
+   * Convert latitude and longitude to UTM coordinates around a central meridian.
+   *
+   * \param[in] Lat                     Latitude, in degrees.
+   * \param[in] Long                    Longitude, in degrees.
+   * \param[in] central_meridian        UTM zone central meridian, in radians.
+   * \param[out] UTMNorthing            UTM northing, in meters.
+   * \param[out] UTMEasting             UTM easting, in meters.
+   * \param[out] p_convergence_angle    Meridian convergence angle, in radians (not computed if null).
+   */
+  void projectUTM(double Lat, double Long, double central_meridian, double &UTMNorthing, double &UTMEasting, double *p_convergence_angle) const;
+
+  /*!
+   * Fill a ROS message header.
    * 
    * \param[in] device_timestamp    SBG device timestamp (in microseconds).
-   * \return                        ROS header message.
+   * \param[out] ref_header         ROS header message.
    */
-  const std_msgs::msg::Header createRosHeader(uint32_t device_timestamp) const;
+  void fillRosHeader(uint32_t device_timestamp, std_msgs::msg::Header &ref_header) const;
   
-  std_msgs::msg::Header createRosHeaderSynced(uint32_t device_timestamp);
+  void fillRosHeaderSynced(uint32_t device_timestamp, std_msgs::msg::Header &ref_header);
 
   /*!
    * Convert INS timestamp from a SBG device to UNIX timestamp.
@@ -277,25 +306,58 @@ private:
    * \return                        SBG-ROS air data status message.
    */
   const sbg_driver::msg::SbgAirDataStatus createAirDataStatusMessage(const SbgLogAirData& ref_sbg_air_data) const;
+
+  /*!
+   * Create a SBG-ROS DVL status message.
+   *
+   * \param[in] ref_sbg_dvl_data    SBG DVL log.
+   * \return                        SBG-ROS DVL status message.
+   */
+  const sbg_driver::msg::SbgDvlStatus createDvlStatusMessage(const SbgLogDvlData& ref_sbg_dvl_data) const;
+
+  /*!
+   * Create a SBG-ROS USBL status message.
+   *
+   * \param[in] ref_sbg_usbl_data   SBG USBL log.
+   * \return                        SBG-ROS USBL status message.
+   */
+  const sbg_driver::msg::SbgUsblStatus createUsblStatusMessage(const SbgLogUsblData& ref_sbg_usbl_data) const;
+
+  /*!
+   * Create a SBG-ROS depth status message.
+   *
+   * \param[in] ref_sbg_depth_data  SBG depth log.
+   * \return                        SBG-ROS depth status message.
+   */
+  const sbg_driver::msg::SbgDepthStatus createDepthStatusMessage(const SbgLogDepth& ref_sbg_depth_data) const;
  
   /*!
-   * Create a ROS standard TwistStamped message.
+   * Fill a ROS standard TwistStamped message.
    *
    * \param[in] body_vel            SBG Body velocity vector.
    * \param[in] ref_sbg_air_data    SBG IMU message.
-   * \return                        SBG TwistStamped message.
+   * \param[out] ref_twist_stamped_message SBG TwistStamped message.
    */
-  const geometry_msgs::msg::TwistStamped createRosTwistStampedMessage(const sbg::SbgVector3f& body_vel, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg) const;
+  void fillRosTwistStampedMessage(const sbg::SbgVector3f& body_vel, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, geometry_msgs::msg::TwistStamped &ref_twist_stamped_message) const;
 
   /*!
    * Fill a transformation.
    *
    * \param[in] ref_parent_frame_id     Parent frame ID.
    * \param[in] ref_child_frame_id      Child frame ID.
+   * \param[in] ref_stamp               Transformation time stamp.
    * \param[in] ref_pose                Pose.
    * \param[out] ref_transform_stamped  Stamped transformation.
    */
-   void fillTransform(const std::string &ref_parent_frame_id, const std::string &ref_child_frame_id, const geometry_msgs::msg::Pose &ref_pose, geometry_msgs::msg::TransformStamped &ref_transform_stamped);
+   void fillTransform(const std::string &ref_parent_frame_id, const std::string &ref_child_frame_id, const builtin_interfaces::msg::Time &ref_stamp, const geometry_msgs::msg::Pose &ref_pose, geometry_msgs::msg::TransformStamped &ref_transform_stamped) const;
+
+  /*!
+   * Broadcast the odometry transformation, decimated to the odometry TF rate.
+   *
+   * \param[in] ref_odo_ros_msg         Odometry message.
+   * \param[in] device_timestamp        Odometry device time stamp (us).
+   */
+   void publishOdomTransform(const nav_msgs::msg::Odometry &ref_odo_ros_msg, uint32_t device_timestamp);
 
    /*!
    * Get UTM letter designator for the given latitude.
@@ -314,16 +376,24 @@ private:
    */
    void initUTM(double Lat, double Long, double altitude);
 
-   /*!
-   * Convert latitude and longitude to a position relative to UTM initial position.
+  /*!
+   * Convert geodetic coordinates to Earth-Centered Earth-Fixed coordinates.
    *
-   * \param[in] Lat                     Latitude, in degrees.
-   * \param[in] Long                    Longitude, in degrees.
-   * \param[in] zoneNumber              UTM zone number.
-   * \param[out] UTMNorthing            UTM northing, in meters.
-   * \param[out] UTMEasting             UTM easting, in meters.
+   * \param[in] latitude                Latitude, in degrees.
+   * \param[in] longitude               Longitude, in degrees.
+   * \param[in] altitude                Altitude above the ellipsoid, in meters.
+   * \return                            ECEF position, in meters.
    */
-   void LLtoUTM(double Lat, double Long, int zoneNumber, double &UTMNorthing, double &UTMEasting) const;
+  SbgVector3d convertToEcef(double latitude, double longitude, double altitude) const;
+
+  /*!
+   * Set the local tangent plane origin and its ECEF to ENU rotation.
+   *
+   * \param[in] latitude                Latitude, in degrees.
+   * \param[in] longitude               Longitude, in degrees.
+   * \param[in] altitude                Altitude above the ellipsoid, in meters.
+   */
+  void initENU(double latitude, double longitude, double altitude);
 
 public:
 
@@ -343,6 +413,13 @@ public:
    */
   MessageWrapper(void);
 
+  /*!
+   * Constructor for a device node in a namespace.
+   *
+   * \param[in] ref_node_namespace      Namespace of the transform broadcaster node.
+   */
+  MessageWrapper(const std::string &ref_node_namespace);
+
   //---------------------------------------------------------------------//
   //- Parameters                                                        -//
   //---------------------------------------------------------------------//
@@ -368,6 +445,14 @@ public:
    */
   void setUseEnu(bool enu);
 
+  /*!
+   * Set the reception time of the next logs, used instead of the current time for the ROS time stamps.
+   * It is used to wrap logs that have been received earlier, for example from a raw frames batch.
+   *
+   * \param[in]  ref_stamp    Reception time of the next logs.
+   */
+  void setReceptionStamp(const rclcpp::Time &ref_stamp);
+
   /*!
    * Set odom enable.
    *
@@ -382,6 +467,13 @@ public:
    */
    void setOdomPublishTf(bool publish_tf);
 
+  /*!
+   * Set the maximum odometry TF broadcast rate.
+   *
+   * \param[in] tf_rate          Maximum rate (Hz), 0 to broadcast every odometry sample.
+   */
+  void setOdomTfRate(uint32_t tf_rate);
+
   /*!
    * Set the odometry frame ID.
    *
@@ -403,254 +495,315 @@ public:
    */
   void setOdomInitFrameId(const std::string &ref_frame_id);
 
+  /*!
+   * Set the odometry position projection.
+   *
+   * \param[in] odom_projection  UTM projection or local tangent plane (ENU) of the first valid position.
+   */
+  void setOdomProjection(OdomProjection odom_projection);
+
   //---------------------------------------------------------------------//
   //- Operations                                                        -//
   //---------------------------------------------------------------------//
 
   /*!
-   * Create a SBG-ROS Ekf Euler message.
+   * Convert latitude and longitude to UTM coordinates in the given zone.
+   *
+   * \param[in] Lat                 Latitude, in degrees.
+   * \param[in] Long                Longitude, in degrees.
+   * \param[in] zoneNumber          UTM zone number.
+   * \param[out] UTMNorthing        UTM northing, in meters.
+   * \param[out] UTMEasting         UTM easting, in meters.
+   */
+  void LLtoUTM(double Lat, double Long, int zoneNumber, double &UTMNorthing, double &UTMEasting) const;
+
+  /*!
+   * Fill a SBG-ROS Ekf Euler message.
    * 
    * \param[in] ref_log_ekf_euler   SBG Ekf Euler log.
-   * \return                        Ekf Euler message.
+   * \param[out] ref_ekf_euler_message Ekf Euler message.
    */
-  const sbg_driver::msg::SbgEkfEuler createSbgEkfEulerMessage(const SbgLogEkfEulerData& ref_log_ekf_euler) const;
+  void fillSbgEkfEulerMessage(const SbgLogEkfEulerData& ref_log_ekf_euler, sbg_driver::msg::SbgEkfEuler &ref_ekf_euler_message) const;
 
   /*!
-   * Create a SBG-ROS Ekf Navigation message.
+   * Fill a SBG-ROS Ekf Navigation message.
    * 
    * \param[in] ref_log_ekf_nav     SBG Ekf Navigation log.
-   * \return                        Ekf Navigation message.
+   * \param[out] ref_ekf_nav_message Ekf Navigation message.
    */
-  const sbg_driver::msg::SbgEkfNav createSbgEkfNavMessage(const SbgLogEkfNavData& ref_log_ekf_nav) const;
+  void fillSbgEkfNavMessage(const SbgLogEkfNavData& ref_log_ekf_nav, sbg_driver::msg::SbgEkfNav &ref_ekf_nav_message) const;
 
   /*!
-   * Create a SBG-ROS Ekf Quaternion message.
+   * Fill a SBG-ROS Ekf Quaternion message.
    * 
    * \param[in] ref_log_ekf_quat    SBG Ekf Quaternion log.
-   * \return                        Ekf Quaternion message.
+   * \param[out] ref_ekf_quat_message Ekf Quaternion message.
    */
-  const sbg_driver::msg::SbgEkfQuat createSbgEkfQuatMessage(const SbgLogEkfQuatData& ref_log_ekf_quat) const;
+  void fillSbgEkfQuatMessage(const SbgLogEkfQuatData& ref_log_ekf_quat, sbg_driver::msg::SbgEkfQuat &ref_ekf_quat_message) const;
 
   /*!
-   * Create a SBG-ROS event message.
+   * Fill a SBG-ROS event message.
    * 
    * \param[in] ref_log_event       SBG event log.
-   * \return                        Event message.
+   * \param[out] ref_event_message  Event message.
    */
-  const sbg_driver::msg::SbgEvent createSbgEventMessage(const SbgLogEvent& ref_log_event) const;
+  void fillSbgEventMessage(const SbgLogEvent& ref_log_event, sbg_driver::msg::SbgEvent &ref_event_message) const;
 
   /*!
-   * Create SBG-ROS GPS-HDT message.
+   * Fill a SBG-ROS event pose message.
+   *
+   * \param[in] ref_pose            EKF pose interpolated at the event time.
+   * \param[in] time_stamp          Device time stamp of the event (us).
+   * \param[in] channel             Sync in pin of the event, 0 for A to 4 for E.
+   * \param[in] sub_event           Event of the marker log, 0 for its time stamp and 1 to 4 for its time offsets.
+   * \param[out] ref_event_pose_message Event pose message.
+   */
+  void fillSbgEventPoseMessage(const PoseHistory::Pose &ref_pose, uint32_t time_stamp, uint8_t channel, uint8_t sub_event, sbg_driver::msg::SbgEventPose &ref_event_pose_message) const;
+
+  /*!
+   * Fill SBG-ROS GPS-HDT message.
    * 
    * \param[in] ref_log_gps_hdt     SBG GPS HDT log.
-   * \return                        GPS HDT message.
+   * \param[out] ref_gps_hdt_message GPS HDT message.
    */
-  const sbg_driver::msg::SbgGpsHdt createSbgGpsHdtMessage(const SbgLogGpsHdt& ref_log_gps_hdt) const;
+  void fillSbgGpsHdtMessage(const SbgLogGpsHdt& ref_log_gps_hdt, sbg_driver::msg::SbgGpsHdt &ref_gps_hdt_message) const;
 
   /*!
-   * Create a SBG-ROS GPS-Position message.
+   * Fill a SBG-ROS GPS-Position message.
    * 
    * \param[in] ref_log_gps_pos     SBG GPS Position log.
-   * \return                        GPS Position message.
+   * \param[out] ref_gps_pos_message GPS Position message.
    */
-  const sbg_driver::msg::SbgGpsPos createSbgGpsPosMessage(const SbgLogGpsPos& ref_log_gps_pos) const;
+  void fillSbgGpsPosMessage(const SbgLogGpsPos& ref_log_gps_pos, sbg_driver::msg::SbgGpsPos &ref_gps_pos_message) const;
 
   /*!
-   * Create a SBG-ROS GPS raw message.
+   * Fill a SBG-ROS GPS raw message, reusing its data buffer.
    * 
    * \param[in] ref_log_gps_raw     SBG GPS raw log.
-   * \return                        GPS raw message.
+   * \param[out] ref_gps_raw_message GPS raw message.
    */
-  const sbg_driver::msg::SbgGpsRaw createSbgGpsRawMessage(const SbgLogGpsRaw& ref_log_gps_raw) const;
+  void fillSbgGpsRawMessage(const SbgLogGpsRaw& ref_log_gps_raw, sbg_driver::msg::SbgGpsRaw &ref_gps_raw_message) const;
 
   /*!
-   * Create a SBG-ROS GPS Velocity message.
+   * Fill a SBG-ROS GPS Velocity message.
    * 
    * \param[in] ref_log_gps_vel     SBG GPS Velocity log.
-   * \return                        GPS Velocity message.
+   * \param[out] ref_gps_vel_message GPS Velocity message.
    */
-  const sbg_driver::msg::SbgGpsVel createSbgGpsVelMessage(const SbgLogGpsVel& ref_log_gps_vel) const;
+  void fillSbgGpsVelMessage(const SbgLogGpsVel& ref_log_gps_vel, sbg_driver::msg::SbgGpsVel &ref_gps_vel_message) const;
 
   /*!
-   * Create a SBG-ROS Imu data message.
+   * Fill a SBG-ROS Imu data message.
    * 
    * \param[in] ref_log_imu_data    SBG Imu data log.
-   * \return                        Imu data message.
+   * \param[out] ref_imu_data_message Imu data message.
    */
-  const sbg_driver::msg::SbgImuData createSbgImuDataMessage(const SbgLogImuData& ref_log_imu_data) const;
+  void fillSbgImuDataMessage(const SbgLogImuData& ref_log_imu_data, sbg_driver::msg::SbgImuData &ref_imu_data_message) const;
 
   /*!
-   * Create a SBG-ROS Magnetometer message.
+   * Fill a SBG-ROS Magnetometer message.
    * 
    * \param[in] ref_log_mag         SBG Magnetometer log.
-   * \return                        Magnetometer message.
+   * \param[out] ref_mag_message    Magnetometer message.
    */
-  const sbg_driver::msg::SbgMag createSbgMagMessage(const SbgLogMag& ref_log_mag) const;
+  void fillSbgMagMessage(const SbgLogMag& ref_log_mag, sbg_driver::msg::SbgMag &ref_mag_message) const;
 
   /*!
-   * Create a SBG-ROS Magnetometer calibration message.
+   * Fill a SBG-ROS Magnetometer calibration message.
    * 
    * \param[in] ref_log_mag_calib   SBG Magnetometer calibration log.
-   * \return                        Magnetometer calibration message.
+   * \param[out] ref_mag_calib_message Magnetometer calibration message.
    */
-  const sbg_driver::msg::SbgMagCalib createSbgMagCalibMessage(const SbgLogMagCalib& ref_log_mag_calib) const;
+  void fillSbgMagCalibMessage(const SbgLogMagCalib& ref_log_mag_calib, sbg_driver::msg::SbgMagCalib &ref_mag_calib_message) const;
 
   /*!
-   * Create a SBG-ROS Odometer velocity message.
+   * Fill a SBG-ROS Odometer velocity message.
    * 
    * \param[in] ref_log_odo         SBG Odometer log.
-   * \return                        Odometer message.
+   * \param[out] ref_odo_vel_message Odometer message.
    */
-  const sbg_driver::msg::SbgOdoVel createSbgOdoVelMessage(const SbgLogOdometerData& ref_log_odo) const;
+  void fillSbgOdoVelMessage(const SbgLogOdometerData& ref_log_odo, sbg_driver::msg::SbgOdoVel &ref_odo_vel_message) const;
 
   /*!
-   * Create a SBG-ROS Shipmotion message.
+   * Fill a SBG-ROS Shipmotion message.
    * 
    * \param[in] ref_log_ship_motion SBG Ship motion log.
-   * \return                        Ship motion message.
+   * \param[out] ref_ship_motion_message Ship motion message.
    */
-  const sbg_driver::msg::SbgShipMotion createSbgShipMotionMessage(const SbgLogShipMotionData& ref_log_ship_motion) const;
+  void fillSbgShipMotionMessage(const SbgLogShipMotionData& ref_log_ship_motion, sbg_driver::msg::SbgShipMotion &ref_ship_motion_message) const;
 
   /*!
-   * Create a SBG-ROS status message from a SBG status log.
+   * Fill a SBG-ROS status message from a SBG status log.
    *
    * \param[in] ref_log_status      SBG status log.
-   * \return                        Status message.
+   * \param[out] ref_status_message Status message.
    */
-  const sbg_driver::msg::SbgStatus createSbgStatusMessage(const SbgLogStatusData& ref_log_status) const;
+  void fillSbgStatusMessage(const SbgLogStatusData& ref_log_status, sbg_driver::msg::SbgStatus &ref_status_message) const;
 
   /*!
-   * Create a SBG-ROS UTC time message from a SBG UTC log.
+   * Fill a SBG-ROS UTC time message from a SBG UTC log.
    *
    * \param[in] ref_log_utc         SBG UTC log.
-   * \return                        UTC time message.                  
+   * \param[out] ref_utc_time_message UTC time message.                  
    */
-  const sbg_driver::msg::SbgUtcTime createSbgUtcTimeMessage(const SbgLogUtcData& ref_log_utc);
+  void fillSbgUtcTimeMessage(const SbgLogUtcData& ref_log_utc, sbg_driver::msg::SbgUtcTime &ref_utc_time_message);
 
   /*!
-   * Create a SBG-ROS Air data message from a SBG log.
+   * Fill a SBG-ROS Air data message from a SBG log.
    * 
    * \param[in] ref_air_data_log    SBG AirData log.
-   * \return                        SBG-ROS airData message.
+   * \param[out] ref_air_data_message SBG-ROS airData message.
+   */
+  void fillSbgAirDataMessage(const SbgLogAirData& ref_air_data_log, sbg_driver::msg::SbgAirData &ref_air_data_message) const;
+
+  /*!
+   * Fill a SBG-ROS DVL message from a bottom or water track SBG log.
+   *
+   * \param[in] ref_dvl_log         SBG DVL log.
+   * \param[out] ref_dvl_message    SBG-ROS DVL message.
+   */
+  void fillSbgDvlMessage(const SbgLogDvlData& ref_dvl_log, sbg_driver::msg::SbgDvl &ref_dvl_message) const;
+
+  /*!
+   * Fill a SBG-ROS USBL message from a SBG log.
+   *
+   * \param[in] ref_usbl_log        SBG USBL log.
+   * \param[out] ref_usbl_message   SBG-ROS USBL message.
+   */
+  void fillSbgUsblMessage(const SbgLogUsblData& ref_usbl_log, sbg_driver::msg::SbgUsbl &ref_usbl_message) const;
+
+  /*!
+   * Fill a SBG-ROS depth message from a SBG log.
+   *
+   * \param[in] ref_depth_log       SBG depth log.
+   * \param[out] ref_depth_message  SBG-ROS depth message.
+   */
+  void fillSbgDepthMessage(const SbgLogDepth& ref_depth_log, sbg_driver::msg::SbgDepth &ref_depth_message) const;
+
+  /*!
+   * Fill a SBG-ROS diagnostic message from a SBG log.
+   *
+   * \param[in] ref_diag_log        SBG diagnostic log, its string is only valid during the log callback.
+   * \param[out] ref_diag_message   SBG-ROS diagnostic message.
    */
-  const sbg_driver::msg::SbgAirData createSbgAirDataMessage(const SbgLogAirData& ref_air_data_log) const;
+  void fillSbgDiagMessage(const SbgLogDiagData& ref_diag_log, sbg_driver::msg::SbgDiag &ref_diag_message) const;
 
   /*!
-   * Create a SBG-ROS Short Imu message.
+   * Fill a SBG-ROS Short Imu message.
    * 
    * \param[in] ref_short_imu_log   SBG Imu short log.
-   * \return                        SBG-ROS Imu short message.
+   * \param[out] ref_imu_short_message SBG-ROS Imu short message.
    */
-  const sbg_driver::msg::SbgImuShort createSbgImuShortMessage(const SbgLogImuShort& ref_short_imu_log) const;
+  void fillSbgImuShortMessage(const SbgLogImuShort& ref_short_imu_log, sbg_driver::msg::SbgImuShort &ref_imu_short_message) const;
 
   /*!
-   * Create a ROS standard IMU message from SBG messages.
+   * Fill a ROS standard IMU message from SBG messages.
    * 
    * \param[in] ref_sbg_imu_msg     SBG-ROS IMU message.
    * \param[in] ref_sbg_quat_msg    SBG_ROS Quaternion message.
-   * \return                        ROS standard IMU message.
+   * \param[out] ref_imu_ros_message ROS standard IMU message.
    */
-  sensor_msgs::msg::Imu createRosImuMessage(const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfQuat& ref_sbg_quat_msg);
+  void fillRosImuMessage(const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfQuat& ref_sbg_quat_msg, sensor_msgs::msg::Imu &ref_imu_ros_message);
 
   /*!
-   * Create a ROS standard odometry message from SBG messages.
+   * Fill a ROS standard odometry message from SBG messages.
    *
    * \param[in] ref_sbg_imu_msg         SBG-ROS IMU message.
    * \param[in] ref_sbg_ekf_nav_msg     SBG-ROS Ekf Nav message.
    * \param[in] ref_sbg_ekf_quat_msg    SBG-ROS Ekf Quaternion message.
    * \param[in] ref_sbg_ekf_euler_msg   SBG-ROS Ekf Euler message.
-   * \return                            ROS standard odometry message.
+   * \param[out] ref_odo_ros_msg        ROS standard odometry message.
    */
-  const nav_msgs::msg::Odometry createRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgEkfQuat &ref_sbg_ekf_quat_msg, const sbg_driver::msg::SbgEkfEuler &ref_sbg_ekf_euler_msg);
+  void fillRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgEkfQuat &ref_sbg_ekf_quat_msg, const sbg_driver::msg::SbgEkfEuler &ref_sbg_ekf_euler_msg, nav_msgs::msg::Odometry &ref_odo_ros_msg);
 
   /*!
-   * Create a ROS standard odometry message from SBG messages.
+   * Fill a ROS standard odometry message from SBG messages.
    *
    * \param[in] ref_sbg_imu_msg         SBG-ROS IMU message.
    * \param[in] ref_sbg_ekf_nav_msg     SBG-ROS Ekf Nav message.
    * \param[in] ref_sbg_ekf_euler_msg   SBG-ROS Ekf Euler message.
-   * \return                            ROS standard odometry message.
+   * \param[out] ref_odo_ros_msg        ROS standard odometry message.
    */
-  const nav_msgs::msg::Odometry createRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgEkfEuler &ref_sbg_ekf_euler_msg);
+  void fillRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgEkfEuler &ref_sbg_ekf_euler_msg, nav_msgs::msg::Odometry &ref_odo_ros_msg);
 
   /*!
-   * Create a ROS standard odometry message from SBG messages and tf2 quaternion.
+   * Fill a ROS standard odometry message from SBG messages and tf2 quaternion.
    *
    * \param[in] ref_sbg_imu_msg         SBG-ROS IMU message.
    * \param[in] ref_sbg_ekf_nav_msg     SBG-ROS Ekf Nav message.
    * \param[in] orientation             Orientation as a Tf2 quaternion.
    * \param[in] ref_sbg_ekf_euler_msg   SBG-ROS Ekf Euler message.
-   * \return                            ROS standard odometry message.
+   * \param[out] ref_odo_ros_msg        ROS standard odometry message.
    */
-  const nav_msgs::msg::Odometry createRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_sbg_ekf_nav_msg, const tf2::Quaternion &ref_orientation, const sbg_driver::msg::SbgEkfEuler &ref_sbg_ekf_euler_msg);
+  void fillRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_sbg_ekf_nav_msg, const tf2::Quaternion &ref_orientation, const sbg_driver::msg::SbgEkfEuler &ref_sbg_ekf_euler_msg, nav_msgs::msg::Odometry &ref_odo_ros_msg);
 
   /*!
-   * Create a ROS standard Temperature message from SBG message.
+   * Fill a ROS standard Temperature message from SBG message.
    * 
    * \param[in] ref_sbg_imu_msg     SBG-ROS IMU message.
-   * \return                        ROS standard Temperature message.
+   * \param[out] ref_temperature_message ROS standard Temperature message.
    */
-  const sensor_msgs::msg::Temperature createRosTemperatureMessage(const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg) const;
+  void fillRosTemperatureMessage(const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, sensor_msgs::msg::Temperature &ref_temperature_message) const;
 
   /*!
-   * Create a ROS standard MagneticField message from SBG message.
+   * Fill a ROS standard MagneticField message from SBG message.
    * 
    * \param[in] ref_sbg_mag_msg     SBG-ROS Mag message.
-   * \return                        ROS standard Mag message.
+   * \param[out] ref_magnetic_message ROS standard Mag message.
    */
-  const sensor_msgs::msg::MagneticField createRosMagneticMessage(const sbg_driver::msg::SbgMag& ref_sbg_mag_msg) const;
+  void fillRosMagneticMessage(const sbg_driver::msg::SbgMag& ref_sbg_mag_msg, sensor_msgs::msg::MagneticField &ref_magnetic_message) const;
 
   /*!
-   * Create a ROS standard TwistStamped message from SBG messages.
+   * Fill a ROS standard TwistStamped message from SBG messages.
    * 
    * \param[in] ref_sbg_ekf_euler_msg   SBG-ROS Ekf Euler message.
    * \param[in] ref_sbg_ekf_nav_msg     SBG-ROS Ekf Nav message.
    * \param[in] ref_sbg_imu_msg     SBG-ROS IMU message.
-   * \return                        ROS standard TwistStamped message.
+   * \param[out] ref_twist_stamped_message ROS standard TwistStamped message.
    */
-  const geometry_msgs::msg::TwistStamped createRosTwistStampedMessage(const sbg_driver::msg::SbgEkfEuler& ref_sbg_ekf_euler_msg, const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg) const;
+  void fillRosTwistStampedMessage(const sbg_driver::msg::SbgEkfEuler& ref_sbg_ekf_euler_msg, const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, geometry_msgs::msg::TwistStamped &ref_twist_stamped_message) const;
 
   /*!
-   * Create a ROS standard TwistStamped message from SBG messages.
+   * Fill a ROS standard TwistStamped message from SBG messages.
    *
    * \param[in] ref_sbg_ekf_quat_msg    SBG-ROS Ekf Quaternion message.
    * \param[in] ref_sbg_ekf_nav_msg     SBG-ROS Ekf Nav message.
    * \param[in] ref_sbg_imu_msg         SBG-ROS IMU message.
-   * \return                            ROS standard TwistStamped message.
+   * \param[out] ref_twist_stamped_message ROS standard TwistStamped message.
    */
-  const geometry_msgs::msg::TwistStamped createRosTwistStampedMessage(const sbg_driver::msg::SbgEkfQuat& ref_sbg_ekf_vel_msg, const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg) const;
+  void fillRosTwistStampedMessage(const sbg_driver::msg::SbgEkfQuat& ref_sbg_ekf_vel_msg, const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, geometry_msgs::msg::TwistStamped &ref_twist_stamped_message) const;
 
   /*!
-   * Create a ROS standard PointStamped message from SBG messages.
+   * Fill a ROS standard PointStamped message from SBG messages.
    * 
    * \param[in] ref_sbg_ekf_msg     SBG-ROS EkfNav message.
-   * \return                        ROS standard PointStamped message (ECEF).
+   * \param[out] ref_point_stamped_message ROS standard PointStamped message (ECEF).
    */
-  const geometry_msgs::msg::PointStamped createRosPointStampedMessage(const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_msg) const;
+  void fillRosPointStampedMessage(const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_msg, geometry_msgs::msg::PointStamped &ref_point_stamped_message) const;
 
   /*!
-   * Create a ROS standard timeReference message for a UTC time.
+   * Fill a ROS standard timeReference message for a UTC time.
    * 
    * \param[in] ref_sbg_utc_msg     SBG-ROS UTC message.
-   * \return                        ROS standard timeReference message.
+   * \param[out] ref_utc_reference_message ROS standard timeReference message.
    */
-  const sensor_msgs::msg::TimeReference createRosUtcTimeReferenceMessage(const sbg_driver::msg::SbgUtcTime& ref_sbg_utc_msg) const;
+  void fillRosUtcTimeReferenceMessage(const sbg_driver::msg::SbgUtcTime& ref_sbg_utc_msg, sensor_msgs::msg::TimeReference &ref_utc_reference_message) const;
 
   /*!
-   * Create a ROS standard NavSatFix message from a Gps message.
+   * Fill a ROS standard NavSatFix message from a Gps message.
    * 
    * \param[in] ref_sbg_gps_msg     SBG-ROS GPS position message.
-   * \return                        ROS standard NavSatFix message.
+   * \param[out] ref_nav_sat_fix_message ROS standard NavSatFix message.
    */
-  const sensor_msgs::msg::NavSatFix createRosNavSatFixMessage(const sbg_driver::msg::SbgGpsPos& ref_sbg_gps_msg) const;
+  void fillRosNavSatFixMessage(const sbg_driver::msg::SbgGpsPos& ref_sbg_gps_msg, sensor_msgs::msg::NavSatFix &ref_nav_sat_fix_message) const;
 
   /*!
-   * Create a ROS standard FluidPressure message.
+   * Fill a ROS standard FluidPressure message.
    * 
    * \param[in] ref_sbg_air_msg     SBG-ROS AirData message.
-   * \return                        ROS standard fluid pressure message.
+   * \param[out] ref_fluid_pressure_message ROS standard fluid pressure message.
    */
-  const sensor_msgs::msg::FluidPressure createRosFluidPressureMessage(const sbg_driver::msg::SbgAirData& ref_sbg_air_msg) const; 
+  void fillRosFluidPressureMessage(const sbg_driver::msg::SbgAirData& ref_sbg_air_msg, sensor_msgs::msg::FluidPressure &ref_fluid_pressure_message) const;
 };
 }
 
@@ -0,0 +1,461 @@
+/*!
+*	\file         pose_history.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Time indexed history of the EKF navigation and attitude logs.
+*
+*   The history keeps the last EKF nav and quaternion logs in fixed capacity struct-of-arrays
+*   rings keyed by the unwrapped device time, so the pose can be interpolated at the capture
+*   time of another sensor through a service.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_POSE_HISTORY_H
+#define SBG_ROS_POSE_HISTORY_H
+
+// Standard headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+#include <geometry_msgs/msg/quaternion.hpp>
+#include <geometry_msgs/msg/vector3.hpp>
+
+// Project headers
+#include <time_aligned_buffer.h>
+
+// SbgRos message headers
+#include "sbg_driver/msg/sbg_ekf_nav.hpp"
+#include "sbg_driver/msg/sbg_ekf_quat.hpp"
+#include "sbg_driver/srv/sbg_pose_at_time.hpp"
+
+namespace sbg
+{
+/*!
+ * Fixed capacity ring of samples stored as one array per field.
+ *
+ * Samples are appended in increasing time order, the time array is kept contiguous
+ * from the binary search point of view so a lookup only touches the time stamps.
+ *
+ * \template  N                 Number of fields of a sample.
+ */
+template <size_t N>
+class HistoryChannel
+{
+private:
+
+  std::vector<uint64_t>               m_times_;
+  std::array<std::vector<double>, N>  m_values_;
+  size_t                              m_first_;
+  size_t                              m_size_;
+
+  /*!
+   * Get the storage index of a sample.
+   *
+   * \param[in] index             Sample index, 0 being the oldest.
+   * \return                      Storage index.
+   */
+  size_t getStorageIndex(size_t index) const
+  {
+    return (m_first_ + index) % m_times_.size();
+  }
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor, the channel is empty until a capacity is set.
+   */
+  HistoryChannel(void):
+  m_first_(0),
+  m_size_(0)
+  {
+  }
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Set the capacity and clear the channel.
+   *
+   * \param[in] capacity          Maximum number of samples.
+   */
+  void setCapacity(size_t capacity)
+  {
+    m_times_.assign(capacity, 0);
+
+    for (std::vector<double> &ref_values : m_values_)
+    {
+      ref_values.assign(capacity, 0.0);
+    }
+
+    clear();
+  }
+
+  /*!
+   * Get the number of samples.
+   *
+   * \return                      Number of samples.
+   */
+  size_t getSize(void) const
+  {
+    return m_size_;
+  }
+
+  /*!
+   * Get the time of a sample.
+   *
+   * \param[in] index             Sample index, 0 being the oldest.
+   * \return                      Unwrapped device time (us).
+   */
+  uint64_t getTime(size_t index) const
+  {
+    return m_times_[getStorageIndex(index)];
+  }
+
+  /*!
+   * Get a field of a sample.
+   *
+   * \param[in] field             Field index.
+   * \param[in] index             Sample index, 0 being the oldest.
+   * \return                      Field value.
+   */
+  double getValue(size_t field, size_t index) const
+  {
+    return m_values_[field][getStorageIndex(index)];
+  }
+
+  /*!
+   * Linear interpolation of a field between a sample and the next one.
+   *
+   * \param[in] field             Field index.
+   * \param[in] index             Sample index, 0 being the oldest.
+   * \param[in] ratio             Interpolation ratio, 0 for the newest sample which has no next one.
+   * \return                      Interpolated value.
+   */
+  double interpolateValue(size_t field, size_t index, double ratio) const
+  {
+    double before = getValue(field, index);
+
+    return (ratio == 0.0) ? before : before + (getValue(field, index + 1) - before) * ratio;
+  }
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Remove all the samples.
+   */
+  void clear(void)
+  {
+    m_first_  = 0;
+    m_size_   = 0;
+  }
+
+  /*!
+   * Append a sample, the oldest one is dropped when the channel is full.
+   *
+   * A sample with the time of the newest one replaces it, an older sample is ignored.
+   *
+   * \param[in] time              Unwrapped device time (us).
+   * \param[in] ref_values        Sample fields.
+   */
+  void push(uint64_t time, const std::array<double, N> &ref_values)
+  {
+    size_t storage_index;
+
+    if (m_times_.empty())
+    {
+      return;
+    }
+
+    if ((m_size_ > 0) && (time <= getTime(m_size_ - 1)))
+    {
+      if (time != getTime(m_size_ - 1))
+      {
+        return;
+      }
+
+      storage_index = getStorageIndex(m_size_ - 1);
+    }
+    else if (m_size_ == m_times_.size())
+    {
+      storage_index = m_first_;
+      m_first_      = getStorageIndex(1);
+    }
+    else
+    {
+      storage_index = getStorageIndex(m_size_);
+      m_size_++;
+    }
+
+    m_times_[storage_index] = time;
+
+    for (size_t i = 0; i < N; i++)
+    {
+      m_values_[i][storage_index] = ref_values[i];
+    }
+  }
+
+  /*!
+   * Find the samples around a time with a binary search.
+   *
+   * \param[in] time              Unwrapped device time (us).
+   * \param[in] max_gap           Maximum time between the two samples around the time (us).
+   * \param[out] ref_index        Index of the last sample at or before the time.
+   * \param[out] ref_ratio        Interpolation ratio between this sample and the next one.
+   * \return                      ALIGNED if the samples have been found.
+   */
+  AlignStatus find(uint64_t time, uint64_t max_gap, size_t &ref_index, double &ref_ratio) const
+  {
+    size_t  lower;
+    size_t  upper;
+    size_t  middle;
+
+    if ((m_size_ == 0) || (time > getTime(m_size_ - 1)))
+    {
+      return AlignStatus::PENDING;
+    }
+    else if (time < getTime(0))
+    {
+      return AlignStatus::UNAVAILABLE;
+    }
+
+    //
+    // Look for the first sample after the time, the oldest sample is at or before it.
+    //
+    lower = 1;
+    upper = m_size_;
+
+    while (lower < upper)
+    {
+      middle = lower + (upper - lower) / 2;
+
+      if (getTime(middle) <= time)
+      {
+        lower = middle + 1;
+      }
+      else
+      {
+        upper = middle;
+      }
+    }
+
+    ref_index = lower - 1;
+
+    if (getTime(ref_index) == time)
+    {
+      ref_ratio = 0.0;
+    }
+    else if ((getTime(lower) - getTime(ref_index)) > max_gap)
+    {
+      return AlignStatus::UNAVAILABLE;
+    }
+    else
+    {
+      ref_ratio = static_cast<double>(time - getTime(ref_index)) / static_cast<double>(getTime(lower) - getTime(ref_index));
+    }
+
+    return AlignStatus::ALIGNED;
+  }
+};
+
+/*!
+ * Class to keep the recent EKF poses and interpolate them at a given time.
+ *
+ * Adding samples and querying the history are thread safe, so the service can be
+ * served by an executor thread while the driver keeps updating the history.
+ */
+class PoseHistory
+{
+public:
+
+  /*!
+   * Interpolated pose.
+   */
+  struct Pose
+  {
+    uint64_t                      device_time;    /*!< Unwrapped device time (us). */
+    rclcpp::Time                  stamp;          /*!< Time in the reference of the published message headers. */
+    double                        latitude;       /*!< Latitude (deg). */
+    double                        longitude;      /*!< Longitude (deg). */
+    double                        altitude;       /*!< Altitude above the mean sea level (m). */
+    geometry_msgs::msg::Vector3   velocity;       /*!< Velocity, as in the EKF nav log (m/s). */
+    geometry_msgs::msg::Quaternion quaternion;    /*!< Orientation, as in the EKF quaternion log. */
+  };
+
+private:
+
+  enum NavField
+  {
+    NAV_LATITUDE,
+    NAV_LONGITUDE,
+    NAV_ALTITUDE,
+    NAV_VELOCITY_X,
+    NAV_VELOCITY_Y,
+    NAV_VELOCITY_Z,
+    NAV_FIELD_COUNT
+  };
+
+  enum QuatField
+  {
+    QUAT_X,
+    QUAT_Y,
+    QUAT_Z,
+    QUAT_W,
+    QUAT_FIELD_COUNT
+  };
+
+  mutable std::mutex                  m_mutex_;
+  HistoryChannel<NAV_FIELD_COUNT>     m_nav_channel_;
+  HistoryChannel<QUAT_FIELD_COUNT>    m_quat_channel_;
+  uint32_t                            m_max_gap_;
+
+  bool                                m_time_stamp_valid_;
+  uint32_t                            m_last_time_stamp_;
+  uint64_t                            m_last_device_time_;
+  rclcpp::Time                        m_last_stamp_;
+
+  std::string                         m_frame_id_;
+  rclcpp::Service<sbg_driver::srv::SbgPoseAtTime>::SharedPtr  m_pose_at_time_service_;
+
+  /*!
+   * Unwrap a device time stamp and record its header time, the history is cleared on a device restart.
+   *
+   * \param[in] time_stamp        Device time stamp (us).
+   * \param[in] ref_stamp         Header time of the log.
+   * \return                      Unwrapped device time (us).
+   */
+  uint64_t unwrapTimeStamp(uint32_t time_stamp, const rclcpp::Time &ref_stamp);
+
+  /*!
+   * Interpolate the pose at an unwrapped device time, the mutex must be held.
+   *
+   * \param[in] device_time       Unwrapped device time (us).
+   * \param[out] ref_pose         Interpolated pose.
+   * \return                      ALIGNED if the pose has been interpolated.
+   */
+  AlignStatus interpolatePose(uint64_t device_time, Pose &ref_pose) const;
+
+  /*!
+   * Service to get the pose at a given time.
+   *
+   * \param[in] ref_ros_request   ROS service request.
+   * \param[in] ref_ros_response  ROS service response.
+   * \return                      Always true, the query status is in the response.
+   */
+  bool processPoseAtTime(const std::shared_ptr<sbg_driver::srv::SbgPoseAtTime::Request> ref_ros_request, std::shared_ptr<sbg_driver::srv::SbgPoseAtTime::Response> ref_ros_response);
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   */
+  PoseHistory(void);
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Set the number of logs kept for each of the nav and quaternion logs, and clear the history.
+   *
+   * \param[in] capacity          Number of logs.
+   */
+  void setCapacity(size_t capacity);
+
+  /*!
+   * Set the maximum time between two logs to interpolate them.
+   *
+   * \param[in] max_gap           Maximum gap (us).
+   */
+  void setMaxGap(uint32_t max_gap);
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Create the pose at time service.
+   *
+   * \param[in] ref_ros_node_handle   ROS node.
+   * \param[in] ref_frame_id          Frame ID of the service responses.
+   */
+  void initService(rclcpp::Node &ref_ros_node_handle, const std::string &ref_frame_id);
+
+  /*!
+   * Add an EKF navigation log.
+   *
+   * \param[in] ref_ekf_nav       SBG-ROS EKF nav message.
+   */
+  void addNavigation(const sbg_driver::msg::SbgEkfNav &ref_ekf_nav);
+
+  /*!
+   * Add an EKF quaternion log.
+   *
+   * \param[in] ref_ekf_quat      SBG-ROS EKF quaternion message.
+   */
+  void addAttitude(const sbg_driver::msg::SbgEkfQuat &ref_ekf_quat);
+
+  /*!
+   * Get the pose at a device time stamp.
+   *
+   * \param[in] time_stamp        Device time stamp (us), unwrapped around the newest log.
+   * \param[out] ref_pose         Interpolated pose.
+   * \return                      ALIGNED if the pose has been interpolated.
+   */
+  AlignStatus getPose(uint32_t time_stamp, Pose &ref_pose) const;
+
+  /*!
+   * Get the pose at a header time.
+   *
+   * The time is converted to the device time with the offset of the newest log,
+   * so it is exact with the INS UNIX time reference and approximate with ROS time.
+   *
+   * \param[in] ref_stamp         Time in the reference of the published message headers.
+   * \param[out] ref_pose         Interpolated pose.
+   * \return                      ALIGNED if the pose has been interpolated.
+   */
+  AlignStatus getPose(const rclcpp::Time &ref_stamp, Pose &ref_pose) const;
+};
+}
+
+#endif // SBG_ROS_POSE_HISTORY_H
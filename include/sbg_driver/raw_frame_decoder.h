@@ -0,0 +1,97 @@
+/*!
+*	\file         raw_frame_decoder.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Decode the raw frames published by a device node.
+*
+*   The log payloads are parsed with sbgECom and published with the same publishers and
+*   configuration as the device node, so the log parsing can run on another computer.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_RAW_FRAME_DECODER_H
+#define SBG_ROS_RAW_FRAME_DECODER_H
+
+// SbgECom headers
+#include <sbgEComLib.h>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+
+// Project headers
+#include <config_store.h>
+#include <message_publisher.h>
+
+// SbgRos message headers
+#include "sbg_driver/msg/sbg_raw_frames.hpp"
+
+namespace sbg
+{
+/*!
+ * Class to decode the raw frames of a device and publish its logs.
+ */
+class RawFrameDecoder
+{
+private:
+
+  rclcpp::Node&             m_ref_node_;
+  ConfigStore               m_config_store_;
+  MessagePublisher          m_message_publisher_;
+
+  rclcpp::Subscription<sbg_driver::msg::SbgRawFrames>::SharedPtr m_raw_frames_sub_;
+
+  //---------------------------------------------------------------------//
+  //- Private  methods                                                  -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Load the parameters, the device node configuration file is used.
+   */
+  void loadParameters(void);
+
+  /*!
+   * Parse and publish the logs of a raw frames message.
+   *
+   * \param[in] p_raw_frames      Raw frames message.
+   */
+  void processRawFrames(const sbg_driver::msg::SbgRawFrames::SharedPtr p_raw_frames);
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor, creates the publishers and subscribes to the raw frames.
+   *
+   * \param[in] ref_node_handle   ROS Node.
+   */
+  RawFrameDecoder(rclcpp::Node& ref_node_handle);
+};
+}
+
+#endif // SBG_ROS_RAW_FRAME_DECODER_H
@@ -0,0 +1,114 @@
+/*!
+*	\file         raw_frame_publisher.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Publish the received log frames in batches without parsing them.
+*
+*   The frames are only validated by the sbgECom protocol, and their payloads are forwarded
+*   on a single topic so they can be parsed by the sbg_raw_decoder node on another computer.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_RAW_FRAME_PUBLISHER_H
+#define SBG_ROS_RAW_FRAME_PUBLISHER_H
+
+// SbgECom headers
+#include <sbgEComLib.h>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+
+// SbgRos message headers
+#include "sbg_driver/msg/sbg_raw_frames.hpp"
+
+namespace sbg
+{
+/*!
+ * Class to publish the received log frames in batches.
+ */
+class RawFramePublisher
+{
+private:
+
+  rclcpp::Clock::SharedPtr        m_clock_;
+  sbg_driver::msg::SbgRawFrames   m_raw_frames_message_;
+  size_t                          m_batch_size_;
+
+  rclcpp::Publisher<sbg_driver::msg::SbgRawFrames, std::allocator<void>>::SharedPtr m_raw_frames_pub_;
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   */
+  RawFramePublisher(void);
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Check if the raw frames are published.
+   *
+   * \return                      True if the publisher is initialized.
+   */
+  bool isEnabled(void) const;
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Create the raw frames publisher.
+   *
+   * \param[in] ref_ros_node_handle   ROS node.
+   * \param[in] ref_frame_id          Frame ID of the messages.
+   * \param[in] batch_size            Maximum number of frames per message.
+   */
+  void initPublisher(rclcpp::Node &ref_ros_node_handle, const std::string &ref_frame_id, uint32_t batch_size);
+
+  /*!
+   * Add a frame to the current batch, the batch is published once full.
+   *
+   * \param[in] msg_class         Class of the log.
+   * \param[in] msg               Message ID of the log.
+   * \param[in] p_payload         Log payload.
+   * \param[in] payload_size      Log payload size in bytes.
+   */
+  void addFrame(SbgEComClass msg_class, SbgEComMsgId msg, const void *p_payload, size_t payload_size);
+
+  /*!
+   * Publish the frames of the current batch, if any.
+   */
+  void flush(void);
+};
+}
+
+#endif // SBG_ROS_RAW_FRAME_PUBLISHER_H
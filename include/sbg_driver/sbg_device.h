@@ -2,18 +2,23 @@
 #define SBG_ROS_SBG_DEVICE_H
 
 // Standard headers
+#include <bitset>
 #include <iostream>
-#include <map>
+#include <memory>
 #include <string>
 
-// ROS headers
-#include <std_srvs/srv/set_bool.hpp>
-#include <std_srvs/srv/trigger.hpp>
+// SbgRos message headers
+#include "sbg_driver/msg/sbg_link_status.hpp"
 
 // Project headers
 #include <config_applier.h>
 #include <config_store.h>
+#include <frame_relay.h>
+#include <latency_monitor.h>
+#include <mag_calibrator.h>
 #include <message_publisher.h>
+#include <raw_frame_publisher.h>
+#include <shared_state_writer.h>
 
 namespace sbg
 {
@@ -24,32 +29,36 @@ class SbgDevice
 {
 private:
 
-  //---------------------------------------------------------------------//
-  //- Static members definition                                         -//
-  //---------------------------------------------------------------------//
-
-  static std::map<SbgEComMagCalibQuality, std::string>    g_mag_calib_quality_;
-  static std::map<SbgEComMagCalibConfidence, std::string> g_mag_calib_confidence_;
-  static std::map<SbgEComMagCalibMode, std::string>       g_mag_calib_mode_;
-  static std::map<SbgEComMagCalibBandwidth, std::string>  g_mag_calib_bandwidth;
-
   //---------------------------------------------------------------------//
   //- Private variables                                                 -//
   //---------------------------------------------------------------------//
 
   SbgEComHandle           m_com_handle_;
   SbgInterface            m_sbg_interface_;
+  std::unique_ptr<AsyncCommandQueue> m_command_queue_;
   rclcpp::Node&        	  m_ref_node_;
   MessagePublisher        m_message_publisher_;
   ConfigStore             m_config_store_;
+  LatencyMonitor          m_latency_monitor_;
+  RawFramePublisher       m_raw_frame_publisher_;
+  FrameRelay              m_frame_relay_;
+  SharedStateWriter       m_shared_state_writer_;
 
   uint32_t                m_rate_frequency_;
+  uint32_t                m_log_filter_countdown_;
+  uint32_t                m_status_countdown_;
+
+  std::bitset<2 * 256>    m_log_consumed_;
+  std::bitset<2 * 256>    m_log_consumed_cached_;
 
-  bool                    m_mag_calibration_ongoing_;
-  bool                    m_mag_calibration_done_;
-  SbgEComMagCalibResults  m_magCalibResults;
-  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr    m_calib_service_;
-  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr      m_calib_save_service_;
+  SbgEComProtocolStats    m_last_link_stats_;
+  rclcpp::Time            m_last_link_stats_time_;
+  rclcpp::Publisher<sbg_driver::msg::SbgLinkStatus, std::allocator<void>>::SharedPtr m_link_status_pub_;
+
+  uint32_t                m_device_serial_number_;
+  uint32_t                m_device_firmware_rev_;
+
+  std::unique_ptr<MagCalibrator> m_mag_calibrator_;
 
   //---------------------------------------------------------------------//
   //- Private  methods                                                  -//
@@ -76,6 +85,30 @@ private:
    */
   void onLogReceived(SbgEComClass msg_class, SbgEComMsgId msg, const SbgBinaryLogData& ref_sbg_data);
 
+  /*!
+   * Callback definition called with the payload of each valid log frame, before the log is parsed.
+   *
+   * \param[in] p_handle          Valid handle on the sbgECom instance that has called this callback.
+   * \param[in] msg_class         Class of the log.
+   * \param[in] msg               Message ID of the log.
+   * \param[in] p_payload         Log payload.
+   * \param[in] payload_size      Log payload size in bytes.
+   * \param[in] p_user_arg        Optional user supplied argument.
+   * \return                      True if the log has been consumed and must not be parsed.
+   */
+  static bool onFrameReceivedCallback(SbgEComHandle *p_handle, SbgEComClass msg_class, SbgEComMsgId msg, const void *p_payload, size_t payload_size, void *p_user_arg);
+
+  /*!
+   * Function to handle the payload of a received log frame.
+   *
+   * \param[in] msg_class         Class of the log.
+   * \param[in] msg               Message ID of the log.
+   * \param[in] p_payload         Log payload.
+   * \param[in] payload_size      Log payload size in bytes.
+   * \return                      True if the log has been consumed and must not be parsed.
+   */
+  bool onFrameReceived(SbgEComClass msg_class, SbgEComMsgId msg, const void *p_payload, size_t payload_size);
+
   /*!
    * Load the parameters.
    */
@@ -109,62 +142,50 @@ private:
   void initPublishers(void);
 
   /*!
-   * Configure the connected SBG device.
-   * This function will configure the device if the config file allows it.
-   * It will log warning for unavailable parameters for the connected device.
-   * 
-   * \throw                       Unable to configure the connected device.
-   */
-  void configure(void);
-
-  /*!
-   * Process the magnetometer calibration.
-   * 
-   * \param[in] ref_ros_request   ROS service request.
-   * \param[in] ref_ros_response  ROS service response.
-   * \return                      Return true if the calibration process has been succesfull.
+   * Check if a received log is used by a publisher with subscribers.
+   * The result is cached until the next periodicHandle call.
+   *
+   * \param[in] msg_class         Class of the log.
+   * \param[in] msg               Message ID of the log.
+   * \return                      True if the log is consumed.
    */
-  bool processMagCalibration(const std::shared_ptr<std_srvs::srv::Trigger::Request> ref_ros_request, std::shared_ptr<std_srvs::srv::Trigger::Response> ref_ros_response);
+  bool isLogConsumed(SbgEComClass msg_class, SbgEComMsgId msg);
 
   /*!
-   * Save the magnetometer calibration.
-   * 
-   * \param[in] ref_ros_request   ROS service request.
-   * \param[in] ref_ros_response  ROS service response.
-   * \return                      Return true if the calibration has been saved.
+   * Update the sbgECom log filter so only the logs used by a publisher with subscribers are parsed.
    */
-  bool saveMagCalibration(const std::shared_ptr<std_srvs::srv::Trigger::Request> ref_ros_request, std::shared_ptr<std_srvs::srv::Trigger::Response> ref_ros_response);
+  void updateLogFilter(void);
 
   /*!
-   * Start the magnetometer calibration process.
-   * 
-   * \return                      True if the calibration process has started successfully.
+   * Publish the reception link health counters accumulated since the previous call.
    */
-  bool startMagCalibration(void);
+  void publishLinkStatus(void);
 
   /*!
-   * End the magnetometer calibration process.
-   * 
-   * \return                      True if the calibration process has ended successfully.
-   */
-  bool endMagCalibration(void);
-
-  /*!
-   * Upload the magnetometers calibration results to the device.
+   * Configure the connected SBG device.
+   * This function will configure the device if the config file allows it.
+   * It will log warning for unavailable parameters for the connected device.
    * 
-   * \return                      True if the magnetometers calibration has been successfully uploaded to the device.
+   * \throw                       Unable to configure the connected device.
    */
-  bool uploadMagCalibrationToDevice(void);
+  void configure(void);
 
   /*!
-   * Display magnetometers calibration status result.
+   * Check if the configuration cache matches the connected device and the configuration to apply.
+   *
+   * \param[in] config_hash       Hash of the configuration to apply.
+   * \param[in] settings_hash     Hash of the settings currently exported by the device.
+   * \return                      True if this configuration has already been applied to this device.
    */
-  void displayMagCalibrationStatusResult(void) const;
+  bool isConfigurationCached(uint64_t config_hash, uint64_t settings_hash) const;
 
   /*!
-   * Export magnetometers calibration results.
+   * Store the applied configuration in the configuration cache.
+   *
+   * \param[in] config_hash       Hash of the applied configuration.
+   * \param[in] settings_hash     Hash of the device settings once configured.
    */
-  void exportMagCalibrationResults(void) const;
+  void storeConfigurationCache(uint64_t config_hash, uint64_t settings_hash) const;
 
 public:
 
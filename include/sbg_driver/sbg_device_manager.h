@@ -0,0 +1,145 @@
+/*!
+*	\file         sbg_device_manager.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Handle several SBG devices in a single process.
+*
+*   Each device gets its own node in its own namespace, so its parameters, topics and
+*   frames are isolated, and all the devices are polled from a single loop sharing one executor.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_SBG_DEVICE_MANAGER_H
+#define SBG_ROS_SBG_DEVICE_MANAGER_H
+
+// Standard headers
+#include <memory>
+#include <string>
+#include <vector>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+
+// Project headers
+#include <sbg_device.h>
+
+namespace sbg
+{
+/*!
+ * Class to handle several connected SBG devices.
+ */
+class SbgDeviceManager
+{
+private:
+
+  /*!
+   * Device handled by the manager.
+   */
+  struct ManagedDevice
+  {
+    rclcpp::Node::SharedPtr     node;       /*!< Device node, in the device namespace. */
+    std::unique_ptr<SbgDevice>  device;     /*!< Connected device. */
+  };
+
+  //---------------------------------------------------------------------//
+  //- Private variables                                                 -//
+  //---------------------------------------------------------------------//
+
+  rclcpp::Node&                             m_ref_node_;
+  std::vector<std::string>                  m_device_namespaces_;
+  std::vector<ManagedDevice>                m_devices_;
+  rclcpp::executors::SingleThreadedExecutor m_executor_;
+
+  //---------------------------------------------------------------------//
+  //- Private  methods                                                  -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Load the manager parameters.
+   */
+  void loadParameters(void);
+
+  /*!
+   * Create a node in each device namespace and connect the devices.
+   *
+   * A device that fails to connect is reported and skipped, so the other devices keep running.
+   *
+   * \throw                       Unable to connect any device.
+   */
+  void connectDevices(void);
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   *
+   * \param[in] ref_node_handle   ROS Node of the manager.
+   */
+  SbgDeviceManager(rclcpp::Node& ref_node_handle);
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Get the frequency to update the main rate loop, the highest device frequency.
+   *
+   * \return                      Frequency to read the logs of all the devices (in Hz).
+   */
+  uint32_t getUpdateFrequency(void) const;
+
+  /*!
+   * Get the number of handled devices.
+   *
+   * \return                      Number of devices.
+   */
+  size_t getDeviceCount(void) const;
+
+  //---------------------------------------------------------------------//
+  //- Public  methods                                                   -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Initialize all the devices for receiving data.
+   *
+   * A device that fails to initialize is reported and removed.
+   *
+   * \throw                       Unable to initialize any device.
+   */
+  void initDevicesForReceivingData(void);
+
+  /*!
+   * Periodic handle of all the devices, then of the shared executor.
+   */
+  void periodicHandle(void);
+};
+}
+
+#endif // SBG_ROS_SBG_DEVICE_MANAGER_H
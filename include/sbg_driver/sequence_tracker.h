@@ -0,0 +1,222 @@
+/*!
+*	\file         sequence_tracker.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Detect missing, duplicate and out of order logs from the device time stamps.
+*
+*   The expected period of each log is derived from its output mode, or learned from
+*   the received time stamps for logs output on new data.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_SEQUENCE_TRACKER_H
+#define SBG_ROS_SEQUENCE_TRACKER_H
+
+// Standard headers
+#include <array>
+
+// SbgECom headers
+#include <sbgEComLib.h>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+
+// SbgRos message headers
+#include "sbg_driver/msg/sbg_log_gap.hpp"
+
+namespace sbg
+{
+/*!
+ * Class to track the device time stamps of each log and report the discontinuities.
+ */
+class SequenceTracker
+{
+private:
+
+  /*!
+   * Sequence state and statistics of a single log id.
+   */
+  struct LogSequence
+  {
+    bool      configured;         /*!< True if the log output mode is known from the configuration, or for event logs. */
+    bool      periodic;           /*!< True if the configured output mode is expected at a regular rate. */
+    uint32_t  nominal_period;     /*!< Period derived from the output mode, 0 if unknown (us). */
+    uint32_t  learned_period;     /*!< Period learned from the received time stamps, 0 until learned (us). */
+    bool      time_stamp_valid;   /*!< True once a first time stamp has been received. */
+    uint32_t  last_time_stamp;    /*!< Device time stamp of the last log (us). */
+    uint32_t  received;           /*!< Number of logs received since the last report. */
+    uint32_t  gaps;               /*!< Number of gaps since the last report. */
+    uint32_t  missing;            /*!< Estimated number of missing samples since the last report. */
+    uint32_t  duplicates;         /*!< Number of duplicate time stamps since the last report. */
+    uint32_t  out_of_order;       /*!< Number of time stamps older than the previous one since the last report. */
+    uint32_t  max_interval;       /*!< Largest interval between two logs since the last report (us). */
+  };
+
+  std::array<LogSequence, 2 * 256> m_logs_;
+  bool                              m_enabled_;
+  bool                              m_learn_new_data_;
+  std::string                       m_frame_id_;
+  rclcpp::Clock::SharedPtr          m_clock_;
+
+  rclcpp::Publisher<sbg_driver::msg::SbgLogGap, std::allocator<void>>::SharedPtr              m_log_gap_pub_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray, std::allocator<void>>::SharedPtr   m_diagnostics_pub_;
+
+  /*!
+   * Get the sequence of a log.
+   *
+   * \param[in] msg_class         Log class.
+   * \param[in] msg               Log id.
+   * \return                      Log sequence, nullptr for non log classes.
+   */
+  LogSequence *getLogSequence(SbgEComClass msg_class, SbgEComMsgId msg);
+
+  /*!
+   * Get the device time stamp of a log.
+   *
+   * \param[in] msg_class         Log class.
+   * \param[in] msg               Log id.
+   * \param[in] ref_sbg_log       SBG log.
+   * \param[out] ref_time_stamp   Time since the sensor power up (us).
+   * \return                      True if the log has a time stamp.
+   */
+  static bool getTimeStamp(SbgEComClass msg_class, SbgEComMsgId msg, const SbgBinaryLogData &ref_sbg_log, uint32_t &ref_time_stamp);
+
+  /*!
+   * Check if a log is an event marker, output on external events rather than at a regular rate.
+   *
+   * \param[in] msg_class         Log class.
+   * \param[in] msg               Log id.
+   * \return                      True for the event in and event out logs.
+   */
+  static bool isEventLog(SbgEComClass msg_class, SbgEComMsgId msg);
+
+  /*!
+   * Get the nominal period of an output mode.
+   *
+   * \param[in] output_mode       Output mode.
+   * \return                      Period, 0 if the output isn't periodic (us).
+   */
+  static uint32_t getNominalPeriod(SbgEComOutputMode output_mode);
+
+  /*!
+   * Get the period used to detect missing samples.
+   *
+   * \param[in] ref_sequence      Log sequence.
+   * \return                      Expected period, 0 if unknown (us).
+   */
+  static uint32_t getExpectedPeriod(const LogSequence &ref_sequence);
+
+  /*!
+   * Refine the learned period of a log with a new interval.
+   *
+   * \param[in] ref_sequence      Log sequence to update.
+   * \param[in] interval          Interval between the last two logs (us).
+   */
+  static void learnPeriod(LogSequence &ref_sequence, uint32_t interval);
+
+  /*!
+   * Publish a gap event.
+   *
+   * \param[in] msg_class         Log class.
+   * \param[in] msg               Log id.
+   * \param[in] type              Gap type.
+   * \param[in] ref_sequence      Log sequence, before its last time stamp is updated.
+   * \param[in] time_stamp        Device time stamp of the current log (us).
+   * \param[in] missing_samples   Estimated number of missing samples.
+   */
+  void publishGap(SbgEComClass msg_class, SbgEComMsgId msg, uint8_t type, const LogSequence &ref_sequence, uint32_t time_stamp, uint32_t missing_samples);
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   */
+  SequenceTracker(void);
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Check if the tracker is enabled.
+   *
+   * \return                      True if logs are tracked.
+   */
+  bool isEnabled(void) const;
+
+  /*!
+   * Set the expected output mode of a log.
+   *
+   * \param[in] msg_class         Log class.
+   * \param[in] msg               Log id.
+   * \param[in] output_mode       Output mode from the configuration.
+   */
+  void setOutputMode(SbgEComClass msg_class, SbgEComMsgId msg, SbgEComOutputMode output_mode);
+
+  /*!
+   * Set if the logs output on new data are expected at a regular rate.
+   * Must be set before the output modes.
+   *
+   * \param[in] learn_new_data    True to learn the period of the new data outputs, false to only check their ordering.
+   */
+  void setLearnNewData(bool learn_new_data);
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Enable the tracker and create its publishers.
+   *
+   * \param[in] ref_ros_node_handle   ROS node.
+   * \param[in] ref_frame_id          Frame ID of the gap messages.
+   */
+  void initPublishers(rclcpp::Node &ref_ros_node_handle, const std::string &ref_frame_id);
+
+  /*!
+   * Check the time stamp of a received log against the previous one.
+   *
+   * \param[in] msg_class         Log class.
+   * \param[in] msg               Log id.
+   * \param[in] ref_sbg_log       SBG log.
+   */
+  void update(SbgEComClass msg_class, SbgEComMsgId msg, const SbgBinaryLogData &ref_sbg_log);
+
+  /*!
+   * Publish the statistics gathered since the last call and reset them.
+   *
+   * \param[in] ref_stamp         Diagnostics time stamp.
+   */
+  void publishDiagnostics(const rclcpp::Time &ref_stamp);
+};
+}
+
+#endif // SBG_ROS_SEQUENCE_TRACKER_H
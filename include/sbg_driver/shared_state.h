@@ -0,0 +1,406 @@
+/*!
+*	\file         shared_state.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Latest device state exported in a POSIX shared memory segment.
+*
+*   Each record is protected by a sequence lock, so the driver never waits for the readers and a
+*   reader gets a consistent record in a bounded number of attempts. This header has no ROS or
+*   sbgECom dependency, a co-located process only needs it to read the state (link with -lrt on
+*   older glibc versions).
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_SHARED_STATE_H
+#define SBG_ROS_SHARED_STATE_H
+
+// Standard headers
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// POSIX headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*!
+ * Shared state segment identifier, set once the segment is initialized.
+ */
+#define SBG_SHARED_STATE_MAGIC          (0x53424753u)
+
+/*!
+ * Shared state layout version, incremented on each layout change.
+ */
+#define SBG_SHARED_STATE_VERSION        (1u)
+
+/*!
+ * Maximum number of attempts to read a record while it is being written.
+ */
+#define SBG_SHARED_STATE_READ_ATTEMPTS  (4)
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "The shared state needs lock free atomics to be shared between processes.");
+
+namespace sbg
+{
+/*!
+ * Latest IMU data, from SBG_ECOM_LOG_IMU_DATA.
+ * Host stamps are std::chrono::steady_clock times in nanoseconds, taken when the log is received.
+ */
+struct SharedImuRecord
+{
+  uint64_t  host_stamp;                 /*!< Reception time in ns. */
+  uint32_t  time_stamp;                 /*!< Device time stamp in us. */
+  uint16_t  status;                     /*!< IMU status bitmask. */
+  float     accel[3];                   /*!< X, Y, Z accelerometers in m.s^-2. */
+  float     gyro[3];                    /*!< X, Y, Z gyroscopes in rad.s^-1. */
+  float     temperature;                /*!< Internal temperature in degrees. */
+  float     delta_velocity[3];          /*!< X, Y, Z delta velocity in m.s^-2. */
+  float     delta_angle[3];             /*!< X, Y, Z delta angle in rad.s^-1. */
+};
+
+/*!
+ * Latest EKF quaternion, from SBG_ECOM_LOG_EKF_QUAT.
+ */
+struct SharedEkfQuatRecord
+{
+  uint64_t  host_stamp;                 /*!< Reception time in ns. */
+  uint32_t  time_stamp;                 /*!< Device time stamp in us. */
+  uint32_t  status;                     /*!< EKF solution status. */
+  float     quaternion[4];              /*!< Orientation quaternion in W, X, Y, Z form. */
+  float     euler_std_dev[3];           /*!< Roll, pitch and yaw 1 sigma standard deviation in rad. */
+};
+
+/*!
+ * Latest EKF Euler angles, from SBG_ECOM_LOG_EKF_EULER.
+ */
+struct SharedEkfEulerRecord
+{
+  uint64_t  host_stamp;                 /*!< Reception time in ns. */
+  uint32_t  time_stamp;                 /*!< Device time stamp in us. */
+  uint32_t  status;                     /*!< EKF solution status. */
+  float     euler[3];                   /*!< Roll, pitch and yaw in rad. */
+  float     euler_std_dev[3];           /*!< Roll, pitch and yaw 1 sigma standard deviation in rad. */
+};
+
+/*!
+ * Latest EKF navigation data, from SBG_ECOM_LOG_EKF_NAV.
+ */
+struct SharedEkfNavRecord
+{
+  uint64_t  host_stamp;                 /*!< Reception time in ns. */
+  uint32_t  time_stamp;                 /*!< Device time stamp in us. */
+  uint32_t  status;                     /*!< EKF solution status. */
+  double    position[3];                /*!< Latitude and longitude in degrees, altitude above mean sea level in m. */
+  float     undulation;                 /*!< Height of the geoid above the ellipsoid in m. */
+  float     position_std_dev[3];        /*!< Latitude, longitude and altitude 1 sigma standard deviation in m. */
+  float     velocity[3];                /*!< North, East, Down velocity in m.s^-1. */
+  float     velocity_std_dev[3];        /*!< North, East, Down velocity 1 sigma standard deviation in m.s^-1. */
+};
+
+/*!
+ * Latest device status, from SBG_ECOM_LOG_STATUS.
+ */
+struct SharedStatusRecord
+{
+  uint64_t  host_stamp;                 /*!< Reception time in ns. */
+  uint32_t  time_stamp;                 /*!< Device time stamp in us. */
+  uint16_t  general_status;             /*!< General status bitmask. */
+  uint32_t  com_status;                 /*!< Communication status bitmask. */
+  uint32_t  aiding_status;              /*!< Aiding equipments status bitmask. */
+  uint32_t  up_time;                    /*!< Device up time in s. */
+};
+
+/*!
+ * Record protected by a sequence lock, on its own cache line.
+ * The sequence is odd while the record is written, and 0 until it is written once.
+ */
+template <typename T>
+class alignas(64) SeqlockRecord
+{
+  static_assert(std::is_trivially_copyable<T>::value, "Shared records must be trivially copyable.");
+
+private:
+
+  std::atomic<uint32_t>   m_sequence_;
+  T                       m_data_;
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Mark the record as never written.
+   */
+  void reset(void)
+  {
+    m_sequence_.store(0, std::memory_order_release);
+  }
+
+  /*!
+   * Write the record, there must be a single writer.
+   *
+   * \param[in] ref_data          Record to write.
+   */
+  void write(const T &ref_data)
+  {
+    uint32_t sequence;
+
+    sequence = m_sequence_.load(std::memory_order_relaxed);
+
+    m_sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_data_ = ref_data;
+
+    m_sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /*!
+   * Read the record, without ever waiting for the writer.
+   *
+   * \param[out] ref_data         Record read.
+   * \return                      True if a consistent record has been read, false if it has never been written
+   *                              or if it has been written during each of the read attempts.
+   */
+  bool read(T &ref_data) const
+  {
+    for (int attempt = 0; attempt < SBG_SHARED_STATE_READ_ATTEMPTS; attempt++)
+    {
+      uint32_t sequence;
+
+      sequence = m_sequence_.load(std::memory_order_acquire);
+
+      if (sequence == 0)
+      {
+        return false;
+      }
+
+      if ((sequence & 1) == 0)
+      {
+        ref_data = m_data_;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (m_sequence_.load(std::memory_order_relaxed) == sequence)
+        {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+};
+
+/*!
+ * Layout of the shared state segment.
+ */
+struct SharedState
+{
+  std::atomic<uint32_t>                 magic;
+  uint32_t                              version;
+  uint32_t                              size;
+
+  SeqlockRecord<SharedImuRecord>        imu;
+  SeqlockRecord<SharedEkfQuatRecord>    ekf_quat;
+  SeqlockRecord<SharedEkfEulerRecord>   ekf_euler;
+  SeqlockRecord<SharedEkfNavRecord>     ekf_nav;
+  SeqlockRecord<SharedStatusRecord>     status;
+};
+
+/*!
+ * Reader of the shared state exported by the driver.
+ */
+class SharedStateReader
+{
+private:
+
+  const SharedState   *m_p_state_;
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   */
+  SharedStateReader(void):
+  m_p_state_(nullptr)
+  {
+  }
+
+  /*!
+   * Default destructor.
+   */
+  ~SharedStateReader(void)
+  {
+    close();
+  }
+
+  SharedStateReader(const SharedStateReader&) = delete;
+  SharedStateReader &operator=(const SharedStateReader&) = delete;
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Check if a shared state segment is opened.
+   *
+   * \return                      True if the reader is opened.
+   */
+  bool isOpened(void) const
+  {
+    return m_p_state_ != nullptr;
+  }
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Open the shared state segment exported by the driver.
+   *
+   * \param[in] ref_name          Segment name, as set in the driver configuration.
+   * \return                      True if the segment has been opened, false if it doesn't exist yet or has another layout.
+   */
+  bool open(const std::string &ref_name)
+  {
+    struct stat   segment_stat;
+    void          *p_segment;
+    int           segment_fd;
+
+    close();
+
+    segment_fd = shm_open(ref_name.c_str(), O_RDONLY, 0);
+
+    if (segment_fd < 0)
+    {
+      return false;
+    }
+
+    if ((fstat(segment_fd, &segment_stat) != 0) || (static_cast<size_t>(segment_stat.st_size) < sizeof(SharedState)))
+    {
+      ::close(segment_fd);
+      return false;
+    }
+
+    p_segment = mmap(nullptr, sizeof(SharedState), PROT_READ, MAP_SHARED, segment_fd, 0);
+    ::close(segment_fd);
+
+    if (p_segment == MAP_FAILED)
+    {
+      return false;
+    }
+
+    m_p_state_ = static_cast<const SharedState*>(p_segment);
+
+    if ((m_p_state_->magic.load(std::memory_order_acquire) != SBG_SHARED_STATE_MAGIC) || (m_p_state_->version != SBG_SHARED_STATE_VERSION) || (m_p_state_->size != sizeof(SharedState)))
+    {
+      close();
+      return false;
+    }
+
+    return true;
+  }
+
+  /*!
+   * Close the shared state segment.
+   */
+  void close(void)
+  {
+    if (m_p_state_)
+    {
+      munmap(const_cast<SharedState*>(m_p_state_), sizeof(SharedState));
+      m_p_state_ = nullptr;
+    }
+  }
+
+  /*!
+   * Read the latest IMU data.
+   *
+   * \param[out] ref_record       Latest IMU data.
+   * \return                      True if the record has been read.
+   */
+  bool readImu(SharedImuRecord &ref_record) const
+  {
+    return m_p_state_ && m_p_state_->imu.read(ref_record);
+  }
+
+  /*!
+   * Read the latest EKF quaternion.
+   *
+   * \param[out] ref_record       Latest EKF quaternion.
+   * \return                      True if the record has been read.
+   */
+  bool readEkfQuat(SharedEkfQuatRecord &ref_record) const
+  {
+    return m_p_state_ && m_p_state_->ekf_quat.read(ref_record);
+  }
+
+  /*!
+   * Read the latest EKF Euler angles.
+   *
+   * \param[out] ref_record       Latest EKF Euler angles.
+   * \return                      True if the record has been read.
+   */
+  bool readEkfEuler(SharedEkfEulerRecord &ref_record) const
+  {
+    return m_p_state_ && m_p_state_->ekf_euler.read(ref_record);
+  }
+
+  /*!
+   * Read the latest EKF navigation data.
+   *
+   * \param[out] ref_record       Latest EKF navigation data.
+   * \return                      True if the record has been read.
+   */
+  bool readEkfNav(SharedEkfNavRecord &ref_record) const
+  {
+    return m_p_state_ && m_p_state_->ekf_nav.read(ref_record);
+  }
+
+  /*!
+   * Read the latest device status.
+   *
+   * \param[out] ref_record       Latest device status.
+   * \return                      True if the record has been read.
+   */
+  bool readStatus(SharedStatusRecord &ref_record) const
+  {
+    return m_p_state_ && m_p_state_->status.read(ref_record);
+  }
+};
+}
+
+#endif // SBG_ROS_SHARED_STATE_H
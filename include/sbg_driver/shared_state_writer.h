@@ -0,0 +1,137 @@
+/*!
+*	\file         shared_state_writer.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Write the latest device state in a POSIX shared memory segment.
+*
+*   The records are updated as soon as their log is received, so a co-located control loop can
+*   read them with the SharedStateReader without a ROS transport.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_SHARED_STATE_WRITER_H
+#define SBG_ROS_SHARED_STATE_WRITER_H
+
+// Standard headers
+#include <string>
+
+// SbgECom headers
+#include <sbgEComLib.h>
+
+// Project headers
+#include <shared_state.h>
+
+/*!
+ * Access mode of the shared memory segment, written by the driver user and read by the processes of its group.
+ */
+#define SBG_SHARED_STATE_WRITER_MODE    (0640)
+
+namespace sbg
+{
+/*!
+ * Class to write the latest device state in a shared memory segment.
+ */
+class SharedStateWriter
+{
+private:
+
+  SharedState   *m_p_state_;
+
+  //---------------------------------------------------------------------//
+  //- Private methods                                                   -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Get the current host stamp of the records.
+   *
+   * \return                      Steady clock time in ns.
+   */
+  static uint64_t getHostStamp(void);
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   */
+  SharedStateWriter(void);
+
+  /*!
+   * Default destructor.
+   * The segment isn't removed, so the readers stay attached if the driver is restarted.
+   */
+  ~SharedStateWriter(void);
+
+  SharedStateWriter(const SharedStateWriter&) = delete;
+  SharedStateWriter &operator=(const SharedStateWriter&) = delete;
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Check if the state is exported.
+   *
+   * \return                      True if the segment is opened.
+   */
+  bool isEnabled(void) const;
+
+  /*!
+   * Check if a log is exported in the shared state.
+   *
+   * \param[in] msg_class         Class of the log.
+   * \param[in] msg               Message ID of the log.
+   * \return                      True if the segment is opened and has a record for this log.
+   */
+  bool isLogExported(SbgEComClass msg_class, SbgEComMsgId msg) const;
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Create or open the shared state segment and reset its records.
+   *
+   * \param[in] ref_name          Segment name.
+   * \throw                       Unable to create the segment.
+   */
+  void open(const std::string &ref_name);
+
+  /*!
+   * Update the record of a received log, other logs are ignored.
+   *
+   * \param[in] msg_class         Class of the log.
+   * \param[in] msg               Message ID of the log.
+   * \param[in] ref_sbg_data      Received log data.
+   */
+  void write(SbgEComClass msg_class, SbgEComMsgId msg, const SbgBinaryLogData &ref_sbg_data);
+};
+}
+
+#endif // SBG_ROS_SHARED_STATE_WRITER_H
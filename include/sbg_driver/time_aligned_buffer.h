@@ -0,0 +1,332 @@
+/*!
+*	\file         time_aligned_buffer.h
+*	\author       SBG Systems
+*	\date         18/10/2026
+*
+*	\brief        Fixed capacity buffer of logs indexed by their device time stamp.
+*
+*   Samples are kept sorted by time stamp, so a log can be matched or interpolated at the
+*   time stamp of another log even with different output rates or a reordered frame.
+*
+*	\section CodeCopyright Copyright Notice
+*	MIT License
+*
+*	Copyright (c) 2020 SBG Systems
+*
+*	Permission is hereby granted, free of charge, to any person obtaining a copy
+*	of this software and associated documentation files (the "Software"), to deal
+*	in the Software without restriction, including without limitation the rights
+*	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*	copies of the Software, and to permit persons to whom the Software is
+*	furnished to do so, subject to the following conditions:
+*
+*	The above copyright notice and this permission notice shall be included in all
+*	copies or substantial portions of the Software.
+*
+*	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*	SOFTWARE.
+*/
+
+#ifndef SBG_ROS_TIME_ALIGNED_BUFFER_H
+#define SBG_ROS_TIME_ALIGNED_BUFFER_H
+
+// Standard headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// SbgRos message headers
+#include "sbg_driver/msg/sbg_ekf_euler.hpp"
+#include "sbg_driver/msg/sbg_ekf_nav.hpp"
+#include "sbg_driver/msg/sbg_ekf_quat.hpp"
+
+/*!
+ * A sample older than the newest stored one by more than this duration comes from a device restart (us).
+ */
+#define SBG_TIME_ALIGNED_BUFFER_RESTART_GAP   (1000000)
+
+namespace sbg
+{
+/*!
+ * Result of a time aligned buffer lookup.
+ */
+enum class AlignStatus
+{
+  ALIGNED,            /*!< A sample has been matched or interpolated at the time stamp. */
+  PENDING,            /*!< No sample received after the time stamp yet. */
+  UNAVAILABLE         /*!< The samples around the time stamp are missing or too far apart. */
+};
+
+/*!
+ * Interpolate an EKF quaternion log, the orientation is interpolated with a SLERP.
+ *
+ * \param[in] ref_before        Log before the interpolated time stamp.
+ * \param[in] ref_after         Log after the interpolated time stamp.
+ * \param[in] ratio             Interpolation ratio, from 0 (before) to 1 (after).
+ * \param[out] ref_sample       Interpolated log.
+ */
+void interpolate(const sbg_driver::msg::SbgEkfQuat &ref_before, const sbg_driver::msg::SbgEkfQuat &ref_after, double ratio, sbg_driver::msg::SbgEkfQuat &ref_sample);
+
+/*!
+ * Interpolate an EKF euler log, each angle is interpolated along the shortest direction.
+ *
+ * \param[in] ref_before        Log before the interpolated time stamp.
+ * \param[in] ref_after         Log after the interpolated time stamp.
+ * \param[in] ratio             Interpolation ratio, from 0 (before) to 1 (after).
+ * \param[out] ref_sample       Interpolated log.
+ */
+void interpolate(const sbg_driver::msg::SbgEkfEuler &ref_before, const sbg_driver::msg::SbgEkfEuler &ref_after, double ratio, sbg_driver::msg::SbgEkfEuler &ref_sample);
+
+/*!
+ * Interpolate an EKF navigation log, position and velocity are interpolated linearly.
+ *
+ * \param[in] ref_before        Log before the interpolated time stamp.
+ * \param[in] ref_after         Log after the interpolated time stamp.
+ * \param[in] ratio             Interpolation ratio, from 0 (before) to 1 (after).
+ * \param[out] ref_sample       Interpolated log.
+ */
+void interpolate(const sbg_driver::msg::SbgEkfNav &ref_before, const sbg_driver::msg::SbgEkfNav &ref_after, double ratio, sbg_driver::msg::SbgEkfNav &ref_sample);
+
+/*!
+ * Class to store the last samples of a log sorted by device time stamp.
+ *
+ * \template  T                 Log message type, with a time_stamp field in microseconds.
+ * \template  N                 Buffer capacity, the oldest sample is dropped when full.
+ */
+template <typename T, size_t N>
+class TimeAlignedBuffer
+{
+private:
+
+  std::array<T, N>  m_samples_;
+  size_t            m_first_;
+  size_t            m_size_;
+
+  //---------------------------------------------------------------------//
+  //- Private methods                                                   -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Compute the signed difference between two device time stamps, robust to the time stamp wrap.
+   *
+   * \param[in] time_stamp        Time stamp (us).
+   * \param[in] reference         Reference time stamp (us).
+   * \return                      Time stamp minus reference (us).
+   */
+  static int64_t getTimeDifference(uint32_t time_stamp, uint32_t reference)
+  {
+    return static_cast<int32_t>(time_stamp - reference);
+  }
+
+  /*!
+   * Get a sample by its rank, from the oldest.
+   *
+   * \param[in] index             Sample rank.
+   * \return                      Sample.
+   */
+  T &at(size_t index)
+  {
+    return m_samples_[(m_first_ + index) % N];
+  }
+
+  const T &at(size_t index) const
+  {
+    return m_samples_[(m_first_ + index) % N];
+  }
+
+public:
+
+  //---------------------------------------------------------------------//
+  //- Constructor                                                       -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Default constructor.
+   */
+  TimeAlignedBuffer(void):
+  m_first_(0),
+  m_size_(0)
+  {
+  }
+
+  //---------------------------------------------------------------------//
+  //- Parameters                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Check if the buffer is empty.
+   *
+   * \return                      True if there is no sample.
+   */
+  bool isEmpty(void) const
+  {
+    return m_size_ == 0;
+  }
+
+  /*!
+   * Get the oldest sample, the buffer must not be empty.
+   *
+   * \return                      Oldest sample.
+   */
+  const T &getOldest(void) const
+  {
+    return at(0);
+  }
+
+  /*!
+   * Get the newest sample, the buffer must not be empty.
+   *
+   * \return                      Newest sample.
+   */
+  const T &getNewest(void) const
+  {
+    return at(m_size_ - 1);
+  }
+
+  //---------------------------------------------------------------------//
+  //- Operations                                                        -//
+  //---------------------------------------------------------------------//
+
+  /*!
+   * Add a sample, a late sample is inserted at its time stamp and a duplicate replaces the stored one.
+   * The oldest sample is dropped when the buffer is full, and a late sample older than all the
+   * stored ones is rejected in this case. The buffer is cleared on a device restart.
+   *
+   * \param[in] ref_sample        Sample to add.
+   */
+  void push(const T &ref_sample)
+  {
+    size_t index;
+
+    if ((m_size_ > 0) && (getTimeDifference(getNewest().time_stamp, ref_sample.time_stamp) > SBG_TIME_ALIGNED_BUFFER_RESTART_GAP))
+    {
+      clear();
+    }
+
+    index = m_size_;
+
+    while ((index > 0) && (getTimeDifference(at(index - 1).time_stamp, ref_sample.time_stamp) >= 0))
+    {
+      index--;
+    }
+
+    if ((index < m_size_) && (at(index).time_stamp == ref_sample.time_stamp))
+    {
+      at(index) = ref_sample;
+      return;
+    }
+
+    if (m_size_ == N)
+    {
+      //
+      // The sample would be the oldest one, dropped right away.
+      //
+      if (index == 0)
+      {
+        return;
+      }
+
+      m_first_ = (m_first_ + 1) % N;
+      m_size_--;
+      index--;
+    }
+
+    for (size_t i = m_size_; i > index; i--)
+    {
+      at(i) = at(i - 1);
+    }
+
+    at(index) = ref_sample;
+    m_size_++;
+  }
+
+  /*!
+   * Remove the oldest sample, the buffer must not be empty.
+   */
+  void popOldest(void)
+  {
+    m_first_ = (m_first_ + 1) % N;
+    m_size_--;
+  }
+
+  /*!
+   * Remove the samples no longer needed to align a time stamp.
+   * The last sample before it is kept, so the two samples around the time stamp remain available.
+   *
+   * \param[in] time_stamp        Time stamp (us).
+   */
+  void discardBefore(uint32_t time_stamp)
+  {
+    while ((m_size_ > 1) && (getTimeDifference(at(1).time_stamp, time_stamp) < 0))
+    {
+      popOldest();
+    }
+  }
+
+  /*!
+   * Remove all the samples.
+   */
+  void clear(void)
+  {
+    m_first_  = 0;
+    m_size_   = 0;
+  }
+
+  /*!
+   * Get the sample at a time stamp, interpolated between the surrounding samples if needed.
+   *
+   * \param[in] time_stamp        Time stamp (us).
+   * \param[in] max_gap           Maximum time between the surrounding samples to interpolate (us).
+   * \param[out] ref_sample       Sample at the time stamp.
+   * \return                      Lookup result.
+   */
+  AlignStatus getSample(uint32_t time_stamp, uint32_t max_gap, T &ref_sample) const
+  {
+    if ((m_size_ == 0) || (getTimeDifference(getNewest().time_stamp, time_stamp) < 0))
+    {
+      return AlignStatus::PENDING;
+    }
+
+    for (size_t i = 0; i < m_size_; i++)
+    {
+      const T &ref_after  = at(i);
+      int64_t after_delta = getTimeDifference(ref_after.time_stamp, time_stamp);
+
+      if (after_delta == 0)
+      {
+        ref_sample = ref_after;
+        return AlignStatus::ALIGNED;
+      }
+      else if (after_delta > 0)
+      {
+        if (i == 0)
+        {
+          return AlignStatus::UNAVAILABLE;
+        }
+
+        const T &ref_before = at(i - 1);
+        int64_t gap         = getTimeDifference(ref_after.time_stamp, ref_before.time_stamp);
+
+        if (gap > max_gap)
+        {
+          return AlignStatus::UNAVAILABLE;
+        }
+
+        interpolate(ref_before, ref_after, static_cast<double>(gap - after_delta) / gap, ref_sample);
+        ref_sample.time_stamp = time_stamp;
+
+        return AlignStatus::ALIGNED;
+      }
+    }
+
+    return AlignStatus::UNAVAILABLE;
+  }
+};
+}
+
+#endif // SBG_ROS_TIME_ALIGNED_BUFFER_H
@@ -0,0 +1,27 @@
+import os
+from ament_index_python.packages import get_package_share_directory
+from launch import LaunchDescription
+from launch_ros.actions import Node
+
+def generate_launch_description():
+	config = os.path.join(
+		get_package_share_directory('sbg_driver'),
+		'config',
+		'sbg_device_uart_default.yaml'
+	)
+
+	devices_config = os.path.join(
+		get_package_share_directory('sbg_driver'),
+		'config',
+		'example',
+		'sbg_multi_device.yaml'
+	)
+
+	return LaunchDescription([
+		Node(
+			package='sbg_driver',
+			executable = 'sbg_device_multi',
+			output = 'screen',
+			parameters = [config, devices_config]
+		)
+	])
@@ -0,0 +1,282 @@
+// File header
+#include "async_command_queue.h"
+
+// Standard headers
+#include <cstring>
+
+using sbg::AsyncCommandQueue;
+
+/*!
+ * Class to send device commands without waiting for their answers.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+AsyncCommandQueue::AsyncCommandQueue(SbgEComHandle &ref_sbg_com_handle):
+m_ref_sbg_com_handle_(ref_sbg_com_handle),
+m_pending_commands_(),
+m_sequence_(0)
+{
+  sbgEComSetReceiveCmdCallback(&m_ref_sbg_com_handle_, onCommandReceivedCallback, this);
+}
+
+AsyncCommandQueue::~AsyncCommandQueue(void)
+{
+  sbgEComSetReceiveCmdCallback(&m_ref_sbg_com_handle_, nullptr, nullptr);
+}
+
+//---------------------------------------------------------------------//
+//- Private methods                                                   -//
+//---------------------------------------------------------------------//
+
+bool AsyncCommandQueue::onCommandReceivedCallback(SbgEComHandle *p_handle, uint8_t msg_class, uint8_t msg, const void *p_payload, size_t payload_size, void *p_user_arg)
+{
+  SBG_UNUSED_PARAMETER(p_handle);
+
+  assert(p_user_arg);
+
+  return static_cast<AsyncCommandQueue*>(p_user_arg)->onCommandReceived(msg_class, msg, static_cast<const uint8_t*>(p_payload), payload_size);
+}
+
+bool AsyncCommandQueue::onCommandReceived(uint8_t msg_class, uint8_t msg, const uint8_t *p_payload, size_t payload_size)
+{
+  PendingCommand *p_command;
+
+  if ((msg_class == SBG_ECOM_CLASS_LOG_CMD_0) && (msg == SBG_ECOM_CMD_ACK))
+  {
+    uint8_t       ack_msg;
+    uint8_t       ack_msg_class;
+    SbgErrorCode  ack_error_code;
+
+    //
+    // Commands waiting for the ACK frame itself are completed first.
+    //
+    p_command = findOldest(msg_class, msg, nullptr, 0);
+
+    if (p_command)
+    {
+      complete(*p_command, SBG_NO_ERROR, p_payload, payload_size);
+      return true;
+    }
+
+    if (payload_size != 2 * sizeof(uint16_t))
+    {
+      return false;
+    }
+
+    //
+    // The ACK frame contains the acknowledged message ID and class, and the error code as an uint16_t.
+    //
+    ack_msg         = p_payload[0];
+    ack_msg_class   = p_payload[1];
+    ack_error_code  = static_cast<SbgErrorCode>(p_payload[2] | (p_payload[3] << 8));
+
+    //
+    // The ACK doesn't echo the command payload, so it completes the oldest command with this class and id.
+    //
+    p_command = findOldest(ack_msg_class, ack_msg, nullptr, 0);
+
+    if (p_command)
+    {
+      //
+      // An ACK for a command waiting for a payload is a negative answer, even without error code.
+      //
+      if ((p_command->answer_type == AsyncAnswerType::PAYLOAD) && (ack_error_code == SBG_NO_ERROR))
+      {
+        ack_error_code = SBG_ERROR;
+      }
+
+      complete(*p_command, ack_error_code, nullptr, 0);
+      return true;
+    }
+  }
+  else
+  {
+    //
+    // A payload answer without a matching echo, such as a late answer to an expired command, is dropped.
+    //
+    p_command = findOldest(msg_class, msg, p_payload, payload_size);
+
+    if (p_command)
+    {
+      complete(*p_command, SBG_NO_ERROR, p_payload, payload_size);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+AsyncCommandQueue::PendingCommand *AsyncCommandQueue::findOldest(uint8_t msg_class, uint8_t msg, const uint8_t *p_payload, size_t payload_size)
+{
+  PendingCommand *p_oldest;
+
+  p_oldest = nullptr;
+
+  for (PendingCommand &ref_command : m_pending_commands_)
+  {
+    bool matches;
+
+    matches = ref_command.in_use && (ref_command.msg_class == msg_class) && (ref_command.msg == msg);
+
+    if (matches && p_payload)
+    {
+      matches = (ref_command.answer_type == AsyncAnswerType::PAYLOAD) && (payload_size >= ref_command.echo_size) &&
+                (memcmp(p_payload, ref_command.echo.data(), ref_command.echo_size) == 0);
+    }
+
+    //
+    // Sequence numbers may wrap, so compare their difference.
+    //
+    if (matches && (!p_oldest || (static_cast<int32_t>(ref_command.sequence - p_oldest->sequence) < 0)))
+    {
+      p_oldest = &ref_command;
+    }
+  }
+
+  return p_oldest;
+}
+
+void AsyncCommandQueue::complete(PendingCommand &ref_command, SbgErrorCode error_code, const uint8_t *p_payload, size_t payload_size)
+{
+  Completion completion;
+
+  //
+  // The payload is only valid during the receive callback, which may run inside a synchronous command.
+  //
+  completion.p_callback = ref_command.p_callback;
+  completion.p_user_arg = ref_command.p_user_arg;
+  completion.error_code = error_code;
+
+  if (p_payload)
+  {
+    completion.payload.assign(p_payload, p_payload + payload_size);
+  }
+
+  ref_command.in_use = false;
+
+  m_completions_.push_back(std::move(completion));
+}
+
+void AsyncCommandQueue::checkTimeOuts(void)
+{
+  uint32_t current_time;
+
+  current_time = sbgGetTime();
+
+  for (PendingCommand &ref_command : m_pending_commands_)
+  {
+    //
+    // Time may wrap, so compare the difference with the deadline.
+    //
+    if (ref_command.in_use && (static_cast<int32_t>(current_time - ref_command.deadline) > 0))
+    {
+      complete(ref_command, SBG_TIME_OUT, nullptr, 0);
+    }
+  }
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+size_t AsyncCommandQueue::getNumPending(void) const
+{
+  size_t num_pending;
+
+  num_pending = m_completions_.size();
+
+  for (const PendingCommand &ref_command : m_pending_commands_)
+  {
+    if (ref_command.in_use)
+    {
+      num_pending++;
+    }
+  }
+
+  return num_pending;
+}
+
+bool AsyncCommandQueue::isFull(void) const
+{
+  for (const PendingCommand &ref_command : m_pending_commands_)
+  {
+    if (!ref_command.in_use)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+SbgErrorCode AsyncCommandQueue::send(uint8_t msg_class, uint8_t msg, const void *p_data, size_t size, AsyncAnswerType answer_type, size_t echo_size, uint32_t time_out, AsyncCommandCallback p_callback, void *p_user_arg)
+{
+  SbgErrorCode error_code;
+
+  if ((echo_size > size) || (echo_size > SBG_ASYNC_COMMAND_MAX_ECHO_SIZE))
+  {
+    return SBG_INVALID_PARAMETER;
+  }
+
+  //
+  // Look for a free slot before sending anything, so the answer can't be lost.
+  //
+  for (PendingCommand &ref_command : m_pending_commands_)
+  {
+    if (!ref_command.in_use)
+    {
+      error_code = sbgEComProtocolSend(&m_ref_sbg_com_handle_.protocolHandle, msg_class, msg, p_data, size);
+
+      if (error_code == SBG_NO_ERROR)
+      {
+        ref_command.msg_class   = msg_class;
+        ref_command.msg         = msg;
+        ref_command.answer_type = answer_type;
+        ref_command.deadline    = sbgGetTime() + time_out;
+        ref_command.sequence    = m_sequence_++;
+        ref_command.echo_size   = echo_size;
+        ref_command.p_callback  = p_callback;
+        ref_command.p_user_arg  = p_user_arg;
+        ref_command.in_use      = true;
+
+        if (echo_size > 0)
+        {
+          memcpy(ref_command.echo.data(), p_data, echo_size);
+        }
+      }
+
+      return error_code;
+    }
+  }
+
+  return SBG_BUFFER_OVERFLOW;
+}
+
+void AsyncCommandQueue::handle(void)
+{
+  sbgEComHandle(&m_ref_sbg_com_handle_);
+
+  checkTimeOuts();
+
+  while (!m_completions_.empty())
+  {
+    Completion completion;
+
+    //
+    // The completion is removed first, so its callback can send a new command.
+    //
+    completion = std::move(m_completions_.front());
+    m_completions_.pop_front();
+
+    if (completion.p_callback)
+    {
+      completion.p_callback(completion.error_code, completion.payload.empty() ? nullptr : completion.payload.data(), completion.payload.size(), completion.p_user_arg);
+    }
+  }
+}
@@ -10,9 +10,12 @@ using sbg::ConfigApplier;
 //- Constructor                                                       -//
 //---------------------------------------------------------------------//
 
-ConfigApplier::ConfigApplier(SbgEComHandle &ref_sbg_com_handle):
+ConfigApplier::ConfigApplier(SbgEComHandle &ref_sbg_com_handle, AsyncCommandQueue &ref_command_queue):
 m_reboot_needed_(false),
-m_ref_sbg_com_handle(ref_sbg_com_handle)
+m_ref_sbg_com_handle(ref_sbg_com_handle),
+m_ref_command_queue_(ref_command_queue),
+m_settings_hash_valid_(false),
+m_settings_hash_(0)
 {
 
 }
@@ -394,6 +397,176 @@ void ConfigApplier::configureOutput(SbgEComOutputPort output_port, const ConfigS
   }
 }
 
+void ConfigApplier::onOutputCommandAnswer(SbgErrorCode error_code, const uint8_t *p_payload, size_t payload_size, void *p_user_arg)
+{
+  OutputCommand *p_command;
+
+  assert(p_user_arg);
+
+  p_command = static_cast<OutputCommand*>(p_user_arg);
+
+  p_command->completed  = true;
+  p_command->error_code = error_code;
+
+  //
+  // The answer to a get is the port, message id and class followed by the output mode.
+  // The queue only completes a get with the answer echoing its request, the echo is checked again against the log.
+  //
+  if ((error_code == SBG_NO_ERROR) && !p_command->set)
+  {
+    if ((payload_size >= 5) && (p_payload[1] == p_command->p_log_output->message_id) && (p_payload[2] == p_command->p_log_output->message_class))
+    {
+      p_command->device_mode = static_cast<SbgEComOutputMode>(p_payload[3] | (p_payload[4] << 8));
+    }
+    else
+    {
+      p_command->error_code = SBG_INVALID_FRAME;
+    }
+  }
+}
+
+void ConfigApplier::pipelineOutputCommands(SbgEComOutputPort output_port, std::vector<OutputCommand> &ref_commands)
+{
+  SbgErrorCode  error_code;
+  size_t        next_command;
+  uint8_t       payload[5];
+
+  next_command = 0;
+
+  while ((next_command < ref_commands.size()) || (m_ref_command_queue_.getNumPending() > 0))
+  {
+    //
+    // Keep the pending commands table full. The answer to a get echoes the port, message id and class,
+    // so it is matched with its own command, while the ACK to a set is matched in the order sets have been sent.
+    //
+    while ((next_command < ref_commands.size()) && !m_ref_command_queue_.isFull())
+    {
+      OutputCommand   &ref_command = ref_commands[next_command];
+      size_t          payload_size = 3;
+      size_t          echo_size    = payload_size;
+      AsyncAnswerType answer_type  = AsyncAnswerType::PAYLOAD;
+
+      payload[0] = static_cast<uint8_t>(output_port);
+      payload[1] = static_cast<uint8_t>(ref_command.p_log_output->message_id);
+      payload[2] = static_cast<uint8_t>(ref_command.p_log_output->message_class);
+
+      if (ref_command.set)
+      {
+        payload[3]    = static_cast<uint8_t>(ref_command.p_log_output->output_mode);
+        payload[4]    = static_cast<uint8_t>(ref_command.p_log_output->output_mode >> 8);
+        payload_size  = 5;
+        echo_size     = 0;
+        answer_type   = AsyncAnswerType::ACK;
+      }
+
+      ref_command.completed = false;
+
+      error_code = m_ref_command_queue_.send(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_OUTPUT_CONF, payload, payload_size, answer_type, echo_size,
+                                             m_ref_sbg_com_handle.cmdDefaultTimeOut, onOutputCommandAnswer, &ref_command);
+
+      if (error_code != SBG_NO_ERROR)
+      {
+        ref_command.completed   = true;
+        ref_command.error_code  = error_code;
+      }
+
+      next_command++;
+    }
+
+    //
+    // Receive the answers and call the completions, expired commands are completed with a time out.
+    //
+    m_ref_command_queue_.handle();
+
+    if (m_ref_command_queue_.getNumPending() > 0)
+    {
+      sbgSleep(1);
+    }
+  }
+}
+
+bool ConfigApplier::hasTimedOut(const std::vector<OutputCommand> &ref_commands)
+{
+  for (const OutputCommand& ref_command : ref_commands)
+  {
+    if (ref_command.error_code == SBG_TIME_OUT)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ConfigApplier::configureOutputs(SbgEComOutputPort output_port, const std::vector<ConfigStore::SbgLogOutput> &ref_log_outputs)
+{
+  std::vector<OutputCommand> get_commands;
+  std::vector<OutputCommand> set_commands;
+  bool                       acks_ambiguous;
+
+  for (const ConfigStore::SbgLogOutput& ref_log_output : ref_log_outputs)
+  {
+    get_commands.push_back({&ref_log_output, false, false, SBG_NO_ERROR, SBG_ECOM_OUTPUT_MODE_DISABLED});
+  }
+
+  pipelineOutputCommands(output_port, get_commands);
+
+  //
+  // A NACK doesn't echo the log it refers to, after a time out it may be the late answer of another get.
+  //
+  acks_ambiguous = hasTimedOut(get_commands);
+
+  for (const OutputCommand& ref_command : get_commands)
+  {
+    if (ref_command.error_code == SBG_NO_ERROR)
+    {
+      if (ref_command.device_mode != ref_command.p_log_output->output_mode)
+      {
+        set_commands.push_back({ref_command.p_log_output, true, false, SBG_NO_ERROR, ref_command.device_mode});
+      }
+    }
+    else if ((ref_command.error_code == SBG_INVALID_PARAMETER) && !acks_ambiguous)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("Config"), "SBG_DRIVER - [Config] Output is not available for this device : Class [%d] - Id [%d]", ref_command.p_log_output->message_class, ref_command.p_log_output->message_id);
+    }
+    else
+    {
+      //
+      // Failures are handled by the synchronous configuration, with retries on time out.
+      //
+      configureOutput(output_port, *ref_command.p_log_output);
+    }
+  }
+
+  pipelineOutputCommands(output_port, set_commands);
+
+  //
+  // Set ACKs don't echo the log either, so after a time out every set is checked and applied again.
+  //
+  acks_ambiguous = hasTimedOut(set_commands);
+
+  for (const OutputCommand& ref_command : set_commands)
+  {
+    if ((ref_command.error_code == SBG_NO_ERROR) && !acks_ambiguous)
+    {
+      m_reboot_needed_ = true;
+    }
+    else
+    {
+      configureOutput(output_port, *ref_command.p_log_output);
+    }
+  }
+}
+
+void ConfigApplier::reportPhaseDuration(const std::string &ref_phase_title, std::chrono::steady_clock::time_point &ref_phase_start) const
+{
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+  RCLCPP_INFO(rclcpp::get_logger("Config"), "SBG_DRIVER - [Config] %s done in %ld ms.", ref_phase_title.c_str(), static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(now - ref_phase_start).count()));
+
+  ref_phase_start = now;
+}
+
 //---------------------------------------------------------------------//
 //- Parameters                                                        -//
 //---------------------------------------------------------------------//
@@ -404,6 +577,8 @@ void ConfigApplier::configureOutput(SbgEComOutputPort output_port, const ConfigS
 
 void ConfigApplier::applyConfiguration(const ConfigStore& ref_config_store)
 {
+  std::chrono::steady_clock::time_point phase_start = std::chrono::steady_clock::now();
+
   //
   // Configure the connected device.
   //
@@ -420,14 +595,23 @@ void ConfigApplier::applyConfiguration(const ConfigStore& ref_config_store)
   configureOdometerLevelArm(ref_config_store.getOdometerLevelArms());
   configureOdometerRejection(ref_config_store.getOdometerRejection());
 
+  reportPhaseDuration("Device settings", phase_start);
+
   //
   // Configure the output, with all output defined in the store.
   //
-  const std::vector<ConfigStore::SbgLogOutput>& ref_output_modes = ref_config_store.getOutputModes();
+  configureOutputs(ref_config_store.getOutputPort(), ref_config_store.getOutputModes());
 
-  for (const ConfigStore::SbgLogOutput& ref_output : ref_output_modes)
+  reportPhaseDuration("Output configuration", phase_start);
+
+  //
+  // Hash the applied settings before they are saved, as the device reboots once saved.
+  //
+  if (!ref_config_store.getConfigurationCacheFile().empty())
   {
-    configureOutput(ref_config_store.getOutputPort(), ref_output);
+    m_settings_hash_valid_ = exportSettingsHash(m_settings_hash_);
+
+    reportPhaseDuration("Settings export", phase_start);
   }
 
   //
@@ -436,6 +620,8 @@ void ConfigApplier::applyConfiguration(const ConfigStore& ref_config_store)
   if (m_reboot_needed_)
   {
     saveConfiguration();
+
+    reportPhaseDuration("Settings save", phase_start);
   }
 }
 
@@ -454,3 +640,32 @@ void ConfigApplier::saveConfiguration(void)
     RCLCPP_INFO(rclcpp::get_logger("Config"), "SBG_DRIVER - Settings saved and device rebooted.");
   }
 }
+
+bool ConfigApplier::exportSettingsHash(uint64_t &ref_hash)
+{
+  SbgErrorCode          error_code;
+  std::vector<uint8_t>  settings(SBG_CONFIG_EXPORT_MAX_SIZE);
+  size_t                settings_size;
+
+  error_code = sbgEComCmdExportSettings(&m_ref_sbg_com_handle, settings.data(), &settings_size, settings.size());
+
+  if (error_code != SBG_NO_ERROR)
+  {
+    RCLCPP_WARN(rclcpp::get_logger("Config"), "SBG_DRIVER - [Config] Unable to export the device settings - %s", sbgErrorCodeToString(error_code));
+    return false;
+  }
+
+  ref_hash = ConfigStore::hashBuffer(settings.data(), settings_size);
+
+  return true;
+}
+
+bool ConfigApplier::getAppliedSettingsHash(uint64_t &ref_hash) const
+{
+  if (m_settings_hash_valid_)
+  {
+    ref_hash = m_settings_hash_;
+  }
+
+  return m_settings_hash_valid_;
+}
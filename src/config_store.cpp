@@ -1,6 +1,9 @@
 // File header
 #include "config_store.h"
 
+// Standard headers
+#include <climits>
+
 using sbg::ConfigStore;
 
 /*!
@@ -26,6 +29,47 @@ m_ros_standard_output_(false)
 void ConfigStore::loadDriverParameters(const rclcpp::Node& ref_node_handle)
 {
   m_rate_frequency_ = getParameter<uint32_t>(ref_node_handle, "driver.frequency", 400);
+
+  ref_node_handle.get_parameter_or<bool>("driver.lazyParsing"        , m_lazy_parsing_         , false);
+  ref_node_handle.get_parameter_or<bool>("driver.filterBeforeCrc"    , m_filter_before_crc_    , false);
+  ref_node_handle.get_parameter_or<bool>("driver.latencyDiagnostics" , m_latency_diagnostics_  , false);
+  ref_node_handle.get_parameter_or<bool>("driver.sequenceDiagnostics", m_sequence_diagnostics_ , false);
+  ref_node_handle.get_parameter_or<bool>("driver.sequenceLearnNewData", m_sequence_learn_new_data_, false);
+  ref_node_handle.get_parameter_or<bool>("driver.eventPose"          , m_event_pose_           , false);
+  ref_node_handle.get_parameter_or<bool>("driver.statusOnChange"     , m_status_on_change_     , false);
+  ref_node_handle.get_parameter_or<bool>("driver.rawFrames"          , m_raw_frames_           , false);
+  ref_node_handle.get_parameter_or<std::string>("driver.sharedMemory", m_shared_memory_name_   , "");
+
+  m_alignment_max_gap_ = getParameter<uint32_t>(ref_node_handle, "driver.alignmentMaxGap", 50);
+  m_pose_history_size_ = getParameter<uint32_t>(ref_node_handle, "driver.poseHistorySize", 0);
+  m_status_heartbeat_  = getParameter<uint32_t>(ref_node_handle, "driver.statusHeartbeat", 1000);
+  m_raw_frames_batch_size_ = getParameter<uint32_t>(ref_node_handle, "driver.rawFramesBatchSize", 64);
+
+  if (m_raw_frames_batch_size_ == 0)
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - The raw frames batch size must be positive.");
+  }
+
+  if (m_raw_frames_ && !m_shared_memory_name_.empty())
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - The raw frames aren't parsed, the shared memory can't be written.");
+  }
+
+  //
+  // A portable shared memory name is a single leading '/' followed by a file name, the '/' is added if missing.
+  //
+  if (!m_shared_memory_name_.empty())
+  {
+    if (m_shared_memory_name_.front() != '/')
+    {
+      m_shared_memory_name_.insert(0, 1, '/');
+    }
+
+    if ((m_shared_memory_name_.size() < 2) || (m_shared_memory_name_.size() > NAME_MAX) || (m_shared_memory_name_.find('/', 1) != std::string::npos))
+    {
+      rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - Invalid shared memory name " + m_shared_memory_name_ + ", expected a name without '/' after the leading one, up to " + std::to_string(NAME_MAX) + " characters.");
+    }
+  }
 }
 
 void ConfigStore::loadOdomParameters(const rclcpp::Node& ref_node_handle)
@@ -35,11 +79,102 @@ void ConfigStore::loadOdomParameters(const rclcpp::Node& ref_node_handle)
   ref_node_handle.get_parameter_or<std::string>("odometry.odomFrameId", m_odom_frame_id_      , "odom");
   ref_node_handle.get_parameter_or<std::string>("odometry.baseFrameId", m_odom_base_frame_id_ , "base_link");
   ref_node_handle.get_parameter_or<std::string>("odometry.initFrameId", m_odom_init_frame_id_ , "map");
+
+  m_odom_tf_rate_ = getParameter<uint32_t>(ref_node_handle, "odometry.tfRate", 0);
+
+  std::string odom_projection;
+
+  ref_node_handle.get_parameter_or<std::string>("odometry.projection", odom_projection, "utm");
+
+  if (odom_projection == "utm")
+  {
+    m_odom_projection_ = OdomProjection::UTM;
+  }
+  else if (odom_projection == "enu")
+  {
+    m_odom_projection_ = OdomProjection::ENU;
+  }
+  else
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "unknown odometry projection: " + odom_projection);
+  }
+}
+
+void ConfigStore::loadImuPreintegrationParameters(const rclcpp::Node& ref_node_handle)
+{
+  std::string trigger;
+
+  ref_node_handle.get_parameter_or<std::string>("imuPreintegration.trigger", trigger, "none");
+  ref_node_handle.get_parameter_or<double>("imuPreintegration.gyroNoiseDensity", m_gyro_noise_density_, 0.00005);
+  ref_node_handle.get_parameter_or<double>("imuPreintegration.accelNoiseDensity", m_accel_noise_density_, 0.0006);
+
+  m_preintegration_period_ = getParameter<uint32_t>(ref_node_handle, "imuPreintegration.period", 50);
+
+  if (trigger == "none")
+  {
+    m_preintegration_trigger_ = PreintegrationTrigger::NONE;
+  }
+  else if (trigger == "interval")
+  {
+    m_preintegration_trigger_ = PreintegrationTrigger::INTERVAL;
+  }
+  else if ((trigger.size() == 6) && (trigger.compare(0, 5, "event") == 0) && (trigger[5] >= 'A') && (trigger[5] <= 'E'))
+  {
+    m_preintegration_trigger_ = static_cast<PreintegrationTrigger>(static_cast<int>(PreintegrationTrigger::EVENT_A) + (trigger[5] - 'A'));
+  }
+  else
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "unknown IMU preintegration trigger: " + trigger);
+  }
+}
+
+void ConfigStore::loadDecimationParameters(const rclcpp::Node& ref_node_handle)
+{
+  m_sbg_imu_data_decimation_  = getParameter<uint32_t>(ref_node_handle, "decimation.sbgImuData", 0);
+  m_imu_decimation_           = getParameter<uint32_t>(ref_node_handle, "decimation.imu", 0);
+}
+
+void ConfigStore::loadRelayParameters(const rclcpp::Node& ref_node_handle)
+{
+  std::string relay_address;
+
+  ref_node_handle.get_parameter_or<std::string>("relay.multicastAddress", relay_address, "");
+
+  m_relay_address_            = relay_address.empty() ? SBG_IPV4_UNSPECIFIED_ADDR : sbgNetworkIpFromString(relay_address.c_str());
+  m_relay_port_               = getParameter<uint32_t>(ref_node_handle, "relay.port", 5000);
+  m_relay_max_datagram_size_  = getParameter<uint32_t>(ref_node_handle, "relay.maxDatagramSize", SBG_INTERFACE_UDP_PACKET_MAX_SIZE);
+
+  if (isRelayEnabled())
+  {
+    if (!sbgIpAddressIsMulticast(m_relay_address_))
+    {
+      rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - The relay address must be a multicast group.");
+    }
+
+    if ((m_relay_port_ == 0) || (m_relay_port_ > UINT16_MAX))
+    {
+      rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - Invalid relay port.");
+    }
+
+    if ((m_relay_max_datagram_size_ == 0) || (m_relay_max_datagram_size_ > SBG_INTERFACE_UDP_PACKET_MAX_SIZE))
+    {
+      rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - The relay datagram size must be within 1 and " + std::to_string(SBG_INTERFACE_UDP_PACKET_MAX_SIZE) + " bytes.");
+    }
+
+    //
+    // A driver receiving from a multicast group would relay the frames back to a group.
+    //
+    if (m_upd_communication_ && sbgIpAddressIsMulticast(m_sbg_ip_address_))
+    {
+      rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - Frames received from a multicast group can't be relayed.");
+    }
+  }
 }
 
 void ConfigStore::loadCommunicationParameters(const rclcpp::Node& ref_node_handle)
 {
   ref_node_handle.get_parameter_or<bool>("confWithRos", m_configure_through_ros_, false);
+  ref_node_handle.get_parameter_or<std::string>("confCacheFile", m_conf_cache_file_, "");
   
   if (ref_node_handle.has_parameter("uartConf.portName"))
   {
@@ -58,6 +193,14 @@ void ConfigStore::loadCommunicationParameters(const rclcpp::Node& ref_node_handl
     m_sbg_ip_address_     = sbgNetworkIpFromString(ip_address.c_str());
     m_out_port_address_   = getParameter<uint32_t>(ref_node_handle, "ipConf.out_port", 0);
     m_in_port_address_    = getParameter<uint32_t>(ref_node_handle, "ipConf.in_port", 0);
+
+    //
+    // A multicast group only carries the relayed frames, commands can't reach the device.
+    //
+    if (sbgIpAddressIsMulticast(m_sbg_ip_address_) && m_configure_through_ros_)
+    {
+      rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - A device received from a multicast group can't be configured.");
+    }
   }
   else
   {
@@ -225,6 +368,11 @@ bool ConfigStore::isInterfaceUdp(void) const
   return m_upd_communication_;
 }
 
+const std::string &ConfigStore::getConfigurationCacheFile(void) const
+{
+  return m_conf_cache_file_;
+}
+
 sbgIpAddress ConfigStore::getIpAddress(void) const
 {
   return m_sbg_ip_address_;
@@ -330,6 +478,71 @@ uint32_t ConfigStore::getReadingRateFrequency(void) const
   return m_rate_frequency_;
 }
 
+bool ConfigStore::getLazyParsing(void) const
+{
+  return m_lazy_parsing_;
+}
+
+bool ConfigStore::getFilterBeforeCrc(void) const
+{
+  return m_filter_before_crc_;
+}
+
+bool ConfigStore::getLatencyDiagnostics(void) const
+{
+  return m_latency_diagnostics_;
+}
+
+bool ConfigStore::getSequenceDiagnostics(void) const
+{
+  return m_sequence_diagnostics_;
+}
+
+bool ConfigStore::getSequenceLearnNewData(void) const
+{
+  return m_sequence_learn_new_data_;
+}
+
+uint32_t ConfigStore::getAlignmentMaxGap(void) const
+{
+  return m_alignment_max_gap_;
+}
+
+uint32_t ConfigStore::getPoseHistorySize(void) const
+{
+  return m_pose_history_size_;
+}
+
+bool ConfigStore::getEventPose(void) const
+{
+  return m_event_pose_;
+}
+
+bool ConfigStore::getStatusOnChange(void) const
+{
+  return m_status_on_change_;
+}
+
+uint32_t ConfigStore::getStatusHeartbeat(void) const
+{
+  return m_status_heartbeat_;
+}
+
+bool ConfigStore::getRawFrames(void) const
+{
+  return m_raw_frames_;
+}
+
+uint32_t ConfigStore::getRawFramesBatchSize(void) const
+{
+  return m_raw_frames_batch_size_;
+}
+
+const std::string &ConfigStore::getSharedMemoryName(void) const
+{
+  return m_shared_memory_name_;
+}
+
 const std::string &ConfigStore::getFrameId(void) const
 {
   return m_frame_id_;
@@ -355,6 +568,11 @@ bool ConfigStore::getOdomPublishTf(void) const
   return m_odom_publish_tf_;
 }
 
+uint32_t ConfigStore::getOdomTfRate(void) const
+{
+  return m_odom_tf_rate_;
+}
+
 const std::string &ConfigStore::getOdomFrameId(void) const
 {
   return m_odom_frame_id_;
@@ -370,6 +588,61 @@ const std::string &ConfigStore::getOdomInitFrameId(void) const
   return m_odom_init_frame_id_;
 }
 
+sbg::OdomProjection ConfigStore::getOdomProjection(void) const
+{
+  return m_odom_projection_;
+}
+
+sbg::PreintegrationTrigger ConfigStore::getPreintegrationTrigger(void) const
+{
+  return m_preintegration_trigger_;
+}
+
+uint32_t ConfigStore::getPreintegrationPeriod(void) const
+{
+  return m_preintegration_period_;
+}
+
+double ConfigStore::getGyroNoiseDensity(void) const
+{
+  return m_gyro_noise_density_;
+}
+
+double ConfigStore::getAccelNoiseDensity(void) const
+{
+  return m_accel_noise_density_;
+}
+
+uint32_t ConfigStore::getSbgImuDataDecimation(void) const
+{
+  return m_sbg_imu_data_decimation_;
+}
+
+uint32_t ConfigStore::getImuDecimation(void) const
+{
+  return m_imu_decimation_;
+}
+
+bool ConfigStore::isRelayEnabled(void) const
+{
+  return !sbgIpAddressIsUnspecified(m_relay_address_);
+}
+
+sbgIpAddress ConfigStore::getRelayAddress(void) const
+{
+  return m_relay_address_;
+}
+
+uint32_t ConfigStore::getRelayPort(void) const
+{
+  return m_relay_port_;
+}
+
+uint32_t ConfigStore::getRelayMaxDatagramSize(void) const
+{
+  return m_relay_max_datagram_size_;
+}
+
 //---------------------------------------------------------------------//
 //- Operations                                                        -//
 //---------------------------------------------------------------------//
@@ -378,7 +651,10 @@ void ConfigStore::loadFromRosNodeHandle(const rclcpp::Node& ref_node_handle)
 {
   loadDriverParameters(ref_node_handle);
   loadOdomParameters(ref_node_handle);
+  loadImuPreintegrationParameters(ref_node_handle);
+  loadDecimationParameters(ref_node_handle);
   loadCommunicationParameters(ref_node_handle);
+  loadRelayParameters(ref_node_handle);
   loadSensorParameters(ref_node_handle);
   loadImuAlignementParameters(ref_node_handle);
   loadAidingAssignementParameters(ref_node_handle);
@@ -410,6 +686,83 @@ void ConfigStore::loadFromRosNodeHandle(const rclcpp::Node& ref_node_handle)
   loadOutputConfiguration(ref_node_handle, "output.log_event_e", SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EVENT_E);
   loadOutputConfiguration(ref_node_handle, "output.log_air_data", SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_AIR_DATA);
   loadOutputConfiguration(ref_node_handle, "output.log_imu_short", SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_SHORT);
+  loadOutputConfiguration(ref_node_handle, "output.log_dvl_bottom_track", SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_DVL_BOTTOM_TRACK);
+  loadOutputConfiguration(ref_node_handle, "output.log_dvl_water_track", SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_DVL_WATER_TRACK);
+  loadOutputConfiguration(ref_node_handle, "output.log_usbl", SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_USBL);
+  loadOutputConfiguration(ref_node_handle, "output.log_depth", SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_DEPTH);
+  loadOutputConfiguration(ref_node_handle, "output.log_event_out_a", SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EVENT_OUT_A);
+  loadOutputConfiguration(ref_node_handle, "output.log_event_out_b", SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EVENT_OUT_B);
+  loadOutputConfiguration(ref_node_handle, "output.log_diag", SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_DIAG);
 
   ref_node_handle.get_parameter_or<bool>("output.ros_standard", m_ros_standard_output_, false);
 }
+
+uint64_t ConfigStore::computeDeviceConfigHash(void) const
+{
+  uint64_t hash = hashBuffer(nullptr, 0);
+
+  //
+  // Hash each field on its own so structure padding never changes the result.
+  //
+  hash = hashValue(hash, m_output_port_);
+
+  hash = hashValue(hash, m_init_condition_conf_.latitude);
+  hash = hashValue(hash, m_init_condition_conf_.longitude);
+  hash = hashValue(hash, m_init_condition_conf_.altitude);
+  hash = hashValue(hash, m_init_condition_conf_.year);
+  hash = hashValue(hash, m_init_condition_conf_.month);
+  hash = hashValue(hash, m_init_condition_conf_.day);
+  hash = hashValue(hash, m_motion_profile_model_info_.id);
+
+  hash = hashValue(hash, m_sensor_alignement_info_.axisDirectionX);
+  hash = hashValue(hash, m_sensor_alignement_info_.axisDirectionY);
+  hash = hashValue(hash, m_sensor_alignement_info_.misRoll);
+  hash = hashValue(hash, m_sensor_alignement_info_.misPitch);
+  hash = hashValue(hash, m_sensor_alignement_info_.misYaw);
+  hash = hashBuffer(m_sensor_lever_arm_.data(), 3 * sizeof(float), hash);
+
+  hash = hashValue(hash, m_aiding_assignement_conf_.gps1Port);
+  hash = hashValue(hash, m_aiding_assignement_conf_.gps1Sync);
+  hash = hashValue(hash, m_aiding_assignement_conf_.rtcmPort);
+  hash = hashValue(hash, m_aiding_assignement_conf_.odometerPinsConf);
+
+  hash = hashValue(hash, m_mag_model_info_.id);
+  hash = hashValue(hash, m_mag_rejection_conf_.magneticField);
+
+  hash = hashValue(hash, m_gnss_model_info_.id);
+  hash = hashBuffer(m_gnss_installation_.leverArmPrimary, sizeof(m_gnss_installation_.leverArmPrimary), hash);
+  hash = hashValue(hash, m_gnss_installation_.leverArmPrimaryPrecise);
+  hash = hashBuffer(m_gnss_installation_.leverArmSecondary, sizeof(m_gnss_installation_.leverArmSecondary), hash);
+  hash = hashValue(hash, m_gnss_installation_.leverArmSecondaryMode);
+  hash = hashValue(hash, m_gnss_rejection_conf_.position);
+  hash = hashValue(hash, m_gnss_rejection_conf_.velocity);
+  hash = hashValue(hash, m_gnss_rejection_conf_.hdt);
+
+  hash = hashValue(hash, m_odometer_conf_.gain);
+  hash = hashValue(hash, m_odometer_conf_.gainError);
+  hash = hashValue(hash, m_odometer_conf_.reverseMode);
+  hash = hashBuffer(m_odometer_level_arm_.data(), 3 * sizeof(float), hash);
+  hash = hashValue(hash, m_odometer_rejection_conf_.velocity);
+
+  for (const SbgLogOutput& ref_output : m_output_modes_)
+  {
+    hash = hashValue(hash, ref_output.message_class);
+    hash = hashValue(hash, ref_output.message_id);
+    hash = hashValue(hash, ref_output.output_mode);
+  }
+
+  return hash;
+}
+
+uint64_t ConfigStore::hashBuffer(const void *p_buffer, size_t size, uint64_t hash)
+{
+  const uint8_t *p_bytes = static_cast<const uint8_t*>(p_buffer);
+
+  for (size_t i = 0; i < size; i++)
+  {
+    hash ^= p_bytes[i];
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
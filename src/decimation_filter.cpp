@@ -0,0 +1,220 @@
+// File header
+#include "decimation_filter.h"
+
+// Standard headers
+#include <cmath>
+
+// SbgECom headers
+#include <sbgCommon.h>
+
+using sbg::DecimationFilter;
+
+/*!
+ * Number of filter taps per decimation factor, the filter has 16 * factor + 1 taps.
+ */
+#define SBG_DECIMATION_TAPS_PER_FACTOR  (16)
+
+/*!
+ * Filter cut-off frequency, relative to the output sampling frequency.
+ */
+#define SBG_DECIMATION_CUTOFF           (0.4)
+
+//---------------------------------------------------------------------//
+//- Message values                                                    -//
+//---------------------------------------------------------------------//
+
+std::array<double, SBG_DECIMATION_IMU_DATA_VALUES> sbg::getDecimatedValues(const sbg_driver::msg::SbgImuData &ref_message)
+{
+  return {{ ref_message.accel.x, ref_message.accel.y, ref_message.accel.z,
+            ref_message.gyro.x, ref_message.gyro.y, ref_message.gyro.z,
+            ref_message.temp,
+            ref_message.delta_vel.x, ref_message.delta_vel.y, ref_message.delta_vel.z,
+            ref_message.delta_angle.x, ref_message.delta_angle.y, ref_message.delta_angle.z }};
+}
+
+void sbg::setDecimatedValues(const std::array<double, SBG_DECIMATION_IMU_DATA_VALUES> &ref_values, sbg_driver::msg::SbgImuData &ref_message)
+{
+  ref_message.accel.x       = ref_values[0];
+  ref_message.accel.y       = ref_values[1];
+  ref_message.accel.z       = ref_values[2];
+  ref_message.gyro.x        = ref_values[3];
+  ref_message.gyro.y        = ref_values[4];
+  ref_message.gyro.z        = ref_values[5];
+  ref_message.temp          = static_cast<float>(ref_values[6]);
+  ref_message.delta_vel.x   = ref_values[7];
+  ref_message.delta_vel.y   = ref_values[8];
+  ref_message.delta_vel.z   = ref_values[9];
+  ref_message.delta_angle.x = ref_values[10];
+  ref_message.delta_angle.y = ref_values[11];
+  ref_message.delta_angle.z = ref_values[12];
+}
+
+std::array<double, SBG_DECIMATION_IMU_VALUES> sbg::getDecimatedValues(const sensor_msgs::msg::Imu &ref_message)
+{
+  return {{ ref_message.angular_velocity.x, ref_message.angular_velocity.y, ref_message.angular_velocity.z,
+            ref_message.linear_acceleration.x, ref_message.linear_acceleration.y, ref_message.linear_acceleration.z }};
+}
+
+void sbg::setDecimatedValues(const std::array<double, SBG_DECIMATION_IMU_VALUES> &ref_values, sensor_msgs::msg::Imu &ref_message)
+{
+  ref_message.angular_velocity.x    = ref_values[0];
+  ref_message.angular_velocity.y    = ref_values[1];
+  ref_message.angular_velocity.z    = ref_values[2];
+  ref_message.linear_acceleration.x = ref_values[3];
+  ref_message.linear_acceleration.y = ref_values[4];
+  ref_message.linear_acceleration.z = ref_values[5];
+}
+
+/*!
+ * Low-pass FIR filter computing one output every decimation factor inputs.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+DecimationFilter::DecimationFilter(void):
+m_factor_(0),
+m_value_count_(0),
+m_tap_count_(0),
+m_position_(0),
+m_input_count_(0),
+m_phase_(0)
+{
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+void DecimationFilter::setFactor(uint32_t factor, size_t value_count)
+{
+  double  cutoff;
+  double  sum;
+
+  m_factor_       = factor;
+  m_value_count_  = value_count;
+
+  if (!isEnabled())
+  {
+    m_tap_count_ = 0;
+    m_coefficients_.clear();
+    m_history_.clear();
+    reset();
+    return;
+  }
+
+  m_tap_count_  = SBG_DECIMATION_TAPS_PER_FACTOR * factor + 1;
+  cutoff        = SBG_DECIMATION_CUTOFF / factor;
+  sum           = 0.0;
+
+  m_coefficients_.resize(m_tap_count_);
+  m_history_.assign(2 * m_tap_count_ * m_value_count_, 0.0);
+
+  //
+  // Windowed sinc with a Blackman window, normalized for a unit static gain.
+  //
+  for (size_t i = 0; i < m_tap_count_; i++)
+  {
+    double offset;
+    double window;
+
+    offset = static_cast<double>(i) - static_cast<double>(m_tap_count_ - 1) / 2.0;
+    window = 0.42 - 0.5 * std::cos(2.0 * SBG_PI * i / (m_tap_count_ - 1)) + 0.08 * std::cos(4.0 * SBG_PI * i / (m_tap_count_ - 1));
+
+    if (offset == 0.0)
+    {
+      m_coefficients_[i] = 2.0 * cutoff;
+    }
+    else
+    {
+      m_coefficients_[i] = std::sin(2.0 * SBG_PI * cutoff * offset) / (SBG_PI * offset);
+    }
+
+    m_coefficients_[i] *= window;
+    sum += m_coefficients_[i];
+  }
+
+  for (double &ref_coefficient : m_coefficients_)
+  {
+    ref_coefficient /= sum;
+  }
+
+  reset();
+}
+
+bool DecimationFilter::isEnabled(void) const
+{
+  return m_factor_ > 1;
+}
+
+size_t DecimationFilter::getDelay(void) const
+{
+  return m_tap_count_ / 2;
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void DecimationFilter::reset(void)
+{
+  m_position_     = 0;
+  m_input_count_  = 0;
+  m_phase_        = 0;
+}
+
+bool DecimationFilter::push(const double *p_input, double *p_output)
+{
+  const double  *p_window;
+
+  if (!isEnabled())
+  {
+    return false;
+  }
+
+  //
+  // Store the input twice, so the window always starts at the oldest input without wrapping.
+  //
+  for (size_t i = 0; i < m_value_count_; i++)
+  {
+    m_history_[m_position_ * m_value_count_ + i]                  = p_input[i];
+    m_history_[(m_position_ + m_tap_count_) * m_value_count_ + i] = p_input[i];
+  }
+
+  m_position_ = (m_position_ + 1) % m_tap_count_;
+
+  if (m_input_count_ < m_tap_count_)
+  {
+    m_input_count_++;
+  }
+
+  m_phase_ = (m_phase_ + 1) % m_factor_;
+
+  if ((m_input_count_ < m_tap_count_) || (m_phase_ != 0))
+  {
+    return false;
+  }
+
+  //
+  // The filter is symmetric, so the window order doesn't matter.
+  //
+  p_window = &m_history_[m_position_ * m_value_count_];
+
+  for (size_t i = 0; i < m_value_count_; i++)
+  {
+    p_output[i] = 0.0;
+  }
+
+  for (size_t tap = 0; tap < m_tap_count_; tap++)
+  {
+    const double  coefficient = m_coefficients_[tap];
+    const double  *p_values   = p_window + tap * m_value_count_;
+
+    for (size_t i = 0; i < m_value_count_; i++)
+    {
+      p_output[i] += coefficient * p_values[i];
+    }
+  }
+
+  return true;
+}
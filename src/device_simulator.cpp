@@ -0,0 +1,963 @@
+// File header
+#include "device_simulator.h"
+
+// Standard headers
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+// Unix headers
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+// SbgECom headers
+#include <commands/transfer/sbgEComTransfer.h>
+#include <interfaces/sbgInterfaceUdp.h>
+#include <version/sbgVersion.h>
+
+using sbg::DeviceSimulator;
+
+namespace
+{
+/*!
+ * Simulated log name.
+ */
+struct SimulatedLogName
+{
+  const char    *p_name;
+  SbgEComMsgId  msg_id;
+};
+
+/*!
+ * Logs that can be simulated, named as in the driver output configuration.
+ */
+const SimulatedLogName SIMULATED_LOGS[] =
+{
+  { "status",     SBG_ECOM_LOG_STATUS     },
+  { "utc_time",   SBG_ECOM_LOG_UTC_TIME   },
+  { "imu_data",   SBG_ECOM_LOG_IMU_DATA   },
+  { "ekf_euler",  SBG_ECOM_LOG_EKF_EULER  },
+  { "ekf_quat",   SBG_ECOM_LOG_EKF_QUAT   },
+  { "ekf_nav",    SBG_ECOM_LOG_EKF_NAV    },
+  { "mag",        SBG_ECOM_LOG_MAG        },
+  { "gps1_vel",   SBG_ECOM_LOG_GPS1_VEL   },
+  { "gps1_pos",   SBG_ECOM_LOG_GPS1_POS   },
+  { "gps1_hdt",   SBG_ECOM_LOG_GPS1_HDT   },
+};
+
+/*!
+ * Settings stored as raw payloads, with the size of their default payload.
+ */
+const std::pair<uint8_t, size_t> STORED_SETTINGS[] =
+{
+  { SBG_ECOM_CMD_INIT_PARAMETERS,           28  },
+  { SBG_ECOM_CMD_IMU_ALIGNMENT_LEVER_ARM,   26  },
+  { SBG_ECOM_CMD_AIDING_ASSIGNMENT,         11  },
+  { SBG_ECOM_CMD_MAGNETOMETER_REJECT_MODE,  1   },
+  { SBG_ECOM_CMD_GNSS_1_INSTALLATION,       26  },
+  { SBG_ECOM_CMD_GNSS_1_REJECT_MODES,       4   },
+  { SBG_ECOM_CMD_ODO_CONF,                  6   },
+  { SBG_ECOM_CMD_ODO_LEVER_ARM,             12  },
+  { SBG_ECOM_CMD_ODO_REJECT_MODE,           1   },
+};
+
+/*!
+ * Model settings, answered with the model id and its revision.
+ */
+const uint8_t MODEL_SETTINGS[] =
+{
+  SBG_ECOM_CMD_MOTION_PROFILE_ID,
+  SBG_ECOM_CMD_MAGNETOMETER_MODEL_ID,
+  SBG_ECOM_CMD_GNSS_1_MODEL_ID,
+};
+
+/*!
+ * Synthetic trajectory, a constant speed circle around a fixed origin.
+ */
+constexpr double    ORIGIN_LATITUDE     = 48.8566;
+constexpr double    ORIGIN_LONGITUDE    = 2.3522;
+constexpr double    ORIGIN_ALTITUDE     = 35.0;
+constexpr double    CIRCLE_RADIUS       = 50.0;
+constexpr double    ANGULAR_RATE        = 0.1;
+constexpr double    EARTH_RADIUS        = 6378137.0;
+constexpr double    GRAVITY             = 9.81;
+
+/*!
+ * Rate of a log when the output mode does not define one (Hz).
+ */
+constexpr double    NEW_DATA_RATE       = 5.0;
+
+/*!
+ * Main loop frequency of a real device (Hz).
+ */
+constexpr double    MAIN_LOOP_RATE      = 200.0;
+
+/*!
+ * Number of garbage bytes injected before a corrupted frame.
+ */
+constexpr size_t    GARBAGE_SIZE        = 16;
+
+/*!
+ * Check if a log can be simulated.
+ *
+ * \param[in] msg_id            Log id.
+ * \return                      True if the log is simulated.
+ */
+bool isSimulatedLog(SbgEComMsgId msg_id)
+{
+  for (const auto &ref_log : SIMULATED_LOGS)
+  {
+    if (ref_log.msg_id == msg_id)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/*!
+ * Write the payload of a simulated log at the given device time.
+ *
+ * \param[in] msg_id            Log id.
+ * \param[in] device_time       Device time (us).
+ * \param[in] ref_stream        Output stream.
+ * \return                      True if the log is simulated.
+ */
+bool writeSimulatedLog(SbgEComMsgId msg_id, uint64_t device_time, SbgStreamBuffer &ref_stream)
+{
+  double    time_s        = device_time * 1e-6;
+  double    angle         = ANGULAR_RATE * time_s;
+  double    speed         = CIRCLE_RADIUS * ANGULAR_RATE;
+  double    north         = CIRCLE_RADIUS * std::sin(angle);
+  double    east          = CIRCLE_RADIUS * (1.0 - std::cos(angle));
+  float     velocity[3]   = { static_cast<float>(speed * std::cos(angle)), static_cast<float>(speed * std::sin(angle)), 0.0f };
+  double    yaw           = std::remainder(angle, 2.0 * SBG_PI);
+  double    course        = sbgRadToDegD(yaw < 0.0 ? yaw + 2.0 * SBG_PI : yaw);
+  double    latitude      = ORIGIN_LATITUDE + sbgRadToDegD(north / EARTH_RADIUS);
+  double    longitude     = ORIGIN_LONGITUDE + sbgRadToDegD(east / (EARTH_RADIUS * std::cos(sbgDegToRadD(ORIGIN_LATITUDE))));
+  uint32_t  time_stamp    = static_cast<uint32_t>(device_time);
+  uint32_t  time_of_week  = static_cast<uint32_t>((device_time / 1000) % (7 * 24 * 3600 * 1000ULL));
+  uint32_t  ekf_status    = sbgEComLogEkfBuildSolutionStatus(SBG_ECOM_SOL_MODE_NAV_POSITION, SBG_ECOM_SOL_ATTITUDE_VALID | SBG_ECOM_SOL_HEADING_VALID | SBG_ECOM_SOL_VELOCITY_VALID | SBG_ECOM_SOL_POSITION_VALID);
+
+  switch (msg_id)
+  {
+  case SBG_ECOM_LOG_STATUS:
+    {
+      SbgLogStatusData status_data = {};
+
+      status_data.timeStamp     = time_stamp;
+      status_data.generalStatus = SBG_ECOM_GENERAL_MAIN_POWER_OK | SBG_ECOM_GENERAL_IMU_POWER_OK | SBG_ECOM_GENERAL_GPS_POWER_OK | SBG_ECOM_GENERAL_SETTINGS_OK | SBG_ECOM_GENERAL_TEMPERATURE_OK;
+      status_data.uptime        = static_cast<uint32_t>(time_s);
+
+      sbgEComBinaryLogWriteStatusData(&ref_stream, &status_data);
+    }
+    return true;
+
+  case SBG_ECOM_LOG_UTC_TIME:
+    {
+      SbgLogUtcData utc_data  = {};
+      uint64_t      second    = device_time / 1000000;
+
+      utc_data.timeStamp      = time_stamp;
+      utc_data.status         = sbgEComLogUtcBuildClockStatus(SBG_ECOM_CLOCK_VALID, SBG_ECOM_UTC_VALID, 0);
+      utc_data.year           = 2026;
+      utc_data.month          = 10;
+      utc_data.day            = 18;
+      utc_data.hour           = static_cast<int8_t>((second / 3600) % 24);
+      utc_data.minute         = static_cast<int8_t>((second / 60) % 60);
+      utc_data.second         = static_cast<int8_t>(second % 60);
+      utc_data.nanoSecond     = static_cast<int32_t>((device_time % 1000000) * 1000);
+      utc_data.gpsTimeOfWeek  = time_of_week;
+
+      sbgEComBinaryLogWriteUtcData(&ref_stream, &utc_data);
+    }
+    return true;
+
+  case SBG_ECOM_LOG_IMU_DATA:
+    {
+      SbgLogImuData imu_data = {};
+
+      imu_data.timeStamp          = time_stamp;
+      imu_data.status             = SBG_ECOM_IMU_COM_OK | SBG_ECOM_IMU_STATUS_BIT;
+      imu_data.accelerometers[1]  = static_cast<float>(speed * ANGULAR_RATE);
+      imu_data.accelerometers[2]  = static_cast<float>(-GRAVITY);
+      imu_data.gyroscopes[2]      = static_cast<float>(ANGULAR_RATE);
+      imu_data.temperature        = 25.0f;
+
+      for (size_t i = 0; i < 3; i++)
+      {
+        imu_data.deltaVelocity[i] = imu_data.accelerometers[i];
+        imu_data.deltaAngle[i]    = imu_data.gyroscopes[i];
+      }
+
+      sbgEComBinaryLogWriteImuData(&ref_stream, &imu_data);
+    }
+    return true;
+
+  case SBG_ECOM_LOG_EKF_EULER:
+    {
+      SbgLogEkfEulerData euler_data = {};
+
+      euler_data.timeStamp  = time_stamp;
+      euler_data.euler[2]   = static_cast<float>(yaw);
+      euler_data.status     = ekf_status;
+
+      for (size_t i = 0; i < 3; i++)
+      {
+        euler_data.eulerStdDev[i] = 0.01f;
+      }
+
+      sbgEComBinaryLogWriteEkfEulerData(&ref_stream, &euler_data);
+    }
+    return true;
+
+  case SBG_ECOM_LOG_EKF_QUAT:
+    {
+      SbgLogEkfQuatData quat_data = {};
+
+      quat_data.timeStamp     = time_stamp;
+      quat_data.quaternion[0] = static_cast<float>(std::cos(yaw / 2.0));
+      quat_data.quaternion[3] = static_cast<float>(std::sin(yaw / 2.0));
+      quat_data.status        = ekf_status;
+
+      for (size_t i = 0; i < 3; i++)
+      {
+        quat_data.eulerStdDev[i] = 0.01f;
+      }
+
+      sbgEComBinaryLogWriteEkfQuatData(&ref_stream, &quat_data);
+    }
+    return true;
+
+  case SBG_ECOM_LOG_EKF_NAV:
+    {
+      SbgLogEkfNavData nav_data = {};
+
+      nav_data.timeStamp    = time_stamp;
+      nav_data.position[0]  = latitude;
+      nav_data.position[1]  = longitude;
+      nav_data.position[2]  = ORIGIN_ALTITUDE;
+      nav_data.undulation   = 47.0f;
+      nav_data.status       = ekf_status;
+
+      for (size_t i = 0; i < 3; i++)
+      {
+        nav_data.velocity[i]        = velocity[i];
+        nav_data.velocityStdDev[i]  = 0.05f;
+        nav_data.positionStdDev[i]  = 0.5f;
+      }
+
+      sbgEComBinaryLogWriteEkfNavData(&ref_stream, &nav_data);
+    }
+    return true;
+
+  case SBG_ECOM_LOG_MAG:
+    {
+      SbgLogMag mag_data = {};
+
+      mag_data.timeStamp          = time_stamp;
+      mag_data.status             = SBG_ECOM_MAG_CALIBRATION_OK;
+      mag_data.magnetometers[0]   = static_cast<float>(std::cos(yaw));
+      mag_data.magnetometers[1]   = static_cast<float>(-std::sin(yaw));
+      mag_data.accelerometers[2]  = static_cast<float>(-GRAVITY);
+
+      sbgEComBinaryLogWriteMagData(&ref_stream, &mag_data);
+    }
+    return true;
+
+  case SBG_ECOM_LOG_GPS1_VEL:
+    {
+      SbgLogGpsVel gps_vel_data = {};
+
+      gps_vel_data.timeStamp  = time_stamp;
+      gps_vel_data.status     = sbgEComLogGpsVelBuildStatus(SBG_ECOM_VEL_SOL_COMPUTED, SBG_ECOM_VEL_DOPPLER);
+      gps_vel_data.timeOfWeek = time_of_week;
+      gps_vel_data.course     = static_cast<float>(course);
+      gps_vel_data.courseAcc  = 0.5f;
+
+      for (size_t i = 0; i < 3; i++)
+      {
+        gps_vel_data.velocity[i]    = velocity[i];
+        gps_vel_data.velocityAcc[i] = 0.1f;
+      }
+
+      sbgEComBinaryLogWriteGpsVelData(&ref_stream, &gps_vel_data);
+    }
+    return true;
+
+  case SBG_ECOM_LOG_GPS1_POS:
+    {
+      SbgLogGpsPos gps_pos_data = {};
+
+      gps_pos_data.timeStamp          = time_stamp;
+      gps_pos_data.status             = sbgEComLogGpsPosBuildStatus(SBG_ECOM_POS_SOL_COMPUTED, SBG_ECOM_POS_RTK_INT, 0);
+      gps_pos_data.timeOfWeek         = time_of_week;
+      gps_pos_data.latitude           = latitude;
+      gps_pos_data.longitude          = longitude;
+      gps_pos_data.altitude           = ORIGIN_ALTITUDE;
+      gps_pos_data.undulation         = 47.0f;
+      gps_pos_data.latitudeAccuracy   = 0.02f;
+      gps_pos_data.longitudeAccuracy  = 0.02f;
+      gps_pos_data.altitudeAccuracy   = 0.04f;
+      gps_pos_data.numSvUsed          = 18;
+      gps_pos_data.baseStationId      = 1;
+      gps_pos_data.differentialAge    = 100;
+
+      sbgEComBinaryLogWriteGpsPosData(&ref_stream, &gps_pos_data);
+    }
+    return true;
+
+  case SBG_ECOM_LOG_GPS1_HDT:
+    {
+      SbgLogGpsHdt gps_hdt_data = {};
+
+      gps_hdt_data.timeStamp        = time_stamp;
+      gps_hdt_data.status           = sbgEComLogGpsHdtBuildStatus(SBG_ECOM_HDT_SOL_COMPUTED, 0);
+      gps_hdt_data.timeOfWeek       = time_of_week;
+      gps_hdt_data.heading          = static_cast<float>(course);
+      gps_hdt_data.headingAccuracy  = 0.2f;
+      gps_hdt_data.pitchAccuracy    = 0.4f;
+      gps_hdt_data.baseline         = 1.0f;
+
+      sbgEComBinaryLogWriteGpsHdtData(&ref_stream, &gps_hdt_data);
+    }
+    return true;
+
+  default:
+    return false;
+  }
+}
+}
+
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+DeviceSimulator::DeviceSimulator(const Config &ref_config):
+m_config_(ref_config),
+m_pty_master_(-1),
+m_pty_slave_(-1),
+m_generator_(ref_config.serial_number),
+m_last_flush_time_(0),
+m_frames_sent_(0),
+m_frames_corrupted_(0),
+m_commands_received_(0),
+m_bytes_sent_(0),
+m_bytes_dropped_(0)
+{
+  for (const auto &ref_log_rate : m_config_.log_rates)
+  {
+    m_logs_[ref_log_rate.first].rate      = ref_log_rate.second;
+    m_logs_[ref_log_rate.first].next_time = 0;
+  }
+
+  initSettings();
+
+  if (m_config_.use_udp)
+  {
+    openUdp();
+  }
+  else
+  {
+    openPty();
+  }
+
+  if (sbgEComProtocolInit(&m_protocol_, &m_interface_) != SBG_NO_ERROR)
+  {
+    throw std::runtime_error("SBG_SIMULATOR - Unable to initialize the protocol.");
+  }
+
+  m_start_time_ = Clock::now();
+}
+
+DeviceSimulator::~DeviceSimulator(void)
+{
+  sbgEComProtocolClose(&m_protocol_);
+
+  if (m_config_.use_udp)
+  {
+    sbgInterfaceUdpDestroy(&m_interface_);
+  }
+  else
+  {
+    close(m_pty_master_);
+    close(m_pty_slave_);
+
+    if (!m_config_.pty_link.empty())
+    {
+      unlink(m_config_.pty_link.c_str());
+    }
+  }
+}
+
+//---------------------------------------------------------------------//
+//- Private methods                                                   -//
+//---------------------------------------------------------------------//
+
+void DeviceSimulator::openPty(void)
+{
+  struct termios  options;
+  const char      *p_slave_name;
+
+  m_pty_master_ = posix_openpt(O_RDWR | O_NOCTTY);
+
+  if ((m_pty_master_ < 0) || (grantpt(m_pty_master_) != 0) || (unlockpt(m_pty_master_) != 0))
+  {
+    throw std::runtime_error("SBG_SIMULATOR - Unable to open a pseudo terminal.");
+  }
+
+  p_slave_name = ptsname(m_pty_master_);
+
+  //
+  // Keep the slave side open in raw mode, so it does not echo the driver commands and the master
+  // does not report an error while the driver is not connected.
+  //
+  m_pty_slave_ = open(p_slave_name, O_RDWR | O_NOCTTY);
+
+  if ((m_pty_slave_ < 0) || (tcgetattr(m_pty_slave_, &options) != 0))
+  {
+    throw std::runtime_error("SBG_SIMULATOR - Unable to open the pseudo terminal slave.");
+  }
+
+  cfmakeraw(&options);
+  tcsetattr(m_pty_slave_, TCSANOW, &options);
+  fcntl(m_pty_master_, F_SETFL, fcntl(m_pty_master_, F_GETFL) | O_NONBLOCK);
+
+  if (!m_config_.pty_link.empty())
+  {
+    unlink(m_config_.pty_link.c_str());
+
+    if (symlink(p_slave_name, m_config_.pty_link.c_str()) != 0)
+    {
+      throw std::runtime_error("SBG_SIMULATOR - Unable to create the link " + m_config_.pty_link + ": " + strerror(errno));
+    }
+  }
+
+  sbgInterfaceZeroInit(&m_interface_);
+
+  m_interface_.handle     = this;
+  m_interface_.type       = SBG_IF_TYPE_LAST_RESERVED + 1;
+  m_interface_.pWriteFunc = ptyWrite;
+  m_interface_.pReadFunc  = ptyRead;
+
+  sbgInterfaceNameSet(&m_interface_, p_slave_name);
+
+  printf("SBG_SIMULATOR - Device available on %s\n", m_config_.pty_link.empty() ? p_slave_name : m_config_.pty_link.c_str());
+}
+
+void DeviceSimulator::openUdp(void)
+{
+  if (sbgInterfaceUdpCreate(&m_interface_, m_config_.udp_address, m_config_.udp_out_port, m_config_.udp_in_port) != SBG_NO_ERROR)
+  {
+    throw std::runtime_error("SBG_SIMULATOR - Unable to open the UDP interface.");
+  }
+
+  printf("SBG_SIMULATOR - Device sending to port %u and listening on port %u\n", m_config_.udp_out_port, m_config_.udp_in_port);
+}
+
+SbgErrorCode DeviceSimulator::ptyWrite(SbgInterface *p_handle, const void *p_buffer, size_t bytes_to_write)
+{
+  DeviceSimulator *p_simulator  = static_cast<DeviceSimulator *>(p_handle->handle);
+  const uint8_t   *p_data       = static_cast<const uint8_t *>(p_buffer);
+
+  while (bytes_to_write > 0)
+  {
+    ssize_t written = write(p_simulator->m_pty_master_, p_data, bytes_to_write);
+
+    if (written < 0)
+    {
+      if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+      {
+        //
+        // The driver does not read fast enough, the remaining bytes are lost as on a real serial link.
+        //
+        p_simulator->m_bytes_dropped_ += bytes_to_write;
+        break;
+      }
+      else if (errno != EINTR)
+      {
+        return SBG_WRITE_ERROR;
+      }
+    }
+    else
+    {
+      p_data          += written;
+      bytes_to_write  -= static_cast<size_t>(written);
+    }
+  }
+
+  return SBG_NO_ERROR;
+}
+
+SbgErrorCode DeviceSimulator::ptyRead(SbgInterface *p_handle, void *p_buffer, size_t *p_read_bytes, size_t bytes_to_read)
+{
+  DeviceSimulator *p_simulator  = static_cast<DeviceSimulator *>(p_handle->handle);
+  ssize_t         read_bytes    = read(p_simulator->m_pty_master_, p_buffer, bytes_to_read);
+
+  if (read_bytes < 0)
+  {
+    *p_read_bytes = 0;
+
+    if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+    {
+      return SBG_NO_ERROR;
+    }
+
+    return SBG_READ_ERROR;
+  }
+
+  *p_read_bytes = static_cast<size_t>(read_bytes);
+
+  return SBG_NO_ERROR;
+}
+
+void DeviceSimulator::initSettings(void)
+{
+  for (const auto &ref_setting : STORED_SETTINGS)
+  {
+    m_settings_[ref_setting.first] = std::vector<uint8_t>(ref_setting.second, 0);
+  }
+
+  for (uint8_t model_cmd : MODEL_SETTINGS)
+  {
+    m_settings_[model_cmd] = std::vector<uint8_t>{ 1, 0, 0, 0 };
+  }
+}
+
+uint64_t DeviceSimulator::getDeviceTime(void) const
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_start_time_).count());
+}
+
+void DeviceSimulator::setLogOutputMode(SbgEComMsgId msg_id, SbgEComOutputMode output_mode)
+{
+  double rate;
+
+  if (!isSimulatedLog(msg_id))
+  {
+    return;
+  }
+
+  if ((output_mode >= SBG_ECOM_OUTPUT_MODE_MAIN_LOOP) && (output_mode <= SBG_ECOM_OUTPUT_MODE_DIV_200))
+  {
+    rate = MAIN_LOOP_RATE / output_mode;
+  }
+  else if (output_mode == SBG_ECOM_OUTPUT_MODE_HIGH_FREQ_LOOP)
+  {
+    rate = 1000.0;
+  }
+  else if (output_mode == SBG_ECOM_OUTPUT_MODE_PPS)
+  {
+    rate = 1.0;
+  }
+  else if (output_mode == SBG_ECOM_OUTPUT_MODE_NEW_DATA)
+  {
+    rate = NEW_DATA_RATE;
+  }
+  else
+  {
+    rate = 0.0;
+  }
+
+  m_logs_[msg_id].rate      = rate;
+  m_logs_[msg_id].next_time = getDeviceTime();
+}
+
+SbgEComOutputMode DeviceSimulator::getLogOutputMode(SbgEComMsgId msg_id) const
+{
+  auto it = m_logs_.find(msg_id);
+
+  if ((it == m_logs_.end()) || (it->second.rate <= 0.0))
+  {
+    return SBG_ECOM_OUTPUT_MODE_DISABLED;
+  }
+  else if (it->second.rate > MAIN_LOOP_RATE)
+  {
+    return SBG_ECOM_OUTPUT_MODE_HIGH_FREQ_LOOP;
+  }
+
+  double divider = MAIN_LOOP_RATE / it->second.rate;
+
+  if ((divider <= SBG_ECOM_OUTPUT_MODE_DIV_200) && (std::fabs(divider - std::round(divider)) < 1e-6))
+  {
+    return static_cast<SbgEComOutputMode>(static_cast<int>(std::round(divider)));
+  }
+
+  return SBG_ECOM_OUTPUT_MODE_NEW_DATA;
+}
+
+std::vector<uint8_t> DeviceSimulator::serializeSettings(void) const
+{
+  std::vector<uint8_t> settings;
+
+  for (const auto &ref_setting : m_settings_)
+  {
+    settings.push_back(ref_setting.first);
+    settings.push_back(static_cast<uint8_t>(ref_setting.second.size()));
+    settings.insert(settings.end(), ref_setting.second.begin(), ref_setting.second.end());
+  }
+
+  for (const auto &ref_log : m_logs_)
+  {
+    uint16_t output_mode = static_cast<uint16_t>(getLogOutputMode(ref_log.first));
+
+    settings.push_back(static_cast<uint8_t>(ref_log.first));
+    settings.push_back(static_cast<uint8_t>(output_mode & 0xFF));
+    settings.push_back(static_cast<uint8_t>(output_mode >> 8));
+  }
+
+  return settings;
+}
+
+void DeviceSimulator::queueLog(SbgEComMsgId msg_id, uint64_t device_time)
+{
+  uint8_t                                 frame[SBG_ECOM_MAX_BUFFER_SIZE];
+  SbgStreamBuffer                         stream;
+  size_t                                  cursor;
+  size_t                                  frame_size;
+  std::uniform_real_distribution<double>  ratio_distribution(0.0, 1.0);
+  std::uniform_int_distribution<int>      byte_distribution(0, 255);
+
+  sbgStreamBufferInitForWrite(&stream, frame, sizeof(frame));
+  sbgEComStartFrameGeneration(&stream, SBG_ECOM_CLASS_LOG_ECOM_0, msg_id, &cursor);
+
+  if (!writeSimulatedLog(msg_id, device_time, stream) || (sbgEComFinalizeFrameGeneration(&stream, cursor) != SBG_NO_ERROR))
+  {
+    return;
+  }
+
+  frame_size = sbgStreamBufferGetLength(&stream);
+
+  if ((m_config_.corruption_ratio > 0.0) && (ratio_distribution(m_generator_) < m_config_.corruption_ratio))
+  {
+    m_frames_corrupted_++;
+
+    if (ratio_distribution(m_generator_) < 0.5)
+    {
+      for (size_t i = 0; i < GARBAGE_SIZE; i++)
+      {
+        m_tx_buffer_.push_back(static_cast<uint8_t>(byte_distribution(m_generator_)));
+      }
+
+      m_tx_frame_sizes_.push_back(GARBAGE_SIZE);
+    }
+    else
+    {
+      frame[frame_size / 2] ^= 0x5A;
+    }
+  }
+
+  m_tx_buffer_.insert(m_tx_buffer_.end(), frame, frame + frame_size);
+  m_tx_frame_sizes_.push_back(frame_size);
+  m_frames_sent_++;
+}
+
+void DeviceSimulator::sendAnswer(uint8_t msg, const void *p_payload, size_t payload_size)
+{
+  sbgEComProtocolSend(&m_protocol_, SBG_ECOM_CLASS_LOG_CMD_0, msg, p_payload, payload_size);
+}
+
+void DeviceSimulator::sendAck(uint8_t msg, SbgErrorCode error_code)
+{
+  uint8_t         payload[4];
+  SbgStreamBuffer stream;
+
+  sbgStreamBufferInitForWrite(&stream, payload, sizeof(payload));
+  sbgStreamBufferWriteUint8LE(&stream, msg);
+  sbgStreamBufferWriteUint8LE(&stream, SBG_ECOM_CLASS_LOG_CMD_0);
+  sbgStreamBufferWriteUint16LE(&stream, static_cast<uint16_t>(error_code));
+
+  sendAnswer(SBG_ECOM_CMD_ACK, payload, sbgStreamBufferGetLength(&stream));
+}
+
+void DeviceSimulator::handleCommand(uint8_t msg, const uint8_t *p_payload, size_t payload_size)
+{
+  uint8_t         answer[SBG_ECOM_MAX_PAYLOAD_SIZE];
+  SbgStreamBuffer output_stream;
+  SbgStreamBuffer input_stream;
+
+  sbgStreamBufferInitForWrite(&output_stream, answer, sizeof(answer));
+  sbgStreamBufferInitForRead(&input_stream, p_payload, payload_size);
+
+  if (msg == SBG_ECOM_CMD_INFO)
+  {
+    char product_code[SBG_ECOM_INFO_PRODUCT_CODE_LENGTH] = "ELLIPSE2-D-G4A3-B1";
+
+    sbgStreamBufferWriteBuffer(&output_stream, product_code, sizeof(product_code));
+    sbgStreamBufferWriteUint32LE(&output_stream, m_config_.serial_number);
+    sbgStreamBufferWriteUint32LE(&output_stream, 1);
+    sbgStreamBufferWriteUint16LE(&output_stream, 2026);
+    sbgStreamBufferWriteUint8LE(&output_stream, 10);
+    sbgStreamBufferWriteUint8LE(&output_stream, 18);
+    sbgStreamBufferWriteUint32LE(&output_stream, SBG_VERSION_BASIC(1, 2, 0, 0));
+    sbgStreamBufferWriteUint32LE(&output_stream, SBG_VERSION_SOFTWARE(2, 1, 0, SBG_VERSION_QUALIFIER_STABLE));
+
+    sendAnswer(msg, answer, sbgStreamBufferGetLength(&output_stream));
+  }
+  else if (msg == SBG_ECOM_CMD_OUTPUT_CONF)
+  {
+    uint8_t output_port = sbgStreamBufferReadUint8LE(&input_stream);
+    uint8_t msg_id      = sbgStreamBufferReadUint8LE(&input_stream);
+    uint8_t class_id    = sbgStreamBufferReadUint8LE(&input_stream);
+
+    if (payload_size == 3)
+    {
+      SbgEComOutputMode output_mode = SBG_ECOM_OUTPUT_MODE_DISABLED;
+
+      if (class_id == SBG_ECOM_CLASS_LOG_ECOM_0)
+      {
+        output_mode = getLogOutputMode(static_cast<SbgEComMsgId>(msg_id));
+      }
+
+      sbgStreamBufferWriteUint8LE(&output_stream, output_port);
+      sbgStreamBufferWriteUint8LE(&output_stream, msg_id);
+      sbgStreamBufferWriteUint8LE(&output_stream, class_id);
+      sbgStreamBufferWriteUint16LE(&output_stream, static_cast<uint16_t>(output_mode));
+
+      sendAnswer(msg, answer, sbgStreamBufferGetLength(&output_stream));
+    }
+    else if (payload_size == 5)
+    {
+      SbgEComOutputMode output_mode = static_cast<SbgEComOutputMode>(sbgStreamBufferReadUint16LE(&input_stream));
+
+      if (class_id == SBG_ECOM_CLASS_LOG_ECOM_0)
+      {
+        setLogOutputMode(static_cast<SbgEComMsgId>(msg_id), output_mode);
+      }
+
+      sendAck(msg, SBG_NO_ERROR);
+    }
+    else
+    {
+      sendAck(msg, SBG_INVALID_PARAMETER);
+    }
+  }
+  else if (msg == SBG_ECOM_CMD_EXPORT_SETTINGS)
+  {
+    handleExportSettings(p_payload, payload_size);
+  }
+  else if (msg == SBG_ECOM_CMD_SETTINGS_ACTION)
+  {
+    sendAck(msg, SBG_NO_ERROR);
+  }
+  else if (m_settings_.count(msg) != 0)
+  {
+    std::vector<uint8_t> &ref_setting = m_settings_[msg];
+
+    if (payload_size == 0)
+    {
+      sbgStreamBufferWriteBuffer(&output_stream, ref_setting.data(), ref_setting.size());
+
+      if (std::find(std::begin(MODEL_SETTINGS), std::end(MODEL_SETTINGS), msg) != std::end(MODEL_SETTINGS))
+      {
+        sbgStreamBufferWriteUint32LE(&output_stream, 1);
+      }
+
+      sendAnswer(msg, answer, sbgStreamBufferGetLength(&output_stream));
+    }
+    else
+    {
+      ref_setting.assign(p_payload, p_payload + payload_size);
+      sendAck(msg, SBG_NO_ERROR);
+    }
+  }
+  else
+  {
+    sendAck(msg, SBG_INVALID_PARAMETER);
+  }
+}
+
+void DeviceSimulator::handleExportSettings(const uint8_t *p_payload, size_t payload_size)
+{
+  uint8_t         answer[SBG_ECOM_MAX_PAYLOAD_SIZE];
+  SbgStreamBuffer output_stream;
+  SbgStreamBuffer input_stream;
+  uint16_t        transfer_cmd;
+
+  sbgStreamBufferInitForWrite(&output_stream, answer, sizeof(answer));
+  sbgStreamBufferInitForRead(&input_stream, p_payload, payload_size);
+
+  transfer_cmd = sbgStreamBufferReadUint16LE(&input_stream);
+
+  if (sbgStreamBufferGetLastError(&input_stream) != SBG_NO_ERROR)
+  {
+    sendAck(SBG_ECOM_CMD_EXPORT_SETTINGS, SBG_INVALID_PARAMETER);
+  }
+  else if (transfer_cmd == SBG_ECOM_TRANSFER_START)
+  {
+    m_export_buffer_ = serializeSettings();
+
+    sbgStreamBufferWriteUint16LE(&output_stream, SBG_ECOM_TRANSFER_START);
+    sbgStreamBufferWriteSizeT32LE(&output_stream, m_export_buffer_.size());
+
+    sendAnswer(SBG_ECOM_CMD_EXPORT_SETTINGS, answer, sbgStreamBufferGetLength(&output_stream));
+  }
+  else if (transfer_cmd == SBG_ECOM_TRANSFER_DATA)
+  {
+    size_t offset = sbgStreamBufferReadSizeT32LE(&input_stream);
+    size_t size   = sbgStreamBufferReadSizeT32LE(&input_stream);
+
+    if ((sbgStreamBufferGetLastError(&input_stream) == SBG_NO_ERROR) && (offset + size <= m_export_buffer_.size()) && (size <= SBG_ECOM_TRANSFER_PACKET_SIZE))
+    {
+      sbgStreamBufferWriteUint16LE(&output_stream, SBG_ECOM_TRANSFER_DATA);
+      sbgStreamBufferWriteSizeT32LE(&output_stream, offset);
+      sbgStreamBufferWriteBuffer(&output_stream, m_export_buffer_.data() + offset, size);
+
+      sendAnswer(SBG_ECOM_CMD_EXPORT_SETTINGS, answer, sbgStreamBufferGetLength(&output_stream));
+    }
+    else
+    {
+      sendAck(SBG_ECOM_CMD_EXPORT_SETTINGS, SBG_INVALID_PARAMETER);
+    }
+  }
+  else
+  {
+    sendAck(SBG_ECOM_CMD_EXPORT_SETTINGS, SBG_NO_ERROR);
+  }
+}
+
+void DeviceSimulator::handleCommands(void)
+{
+  uint8_t       payload[SBG_ECOM_MAX_PAYLOAD_SIZE];
+  uint8_t       msg_class;
+  uint8_t       msg;
+  size_t        payload_size;
+  SbgErrorCode  error_code;
+
+  do
+  {
+    error_code = sbgEComProtocolReceive(&m_protocol_, &msg_class, &msg, payload, &payload_size, sizeof(payload));
+
+    if ((error_code == SBG_NO_ERROR) && (msg_class == SBG_ECOM_CLASS_LOG_CMD_0))
+    {
+      m_commands_received_++;
+      handleCommand(msg, payload, payload_size);
+    }
+  } while ((error_code == SBG_NO_ERROR) || (error_code == SBG_INVALID_CRC));
+}
+
+void DeviceSimulator::emitLogs(uint64_t device_time)
+{
+  for (auto &ref_log : m_logs_)
+  {
+    SimulatedLog &ref_simulated_log = ref_log.second;
+
+    if (ref_simulated_log.rate <= 0.0)
+    {
+      continue;
+    }
+
+    uint64_t period = static_cast<uint64_t>(std::llround(1e6 / ref_simulated_log.rate));
+
+    //
+    // Resynchronize instead of sending a large backlog if the simulator has been suspended.
+    //
+    if (device_time > ref_simulated_log.next_time + 1000000)
+    {
+      ref_simulated_log.next_time = device_time;
+    }
+
+    while (ref_simulated_log.next_time <= device_time)
+    {
+      queueLog(ref_log.first, ref_simulated_log.next_time);
+      ref_simulated_log.next_time += period;
+    }
+  }
+}
+
+void DeviceSimulator::flush(void)
+{
+  const uint8_t *p_data = m_tx_buffer_.data();
+
+  for (size_t frame_size : m_tx_frame_sizes_)
+  {
+    size_t bytes_dropped = m_bytes_dropped_;
+
+    if (sbgInterfaceWrite(&m_interface_, p_data, frame_size) == SBG_NO_ERROR)
+    {
+      m_bytes_sent_ += frame_size - (m_bytes_dropped_ - bytes_dropped);
+    }
+    else
+    {
+      m_bytes_dropped_ += frame_size;
+    }
+
+    p_data += frame_size;
+  }
+
+  m_tx_buffer_.clear();
+  m_tx_frame_sizes_.clear();
+}
+
+void DeviceSimulator::printStatistics(double elapsed_s)
+{
+  printf("SBG_SIMULATOR - %.0f frames/s, %.0f bytes/s, %u corrupted, %zu bytes dropped, %u commands\n",
+         m_frames_sent_ / elapsed_s, m_bytes_sent_ / elapsed_s, m_frames_corrupted_, m_bytes_dropped_, m_commands_received_);
+
+  m_frames_sent_        = 0;
+  m_frames_corrupted_   = 0;
+  m_commands_received_  = 0;
+  m_bytes_sent_         = 0;
+  m_bytes_dropped_      = 0;
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+bool DeviceSimulator::getLogId(const std::string &ref_name, SbgEComMsgId &ref_msg_id)
+{
+  for (const auto &ref_log : SIMULATED_LOGS)
+  {
+    if (ref_name == ref_log.p_name)
+    {
+      ref_msg_id = ref_log.msg_id;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void DeviceSimulator::run(const volatile bool &ref_stop)
+{
+  uint64_t last_statistics_time = 0;
+
+  while (!ref_stop)
+  {
+    uint64_t device_time = getDeviceTime();
+
+    if ((m_config_.duration != 0) && (device_time >= m_config_.duration * 1000000ULL))
+    {
+      break;
+    }
+
+    handleCommands();
+    emitLogs(device_time);
+
+    if ((m_config_.burst_period == 0) || (device_time - m_last_flush_time_ >= m_config_.burst_period * 1000ULL))
+    {
+      flush();
+      m_last_flush_time_ = device_time;
+    }
+
+    if (device_time - last_statistics_time >= 1000000)
+    {
+      printStatistics((device_time - last_statistics_time) * 1e-6);
+      last_statistics_time = device_time;
+    }
+
+    sbgSleep(1);
+  }
+
+  flush();
+}
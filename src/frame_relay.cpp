@@ -0,0 +1,114 @@
+// File header
+#include "frame_relay.h"
+
+// Standard headers
+#include <algorithm>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+
+using sbg::FrameRelay;
+
+/*!
+ * Size of the sbgECom frame around the payload: sync chars, message ID and class, length, CRC and ETX.
+ */
+#define SBG_FRAME_RELAY_FRAME_OVERHEAD  (9)
+
+/*!
+ * Class to relay the received log frames to an UDP multicast group.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+FrameRelay::FrameRelay(void):
+m_interface_(),
+m_opened_(false),
+m_max_datagram_size_(0)
+{
+  sbgStreamBufferInitForWrite(&m_datagram_stream_, m_datagram_.data(), m_datagram_.size());
+}
+
+FrameRelay::~FrameRelay(void)
+{
+  if (m_opened_)
+  {
+    sbgInterfaceUdpDestroy(&m_interface_);
+  }
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+bool FrameRelay::isEnabled(void) const
+{
+  return m_opened_;
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void FrameRelay::open(sbgIpAddress group_address, uint32_t port, size_t max_datagram_size)
+{
+  SbgErrorCode error_code;
+
+  //
+  // The relay only sends, so it listens on an ephemeral port.
+  //
+  error_code = sbgInterfaceUdpCreate(&m_interface_, group_address, port, 0);
+
+  if (error_code != SBG_NO_ERROR)
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RCL_RET_ERROR, "SBG_DRIVER - [Relay] Unable to initialize the relay interface - " + std::string(sbgErrorCodeToString(error_code)));
+  }
+
+  m_opened_             = true;
+  m_max_datagram_size_  = std::min(max_datagram_size, m_datagram_.size());
+}
+
+void FrameRelay::relayFrame(SbgEComClass msg_class, SbgEComMsgId msg, const void *p_payload, size_t payload_size)
+{
+  size_t stream_cursor;
+
+  if (!m_opened_)
+  {
+    return;
+  }
+
+  //
+  // Frames are never split across datagrams, a frame larger than a datagram is sent alone.
+  //
+  if (sbgStreamBufferGetLength(&m_datagram_stream_) + payload_size + SBG_FRAME_RELAY_FRAME_OVERHEAD > m_max_datagram_size_)
+  {
+    flush();
+  }
+
+  sbgEComStartFrameGeneration(&m_datagram_stream_, msg_class, msg, &stream_cursor);
+  sbgStreamBufferWriteBuffer(&m_datagram_stream_, p_payload, payload_size);
+
+  if (sbgEComFinalizeFrameGeneration(&m_datagram_stream_, stream_cursor) != SBG_NO_ERROR)
+  {
+    //
+    // Drop the incomplete frame, the previous ones are kept.
+    //
+    sbgStreamBufferClearLastError(&m_datagram_stream_);
+    sbgStreamBufferSeek(&m_datagram_stream_, stream_cursor, SB_SEEK_SET);
+  }
+
+  if (sbgStreamBufferGetLength(&m_datagram_stream_) >= m_max_datagram_size_)
+  {
+    flush();
+  }
+}
+
+void FrameRelay::flush(void)
+{
+  if (m_opened_ && (sbgStreamBufferGetLength(&m_datagram_stream_) > 0))
+  {
+    sbgInterfaceWrite(&m_interface_, m_datagram_.data(), sbgStreamBufferGetLength(&m_datagram_stream_));
+
+    sbgStreamBufferInitForWrite(&m_datagram_stream_, m_datagram_.data(), m_datagram_.size());
+  }
+}
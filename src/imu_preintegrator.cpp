@@ -0,0 +1,522 @@
+// File header
+#include "imu_preintegrator.h"
+
+// Standard headers
+#include <algorithm>
+#include <cmath>
+
+using sbg::ImuPreintegrator;
+
+/*!
+ * Maximum number of IMU logs waiting for a trigger, older logs are dropped.
+ */
+#define SBG_PREINTEGRATION_MAX_SAMPLES  (4096)
+
+/*!
+ * Maximum number of triggers waiting for the IMU logs after them.
+ */
+#define SBG_PREINTEGRATION_MAX_TRIGGERS (64)
+
+//---------------------------------------------------------------------//
+//- Private functions                                                 -//
+//---------------------------------------------------------------------//
+
+namespace
+{
+typedef std::array<double, 3>   Vector3;
+typedef std::array<double, 9>   Matrix3;
+typedef std::array<double, 81>  Matrix9;
+
+/*!
+ * Product of a row major matrix and a vector.
+ *
+ * \param[in] ref_m             Matrix.
+ * \param[in] ref_v             Vector.
+ * \return                      Matrix times vector.
+ */
+Vector3 multiply(const Matrix3 &ref_m, const Vector3 &ref_v)
+{
+  Vector3 result;
+
+  for (size_t i = 0; i < 3; i++)
+  {
+    result[i] = ref_m[i * 3] * ref_v[0] + ref_m[i * 3 + 1] * ref_v[1] + ref_m[i * 3 + 2] * ref_v[2];
+  }
+
+  return result;
+}
+
+/*!
+ * Product of two row major matrices.
+ *
+ * \param[in] ref_a             First matrix.
+ * \param[in] ref_b             Second matrix.
+ * \return                      First matrix times second matrix.
+ */
+Matrix3 multiply(const Matrix3 &ref_a, const Matrix3 &ref_b)
+{
+  Matrix3 result;
+
+  for (size_t i = 0; i < 3; i++)
+  {
+    for (size_t j = 0; j < 3; j++)
+    {
+      result[i * 3 + j] = ref_a[i * 3] * ref_b[j] + ref_a[i * 3 + 1] * ref_b[3 + j] + ref_a[i * 3 + 2] * ref_b[6 + j];
+    }
+  }
+
+  return result;
+}
+
+/*!
+ * Product of a matrix and a scalar.
+ *
+ * \param[in] ref_m             Matrix.
+ * \param[in] factor            Scalar.
+ * \return                      Matrix times scalar.
+ */
+Matrix3 scale(const Matrix3 &ref_m, double factor)
+{
+  Matrix3 result;
+
+  for (size_t i = 0; i < ref_m.size(); i++)
+  {
+    result[i] = ref_m[i] * factor;
+  }
+
+  return result;
+}
+
+/*!
+ * Rotation matrix of a rotation vector, with the Rodrigues formula.
+ *
+ * \param[in] ref_rotation      Rotation vector (rad).
+ * \return                      Rotation matrix.
+ */
+Matrix3 exponential(const Vector3 &ref_rotation)
+{
+  double  angle;
+  double  a;
+  double  b;
+  double  x;
+  double  y;
+  double  z;
+
+  angle = std::sqrt(ref_rotation[0] * ref_rotation[0] + ref_rotation[1] * ref_rotation[1] + ref_rotation[2] * ref_rotation[2]);
+
+  //
+  // Use the Taylor expansions of sin(t)/t and (1-cos(t))/t^2 for small angles.
+  //
+  if (angle < 1e-6)
+  {
+    a = 1.0 - angle * angle / 6.0;
+    b = 0.5 - angle * angle / 24.0;
+  }
+  else
+  {
+    a = std::sin(angle) / angle;
+    b = (1.0 - std::cos(angle)) / (angle * angle);
+  }
+
+  x = ref_rotation[0];
+  y = ref_rotation[1];
+  z = ref_rotation[2];
+
+  return {{ 1.0 - b * (y * y + z * z),  -a * z + b * x * y,         a * y + b * x * z,
+            a * z + b * x * y,          1.0 - b * (x * x + z * z),  -a * x + b * y * z,
+            -a * y + b * x * z,         a * x + b * y * z,          1.0 - b * (x * x + y * y) }};
+}
+
+/*!
+ * Quaternion of a rotation matrix.
+ *
+ * \param[in] ref_m             Rotation matrix.
+ * \return                      Quaternion.
+ */
+geometry_msgs::msg::Quaternion toQuaternion(const Matrix3 &ref_m)
+{
+  geometry_msgs::msg::Quaternion  quaternion;
+  double                          trace;
+  double                          s;
+
+  trace = ref_m[0] + ref_m[4] + ref_m[8];
+
+  if (trace > 0.0)
+  {
+    s             = 2.0 * std::sqrt(trace + 1.0);
+    quaternion.w  = 0.25 * s;
+    quaternion.x  = (ref_m[7] - ref_m[5]) / s;
+    quaternion.y  = (ref_m[2] - ref_m[6]) / s;
+    quaternion.z  = (ref_m[3] - ref_m[1]) / s;
+  }
+  else if ((ref_m[0] > ref_m[4]) && (ref_m[0] > ref_m[8]))
+  {
+    s             = 2.0 * std::sqrt(1.0 + ref_m[0] - ref_m[4] - ref_m[8]);
+    quaternion.w  = (ref_m[7] - ref_m[5]) / s;
+    quaternion.x  = 0.25 * s;
+    quaternion.y  = (ref_m[1] + ref_m[3]) / s;
+    quaternion.z  = (ref_m[2] + ref_m[6]) / s;
+  }
+  else if (ref_m[4] > ref_m[8])
+  {
+    s             = 2.0 * std::sqrt(1.0 + ref_m[4] - ref_m[0] - ref_m[8]);
+    quaternion.w  = (ref_m[2] - ref_m[6]) / s;
+    quaternion.x  = (ref_m[1] + ref_m[3]) / s;
+    quaternion.y  = 0.25 * s;
+    quaternion.z  = (ref_m[5] + ref_m[7]) / s;
+  }
+  else
+  {
+    s             = 2.0 * std::sqrt(1.0 + ref_m[8] - ref_m[0] - ref_m[4]);
+    quaternion.w  = (ref_m[3] - ref_m[1]) / s;
+    quaternion.x  = (ref_m[2] + ref_m[6]) / s;
+    quaternion.y  = (ref_m[5] + ref_m[7]) / s;
+    quaternion.z  = 0.25 * s;
+  }
+
+  return quaternion;
+}
+
+/*!
+ * Set a 3x3 block of a 9x9 row major matrix.
+ *
+ * \param[in] ref_m             9x9 matrix.
+ * \param[in] row               First row of the block.
+ * \param[in] column            First column of the block.
+ * \param[in] ref_block         Block value.
+ */
+void setBlock(Matrix9 &ref_m, size_t row, size_t column, const Matrix3 &ref_block)
+{
+  for (size_t i = 0; i < 3; i++)
+  {
+    for (size_t j = 0; j < 3; j++)
+    {
+      ref_m[(row + i) * 9 + column + j] = ref_block[i * 3 + j];
+    }
+  }
+}
+
+/*!
+ * Propagate a covariance through a linear transition: A P A^T.
+ * Only the upper triangle is computed and mirrored, so the result stays exactly symmetric.
+ *
+ * \param[in] ref_a             9x9 transition matrix.
+ * \param[in] ref_p             9x9 covariance.
+ * \return                      Propagated covariance.
+ */
+Matrix9 propagate(const Matrix9 &ref_a, const Matrix9 &ref_p)
+{
+  Matrix9 ap;
+  Matrix9 result;
+
+  for (size_t i = 0; i < 9; i++)
+  {
+    for (size_t j = 0; j < 9; j++)
+    {
+      double sum = 0.0;
+
+      for (size_t k = 0; k < 9; k++)
+      {
+        sum += ref_a[i * 9 + k] * ref_p[k * 9 + j];
+      }
+
+      ap[i * 9 + j] = sum;
+    }
+  }
+
+  for (size_t i = 0; i < 9; i++)
+  {
+    for (size_t j = i; j < 9; j++)
+    {
+      double sum = 0.0;
+
+      for (size_t k = 0; k < 9; k++)
+      {
+        sum += ap[i * 9 + k] * ref_a[j * 9 + k];
+      }
+
+      result[i * 9 + j] = sum;
+      result[j * 9 + i] = sum;
+    }
+  }
+
+  return result;
+}
+}
+
+/*!
+ * Class to preintegrate the IMU logs between trigger events.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+ImuPreintegrator::ImuPreintegrator(void):
+m_trigger_(PreintegrationTrigger::NONE),
+m_period_(0),
+m_gyro_noise_density_(0.0),
+m_accel_noise_density_(0.0),
+m_started_(false),
+m_start_time_stamp_(0)
+{
+}
+
+//---------------------------------------------------------------------//
+//- Private methods                                                   -//
+//---------------------------------------------------------------------//
+
+void ImuPreintegrator::processTrigger(uint32_t trigger_time_stamp)
+{
+  sbg_driver::msg::SbgImuPreintegration preintegration_message;
+  Matrix3                               delta_rotation;
+  Vector3                               delta_velocity;
+  Vector3                               delta_position;
+  Matrix9                               covariance;
+  Matrix9                               transition;
+  uint32_t                              previous_time_stamp;
+  uint16_t                              sample_count;
+
+  delta_rotation  = {{ 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 }};
+  delta_velocity  = {{ 0.0, 0.0, 0.0 }};
+  delta_position  = {{ 0.0, 0.0, 0.0 }};
+  covariance.fill(0.0);
+  transition.fill(0.0);
+
+  for (size_t i = 0; i < 9; i++)
+  {
+    transition[i * 9 + i] = 1.0;
+  }
+
+  previous_time_stamp = m_start_time_stamp_;
+  sample_count        = 0;
+
+  while (!m_samples_.empty() && (static_cast<int32_t>(m_samples_.front().time_stamp - trigger_time_stamp) <= 0))
+  {
+    const ImuSample &ref_sample = m_samples_.front();
+    double          dt;
+    Vector3         rotation;
+    Vector3         velocity;
+    Vector3         rotated_velocity;
+    Matrix3         velocity_skew;
+    Matrix3         rotated_velocity_skew;
+    Matrix3         step_rotation;
+
+    dt = static_cast<int32_t>(ref_sample.time_stamp - previous_time_stamp) * 1e-6;
+
+    if (dt > 0.0)
+    {
+      //
+      // The device already applies the coning and sculling compensations to its increments,
+      // so they are integrated directly.
+      //
+      for (size_t i = 0; i < 3; i++)
+      {
+        rotation[i] = ref_sample.delta_angle[i] * dt;
+        velocity[i] = ref_sample.delta_velocity[i] * dt;
+      }
+
+      //
+      // Error state propagation of the rotation, velocity and position increments.
+      //
+      step_rotation         = exponential(rotation);
+      rotated_velocity      = multiply(delta_rotation, velocity);
+      velocity_skew         = {{ 0.0, -velocity[2], velocity[1], velocity[2], 0.0, -velocity[0], -velocity[1], velocity[0], 0.0 }};
+      rotated_velocity_skew = multiply(delta_rotation, velocity_skew);
+
+      setBlock(transition, 0, 0, {{ step_rotation[0], step_rotation[3], step_rotation[6], step_rotation[1], step_rotation[4], step_rotation[7], step_rotation[2], step_rotation[5], step_rotation[8] }});
+      setBlock(transition, 3, 0, scale(rotated_velocity_skew, -1.0));
+      setBlock(transition, 6, 0, scale(rotated_velocity_skew, -dt / 2.0));
+      setBlock(transition, 6, 3, {{ dt, 0.0, 0.0, 0.0, dt, 0.0, 0.0, 0.0, dt }});
+
+      covariance = propagate(transition, covariance);
+
+      for (size_t i = 0; i < 3; i++)
+      {
+        double gyro_variance  = m_gyro_noise_density_ * m_gyro_noise_density_ * dt;
+        double accel_variance = m_accel_noise_density_ * m_accel_noise_density_ * dt;
+
+        covariance[i * 9 + i]               += gyro_variance;
+        covariance[(3 + i) * 9 + 3 + i]     += accel_variance;
+        covariance[(6 + i) * 9 + 6 + i]     += accel_variance * dt * dt / 4.0;
+        covariance[(3 + i) * 9 + 6 + i]     += accel_variance * dt / 2.0;
+        covariance[(6 + i) * 9 + 3 + i]     += accel_variance * dt / 2.0;
+      }
+
+      //
+      // Increments, expressed in the IMU frame at the start of the interval.
+      //
+      for (size_t i = 0; i < 3; i++)
+      {
+        delta_position[i] += delta_velocity[i] * dt + rotated_velocity[i] * dt / 2.0;
+        delta_velocity[i] += rotated_velocity[i];
+      }
+
+      delta_rotation = multiply(delta_rotation, step_rotation);
+
+      sample_count++;
+    }
+
+    previous_time_stamp                     = ref_sample.time_stamp;
+    preintegration_message.header           = ref_sample.header;
+
+    m_samples_.pop_front();
+  }
+
+  if (sample_count > 0)
+  {
+    preintegration_message.time_stamp_start = m_start_time_stamp_;
+    preintegration_message.time_stamp       = previous_time_stamp;
+    preintegration_message.trigger          = (m_trigger_ == PreintegrationTrigger::INTERVAL) ? sbg_driver::msg::SbgImuPreintegration::TRIGGER_INTERVAL : sbg_driver::msg::SbgImuPreintegration::TRIGGER_EVENT;
+    preintegration_message.sample_count     = sample_count;
+    preintegration_message.delta_rotation   = toQuaternion(delta_rotation);
+    preintegration_message.delta_velocity.x = delta_velocity[0];
+    preintegration_message.delta_velocity.y = delta_velocity[1];
+    preintegration_message.delta_velocity.z = delta_velocity[2];
+    preintegration_message.delta_position.x = delta_position[0];
+    preintegration_message.delta_position.y = delta_position[1];
+    preintegration_message.delta_position.z = delta_position[2];
+
+    std::copy(covariance.begin(), covariance.end(), preintegration_message.covariance.begin());
+
+    m_preintegration_pub_->publish(preintegration_message);
+  }
+
+  m_start_time_stamp_ = previous_time_stamp;
+}
+
+void ImuPreintegrator::startInterval(uint32_t time_stamp)
+{
+  bool started;
+
+  started = false;
+
+  while (!m_samples_.empty() && (static_cast<int32_t>(m_samples_.front().time_stamp - time_stamp) <= 0))
+  {
+    m_start_time_stamp_ = m_samples_.front().time_stamp;
+    started             = true;
+
+    m_samples_.pop_front();
+  }
+
+  m_started_ = started;
+}
+
+void ImuPreintegrator::processTriggers(void)
+{
+  uint32_t trigger_time_stamp;
+
+  while (!m_triggers_.empty() && !m_samples_.empty() && (static_cast<int32_t>(m_samples_.back().time_stamp - m_triggers_.front()) >= 0))
+  {
+    trigger_time_stamp = m_triggers_.front();
+    m_triggers_.pop_front();
+
+    if (!m_started_)
+    {
+      startInterval(trigger_time_stamp);
+    }
+    else if (static_cast<int32_t>(trigger_time_stamp - m_start_time_stamp_) > 0)
+    {
+      processTrigger(trigger_time_stamp);
+    }
+
+    if (m_started_ && (m_trigger_ == PreintegrationTrigger::INTERVAL))
+    {
+      m_triggers_.push_back(trigger_time_stamp + m_period_);
+    }
+  }
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+bool ImuPreintegrator::isEnabled(void) const
+{
+  return m_trigger_ != PreintegrationTrigger::NONE;
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void ImuPreintegrator::initPublishers(rclcpp::Node &ref_ros_node_handle, const ConfigStore &ref_config_store)
+{
+  m_trigger_              = ref_config_store.getPreintegrationTrigger();
+  m_period_               = ref_config_store.getPreintegrationPeriod() * 1000;
+  m_gyro_noise_density_   = ref_config_store.getGyroNoiseDensity();
+  m_accel_noise_density_  = ref_config_store.getAccelNoiseDensity();
+
+  if ((m_trigger_ == PreintegrationTrigger::INTERVAL) && (m_period_ == 0))
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG_DRIVER - [Preintegration] The preintegration period must be positive.");
+  }
+
+  m_preintegration_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgImuPreintegration>("sbg/imu_preintegration", 10);
+}
+
+void ImuPreintegrator::addImuData(const sbg_driver::msg::SbgImuData &ref_imu_data)
+{
+  ImuSample sample;
+
+  sample.header         = ref_imu_data.header;
+  sample.time_stamp     = ref_imu_data.time_stamp;
+  sample.delta_angle    = {{ ref_imu_data.delta_angle.x, ref_imu_data.delta_angle.y, ref_imu_data.delta_angle.z }};
+  sample.delta_velocity = {{ ref_imu_data.delta_vel.x, ref_imu_data.delta_vel.y, ref_imu_data.delta_vel.z }};
+
+  //
+  // The interval is restarted if an IMU log is out of order or if too many logs wait for a trigger.
+  //
+  if (!m_samples_.empty() && (static_cast<int32_t>(sample.time_stamp - m_samples_.back().time_stamp) <= 0))
+  {
+    m_samples_.clear();
+    m_triggers_.clear();
+    m_started_ = false;
+  }
+  else if (m_samples_.size() >= SBG_PREINTEGRATION_MAX_SAMPLES)
+  {
+    m_samples_.pop_front();
+    m_started_ = false;
+  }
+
+  m_samples_.push_back(sample);
+
+  if ((m_trigger_ == PreintegrationTrigger::INTERVAL) && m_triggers_.empty())
+  {
+    m_triggers_.push_back(sample.time_stamp);
+  }
+
+  processTriggers();
+}
+
+void ImuPreintegrator::addEvent(uint8_t channel, const SbgLogEvent &ref_event)
+{
+  const std::array<std::pair<uint16_t, uint16_t>, 4> time_offsets =
+  {{
+    { SBG_ECOM_EVENT_OFFSET_0_VALID, ref_event.timeOffset0 },
+    { SBG_ECOM_EVENT_OFFSET_1_VALID, ref_event.timeOffset1 },
+    { SBG_ECOM_EVENT_OFFSET_2_VALID, ref_event.timeOffset2 },
+    { SBG_ECOM_EVENT_OFFSET_3_VALID, ref_event.timeOffset3 }
+  }};
+
+  if ((m_trigger_ == PreintegrationTrigger::NONE) || (m_trigger_ == PreintegrationTrigger::INTERVAL) || (channel != static_cast<uint8_t>(m_trigger_) - static_cast<uint8_t>(PreintegrationTrigger::EVENT_A)))
+  {
+    return;
+  }
+
+  m_triggers_.push_back(ref_event.timeStamp);
+
+  for (const std::pair<uint16_t, uint16_t> &ref_time_offset : time_offsets)
+  {
+    if (ref_event.status & ref_time_offset.first)
+    {
+      m_triggers_.push_back(ref_event.timeStamp + ref_time_offset.second);
+    }
+  }
+
+  while (m_triggers_.size() > SBG_PREINTEGRATION_MAX_TRIGGERS)
+  {
+    m_triggers_.pop_front();
+  }
+
+  processTriggers();
+}
@@ -0,0 +1,354 @@
+// File header
+#include "latency_monitor.h"
+
+// Standard headers
+#include <algorithm>
+#include <cmath>
+
+using sbg::LatencyHistogram;
+using sbg::LatencyMonitor;
+
+constexpr size_t LatencyHistogram::SUB_BUCKET_BITS;
+constexpr size_t LatencyHistogram::SUB_BUCKET_COUNT;
+constexpr size_t LatencyHistogram::BUCKET_COUNT;
+
+/*!
+ * Lock free histogram of durations in microseconds.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+LatencyHistogram::LatencyHistogram(void)
+{
+  reset();
+}
+
+//---------------------------------------------------------------------//
+//- Private methods                                                   -//
+//---------------------------------------------------------------------//
+
+size_t LatencyHistogram::getBucketIndex(uint32_t value)
+{
+  size_t msb;
+
+  if (value < SUB_BUCKET_COUNT)
+  {
+    return value;
+  }
+
+  msb = 0;
+
+  while ((value >> (msb + 1)) != 0)
+  {
+    msb++;
+  }
+
+  //
+  // Each power of two above the sub-buckets range is split in SUB_BUCKET_COUNT linear buckets.
+  //
+  size_t shift = msb - SUB_BUCKET_BITS;
+
+  return (shift + 1) * SUB_BUCKET_COUNT + ((value >> shift) & (SUB_BUCKET_COUNT - 1));
+}
+
+uint32_t LatencyHistogram::getBucketUpperBound(size_t index)
+{
+  if (index < SUB_BUCKET_COUNT)
+  {
+    return static_cast<uint32_t>(index);
+  }
+
+  size_t    shift = index / SUB_BUCKET_COUNT - 1;
+  uint64_t  lower = static_cast<uint64_t>(SUB_BUCKET_COUNT + (index % SUB_BUCKET_COUNT)) << shift;
+
+  return static_cast<uint32_t>(std::min<uint64_t>(lower + (1ULL << shift) - 1, UINT32_MAX));
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+uint32_t LatencyHistogram::getCount(void) const
+{
+  return m_count_.load(std::memory_order_relaxed);
+}
+
+uint32_t LatencyHistogram::getMax(void) const
+{
+  return m_max_.load(std::memory_order_relaxed);
+}
+
+uint32_t LatencyHistogram::getPercentile(double percentile) const
+{
+  uint32_t  count = getCount();
+  uint64_t  rank;
+  uint64_t  cumulated_count;
+
+  if (count == 0)
+  {
+    return 0;
+  }
+
+  rank            = static_cast<uint64_t>(std::ceil(percentile / 100.0 * count));
+  rank            = std::max<uint64_t>(rank, 1);
+  cumulated_count = 0;
+
+  for (size_t i = 0; i < BUCKET_COUNT; i++)
+  {
+    cumulated_count += m_buckets_[i].load(std::memory_order_relaxed);
+
+    if (cumulated_count >= rank)
+    {
+      return std::min(getBucketUpperBound(i), getMax());
+    }
+  }
+
+  return getMax();
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void LatencyHistogram::record(uint32_t value)
+{
+  uint32_t current_max;
+
+  m_buckets_[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  m_count_.fetch_add(1, std::memory_order_relaxed);
+
+  current_max = m_max_.load(std::memory_order_relaxed);
+
+  while ((value > current_max) && !m_max_.compare_exchange_weak(current_max, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+void LatencyHistogram::reset(void)
+{
+  for (std::atomic<uint32_t> &ref_bucket : m_buckets_)
+  {
+    ref_bucket.store(0, std::memory_order_relaxed);
+  }
+
+  m_count_.store(0, std::memory_order_relaxed);
+  m_max_.store(0, std::memory_order_relaxed);
+}
+
+/*!
+ * Class to measure the reception, parsing and publication latency of each log.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+LatencyMonitor::LatencyMonitor(void):
+m_read_time_(Clock::now()),
+m_last_publish_time_(Clock::now())
+{
+  for (std::atomic<LogLatency*> &ref_log : m_logs_)
+  {
+    ref_log.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+LatencyMonitor::~LatencyMonitor(void)
+{
+  for (std::atomic<LogLatency*> &ref_log : m_logs_)
+  {
+    delete ref_log.load(std::memory_order_relaxed);
+  }
+}
+
+//---------------------------------------------------------------------//
+//- Private methods                                                   -//
+//---------------------------------------------------------------------//
+
+LatencyMonitor::LogLatency *LatencyMonitor::getLogLatency(SbgEComClass msg_class, SbgEComMsgId msg)
+{
+  size_t      index;
+  LogLatency  *p_log_latency;
+
+  if (msg_class == SBG_ECOM_CLASS_LOG_ECOM_0)
+  {
+    index = msg;
+  }
+  else if (msg_class == SBG_ECOM_CLASS_LOG_ECOM_1)
+  {
+    index = 256 + msg;
+  }
+  else
+  {
+    return nullptr;
+  }
+
+  p_log_latency = m_logs_[index].load(std::memory_order_acquire);
+
+  //
+  // Statistics are only allocated for the logs actually received, logs are always recorded from the same thread.
+  //
+  if (!p_log_latency)
+  {
+    p_log_latency = new LogLatency();
+    p_log_latency->received.store(0, std::memory_order_relaxed);
+    p_log_latency->published.store(0, std::memory_order_relaxed);
+
+    m_logs_[index].store(p_log_latency, std::memory_order_release);
+  }
+
+  return p_log_latency;
+}
+
+uint32_t LatencyMonitor::getDurationUs(const Clock::time_point &ref_start, const Clock::time_point &ref_end)
+{
+  int64_t duration = std::chrono::duration_cast<std::chrono::microseconds>(ref_end - ref_start).count();
+
+  return static_cast<uint32_t>(std::min<int64_t>(std::max<int64_t>(duration, 0), UINT32_MAX));
+}
+
+void LatencyMonitor::addHistogramValues(const std::string &ref_prefix, const LatencyHistogram &ref_histogram, diagnostic_msgs::msg::DiagnosticStatus &ref_status)
+{
+  diagnostic_msgs::msg::KeyValue key_value;
+
+  key_value.key   = ref_prefix + "_p50_us";
+  key_value.value = std::to_string(ref_histogram.getPercentile(50.0));
+  ref_status.values.push_back(key_value);
+
+  key_value.key   = ref_prefix + "_p99_us";
+  key_value.value = std::to_string(ref_histogram.getPercentile(99.0));
+  ref_status.values.push_back(key_value);
+
+  key_value.key   = ref_prefix + "_p999_us";
+  key_value.value = std::to_string(ref_histogram.getPercentile(99.9));
+  ref_status.values.push_back(key_value);
+
+  key_value.key   = ref_prefix + "_max_us";
+  key_value.value = std::to_string(ref_histogram.getMax());
+  ref_status.values.push_back(key_value);
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void LatencyMonitor::initPublisher(rclcpp::Node &ref_ros_node_handle)
+{
+  m_diagnostics_pub_ = ref_ros_node_handle.create_publisher<diagnostic_msgs::msg::DiagnosticArray>("diagnostics", 10);
+}
+
+void LatencyMonitor::onBytesReadCallback(size_t num_bytes_read, void *p_user_arg)
+{
+  SBG_UNUSED_PARAMETER(num_bytes_read);
+
+  assert(p_user_arg);
+
+  static_cast<LatencyMonitor*>(p_user_arg)->m_read_time_ = Clock::now();
+}
+
+void LatencyMonitor::onFrameStageCallback(SbgEComHandle *p_handle, SbgEComFrameStage stage, SbgEComClass msg_class, SbgEComMsgId msg, void *p_user_arg)
+{
+  LatencyMonitor  *p_monitor;
+  LogLatency      *p_log_latency;
+
+  SBG_UNUSED_PARAMETER(p_handle);
+
+  assert(p_user_arg);
+
+  p_monitor = static_cast<LatencyMonitor*>(p_user_arg);
+
+  if (stage == SBG_ECOM_FRAME_STAGE_RECEIVED)
+  {
+    //
+    // The frame has been completed by the last read, it may have waited in the reception buffer since then.
+    //
+    p_monitor->m_received_time_ = p_monitor->m_read_time_;
+    p_monitor->m_parsed_time_   = p_monitor->m_received_time_;
+
+    p_log_latency = p_monitor->getLogLatency(msg_class, msg);
+
+    if (p_log_latency)
+    {
+      p_log_latency->received.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  else
+  {
+    p_monitor->m_parsed_time_ = Clock::now();
+  }
+}
+
+void LatencyMonitor::onLogPublished(SbgEComClass msg_class, SbgEComMsgId msg, bool delivered)
+{
+  Clock::time_point published_time = Clock::now();
+  LogLatency        *p_log_latency = getLogLatency(msg_class, msg);
+
+  if (p_log_latency)
+  {
+    p_log_latency->parse.record(getDurationUs(m_received_time_, m_parsed_time_));
+    p_log_latency->publish.record(getDurationUs(m_parsed_time_, published_time));
+    p_log_latency->total.record(getDurationUs(m_received_time_, published_time));
+
+    if (delivered)
+    {
+      p_log_latency->published.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void LatencyMonitor::publishDiagnostics(const rclcpp::Time &ref_stamp)
+{
+  diagnostic_msgs::msg::DiagnosticArray diagnostics;
+  Clock::time_point                     now = Clock::now();
+  double                                elapsed_s;
+
+  elapsed_s             = std::max(std::chrono::duration<double>(now - m_last_publish_time_).count(), 1e-3);
+  m_last_publish_time_  = now;
+
+  diagnostics.header.stamp = ref_stamp;
+
+  for (size_t i = 0; i < m_logs_.size(); i++)
+  {
+    LogLatency *p_log_latency = m_logs_[i].load(std::memory_order_acquire);
+
+    if (p_log_latency)
+    {
+      diagnostic_msgs::msg::DiagnosticStatus  status;
+      diagnostic_msgs::msg::KeyValue          key_value;
+      uint32_t                                received  = p_log_latency->received.exchange(0, std::memory_order_relaxed);
+      uint32_t                                published = p_log_latency->published.exchange(0, std::memory_order_relaxed);
+
+      status.level        = diagnostic_msgs::msg::DiagnosticStatus::OK;
+      status.name         = "sbg_driver: log latency class " + std::to_string(i / 256) + " id " + std::to_string(i % 256);
+      status.hardware_id  = "sbg_device";
+      status.message      = "Latency from frame reception to publication";
+
+      key_value.key   = "rate_hz";
+      key_value.value = std::to_string(received / elapsed_s);
+      status.values.push_back(key_value);
+
+      key_value.key   = "received";
+      key_value.value = std::to_string(received);
+      status.values.push_back(key_value);
+
+      key_value.key   = "unconsumed";
+      key_value.value = std::to_string(received - std::min(received, published));
+      status.values.push_back(key_value);
+
+      addHistogramValues("parse", p_log_latency->parse, status);
+      addHistogramValues("publish", p_log_latency->publish, status);
+      addHistogramValues("total", p_log_latency->total, status);
+
+      p_log_latency->parse.reset();
+      p_log_latency->publish.reset();
+      p_log_latency->total.reset();
+
+      diagnostics.status.push_back(status);
+    }
+  }
+
+  if (m_diagnostics_pub_)
+  {
+    m_diagnostics_pub_->publish(diagnostics);
+  }
+}
@@ -0,0 +1,481 @@
+// File header
+#include "mag_calibrator.h"
+
+// Standard headers
+#include <fstream>
+
+// Boost headers
+#include <boost/date_time/local_time/local_time.hpp>
+
+using namespace std;
+using sbg::MagCalibrator;
+
+// From ros_com/recorder
+std::string timeToStr() //rclcpp::WallTimer<std::function<void()>> ros_t) //TODO: FIXME
+{
+    //(void)ros_t;
+    std::stringstream msg;
+    const boost::posix_time::ptime now = boost::posix_time::second_clock::local_time();
+    boost::posix_time::time_facet *const f = new boost::posix_time::time_facet("%Y-%m-%d-%H-%M-%S");
+    msg.imbue(std::locale(msg.getloc(),f));
+    msg << now;
+    return msg.str();
+}
+
+//
+// Static magnetometers maps definition.
+//
+std::map<SbgEComMagCalibQuality, std::string> MagCalibrator::g_mag_calib_quality_ = { {SBG_ECOM_MAG_CALIB_QUAL_OPTIMAL, "Quality: optimal"},
+                                                                                      {SBG_ECOM_MAG_CALIB_QUAL_GOOD, "Quality: good"},
+                                                                                      {SBG_ECOM_MAG_CALIB_QUAL_POOR, "Quality: poor"},
+                                                                                      {SBG_ECOM_MAG_CALIB_QUAL_INVALID, "Quality: invalid"}};
+
+std::map<SbgEComMagCalibConfidence, std::string> MagCalibrator::g_mag_calib_confidence_ = { {SBG_ECOM_MAG_CALIB_TRUST_HIGH, "Confidence: high"},
+                                                                                            {SBG_ECOM_MAG_CALIB_TRUST_MEDIUM, "Confidence: medium"},
+                                                                                            {SBG_ECOM_MAG_CALIB_TRUST_LOW, "Confidence: low"}};
+
+std::map<SbgEComMagCalibMode, std::string> MagCalibrator::g_mag_calib_mode_ = { {SBG_ECOM_MAG_CALIB_MODE_2D, "Mode 2D"},
+                                                                                {SBG_ECOM_MAG_CALIB_MODE_3D, "Mode 3D"}};
+
+std::map<SbgEComMagCalibBandwidth, std::string> MagCalibrator::g_mag_calib_bandwidth = {{SBG_ECOM_MAG_CALIB_HIGH_BW, "High Bandwidth"},
+                                                                                        {SBG_ECOM_MAG_CALIB_MEDIUM_BW, "Medium Bandwidth"},
+                                                                                        {SBG_ECOM_MAG_CALIB_LOW_BW, "Low Bandwidth"}};
+
+/*!
+ * Class to calibrate the magnetometers of the connected device.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+MagCalibrator::MagCalibrator(SbgEComHandle &ref_sbg_com_handle, AsyncCommandQueue &ref_command_queue):
+m_ref_sbg_com_handle_(ref_sbg_com_handle),
+m_ref_command_queue_(ref_command_queue),
+m_mag_calib_mode_(SBG_ECOM_MAG_CALIB_MODE_2D),
+m_mag_calib_bandwidth_(SBG_ECOM_MAG_CALIB_HIGH_BW),
+m_pending_command_(Command::NONE),
+m_mag_calibration_ongoing_(false),
+m_mag_calibration_done_(false),
+m_mag_calib_results_()
+{
+
+}
+
+//---------------------------------------------------------------------//
+//- Private methods                                                   -//
+//---------------------------------------------------------------------//
+
+void MagCalibrator::onCommandAnswerCallback(SbgErrorCode error_code, const uint8_t *p_payload, size_t payload_size, void *p_user_arg)
+{
+  assert(p_user_arg);
+
+  static_cast<MagCalibrator*>(p_user_arg)->onCommandAnswer(error_code, p_payload, payload_size);
+}
+
+void MagCalibrator::onCommandAnswer(SbgErrorCode error_code, const uint8_t *p_payload, size_t payload_size)
+{
+  Command command;
+
+  command             = m_pending_command_;
+  m_pending_command_  = Command::NONE;
+
+  if (command == Command::START)
+  {
+    if (error_code != SBG_NO_ERROR)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Unable to start the magnetometer calibration : %s", sbgErrorCodeToString(error_code));
+      publishStatus(diagnostic_msgs::msg::DiagnosticStatus::ERROR, "Unable to start magnetometers calibration.");
+    }
+    else
+    {
+      m_mag_calibration_ongoing_ = true;
+
+      RCLCPP_INFO(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Start calibration");
+      RCLCPP_INFO(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Mode : %s", g_mag_calib_mode_[m_mag_calib_mode_].c_str());
+      RCLCPP_INFO(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Bandwidth : %s", g_mag_calib_bandwidth[m_mag_calib_bandwidth_].c_str());
+      publishStatus(diagnostic_msgs::msg::DiagnosticStatus::OK, "Magnetometer calibration process started.");
+    }
+  }
+  else if (command == Command::COMPUTE)
+  {
+    //
+    // The acquisition is over once the computation has been requested, whatever its result.
+    //
+    m_mag_calibration_ongoing_ = false;
+
+    if ((error_code == SBG_NO_ERROR) && !readCalibrationResults(p_payload, payload_size))
+    {
+      error_code = SBG_INVALID_FRAME;
+    }
+
+    if (error_code != SBG_NO_ERROR)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Unable to compute the magnetometer calibration results : %s", sbgErrorCodeToString(error_code));
+      publishStatus(diagnostic_msgs::msg::DiagnosticStatus::ERROR, "Unable to end the calibration.");
+    }
+    else
+    {
+      m_mag_calibration_done_ = true;
+
+      displayMagCalibrationStatusResult();
+      exportMagCalibrationResults();
+
+      if (m_mag_calib_results_.quality == SBG_ECOM_MAG_CALIB_QUAL_INVALID)
+      {
+        publishStatus(diagnostic_msgs::msg::DiagnosticStatus::WARN, "Magnetometer calibration is finished, the calibration is invalid.");
+      }
+      else
+      {
+        publishStatus(diagnostic_msgs::msg::DiagnosticStatus::OK, "Magnetometer calibration is finished.");
+      }
+    }
+  }
+  else if (command == Command::SET_DATA)
+  {
+    if (error_code != SBG_NO_ERROR)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Unable to set the magnetometers calibration data to the device : %s", sbgErrorCodeToString(error_code));
+      publishStatus(diagnostic_msgs::msg::DiagnosticStatus::ERROR, "Magnetometer calibration has not been uploaded to the device.");
+    }
+    else
+    {
+      uint8_t action;
+
+      RCLCPP_INFO(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Saving data to the device");
+
+      action      = SBG_ECOM_SAVE_SETTINGS;
+      error_code  = sendCommand(Command::SAVE, SBG_ECOM_CMD_SETTINGS_ACTION, &action, sizeof(action), AsyncAnswerType::ACK, m_ref_sbg_com_handle_.cmdDefaultTimeOut);
+
+      if (error_code != SBG_NO_ERROR)
+      {
+        RCLCPP_ERROR(rclcpp::get_logger("MagCalib"), "Unable to save the settings on the SBG device - %s", sbgErrorCodeToString(error_code));
+        publishStatus(diagnostic_msgs::msg::DiagnosticStatus::ERROR, "Magnetometer calibration has been uploaded to the device but not saved.");
+      }
+    }
+  }
+  else if (command == Command::SAVE)
+  {
+    if (error_code != SBG_NO_ERROR)
+    {
+      RCLCPP_ERROR(rclcpp::get_logger("MagCalib"), "Unable to save the settings on the SBG device - %s", sbgErrorCodeToString(error_code));
+      publishStatus(diagnostic_msgs::msg::DiagnosticStatus::ERROR, "Magnetometer calibration has been uploaded to the device but not saved.");
+    }
+    else
+    {
+      RCLCPP_INFO(rclcpp::get_logger("MagCalib"), "SBG_DRIVER - Settings saved and device rebooted.");
+      publishStatus(diagnostic_msgs::msg::DiagnosticStatus::OK, "Magnetometer calibration has been uploaded to the device.");
+    }
+  }
+}
+
+SbgErrorCode MagCalibrator::sendCommand(Command command, uint8_t msg, const void *p_data, size_t size, AsyncAnswerType answer_type, uint32_t time_out)
+{
+  SbgErrorCode error_code;
+
+  error_code = m_ref_command_queue_.send(SBG_ECOM_CLASS_LOG_CMD_0, msg, p_data, size, answer_type, 0, time_out, onCommandAnswerCallback, this);
+
+  if (error_code == SBG_NO_ERROR)
+  {
+    m_pending_command_ = command;
+  }
+
+  return error_code;
+}
+
+bool MagCalibrator::readCalibrationResults(const uint8_t *p_payload, size_t payload_size)
+{
+  SbgStreamBuffer input_stream;
+
+  sbgStreamBufferInitForRead(&input_stream, p_payload, payload_size);
+
+  m_mag_calib_results_.quality          = static_cast<SbgEComMagCalibQuality>(sbgStreamBufferReadUint8LE(&input_stream));
+  m_mag_calib_results_.confidence       = static_cast<SbgEComMagCalibConfidence>(sbgStreamBufferReadUint8LE(&input_stream));
+  m_mag_calib_results_.advancedStatus   = sbgStreamBufferReadUint16LE(&input_stream);
+
+  m_mag_calib_results_.beforeMeanError  = sbgStreamBufferReadFloatLE(&input_stream);
+  m_mag_calib_results_.beforeStdError   = sbgStreamBufferReadFloatLE(&input_stream);
+  m_mag_calib_results_.beforeMaxError   = sbgStreamBufferReadFloatLE(&input_stream);
+
+  m_mag_calib_results_.afterMeanError   = sbgStreamBufferReadFloatLE(&input_stream);
+  m_mag_calib_results_.afterStdError    = sbgStreamBufferReadFloatLE(&input_stream);
+  m_mag_calib_results_.afterMaxError    = sbgStreamBufferReadFloatLE(&input_stream);
+
+  m_mag_calib_results_.meanAccuracy     = sbgStreamBufferReadFloatLE(&input_stream);
+  m_mag_calib_results_.stdAccuracy      = sbgStreamBufferReadFloatLE(&input_stream);
+  m_mag_calib_results_.maxAccuracy      = sbgStreamBufferReadFloatLE(&input_stream);
+
+  m_mag_calib_results_.numPoints        = sbgStreamBufferReadUint16LE(&input_stream);
+  m_mag_calib_results_.maxNumPoints     = sbgStreamBufferReadUint16LE(&input_stream);
+
+  for (size_t i = 0; i < 3; i++)
+  {
+    m_mag_calib_results_.offset[i] = sbgStreamBufferReadFloatLE(&input_stream);
+  }
+
+  for (size_t i = 0; i < 9; i++)
+  {
+    m_mag_calib_results_.matrix[i] = sbgStreamBufferReadFloatLE(&input_stream);
+  }
+
+  return sbgStreamBufferGetLastError(&input_stream) == SBG_NO_ERROR;
+}
+
+void MagCalibrator::publishStatus(uint8_t level, const std::string &ref_message)
+{
+  diagnostic_msgs::msg::DiagnosticStatus  status;
+  diagnostic_msgs::msg::KeyValue          key_value;
+
+  if (!m_status_pub_)
+  {
+    return;
+  }
+
+  status.level    = level;
+  status.name     = "sbg_driver: Magnetometers calibration";
+  status.message  = ref_message;
+
+  if (m_mag_calibration_done_)
+  {
+    key_value.key   = "quality";
+    key_value.value = g_mag_calib_quality_[m_mag_calib_results_.quality];
+    status.values.push_back(key_value);
+
+    key_value.key   = "confidence";
+    key_value.value = g_mag_calib_confidence_[m_mag_calib_results_.confidence];
+    status.values.push_back(key_value);
+
+    key_value.key   = "used_points";
+    key_value.value = std::to_string(m_mag_calib_results_.numPoints) + "/" + std::to_string(m_mag_calib_results_.maxNumPoints);
+    status.values.push_back(key_value);
+  }
+
+  m_status_pub_->publish(status);
+}
+
+void MagCalibrator::processMagCalibration(const std::shared_ptr<std_srvs::srv::Trigger::Request> ref_ros_request, std::shared_ptr<std_srvs::srv::Trigger::Response> ref_ros_response)
+{
+  SbgErrorCode error_code;
+
+  SBG_UNUSED_PARAMETER(ref_ros_request);
+
+  //
+  // The services only send the commands, their results are reported once the device loop receives the answers.
+  //
+  if (m_pending_command_ != Command::NONE)
+  {
+    ref_ros_response->success = false;
+    ref_ros_response->message = "A magnetometer calibration command is still pending.";
+  }
+  else if (m_mag_calibration_ongoing_)
+  {
+    error_code = sendCommand(Command::COMPUTE, SBG_ECOM_CMD_COMPUTE_MAG_CALIB, nullptr, 0, AsyncAnswerType::PAYLOAD, SBG_MAG_CALIB_COMPUTE_TIME_OUT);
+
+    if (error_code != SBG_NO_ERROR)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Unable to compute the magnetometer calibration results : %s", sbgErrorCodeToString(error_code));
+      ref_ros_response->success = false;
+      ref_ros_response->message = "Unable to end the calibration.";
+    }
+    else
+    {
+      ref_ros_response->success = true;
+      ref_ros_response->message = "Magnetometer calibration end requested. See the output console or sbg/mag_calibration_status to get calibration informations.";
+    }
+  }
+  else
+  {
+    uint8_t payload[2];
+
+    payload[0] = static_cast<uint8_t>(m_mag_calib_mode_);
+    payload[1] = static_cast<uint8_t>(m_mag_calib_bandwidth_);
+
+    error_code = sendCommand(Command::START, SBG_ECOM_CMD_START_MAG_CALIB, payload, sizeof(payload), AsyncAnswerType::ACK, m_ref_sbg_com_handle_.cmdDefaultTimeOut);
+
+    if (error_code != SBG_NO_ERROR)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Unable to start the magnetometer calibration : %s", sbgErrorCodeToString(error_code));
+      ref_ros_response->success = false;
+      ref_ros_response->message = "Unable to start magnetometers calibration.";
+    }
+    else
+    {
+      ref_ros_response->success = true;
+      ref_ros_response->message = "Magnetometer calibration start requested. See sbg/mag_calibration_status to know when it has started.";
+    }
+  }
+}
+
+void MagCalibrator::saveMagCalibration(const std::shared_ptr<std_srvs::srv::Trigger::Request> ref_ros_request, std::shared_ptr<std_srvs::srv::Trigger::Response> ref_ros_response)
+{
+  SBG_UNUSED_PARAMETER(ref_ros_request);
+
+  if (m_pending_command_ != Command::NONE)
+  {
+    ref_ros_response->success = false;
+    ref_ros_response->message = "A magnetometer calibration command is still pending.";
+  }
+  else if (m_mag_calibration_ongoing_)
+  {
+    ref_ros_response->success = false;
+    ref_ros_response->message = "Magnetometer calibration process is still ongoing, finish it before trying to save it.";
+  }
+  else if (!m_mag_calibration_done_)
+  {
+    ref_ros_response->success = false;
+    ref_ros_response->message = "No magnetometer calibration has been done.";
+  }
+  else if (m_mag_calib_results_.quality == SBG_ECOM_MAG_CALIB_QUAL_INVALID)
+  {
+    RCLCPP_ERROR(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - The calibration was invalid, it can't be uploaded on the device.");
+    ref_ros_response->success = false;
+    ref_ros_response->message = "Magnetometer calibration has not been uploaded to the device.";
+  }
+  else
+  {
+    SbgErrorCode    error_code;
+    SbgStreamBuffer output_stream;
+    uint8_t         payload[12 * sizeof(float)];
+
+    sbgStreamBufferInitForWrite(&output_stream, payload, sizeof(payload));
+
+    for (size_t i = 0; i < 3; i++)
+    {
+      sbgStreamBufferWriteFloatLE(&output_stream, m_mag_calib_results_.offset[i]);
+    }
+
+    for (size_t i = 0; i < 9; i++)
+    {
+      sbgStreamBufferWriteFloatLE(&output_stream, m_mag_calib_results_.matrix[i]);
+    }
+
+    error_code = sendCommand(Command::SET_DATA, SBG_ECOM_CMD_SET_MAG_CALIB, payload, sbgStreamBufferGetLength(&output_stream), AsyncAnswerType::ACK, m_ref_sbg_com_handle_.cmdDefaultTimeOut);
+
+    if (error_code != SBG_NO_ERROR)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Unable to set the magnetometers calibration data to the device : %s", sbgErrorCodeToString(error_code));
+      ref_ros_response->success = false;
+      ref_ros_response->message = "Magnetometer calibration has not been uploaded to the device.";
+    }
+    else
+    {
+      ref_ros_response->success = true;
+      ref_ros_response->message = "Magnetometer calibration upload requested. See sbg/mag_calibration_status to know when it has been saved.";
+    }
+  }
+}
+
+void MagCalibrator::displayMagCalibrationStatusResult(void) const
+{
+  RCLCPP_INFO(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Quality of the calibration %s", g_mag_calib_quality_[m_mag_calib_results_.quality].c_str());
+  RCLCPP_INFO(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Calibration results confidence %s", g_mag_calib_confidence_[m_mag_calib_results_.confidence].c_str());
+
+  //
+  // Check the magnetometers calibration status and display the warnings.
+  //
+  if (m_mag_calib_results_.advancedStatus & SBG_ECOM_MAG_CALIB_NOT_ENOUGH_POINTS)
+  {
+    RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Not enough valid points. Maybe you are moving too fast");
+  }
+  if (m_mag_calib_results_.advancedStatus & SBG_ECOM_MAG_CALIB_TOO_MUCH_DISTORTIONS)
+  {
+    RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Unable to find a calibration solution. Maybe there are too much non static distortions");
+  }
+  if (m_mag_calib_results_.advancedStatus & SBG_ECOM_MAG_CALIB_ALIGNMENT_ISSUE)
+  {
+    RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - The magnetic calibration has troubles to correct the magnetometers and inertial frame alignment");
+  }
+  if (m_mag_calib_mode_ == SBG_ECOM_MAG_CALIB_MODE_2D)
+  {
+    if (m_mag_calib_results_.advancedStatus & SBG_ECOM_MAG_CALIB_X_MOTION_ISSUE)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Too much roll motion for a 2D magnetic calibration");
+    }
+    if (m_mag_calib_results_.advancedStatus & SBG_ECOM_MAG_CALIB_Y_MOTION_ISSUE)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Too much pitch motion for a 2D magnetic calibration");
+    }
+  }
+  else
+  {
+    if (m_mag_calib_results_.advancedStatus & SBG_ECOM_MAG_CALIB_X_MOTION_ISSUE)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Not enough roll motion for a 3D magnetic calibration");
+    }
+    if (m_mag_calib_results_.advancedStatus & SBG_ECOM_MAG_CALIB_Y_MOTION_ISSUE)
+    {
+      RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Not enough pitch motion for a 3D magnetic calibration.");
+    }
+  }
+  if (m_mag_calib_results_.advancedStatus & SBG_ECOM_MAG_CALIB_Z_MOTION_ISSUE)
+  {
+    RCLCPP_WARN(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Not enough yaw motion to compute a valid magnetic calibration");
+  }
+}
+
+void MagCalibrator::exportMagCalibrationResults(void) const
+{
+  ostringstream mag_results_stream;
+  string        output_filename;
+
+  mag_results_stream << "SBG DRIVER [Mag Calib]" << endl;
+  mag_results_stream << "======= Parameters =======" << endl;
+  mag_results_stream << "* CALIB_MODE = " << g_mag_calib_mode_[m_mag_calib_mode_] << endl;
+  mag_results_stream << "* CALIB_BW = " << g_mag_calib_bandwidth[m_mag_calib_bandwidth_] << endl;
+
+  mag_results_stream << "======= Results =======" << endl;
+  mag_results_stream << g_mag_calib_quality_[m_mag_calib_results_.quality] << endl;
+  mag_results_stream << g_mag_calib_confidence_[m_mag_calib_results_.confidence] << endl;
+  mag_results_stream << "======= Infos =======" << endl;
+  mag_results_stream << "* Used points : " << m_mag_calib_results_.numPoints << "/" << m_mag_calib_results_.maxNumPoints << endl;
+  mag_results_stream << "* Mean, Std, Max" << endl;
+  mag_results_stream << "[Before]\t" << m_mag_calib_results_.beforeMeanError << "\t" <<  m_mag_calib_results_.beforeStdError << "\t" << m_mag_calib_results_.beforeMaxError << endl;
+  mag_results_stream << "[After]\t" << m_mag_calib_results_.afterMeanError << "\t" << m_mag_calib_results_.afterStdError << "\t" << m_mag_calib_results_.afterMaxError << endl;
+  mag_results_stream << "[Accuracy]\t" << sbgRadToDegF(m_mag_calib_results_.meanAccuracy) << "\t" << sbgRadToDegF(m_mag_calib_results_.stdAccuracy) << "\t" << sbgRadToDegF(m_mag_calib_results_.maxAccuracy) << endl;
+  mag_results_stream << "* Offset\t" << m_mag_calib_results_.offset[0] << "\t" << m_mag_calib_results_.offset[1] << "\t" << m_mag_calib_results_.offset[2] << endl;
+
+  mag_results_stream << "* Matrix" << endl;
+  mag_results_stream << m_mag_calib_results_.matrix[0] << "\t" << m_mag_calib_results_.matrix[1] << "\t" << m_mag_calib_results_.matrix[2] << endl;
+  mag_results_stream << m_mag_calib_results_.matrix[3] << "\t" << m_mag_calib_results_.matrix[4] << "\t" << m_mag_calib_results_.matrix[5] << endl;
+  mag_results_stream << m_mag_calib_results_.matrix[6] << "\t" << m_mag_calib_results_.matrix[7] << "\t" << m_mag_calib_results_.matrix[8] << endl;
+
+  output_filename = "mag_calib_" + timeToStr()/*(nullptrrclcpp::WallTimer::now())*/ + ".txt";
+  ofstream output_file(output_filename);
+  output_file << mag_results_stream.str();
+  output_file.close();
+
+  RCLCPP_INFO(rclcpp::get_logger("MagCalib"), "%s", mag_results_stream.str().c_str());
+  RCLCPP_INFO(rclcpp::get_logger("MagCalib"), "SBG DRIVER [Mag Calib] - Magnetometers calibration results saved to file %s", output_filename.c_str());
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+bool MagCalibrator::isCommandPending(void) const
+{
+  return m_pending_command_ != Command::NONE;
+}
+
+bool MagCalibrator::isCalibrationOngoing(void) const
+{
+  return m_mag_calibration_ongoing_;
+}
+
+bool MagCalibrator::isCalibrationDone(void) const
+{
+  return m_mag_calibration_done_;
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void MagCalibrator::initServices(rclcpp::Node &ref_ros_node_handle, const ConfigStore &ref_config_store)
+{
+  m_mag_calib_mode_       = ref_config_store.getMagnetometerCalibMode();
+  m_mag_calib_bandwidth_  = ref_config_store.getMagnetometerCalibBandwidth();
+
+  m_status_pub_         = ref_ros_node_handle.create_publisher<diagnostic_msgs::msg::DiagnosticStatus>("sbg/mag_calibration_status", 10);
+  m_calib_service_      = ref_ros_node_handle.create_service<std_srvs::srv::Trigger>("sbg/mag_calibration", std::bind(&MagCalibrator::processMagCalibration, this, std::placeholders::_1, std::placeholders::_2));
+  m_calib_save_service_ = ref_ros_node_handle.create_service<std_srvs::srv::Trigger>("sbg/mag_calibration_save", std::bind(&MagCalibrator::saveMagCalibration, this, std::placeholders::_1, std::placeholders::_2));
+}
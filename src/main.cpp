@@ -21,9 +21,16 @@ int main(int argc, char **argv)
     RCLCPP_INFO(node_handle.get_logger(), "SBG DRIVER - ROS Node frequency : %u Hz", loopFrequency);
     rclcpp::Rate loop_rate(loopFrequency);
 
+    //
+    // The node services are served between two device handle calls.
+    //
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(node_handle.get_node_base_interface());
+
     while (rclcpp::ok())
     {
       sbg_device.periodicHandle();
+      executor.spin_some();
       loop_rate.sleep();
     }
 
@@ -5,22 +5,38 @@ using sbg::SbgDevice;
 int main(int argc, char **argv)
 {
   rclcpp::init(argc, argv);
-  rclcpp::Node::SharedPtr node_handle;
+  rclcpp::Node node_handle("sbg_device_mag");
 
   try
   {
-    RCLCPP_INFO(node_handle->get_logger(), "SBG DRIVER - Init node, load params and connect to the device");
-    SbgDevice sbg_device(*node_handle);
-    
+    uint32_t loopFrequency;
+
+    RCLCPP_INFO(node_handle.get_logger(), "SBG DRIVER - Init node, load params and connect to the device");
+    SbgDevice sbg_device(node_handle);
+
     sbg_device.initDeviceForMagCalibration();
-    
-    rclcpp::spin(node_handle);
+
+    loopFrequency = sbg_device.getUpdateFrequency();
+    rclcpp::Rate loop_rate(loopFrequency);
+
+    //
+    // The calibration services only send the commands, their answers are received by the device handle.
+    //
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(node_handle.get_node_base_interface());
+
+    while (rclcpp::ok())
+    {
+      sbg_device.periodicHandle();
+      executor.spin_some();
+      loop_rate.sleep();
+    }
 
     return 0;
   }
   catch (std::exception const& refE)
   {
-    RCLCPP_ERROR(node_handle->get_logger(), "SBG_DRIVER - [MagNode] Error - %s.", refE.what());
+    RCLCPP_ERROR(node_handle.get_logger(), "SBG_DRIVER - [MagNode] Error - %s.", refE.what());
   }
 
   return 0;
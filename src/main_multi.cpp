@@ -0,0 +1,41 @@
+#include <sbg_device_manager.h>
+
+using sbg::SbgDeviceManager;
+
+int main(int argc, char **argv)
+{
+  rclcpp::init(argc, argv);
+
+  rclcpp::NodeOptions node_opt;
+  node_opt.automatically_declare_parameters_from_overrides(true);
+  rclcpp::Node node_handle("sbg_device_manager", node_opt);
+
+  try
+  {
+    uint32_t loopFrequency;
+
+    RCLCPP_INFO(node_handle.get_logger(), "SBG DRIVER - Init manager, load params and connect to the devices.");
+    SbgDeviceManager sbg_device_manager(node_handle);
+
+    RCLCPP_INFO(node_handle.get_logger(), "SBG DRIVER - Initialize %zu devices for receiving data", sbg_device_manager.getDeviceCount());
+    sbg_device_manager.initDevicesForReceivingData();
+
+    loopFrequency = sbg_device_manager.getUpdateFrequency();
+    RCLCPP_INFO(node_handle.get_logger(), "SBG DRIVER - ROS Node frequency : %u Hz", loopFrequency);
+    rclcpp::Rate loop_rate(loopFrequency);
+
+    while (rclcpp::ok())
+    {
+      sbg_device_manager.periodicHandle();
+      loop_rate.sleep();
+    }
+
+    return 0;
+  }
+  catch (std::exception const& refE)
+  {
+    RCLCPP_ERROR(node_handle.get_logger(), "SBG_DRIVER - %s", refE.what());
+  }
+
+  return 0;
+}
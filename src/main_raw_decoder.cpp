@@ -0,0 +1,25 @@
+#include <raw_frame_decoder.h>
+
+using sbg::RawFrameDecoder;
+
+int main(int argc, char **argv)
+{
+  rclcpp::init(argc, argv);
+  rclcpp::Node::SharedPtr node_handle = std::make_shared<rclcpp::Node>("sbg_raw_decoder");
+
+  try
+  {
+    RCLCPP_INFO(node_handle->get_logger(), "SBG DRIVER - Init raw frames decoder and load params.");
+    RawFrameDecoder raw_frame_decoder(*node_handle);
+
+    rclcpp::spin(node_handle);
+
+    return 0;
+  }
+  catch (std::exception const& refE)
+  {
+    RCLCPP_ERROR(node_handle->get_logger(), "SBG_DRIVER - %s", refE.what());
+  }
+
+  return 0;
+}
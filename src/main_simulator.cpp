@@ -0,0 +1,134 @@
+#include <device_simulator.h>
+
+// Standard headers
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+using sbg::DeviceSimulator;
+
+namespace
+{
+volatile bool g_stop = false;
+
+void handleSignal(int signal)
+{
+  (void)signal;
+  g_stop = true;
+}
+
+void printUsage(const char *p_program)
+{
+  printf("Usage: %s [--pty <link> | --udp <driver_ip> <in_port> <out_port>] [options]\n"
+         "  --pty <link>             Open a pseudo terminal and link it to <link> (default).\n"
+         "  --udp <ip> <in> <out>    Send logs to <ip>:<out> and receive commands on <in>, as in the driver ipConf.\n"
+         "  --log <name>=<rate>      Output a log at <rate> Hz, for example imu_data=1000 (repeatable).\n"
+         "  --corrupt <ratio>        Ratio of frames corrupted or preceded by garbage, between 0 and 1.\n"
+         "  --burst <ms>             Write the frames in bursts every <ms> milliseconds.\n"
+         "  --duration <s>           Stop after <s> seconds.\n"
+         "  --serial <number>        Device serial number.\n", p_program);
+}
+}
+
+int main(int argc, char **argv)
+{
+  DeviceSimulator::Config config;
+
+  config.use_udp          = false;
+  config.pty_link         = "/tmp/sbg_simulator";
+  config.udp_address      = sbgNetworkIpFromString("127.0.0.1");
+  config.udp_in_port      = 1234;
+  config.udp_out_port     = 5678;
+  config.corruption_ratio = 0.0;
+  config.burst_period     = 0;
+  config.duration         = 0;
+  config.serial_number    = 45000000;
+
+  for (int i = 1; i < argc; i++)
+  {
+    std::string argument(argv[i]);
+
+    if ((argument == "--pty") && (i + 1 < argc))
+    {
+      config.use_udp  = false;
+      config.pty_link = argv[++i];
+    }
+    else if ((argument == "--udp") && (i + 3 < argc))
+    {
+      config.use_udp      = true;
+      config.udp_address  = sbgNetworkIpFromString(argv[++i]);
+      config.udp_in_port  = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+      config.udp_out_port = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    }
+    else if ((argument == "--log") && (i + 1 < argc))
+    {
+      std::string   log_option(argv[++i]);
+      size_t        separator = log_option.find('=');
+      SbgEComMsgId  msg_id;
+
+      if ((separator == std::string::npos) || !DeviceSimulator::getLogId(log_option.substr(0, separator), msg_id))
+      {
+        fprintf(stderr, "SBG_SIMULATOR - Unknown log %s\n", log_option.c_str());
+        return 1;
+      }
+
+      config.log_rates[msg_id] = strtod(log_option.c_str() + separator + 1, nullptr);
+    }
+    else if ((argument == "--corrupt") && (i + 1 < argc))
+    {
+      config.corruption_ratio = strtod(argv[++i], nullptr);
+    }
+    else if ((argument == "--burst") && (i + 1 < argc))
+    {
+      config.burst_period = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    }
+    else if ((argument == "--duration") && (i + 1 < argc))
+    {
+      config.duration = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    }
+    else if ((argument == "--serial") && (i + 1 < argc))
+    {
+      config.serial_number = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    }
+    else
+    {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  //
+  // Without explicit logs, output the default driver configuration mix.
+  //
+  if (config.log_rates.empty())
+  {
+    config.log_rates[SBG_ECOM_LOG_STATUS]     = 25.0;
+    config.log_rates[SBG_ECOM_LOG_UTC_TIME]   = 25.0;
+    config.log_rates[SBG_ECOM_LOG_IMU_DATA]   = 200.0;
+    config.log_rates[SBG_ECOM_LOG_EKF_EULER]  = 25.0;
+    config.log_rates[SBG_ECOM_LOG_EKF_QUAT]   = 25.0;
+    config.log_rates[SBG_ECOM_LOG_EKF_NAV]    = 25.0;
+    config.log_rates[SBG_ECOM_LOG_GPS1_VEL]   = 5.0;
+    config.log_rates[SBG_ECOM_LOG_GPS1_POS]   = 5.0;
+    config.log_rates[SBG_ECOM_LOG_GPS1_HDT]   = 5.0;
+  }
+
+  signal(SIGINT, handleSignal);
+  signal(SIGTERM, handleSignal);
+
+  try
+  {
+    DeviceSimulator simulator(config);
+
+    simulator.run(g_stop);
+  }
+  catch (std::exception const& refE)
+  {
+    fprintf(stderr, "%s\n", refE.what());
+    return 1;
+  }
+
+  return 0;
+}
@@ -1,6 +1,27 @@
 #include "message_publisher.h"
 
+/*!
+ * Maximum number of events waiting for the EKF logs after them.
+ */
+#define SBG_EVENT_POSE_MAX_PENDING  (64)
+
+/*!
+ * Maximum number of events of a marker log, its time stamp and its four time offsets.
+ */
+#define SBG_EVENT_POSE_MAX_PER_LOG  (5)
+
+/*!
+ * Number of EKF logs kept to interpolate the event poses if the pose history isn't enabled.
+ */
+#define SBG_EVENT_POSE_HISTORY_SIZE (64)
+
+/*!
+ * Gap between two IMU messages above which the decimation filters restart (ns).
+ */
+#define SBG_DECIMATION_MAX_GAP      (100000000)
+
 using sbg::MessagePublisher;
+using sbg::AlignStatus;
 
 /*!
  * Class to publish all SBG-ROS messages to the corresponding publishers. 
@@ -10,7 +31,19 @@ using sbg::MessagePublisher;
 //---------------------------------------------------------------------//
 
 MessagePublisher::MessagePublisher(void):
-m_max_messages_(10)
+MessagePublisher("")
+{
+}
+
+MessagePublisher::MessagePublisher(const std::string &ref_node_namespace):
+m_alignment_max_gap_(50000),
+m_message_wrapper_(ref_node_namespace),
+m_max_messages_(10),
+m_odom_publish_tf_(false),
+m_status_on_change_(false),
+m_status_heartbeat_(0),
+m_status_change_(),
+m_utc_status_change_()
 {
 }
 
@@ -18,6 +51,38 @@ m_max_messages_(10)
 //- Private methods                                                   -//
 //---------------------------------------------------------------------//
 
+bool MessagePublisher::isStatusPublished(StatusChange &ref_status_change, const std::array<uint32_t, 3> &ref_bitmasks, uint32_t time_stamp)
+{
+  bool heartbeat;
+
+  if (!m_status_on_change_)
+  {
+    return true;
+  }
+
+  heartbeat = (m_status_heartbeat_ != 0) && (static_cast<int32_t>(time_stamp - ref_status_change.time_stamp) >= static_cast<int32_t>(m_status_heartbeat_));
+
+  //
+  // A backward time stamp means the device restarted, so the status is published again.
+  //
+  if (ref_status_change.published && (ref_status_change.bitmasks == ref_bitmasks) && !heartbeat
+   && (static_cast<int32_t>(time_stamp - ref_status_change.time_stamp) >= 0))
+  {
+    return false;
+  }
+
+  ref_status_change.published   = true;
+  ref_status_change.bitmasks    = ref_bitmasks;
+  ref_status_change.time_stamp  = time_stamp;
+
+  return true;
+}
+
+bool MessagePublisher::isOdometryConsumed(void) const
+{
+  return m_odometry_pub_ && (m_odom_publish_tf_ || (m_odometry_pub_->get_subscription_count() > 0));
+}
+
 std::string MessagePublisher::getOutputTopicName(SbgEComMsgId sbg_message_id) const
 {
   switch (sbg_message_id)
@@ -85,6 +150,27 @@ std::string MessagePublisher::getOutputTopicName(SbgEComMsgId sbg_message_id) co
   case SBG_ECOM_LOG_IMU_SHORT:
     return "sbg/imu_short";
 
+  case SBG_ECOM_LOG_DVL_BOTTOM_TRACK:
+    return "sbg/dvl_bottom_track";
+
+  case SBG_ECOM_LOG_DVL_WATER_TRACK:
+    return "sbg/dvl_water_track";
+
+  case SBG_ECOM_LOG_USBL:
+    return "sbg/usbl";
+
+  case SBG_ECOM_LOG_DEPTH:
+    return "sbg/depth";
+
+  case SBG_ECOM_LOG_EVENT_OUT_A:
+    return "sbg/event_out_a";
+
+  case SBG_ECOM_LOG_EVENT_OUT_B:
+    return "sbg/event_out_b";
+
+  case SBG_ECOM_LOG_DIAG:
+    return "sbg/diag";
+
   default:
     return "undefined";
   }
@@ -201,6 +287,41 @@ void MessagePublisher::initPublisher(rclcpp::Node& ref_ros_node_handle, SbgEComM
         m_SbgAirData_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgAirData>(ref_output_topic, m_max_messages_);
         break;
 
+      case SBG_ECOM_LOG_DVL_BOTTOM_TRACK:
+
+        m_sbgDvlBottomTrack_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgDvl>(ref_output_topic, m_max_messages_);
+        break;
+
+      case SBG_ECOM_LOG_DVL_WATER_TRACK:
+
+        m_sbgDvlWaterTrack_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgDvl>(ref_output_topic, m_max_messages_);
+        break;
+
+      case SBG_ECOM_LOG_USBL:
+
+        m_sbgUsbl_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgUsbl>(ref_output_topic, m_max_messages_);
+        break;
+
+      case SBG_ECOM_LOG_DEPTH:
+
+        m_sbgDepth_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgDepth>(ref_output_topic, m_max_messages_);
+        break;
+
+      case SBG_ECOM_LOG_EVENT_OUT_A:
+
+        m_sbgEventOutA_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgEvent>(ref_output_topic, m_max_messages_);
+        break;
+
+      case SBG_ECOM_LOG_EVENT_OUT_B:
+
+        m_sbgEventOutB_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgEvent>(ref_output_topic, m_max_messages_);
+        break;
+
+      case SBG_ECOM_LOG_DIAG:
+
+        m_sbgDiag_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgDiag>(ref_output_topic, m_max_messages_);
+        break;
+
       default:
         break;
     }
@@ -300,111 +421,169 @@ void MessagePublisher::defineRosStandardPublishers(rclcpp::Node& ref_ros_node_ha
 
 void MessagePublisher::publishIMUData(const SbgBinaryLogData &ref_sbg_log)
 {
+  m_message_wrapper_.fillSbgImuDataMessage(ref_sbg_log.imuData, m_sbg_imu_message_);
+
   if (m_sbgImuData_pub_)
   {
-    m_sbg_imu_message_ = m_message_wrapper_.createSbgImuDataMessage(ref_sbg_log.imuData);
     m_sbgImuData_pub_->publish(m_sbg_imu_message_);
   }
+  if (m_sbgImuDataDecimated_pub_)
+  {
+    if (m_imu_data_decimator_.push(m_sbg_imu_message_, m_sbg_imu_decimated_message_))
+    {
+      m_sbgImuDataDecimated_pub_->publish(m_sbg_imu_decimated_message_);
+    }
+  }
   if (m_temp_pub_)
   {
-    m_temp_pub_->publish(m_message_wrapper_.createRosTemperatureMessage(m_sbg_imu_message_));
+    m_message_wrapper_.fillRosTemperatureMessage(m_sbg_imu_message_, m_temperature_message_);
+    m_temp_pub_->publish(m_temperature_message_);
   }
 
-  processRosImuMessage();
-  processRosVelMessage();
-  processRosOdoMessage();
-}
+  if (m_imu_preintegrator_.isEnabled())
+  {
+    m_imu_preintegrator_.addImuData(m_sbg_imu_message_);
+  }
 
-void MessagePublisher::processRosVelMessage(void)
-{
-  if (m_velocity_pub_)
+  if (hasAlignedPublishers())
   {
-    if (m_sbgEkfQuat_pub_)
-    {
-      m_velocity_pub_->publish(m_message_wrapper_.createRosTwistStampedMessage(m_sbg_ekf_quat_message_, m_sbg_ekf_nav_message_, m_sbg_imu_message_));
-    }
-    else if (m_sbgEkfEuler_pub_)
-    {
-      m_velocity_pub_->publish(m_message_wrapper_.createRosTwistStampedMessage(m_sbg_ekf_euler_message_, m_sbg_ekf_nav_message_, m_sbg_imu_message_));
-    }
+    m_imu_buffer_.push(m_sbg_imu_message_);
+    processAlignedMessages();
   }
 }
 
-void MessagePublisher::processRosImuMessage(void)
+bool MessagePublisher::hasAlignedPublishers(void) const
 {
-  if (m_imu_pub_)
-  {
-    if (m_sbg_imu_message_.time_stamp == m_sbg_ekf_quat_message_.time_stamp)
-    {
-      m_imu_pub_->publish(m_message_wrapper_.createRosImuMessage(m_sbg_imu_message_, m_sbg_ekf_quat_message_));
-    }
-  }
+  return m_imu_pub_ || m_velocity_pub_ || m_odometry_pub_;
 }
 
-void MessagePublisher::processRosOdoMessage(void)
+void MessagePublisher::processAlignedMessages(void)
 {
-  if (m_odometry_pub_)
+  bool  quat_needed;
+  bool  euler_needed;
+  bool  nav_needed;
+
+  //
+  // Velocity and odometry use the quaternion if available, the euler angles otherwise.
+  // The odometry also uses the euler accuracies with the quaternion.
+  //
+  quat_needed   = m_imu_pub_ || ((m_velocity_pub_ || m_odometry_pub_) && m_sbgEkfQuat_pub_);
+  euler_needed  = (m_velocity_pub_ && !m_sbgEkfQuat_pub_ && m_sbgEkfEuler_pub_) || (m_odometry_pub_ && m_sbgEkfEuler_pub_);
+  nav_needed    = m_velocity_pub_ || m_odometry_pub_;
+
+  while (!m_imu_buffer_.isEmpty())
   {
-    if (m_sbg_ekf_nav_message_.status.position_valid)
+    const sbg_driver::msg::SbgImuData &ref_imu_message = m_imu_buffer_.getOldest();
+    uint32_t                          time_stamp      = ref_imu_message.time_stamp;
+    bool                              can_wait;
+    AlignStatus                       quat_status;
+    AlignStatus                       euler_status;
+    AlignStatus                       nav_status;
+    AlignStatus                       orientation_status;
+
+    can_wait      = static_cast<int32_t>(m_imu_buffer_.getNewest().time_stamp - time_stamp) < static_cast<int32_t>(m_alignment_max_gap_);
+    quat_status   = m_ekf_quat_buffer_.getSample(time_stamp, m_alignment_max_gap_, m_aligned_ekf_quat_message_);
+    euler_status  = m_ekf_euler_buffer_.getSample(time_stamp, m_alignment_max_gap_, m_aligned_ekf_euler_message_);
+    nav_status    = m_ekf_nav_buffer_.getSample(time_stamp, m_alignment_max_gap_, m_aligned_ekf_nav_message_);
+
+    if (can_wait && ((quat_needed && (quat_status == AlignStatus::PENDING)) || (euler_needed && (euler_status == AlignStatus::PENDING))
+                  || (nav_needed && (nav_status == AlignStatus::PENDING))))
+    {
+      break;
+    }
+
+    if (m_imu_pub_ && (quat_status == AlignStatus::ALIGNED))
     {
-      if (m_sbg_imu_message_.time_stamp == m_sbg_ekf_nav_message_.time_stamp)
+      m_message_wrapper_.fillRosImuMessage(ref_imu_message, m_aligned_ekf_quat_message_, m_imu_message_);
+      m_imu_pub_->publish(m_imu_message_);
+
+      if (m_imu_decimated_pub_ && m_imu_decimator_.push(m_imu_message_, m_imu_decimated_message_))
+      {
+        m_imu_decimated_pub_->publish(m_imu_decimated_message_);
+      }
+    }
+
+    orientation_status = m_sbgEkfQuat_pub_ ? quat_status : euler_status;
+
+    if ((nav_status == AlignStatus::ALIGNED) && (orientation_status == AlignStatus::ALIGNED))
+    {
+      if (m_velocity_pub_)
       {
-        /*
-         * Odometry message can be generated from quaternion or euler angles.
-         * Quaternion is prefered if they are available.
-         */
         if (m_sbgEkfQuat_pub_)
         {
-          if (m_sbg_imu_message_.time_stamp == m_sbg_ekf_quat_message_.time_stamp)
-          {
-            m_odometry_pub_->publish(m_message_wrapper_.createRosOdoMessage(m_sbg_imu_message_, m_sbg_ekf_nav_message_, m_sbg_ekf_quat_message_, m_sbg_ekf_euler_message_));
-          }
+          m_message_wrapper_.fillRosTwistStampedMessage(m_aligned_ekf_quat_message_, m_aligned_ekf_nav_message_, ref_imu_message, m_velocity_message_);
         }
         else
         {
-          if (m_sbg_imu_message_.time_stamp == m_sbg_ekf_euler_message_.time_stamp)
+          m_message_wrapper_.fillRosTwistStampedMessage(m_aligned_ekf_euler_message_, m_aligned_ekf_nav_message_, ref_imu_message, m_velocity_message_);
+        }
+
+        m_velocity_pub_->publish(m_velocity_message_);
+      }
+
+      if (m_odometry_pub_ && m_aligned_ekf_nav_message_.status.position_valid)
+      {
+        if (m_sbgEkfQuat_pub_)
+        {
+          //
+          // Without an aligned euler log, the orientation accuracies are unknown.
+          //
+          if (euler_status != AlignStatus::ALIGNED)
           {
-            m_odometry_pub_->publish(m_message_wrapper_.createRosOdoMessage(m_sbg_imu_message_, m_sbg_ekf_nav_message_, m_sbg_ekf_euler_message_));
+            m_aligned_ekf_euler_message_.accuracy = geometry_msgs::msg::Vector3();
           }
+
+          m_message_wrapper_.fillRosOdoMessage(ref_imu_message, m_aligned_ekf_nav_message_, m_aligned_ekf_quat_message_, m_aligned_ekf_euler_message_, m_odometry_message_);
         }
+        else
+        {
+          m_message_wrapper_.fillRosOdoMessage(ref_imu_message, m_aligned_ekf_nav_message_, m_aligned_ekf_euler_message_, m_odometry_message_);
+        }
+
+        m_odometry_pub_->publish(m_odometry_message_);
       }
     }
+
+    m_ekf_quat_buffer_.discardBefore(time_stamp);
+    m_ekf_euler_buffer_.discardBefore(time_stamp);
+    m_ekf_nav_buffer_.discardBefore(time_stamp);
+    m_imu_buffer_.popOldest();
   }
 }
 
 void MessagePublisher::publishMagData(const SbgBinaryLogData &ref_sbg_log)
 {
-  sbg_driver::msg::SbgMag sbg_mag_message;
-  sbg_mag_message = m_message_wrapper_.createSbgMagMessage(ref_sbg_log.magData);
+  m_message_wrapper_.fillSbgMagMessage(ref_sbg_log.magData, m_sbg_mag_message_);
 
   if (m_sbgMag_pub_)
   {
-    m_sbgMag_pub_->publish(sbg_mag_message);
+    m_sbgMag_pub_->publish(m_sbg_mag_message_);
   }
   if (m_mag_pub_)
   {
-    m_mag_pub_->publish(m_message_wrapper_.createRosMagneticMessage(sbg_mag_message));
+    m_message_wrapper_.fillRosMagneticMessage(m_sbg_mag_message_, m_magnetic_message_);
+    m_mag_pub_->publish(m_magnetic_message_);
   }
 }
 
 void MessagePublisher::publishFluidPressureData(const SbgBinaryLogData &ref_sbg_log)
 {
-  sbg_driver::msg::SbgAirData sbg_air_data_message;
-  sbg_air_data_message = m_message_wrapper_.createSbgAirDataMessage(ref_sbg_log.airData);
+  m_message_wrapper_.fillSbgAirDataMessage(ref_sbg_log.airData, m_sbg_air_data_message_);
 
   if (m_SbgAirData_pub_)
   {
-    m_SbgAirData_pub_->publish(sbg_air_data_message);
+    m_SbgAirData_pub_->publish(m_sbg_air_data_message_);
   }
   if (m_fluid_pub_)
   {
-    m_fluid_pub_->publish(m_message_wrapper_.createRosFluidPressureMessage(sbg_air_data_message));
+    m_message_wrapper_.fillRosFluidPressureMessage(m_sbg_air_data_message_, m_fluid_pressure_message_);
+    m_fluid_pub_->publish(m_fluid_pressure_message_);
   }
 }
 
 void MessagePublisher::publishEkfNavigationData(const SbgBinaryLogData &ref_sbg_log)
 {
-  m_sbg_ekf_nav_message_ = m_message_wrapper_.createSbgEkfNavMessage(ref_sbg_log.ekfNavData);
+  m_message_wrapper_.fillSbgEkfNavMessage(ref_sbg_log.ekfNavData, m_sbg_ekf_nav_message_);
 
   if (m_sbgEkfNav_pub_)
   {
@@ -412,43 +591,156 @@ void MessagePublisher::publishEkfNavigationData(const SbgBinaryLogData &ref_sbg_
   }
   if (m_pos_ecef_pub_)
   {
-    m_pos_ecef_pub_->publish(m_message_wrapper_.createRosPointStampedMessage(m_sbg_ekf_nav_message_));
+    m_message_wrapper_.fillRosPointStampedMessage(m_sbg_ekf_nav_message_, m_pos_ecef_message_);
+    m_pos_ecef_pub_->publish(m_pos_ecef_message_);
+  }
+
+  if (m_pose_history_)
+  {
+    m_pose_history_->addNavigation(m_sbg_ekf_nav_message_);
+    processEventPoses();
+  }
+
+  if (hasAlignedPublishers())
+  {
+    m_ekf_nav_buffer_.push(m_sbg_ekf_nav_message_);
+    processAlignedMessages();
   }
-  processRosVelMessage();
 }
 
-void MessagePublisher::publishUtcData(const SbgBinaryLogData &ref_sbg_log)
+void MessagePublisher::publishEkfQuaternionData(const SbgBinaryLogData &ref_sbg_log)
 {
-  sbg_driver::msg::SbgUtcTime sbg_utc_message;
+  if (!m_sbgEkfQuat_pub_ && !m_pose_history_)
+  {
+    return;
+  }
 
-  sbg_utc_message = m_message_wrapper_.createSbgUtcTimeMessage(ref_sbg_log.utcData);
+  m_message_wrapper_.fillSbgEkfQuatMessage(ref_sbg_log.ekfQuatData, m_sbg_ekf_quat_message_);
 
-  if (m_sbgUtcTime_pub_)
+  if (m_pose_history_)
+  {
+    m_pose_history_->addAttitude(m_sbg_ekf_quat_message_);
+    processEventPoses();
+  }
+
+  if (m_sbgEkfQuat_pub_)
+  {
+    m_sbgEkfQuat_pub_->publish(m_sbg_ekf_quat_message_);
+
+    if (hasAlignedPublishers())
+    {
+      m_ekf_quat_buffer_.push(m_sbg_ekf_quat_message_);
+      processAlignedMessages();
+    }
+  }
+}
+
+void MessagePublisher::publishEventData(const rclcpp::Publisher<sbg_driver::msg::SbgEvent, std::allocator<void>>::SharedPtr &ref_event_pub, uint8_t channel, const SbgBinaryLogData &ref_sbg_log)
+{
+  const SbgLogEvent &ref_event = ref_sbg_log.eventMarker;
+
+  if (ref_event_pub)
+  {
+    m_message_wrapper_.fillSbgEventMessage(ref_event, m_sbg_event_message_);
+    ref_event_pub->publish(m_sbg_event_message_);
+  }
+
+  if (m_imu_preintegrator_.isEnabled())
+  {
+    m_imu_preintegrator_.addEvent(channel, ref_event);
+  }
+
+  if (m_event_pose_pub_)
+  {
+    const std::array<std::pair<uint16_t, uint16_t>, 4> time_offsets =
+    {{
+      { SBG_ECOM_EVENT_OFFSET_0_VALID, ref_event.timeOffset0 },
+      { SBG_ECOM_EVENT_OFFSET_1_VALID, ref_event.timeOffset1 },
+      { SBG_ECOM_EVENT_OFFSET_2_VALID, ref_event.timeOffset2 },
+      { SBG_ECOM_EVENT_OFFSET_3_VALID, ref_event.timeOffset3 }
+    }};
+
+    m_pending_events_.push_back({ ref_event.timeStamp, channel, 0 });
+
+    for (size_t i = 0; i < time_offsets.size(); i++)
+    {
+      if (ref_event.status & time_offsets[i].first)
+      {
+        m_pending_events_.push_back({ ref_event.timeStamp + time_offsets[i].second, channel, static_cast<uint8_t>(i + 1) });
+      }
+    }
+
+    if (m_pending_events_.size() > SBG_EVENT_POSE_MAX_PENDING)
+    {
+      m_pending_events_.erase(m_pending_events_.begin(), m_pending_events_.end() - SBG_EVENT_POSE_MAX_PENDING);
+    }
+
+    processEventPoses();
+  }
+}
+
+void MessagePublisher::processEventPoses(void)
+{
+  PoseHistory::Pose pose;
+  AlignStatus       status;
+
+  //
+  // Events are queued in reception order, not in time stamp order: an event of a channel, or a
+  // sub event with a large time offset, may still wait for its pose while a later queued one can be aligned.
+  //
+  auto it = m_pending_events_.begin();
+
+  while (it != m_pending_events_.end())
+  {
+    status = m_pose_history_->getPose(it->time_stamp, pose);
+
+    if (status == AlignStatus::PENDING)
+    {
+      ++it;
+    }
+    else
+    {
+      if (status == AlignStatus::ALIGNED)
+      {
+        m_message_wrapper_.fillSbgEventPoseMessage(pose, it->time_stamp, it->channel, it->sub_event, m_event_pose_message_);
+        m_event_pose_pub_->publish(m_event_pose_message_);
+      }
+
+      it = m_pending_events_.erase(it);
+    }
+  }
+}
+
+void MessagePublisher::publishUtcData(const SbgBinaryLogData &ref_sbg_log)
+{
+  m_message_wrapper_.fillSbgUtcTimeMessage(ref_sbg_log.utcData, m_sbg_utc_message_);
+
+  if (m_sbgUtcTime_pub_ && isStatusPublished(m_utc_status_change_, {{ ref_sbg_log.utcData.status, 0, 0 }}, ref_sbg_log.utcData.timeStamp))
   {
-    m_sbgUtcTime_pub_->publish(sbg_utc_message);
+    m_sbgUtcTime_pub_->publish(m_sbg_utc_message_);
   }
   if (m_utc_reference_pub_)
   {
-    if (sbg_utc_message.clock_status.clock_utc_status != SBG_ECOM_UTC_INVALID)
+    if (m_sbg_utc_message_.clock_status.clock_utc_status != SBG_ECOM_UTC_INVALID)
     {
-      m_utc_reference_pub_->publish(m_message_wrapper_.createRosUtcTimeReferenceMessage(sbg_utc_message));
+      m_message_wrapper_.fillRosUtcTimeReferenceMessage(m_sbg_utc_message_, m_utc_reference_message_);
+      m_utc_reference_pub_->publish(m_utc_reference_message_);
     }
   }
 }
 
 void MessagePublisher::publishGpsPosData(const SbgBinaryLogData &ref_sbg_log)
 {
-  sbg_driver::msg::SbgGpsPos sbg_gps_pos_message;
-
-  sbg_gps_pos_message = m_message_wrapper_.createSbgGpsPosMessage(ref_sbg_log.gpsPosData);
+  m_message_wrapper_.fillSbgGpsPosMessage(ref_sbg_log.gpsPosData, m_sbg_gps_pos_message_);
 
   if (m_sbgGpsPos_pub_)
   {
-    m_sbgGpsPos_pub_->publish(sbg_gps_pos_message);
+    m_sbgGpsPos_pub_->publish(m_sbg_gps_pos_message_);
   }
   if (m_nav_sat_fix_pub_)
   {
-    m_nav_sat_fix_pub_->publish(m_message_wrapper_.createRosNavSatFixMessage(sbg_gps_pos_message));
+    m_message_wrapper_.fillRosNavSatFixMessage(m_sbg_gps_pos_message_, m_nav_sat_fix_message_);
+    m_nav_sat_fix_pub_->publish(m_nav_sat_fix_message_);
   }
 }
 
@@ -456,6 +748,39 @@ void MessagePublisher::publishGpsPosData(const SbgBinaryLogData &ref_sbg_log)
 //- Operations                                                        -//
 //---------------------------------------------------------------------//
 
+void MessagePublisher::initDecimatedPublishers(rclcpp::Node& ref_ros_node_handle, const ConfigStore &ref_config_store)
+{
+  //
+  // The filters restart after a gap in the IMU messages, as the window would mix unrelated data.
+  //
+  m_imu_data_decimator_.setFactor(ref_config_store.getSbgImuDataDecimation(), SBG_DECIMATION_MAX_GAP);
+  m_imu_decimator_.setFactor(ref_config_store.getImuDecimation(), SBG_DECIMATION_MAX_GAP);
+
+  if (m_imu_data_decimator_.isEnabled())
+  {
+    if (m_sbgImuData_pub_)
+    {
+      m_sbgImuDataDecimated_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgImuData>("sbg/imu_data_decimated", m_max_messages_);
+    }
+    else
+    {
+      RCLCPP_WARN(ref_ros_node_handle.get_logger(), "SBG_DRIVER - [Publisher] SBG Imu data output is not configured, the decimated IMU data can not be defined.");
+    }
+  }
+
+  if (m_imu_decimator_.isEnabled())
+  {
+    if (m_imu_pub_)
+    {
+      m_imu_decimated_pub_ = ref_ros_node_handle.create_publisher<sensor_msgs::msg::Imu>("imu/data_decimated", m_max_messages_);
+    }
+    else
+    {
+      RCLCPP_WARN(ref_ros_node_handle.get_logger(), "SBG_DRIVER - [Publisher] Standard IMU is not defined, the decimated IMU can not be defined.");
+    }
+  }
+}
+
 void MessagePublisher::initPublishers(rclcpp::Node& ref_ros_node_handle, const ConfigStore &ref_config_store)
 {
   //
@@ -471,19 +796,77 @@ void MessagePublisher::initPublishers(rclcpp::Node& ref_ros_node_handle, const C
 
   m_message_wrapper_.setOdomEnable(ref_config_store.getOdomEnable());
   m_message_wrapper_.setOdomPublishTf(ref_config_store.getOdomPublishTf());
+  m_message_wrapper_.setOdomTfRate(ref_config_store.getOdomTfRate());
+  m_odom_publish_tf_ = ref_config_store.getOdomPublishTf();
+  m_status_on_change_ = ref_config_store.getStatusOnChange();
+  m_status_heartbeat_ = ref_config_store.getStatusHeartbeat() * 1000;
+  m_alignment_max_gap_ = ref_config_store.getAlignmentMaxGap() * 1000;
   m_message_wrapper_.setOdomFrameId(ref_config_store.getOdomFrameId());
   m_message_wrapper_.setOdomBaseFrameId(ref_config_store.getOdomBaseFrameId());
   m_message_wrapper_.setOdomInitFrameId(ref_config_store.getOdomInitFrameId());
+  m_message_wrapper_.setOdomProjection(ref_config_store.getOdomProjection());
 
   for (const ConfigStore::SbgLogOutput &ref_output : ref_output_modes)
   {
     initPublisher(ref_ros_node_handle, ref_output.message_id, ref_output.output_mode, getOutputTopicName(ref_output.message_id));
   }
 
+  if (ref_config_store.getSequenceDiagnostics())
+  {
+    m_sequence_tracker_.initPublishers(ref_ros_node_handle, ref_config_store.getFrameId());
+    m_sequence_tracker_.setLearnNewData(ref_config_store.getSequenceLearnNewData());
+
+    for (const ConfigStore::SbgLogOutput &ref_output : ref_output_modes)
+    {
+      m_sequence_tracker_.setOutputMode(ref_output.message_class, ref_output.message_id, ref_output.output_mode);
+    }
+  }
+
   if (ref_config_store.checkRosStandardMessages())
   {
     defineRosStandardPublishers(ref_ros_node_handle, ref_config_store.getOdomEnable());
   }
+
+  initDecimatedPublishers(ref_ros_node_handle, ref_config_store);
+
+  if ((ref_config_store.getPoseHistorySize() > 0) || ref_config_store.getEventPose())
+  {
+    m_pose_history_ = std::make_shared<PoseHistory>();
+
+    m_pose_history_->setCapacity(std::max<size_t>(ref_config_store.getPoseHistorySize(), ref_config_store.getEventPose() ? SBG_EVENT_POSE_HISTORY_SIZE : 0));
+    m_pose_history_->setMaxGap(m_alignment_max_gap_);
+  }
+
+  if (ref_config_store.getPoseHistorySize() > 0)
+  {
+    m_pose_history_->initService(ref_ros_node_handle, ref_config_store.getFrameId());
+  }
+
+  if (ref_config_store.getEventPose())
+  {
+    m_event_pose_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgEventPose>("sbg/event_pose", m_max_messages_);
+  }
+
+  if (ref_config_store.getPreintegrationTrigger() != PreintegrationTrigger::NONE)
+  {
+    m_imu_preintegrator_.initPublishers(ref_ros_node_handle, ref_config_store);
+  }
+
+  //
+  // Reserve the variable size fields to their maximum size, so that filling them never reallocates.
+  //
+  if (m_sbgGpsRaw_pub_)
+  {
+    m_gps_raw_message_.data.reserve(SBG_ECOM_GPS_RAW_MAX_BUFFER_SIZE);
+  }
+  if (m_sbgDiag_pub_)
+  {
+    m_sbg_diag_message_.message.reserve(SBG_ECOM_LOG_DIAG_MAX_STRING_SIZE);
+  }
+  if (m_event_pose_pub_)
+  {
+    m_pending_events_.reserve(SBG_EVENT_POSE_MAX_PENDING + SBG_EVENT_POSE_MAX_PER_LOG);
+  }
 }
 
 void MessagePublisher::publish(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_id, const SbgBinaryLogData &ref_sbg_log)
@@ -492,15 +875,21 @@ void MessagePublisher::publish(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_
   // Publish the message with the corresponding publisher and SBG message ID.
   // For each log, check if the publisher has been initialized.
   //
+  if (m_sequence_tracker_.isEnabled())
+  {
+    m_sequence_tracker_.update(sbg_msg_class, sbg_msg_id, ref_sbg_log);
+  }
+
   if(sbg_msg_class == SBG_ECOM_CLASS_LOG_ECOM_0)
   {
     switch (sbg_msg_id)
     {
     case SBG_ECOM_LOG_STATUS:
 
-      if (m_sbgStatus_pub_)
+      if (m_sbgStatus_pub_ && isStatusPublished(m_status_change_, {{ ref_sbg_log.statusData.generalStatus, ref_sbg_log.statusData.comStatus, ref_sbg_log.statusData.aidingStatus }}, ref_sbg_log.statusData.timeStamp))
       {
-        m_sbgStatus_pub_->publish(m_message_wrapper_.createSbgStatusMessage(ref_sbg_log.statusData));
+        m_message_wrapper_.fillSbgStatusMessage(ref_sbg_log.statusData, m_sbg_status_message_);
+        m_sbgStatus_pub_->publish(m_sbg_status_message_);
       }
       break;
 
@@ -523,7 +912,8 @@ void MessagePublisher::publish(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_
 
       if (m_sbgMagCalib_pub_)
       {
-        m_sbgMagCalib_pub_->publish(m_message_wrapper_.createSbgMagCalibMessage(ref_sbg_log.magCalibData));
+        m_message_wrapper_.fillSbgMagCalibMessage(ref_sbg_log.magCalibData, m_sbg_mag_calib_message_);
+        m_sbgMagCalib_pub_->publish(m_sbg_mag_calib_message_);
       }
       break;
 
@@ -531,35 +921,33 @@ void MessagePublisher::publish(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_
 
       if (m_sbgEkfEuler_pub_)
       {
-        m_sbg_ekf_euler_message_ = m_message_wrapper_.createSbgEkfEulerMessage(ref_sbg_log.ekfEulerData);
+        m_message_wrapper_.fillSbgEkfEulerMessage(ref_sbg_log.ekfEulerData, m_sbg_ekf_euler_message_);
         m_sbgEkfEuler_pub_->publish(m_sbg_ekf_euler_message_);
-        processRosVelMessage();
-        processRosOdoMessage();
+
+        if (hasAlignedPublishers())
+        {
+          m_ekf_euler_buffer_.push(m_sbg_ekf_euler_message_);
+          processAlignedMessages();
+        }
       }
       break;
 
     case SBG_ECOM_LOG_EKF_QUAT:
 
-      if (m_sbgEkfQuat_pub_)
-      {
-        m_sbg_ekf_quat_message_ = m_message_wrapper_.createSbgEkfQuatMessage(ref_sbg_log.ekfQuatData);
-        m_sbgEkfQuat_pub_->publish(m_sbg_ekf_quat_message_);
-        processRosImuMessage();
-        processRosVelMessage();
-      }
+      publishEkfQuaternionData(ref_sbg_log);
       break;
 
     case SBG_ECOM_LOG_EKF_NAV:
 
       publishEkfNavigationData(ref_sbg_log);
-      processRosOdoMessage();
       break;
 
     case SBG_ECOM_LOG_SHIP_MOTION:
 
       if (m_sbgShipMotion_pub_)
       {
-        m_sbgShipMotion_pub_->publish(m_message_wrapper_.createSbgShipMotionMessage(ref_sbg_log.shipMotionData));
+        m_message_wrapper_.fillSbgShipMotionMessage(ref_sbg_log.shipMotionData, m_sbg_ship_motion_message_);
+        m_sbgShipMotion_pub_->publish(m_sbg_ship_motion_message_);
       }
       break;
 
@@ -568,7 +956,8 @@ void MessagePublisher::publish(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_
 
       if (m_sbgGpsVel_pub_)
       {
-        m_sbgGpsVel_pub_->publish(m_message_wrapper_.createSbgGpsVelMessage(ref_sbg_log.gpsVelData));
+        m_message_wrapper_.fillSbgGpsVelMessage(ref_sbg_log.gpsVelData, m_sbg_gps_vel_message_);
+        m_sbgGpsVel_pub_->publish(m_sbg_gps_vel_message_);
       }
       break;
 
@@ -583,7 +972,8 @@ void MessagePublisher::publish(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_
 
       if (m_sbgGpsHdt_pub_)
       {
-        m_sbgGpsHdt_pub_->publish(m_message_wrapper_.createSbgGpsHdtMessage(ref_sbg_log.gpsHdtData));
+        m_message_wrapper_.fillSbgGpsHdtMessage(ref_sbg_log.gpsHdtData, m_sbg_gps_hdt_message_);
+        m_sbgGpsHdt_pub_->publish(m_sbg_gps_hdt_message_);
       }
       break;
 
@@ -592,7 +982,8 @@ void MessagePublisher::publish(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_
 
       if (m_sbgGpsRaw_pub_)
       {
-        m_sbgGpsRaw_pub_->publish(m_message_wrapper_.createSbgGpsRawMessage(ref_sbg_log.gpsRawData));
+        m_message_wrapper_.fillSbgGpsRawMessage(ref_sbg_log.gpsRawData, m_gps_raw_message_);
+        m_sbgGpsRaw_pub_->publish(m_gps_raw_message_);
       }
       break;
 
@@ -600,61 +991,111 @@ void MessagePublisher::publish(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_
 
       if (m_sbgOdoVel_pub_)
       {
-        m_sbgOdoVel_pub_->publish(m_message_wrapper_.createSbgOdoVelMessage(ref_sbg_log.odometerData));
+        m_message_wrapper_.fillSbgOdoVelMessage(ref_sbg_log.odometerData, m_sbg_odo_vel_message_);
+        m_sbgOdoVel_pub_->publish(m_sbg_odo_vel_message_);
       }
       break;
 
     case SBG_ECOM_LOG_EVENT_A:
 
-      if (m_sbgEventA_pub_)
+      publishEventData(m_sbgEventA_pub_, 0, ref_sbg_log);
+      break;
+
+    case SBG_ECOM_LOG_EVENT_B:
+
+      publishEventData(m_sbgEventB_pub_, 1, ref_sbg_log);
+      break;
+
+    case SBG_ECOM_LOG_EVENT_C:
+
+      publishEventData(m_sbgEventC_pub_, 2, ref_sbg_log);
+      break;
+
+    case SBG_ECOM_LOG_EVENT_D:
+
+      publishEventData(m_sbgEventD_pub_, 3, ref_sbg_log);
+      break;
+
+    case SBG_ECOM_LOG_EVENT_E:
+
+      publishEventData(m_sbgEventE_pub_, 4, ref_sbg_log);
+      break;
+
+    case SBG_ECOM_LOG_IMU_SHORT:
+
+      if (m_SbgImuShort_pub_)
       {
-        m_sbgEventA_pub_->publish(m_message_wrapper_.createSbgEventMessage(ref_sbg_log.eventMarker));
+        m_message_wrapper_.fillSbgImuShortMessage(ref_sbg_log.imuShort, m_sbg_imu_short_message_);
+        m_SbgImuShort_pub_->publish(m_sbg_imu_short_message_);
       }
       break;
 
-    case SBG_ECOM_LOG_EVENT_B:
+    case SBG_ECOM_LOG_AIR_DATA:
 
-      if (m_sbgEventB_pub_)
+      publishFluidPressureData(ref_sbg_log);
+      break;
+
+    case SBG_ECOM_LOG_DVL_BOTTOM_TRACK:
+
+      if (m_sbgDvlBottomTrack_pub_)
       {
-        m_sbgEventB_pub_->publish(m_message_wrapper_.createSbgEventMessage(ref_sbg_log.eventMarker));
+        m_message_wrapper_.fillSbgDvlMessage(ref_sbg_log.dvlData, m_sbg_dvl_message_);
+        m_sbgDvlBottomTrack_pub_->publish(m_sbg_dvl_message_);
       }
       break;
 
-    case SBG_ECOM_LOG_EVENT_C:
+    case SBG_ECOM_LOG_DVL_WATER_TRACK:
 
-      if (m_sbgEventC_pub_)
+      if (m_sbgDvlWaterTrack_pub_)
       {
-        m_sbgEventC_pub_->publish(m_message_wrapper_.createSbgEventMessage(ref_sbg_log.eventMarker));
+        m_message_wrapper_.fillSbgDvlMessage(ref_sbg_log.dvlData, m_sbg_dvl_message_);
+        m_sbgDvlWaterTrack_pub_->publish(m_sbg_dvl_message_);
       }
       break;
 
-    case SBG_ECOM_LOG_EVENT_D:
+    case SBG_ECOM_LOG_USBL:
 
-      if (m_sbgEventD_pub_)
+      if (m_sbgUsbl_pub_)
       {
-        m_sbgEventD_pub_->publish(m_message_wrapper_.createSbgEventMessage(ref_sbg_log.eventMarker));
+        m_message_wrapper_.fillSbgUsblMessage(ref_sbg_log.usblData, m_sbg_usbl_message_);
+        m_sbgUsbl_pub_->publish(m_sbg_usbl_message_);
       }
       break;
 
-    case SBG_ECOM_LOG_EVENT_E:
+    case SBG_ECOM_LOG_DEPTH:
 
-      if (m_sbgEventE_pub_)
+      if (m_sbgDepth_pub_)
       {
-        m_sbgEventE_pub_->publish(m_message_wrapper_.createSbgEventMessage(ref_sbg_log.eventMarker));
+        m_message_wrapper_.fillSbgDepthMessage(ref_sbg_log.depthData, m_sbg_depth_message_);
+        m_sbgDepth_pub_->publish(m_sbg_depth_message_);
       }
       break;
 
-    case SBG_ECOM_LOG_IMU_SHORT:
+    case SBG_ECOM_LOG_EVENT_OUT_A:
 
-      if (m_SbgImuShort_pub_)
+      if (m_sbgEventOutA_pub_)
       {
-        m_SbgImuShort_pub_->publish(m_message_wrapper_.createSbgImuShortMessage(ref_sbg_log.imuShort));
+        m_message_wrapper_.fillSbgEventMessage(ref_sbg_log.eventMarker, m_sbg_event_message_);
+        m_sbgEventOutA_pub_->publish(m_sbg_event_message_);
       }
       break;
 
-    case SBG_ECOM_LOG_AIR_DATA:
+    case SBG_ECOM_LOG_EVENT_OUT_B:
 
-      publishFluidPressureData(ref_sbg_log);
+      if (m_sbgEventOutB_pub_)
+      {
+        m_message_wrapper_.fillSbgEventMessage(ref_sbg_log.eventMarker, m_sbg_event_message_);
+        m_sbgEventOutB_pub_->publish(m_sbg_event_message_);
+      }
+      break;
+
+    case SBG_ECOM_LOG_DIAG:
+
+      if (m_sbgDiag_pub_)
+      {
+        m_message_wrapper_.fillSbgDiagMessage(ref_sbg_log.diagData, m_sbg_diag_message_);
+        m_sbgDiag_pub_->publish(m_sbg_diag_message_);
+      }
       break;
 
     default:
@@ -670,3 +1111,122 @@ void MessagePublisher::publish(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_
     }
   }
 }
+
+void MessagePublisher::setReceptionStamp(const rclcpp::Time &ref_stamp)
+{
+  m_message_wrapper_.setReceptionStamp(ref_stamp);
+}
+
+bool MessagePublisher::isLogConsumed(SbgEComClass sbg_msg_class, SbgEComMsgId sbg_msg_id) const
+{
+  //
+  // Only ECOM_0 logs are handled by the publish method.
+  //
+  if (sbg_msg_class != SBG_ECOM_CLASS_LOG_ECOM_0)
+  {
+    return false;
+  }
+
+  switch (sbg_msg_id)
+  {
+  case SBG_ECOM_LOG_STATUS:
+    return hasSubscribers(m_sbgStatus_pub_);
+
+  case SBG_ECOM_LOG_UTC_TIME:
+    return hasSubscribers(m_sbgUtcTime_pub_) || hasSubscribers(m_utc_reference_pub_);
+
+  case SBG_ECOM_LOG_IMU_DATA:
+    return hasSubscribers(m_sbgImuData_pub_) || hasSubscribers(m_temp_pub_) || hasSubscribers(m_imu_pub_)
+        || hasSubscribers(m_sbgImuDataDecimated_pub_) || hasSubscribers(m_imu_decimated_pub_) || hasSubscribers(m_velocity_pub_) || isOdometryConsumed() || m_imu_preintegrator_.isEnabled();
+
+  case SBG_ECOM_LOG_MAG:
+    return hasSubscribers(m_sbgMag_pub_) || hasSubscribers(m_mag_pub_);
+
+  case SBG_ECOM_LOG_MAG_CALIB:
+    return hasSubscribers(m_sbgMagCalib_pub_);
+
+  case SBG_ECOM_LOG_EKF_EULER:
+    return hasSubscribers(m_sbgEkfEuler_pub_) || (m_sbgEkfEuler_pub_ && (hasSubscribers(m_velocity_pub_) || isOdometryConsumed()));
+
+  case SBG_ECOM_LOG_EKF_QUAT:
+    return hasSubscribers(m_sbgEkfQuat_pub_) || (m_sbgEkfQuat_pub_ && (hasSubscribers(m_imu_pub_) || hasSubscribers(m_imu_decimated_pub_) || hasSubscribers(m_velocity_pub_) || isOdometryConsumed())) || m_pose_history_;
+
+  case SBG_ECOM_LOG_EKF_NAV:
+    return hasSubscribers(m_sbgEkfNav_pub_) || hasSubscribers(m_pos_ecef_pub_) || hasSubscribers(m_velocity_pub_) || isOdometryConsumed() || m_pose_history_;
+
+  case SBG_ECOM_LOG_SHIP_MOTION:
+    return hasSubscribers(m_sbgShipMotion_pub_);
+
+  case SBG_ECOM_LOG_GPS1_VEL:
+  case SBG_ECOM_LOG_GPS2_VEL:
+    return hasSubscribers(m_sbgGpsVel_pub_);
+
+  case SBG_ECOM_LOG_GPS1_POS:
+  case SBG_ECOM_LOG_GPS2_POS:
+    return hasSubscribers(m_sbgGpsPos_pub_) || hasSubscribers(m_nav_sat_fix_pub_);
+
+  case SBG_ECOM_LOG_GPS1_HDT:
+  case SBG_ECOM_LOG_GPS2_HDT:
+    return hasSubscribers(m_sbgGpsHdt_pub_);
+
+  case SBG_ECOM_LOG_GPS1_RAW:
+  case SBG_ECOM_LOG_GPS2_RAW:
+    return hasSubscribers(m_sbgGpsRaw_pub_);
+
+  case SBG_ECOM_LOG_ODO_VEL:
+    return hasSubscribers(m_sbgOdoVel_pub_);
+
+  case SBG_ECOM_LOG_EVENT_A:
+    return hasSubscribers(m_sbgEventA_pub_) || hasSubscribers(m_event_pose_pub_) || m_imu_preintegrator_.isEnabled();
+
+  case SBG_ECOM_LOG_EVENT_B:
+    return hasSubscribers(m_sbgEventB_pub_) || hasSubscribers(m_event_pose_pub_) || m_imu_preintegrator_.isEnabled();
+
+  case SBG_ECOM_LOG_EVENT_C:
+    return hasSubscribers(m_sbgEventC_pub_) || hasSubscribers(m_event_pose_pub_) || m_imu_preintegrator_.isEnabled();
+
+  case SBG_ECOM_LOG_EVENT_D:
+    return hasSubscribers(m_sbgEventD_pub_) || hasSubscribers(m_event_pose_pub_) || m_imu_preintegrator_.isEnabled();
+
+  case SBG_ECOM_LOG_EVENT_E:
+    return hasSubscribers(m_sbgEventE_pub_) || hasSubscribers(m_event_pose_pub_) || m_imu_preintegrator_.isEnabled();
+
+  case SBG_ECOM_LOG_IMU_SHORT:
+    return hasSubscribers(m_SbgImuShort_pub_);
+
+  case SBG_ECOM_LOG_AIR_DATA:
+    return hasSubscribers(m_SbgAirData_pub_) || hasSubscribers(m_fluid_pub_);
+
+  case SBG_ECOM_LOG_DVL_BOTTOM_TRACK:
+    return hasSubscribers(m_sbgDvlBottomTrack_pub_);
+
+  case SBG_ECOM_LOG_DVL_WATER_TRACK:
+    return hasSubscribers(m_sbgDvlWaterTrack_pub_);
+
+  case SBG_ECOM_LOG_USBL:
+    return hasSubscribers(m_sbgUsbl_pub_);
+
+  case SBG_ECOM_LOG_DEPTH:
+    return hasSubscribers(m_sbgDepth_pub_);
+
+  case SBG_ECOM_LOG_EVENT_OUT_A:
+    return hasSubscribers(m_sbgEventOutA_pub_);
+
+  case SBG_ECOM_LOG_EVENT_OUT_B:
+    return hasSubscribers(m_sbgEventOutB_pub_);
+
+  case SBG_ECOM_LOG_DIAG:
+    return hasSubscribers(m_sbgDiag_pub_);
+
+  default:
+    return false;
+  }
+}
+
+void MessagePublisher::publishSequenceDiagnostics(const rclcpp::Time &ref_stamp)
+{
+  if (m_sequence_tracker_.isEnabled())
+  {
+    m_sequence_tracker_.publishDiagnostics(ref_stamp);
+  }
+}
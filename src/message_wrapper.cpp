@@ -12,6 +12,28 @@
 
 using sbg::MessageWrapper;
 
+namespace
+{
+  //
+  // WGS84 ellipsoid and UTM projection constants.
+  //
+  const double WGS84_A          = 6378137.0;                    // major axis
+  const double WGS84_E          = 0.0818191908;                 // first eccentricity
+  const double WGS84_E2         = WGS84_E * WGS84_E;            // e^2
+  const double WGS84_E4         = WGS84_E2 * WGS84_E2;          // e^4
+  const double WGS84_E6         = WGS84_E4 * WGS84_E2;          // e^6
+  const double WGS84_EP2        = WGS84_E2 / (1.0 - WGS84_E2);  // second eccentricity squared
+  const double UTM_K0           = 0.9996;                       // scale factor
+
+  //
+  // Meridian arc length series coefficients, from USGS Bulletin 1532.
+  //
+  const double UTM_M1           = WGS84_A * (1.0 - WGS84_E2 / 4.0 - 3.0 * WGS84_E4 / 64.0 - 5.0 * WGS84_E6 / 256.0);
+  const double UTM_M2           = WGS84_A * (3.0 * WGS84_E2 / 8.0 + 3.0 * WGS84_E4 / 32.0 + 45.0 * WGS84_E6 / 1024.0);
+  const double UTM_M3           = WGS84_A * (15.0 * WGS84_E4 / 256.0 + 45.0 * WGS84_E6 / 1024.0);
+  const double UTM_M4           = WGS84_A * (35.0 * WGS84_E6 / 3072.0);
+}
+
 /*!
  * Class to wrap the SBG logs into ROS messages.
  */
@@ -20,7 +42,12 @@ using sbg::MessageWrapper;
 //---------------------------------------------------------------------//
 
 MessageWrapper::MessageWrapper(void):
-Node("tf_broadcaster")
+MessageWrapper("")
+{
+}
+
+MessageWrapper::MessageWrapper(const std::string &ref_node_namespace):
+Node("tf_broadcaster", ref_node_namespace)
 {
   m_first_valid_utc_ = false;
   m_tf_broadcaster_ = std::make_shared<tf2_ros::TransformBroadcaster>(this);
@@ -29,7 +56,15 @@ Node("tf_broadcaster")
   m_utm0_.northing = 0.0;
   m_utm0_.altitude = 0.0;
   m_utm0_.zone = 0;
+  m_utm0_.central_meridian = 0.0;
+  m_odom_projection_ = OdomProjection::UTM;
+  m_enu_origin_valid_ = false;
+  m_odom_tf_period_ = 0;
+  m_odom_tf_sent_ = false;
+  m_last_odom_tf_timestamp_ = 0;
   m_is_first = true;
+  m_use_reception_stamp_ = false;
+  m_clock_ = std::make_shared<rclcpp::Clock>();
 }
 
 //---------------------------------------------------------------------//
@@ -71,45 +106,40 @@ double MessageWrapper::computeMeridian(int zone_number) const
   return (zone_number == 0) ? 0.0 : (zone_number - 1) * 6.0 - 177.0;
 }
 
-const std_msgs::msg::Header MessageWrapper::createRosHeader(uint32_t device_timestamp) const
+void MessageWrapper::fillRosHeader(uint32_t device_timestamp, std_msgs::msg::Header &ref_header) const
 {
-  std_msgs::msg::Header header;
-
-  header.frame_id = m_frame_id_;
+  ref_header.frame_id = m_frame_id_;
 
   if (m_first_valid_utc_ && (m_time_reference_ == TimeReference::INS_UNIX))
   {
-    header.stamp = convertInsTimeToUnix(device_timestamp);
+    ref_header.stamp = convertInsTimeToUnix(device_timestamp);
+  }
+  else if (m_use_reception_stamp_)
+  {
+    ref_header.stamp = m_reception_stamp_;
   }
   else
   {
-    header.stamp = rclcpp::Clock().now();
+    ref_header.stamp = m_clock_->now();
   }
-
-  return header;
 }
 
 
-std_msgs::msg::Header MessageWrapper::createRosHeaderSynced(uint32_t device_timestamp)
+void MessageWrapper::fillRosHeaderSynced(uint32_t device_timestamp, std_msgs::msg::Header &ref_header)
 {
-  std_msgs::msg::Header header;
-  
   if (m_is_first) {
-    m_ros_time_init = rclcpp::Clock().now();
+    m_ros_time_init = m_use_reception_stamp_ ? m_reception_stamp_ : m_clock_->now();
     m_clock_time_init = device_timestamp;
     m_is_first = false;
   }
 
-  header.frame_id = m_frame_id_;
+  ref_header.frame_id = m_frame_id_;
   
   double t_s = (double)(device_timestamp - m_clock_time_init) * 1e-6;
   int sec = (int)(std::floor(t_s));
   int nsec = (int)((t_s - (double)sec) * 1e9);
 
-  header.stamp = rclcpp::Duration(sec,nsec) + m_ros_time_init;
-
-
-  return header;
+  ref_header.stamp = rclcpp::Duration(sec,nsec) + m_ros_time_init;
 }
 
 const rclcpp::Time MessageWrapper::convertInsTimeToUnix(uint32_t device_timestamp) const
@@ -397,6 +427,38 @@ const sbg_driver::msg::SbgAirDataStatus MessageWrapper::createAirDataStatusMessa
   return air_data_status_message;
 }
 
+const sbg_driver::msg::SbgDvlStatus MessageWrapper::createDvlStatusMessage(const SbgLogDvlData& ref_sbg_dvl_data) const
+{
+  sbg_driver::msg::SbgDvlStatus dvl_status_message;
+
+  dvl_status_message.velocity_valid = (ref_sbg_dvl_data.status & SBG_ECOM_DVL_VELOCITY_VALID) != 0;
+  dvl_status_message.time_sync      = (ref_sbg_dvl_data.status & SBG_ECOM_DVL_TIME_SYNC) != 0;
+
+  return dvl_status_message;
+}
+
+const sbg_driver::msg::SbgUsblStatus MessageWrapper::createUsblStatusMessage(const SbgLogUsblData& ref_sbg_usbl_data) const
+{
+  sbg_driver::msg::SbgUsblStatus usbl_status_message;
+
+  usbl_status_message.time_sync       = (ref_sbg_usbl_data.status & SBG_ECOM_USBL_TIME_SYNC) != 0;
+  usbl_status_message.position_valid  = (ref_sbg_usbl_data.status & SBG_ECOM_USBL_POSITION_VALID) != 0;
+  usbl_status_message.depth_valid     = (ref_sbg_usbl_data.status & SBG_ECOM_USBL_DEPTH_VALID) != 0;
+
+  return usbl_status_message;
+}
+
+const sbg_driver::msg::SbgDepthStatus MessageWrapper::createDepthStatusMessage(const SbgLogDepth& ref_sbg_depth_data) const
+{
+  sbg_driver::msg::SbgDepthStatus depth_status_message;
+
+  depth_status_message.is_delay_time  = (ref_sbg_depth_data.status & SBG_ECOM_DEPTH_TIME_IS_DELAY) != 0;
+  depth_status_message.pressure_valid = (ref_sbg_depth_data.status & SBG_ECOM_DEPTH_PRESSURE_ABS_VALID) != 0;
+  depth_status_message.altitude_valid = (ref_sbg_depth_data.status & SBG_ECOM_DEPTH_ALTITUDE_VALID) != 0;
+
+  return depth_status_message;
+}
+
 /**
  * Get UTM letter designator for the given latitude.
  *
@@ -457,8 +519,9 @@ void MessageWrapper::initUTM(double Lat, double Long, double altitude)
   }
 
   m_utm0_.zone = zoneNumber;
+  m_utm0_.central_meridian = sbgDegToRadD(computeMeridian(zoneNumber));
   m_utm0_.altitude = altitude;
-  LLtoUTM(Lat, Long, m_utm0_.zone, m_utm0_.northing, m_utm0_.easting);
+  projectUTM(Lat, Long, m_utm0_.central_meridian, m_utm0_.northing, m_utm0_.easting, nullptr);
 
   RCLCPP_INFO(rclcpp::get_logger("Message wrapper"), "initialized from lat:%f long:%f UTM zone %d%c: easting:%fm (%dkm) northing:%fm (%dkm)"
   , Lat, Long, m_utm0_.zone, UTMLetterDesignator(Lat)
@@ -477,61 +540,93 @@ void MessageWrapper::initUTM(double Lat, double Long, double altitude)
  * Lat and Long are in fractional degrees
  *
  * Originally written by Chuck Gantz- chuck.gantz@globalstar.com.
+ *
+ * The ellipsoid terms are precomputed and the multiple angle sines are derived
+ * from a single sine and cosine of the latitude.
  */
-void MessageWrapper::LLtoUTM(double Lat, double Long, int zoneNumber, double &UTMNorthing, double &UTMEasting) const
+void MessageWrapper::projectUTM(double Lat, double Long, double central_meridian, double &UTMNorthing, double &UTMEasting, double *p_convergence_angle) const
 {
-  const double RADIANS_PER_DEGREE = M_PI/180.0;
-
-  // WGS84 Parameters
-  const double WGS84_A = 6378137.0;        // major axis
-  const double WGS84_E = 0.0818191908;     // first eccentricity
-
-  // UTM Parameters
-  const double UTM_K0 = 0.9996;            // scale factor
-  const double UTM_E2 = (WGS84_E*WGS84_E); // e^2
-
-  double a = WGS84_A;
-  double eccSquared = UTM_E2;
-  double k0 = UTM_K0;
-
-  double LongOrigin;
-  double eccPrimeSquared;
   double N, T, C, A, M;
 
   // Make sure the longitude is between -180.00 .. 179.9
   double LongTemp = (Long+180)-int((Long+180)/360)*360-180;
 
-  double LatRad = Lat*RADIANS_PER_DEGREE;
-  double LongRad = LongTemp*RADIANS_PER_DEGREE;
-  double LongOriginRad;
+  double LatRad = sbgDegToRadD(Lat);
+  double LongRad = sbgDegToRadD(LongTemp);
+  double DeltaLongRad = LongRad - central_meridian;
 
-  // +3 puts origin in middle of zone
-  LongOrigin = (zoneNumber - 1)*6 - 180 + 3;
-  LongOriginRad = LongOrigin * RADIANS_PER_DEGREE;
+  double sin_lat = sin(LatRad);
+  double cos_lat = cos(LatRad);
+  double tan_lat = sin_lat/cos_lat;
 
-  eccPrimeSquared = (eccSquared)/(1-eccSquared);
+  double sin_2lat = 2*sin_lat*cos_lat;
+  double cos_2lat = 1 - 2*sin_lat*sin_lat;
+  double sin_4lat = 2*sin_2lat*cos_2lat;
+  double cos_4lat = 1 - 2*sin_2lat*sin_2lat;
+  double sin_6lat = sin_4lat*cos_2lat + cos_4lat*sin_2lat;
 
-  N = a/sqrt(1-eccSquared*sin(LatRad)*sin(LatRad));
-  T = tan(LatRad)*tan(LatRad);
-  C = eccPrimeSquared*cos(LatRad)*cos(LatRad);
-  A = cos(LatRad)*(LongRad-LongOriginRad);
+  N = WGS84_A/sqrt(1-WGS84_E2*sin_lat*sin_lat);
+  T = tan_lat*tan_lat;
+  C = WGS84_EP2*cos_lat*cos_lat;
+  A = cos_lat*DeltaLongRad;
 
-  M = a*((1 - eccSquared/4      - 3*eccSquared*eccSquared/64     - 5*eccSquared*eccSquared*eccSquared/256)*LatRad
-            - (3*eccSquared/8   + 3*eccSquared*eccSquared/32    + 45*eccSquared*eccSquared*eccSquared/1024)*sin(2*LatRad)
-                                + (15*eccSquared*eccSquared/256 + 45*eccSquared*eccSquared*eccSquared/1024)*sin(4*LatRad)
-                                - (35*eccSquared*eccSquared*eccSquared/3072)*sin(6*LatRad));
+  M = UTM_M1*LatRad - UTM_M2*sin_2lat + UTM_M3*sin_4lat - UTM_M4*sin_6lat;
 
-  UTMEasting = (double)(k0*N*(A+(1-T+C)*A*A*A/6
-    + (5-18*T+T*T+72*C-58*eccPrimeSquared)*A*A*A*A*A/120)
+  UTMEasting = (double)(UTM_K0*N*(A+(1-T+C)*A*A*A/6
+    + (5-18*T+T*T+72*C-58*WGS84_EP2)*A*A*A*A*A/120)
     + 500000.0);
 
-  UTMNorthing = (double)(k0*(M+N*tan(LatRad)*(A*A/2+(5-T+9*C+4*C*C)*A*A*A*A/24
-    + (61-58*T+T*T+600*C-330*eccPrimeSquared)*A*A*A*A*A*A/720)));
+  UTMNorthing = (double)(UTM_K0*(M+N*tan_lat*(A*A/2+(5-T+9*C+4*C*C)*A*A*A*A/24
+    + (61-58*T+T*T+600*C-330*WGS84_EP2)*A*A*A*A*A*A/720)));
 
   if(Lat < 0)
   {
     UTMNorthing += 10000000.0; //10000000 meter offset for southern hemisphere
   }
+
+  if (p_convergence_angle)
+  {
+    *p_convergence_angle = atan(tan(DeltaLongRad) * sin_lat);
+  }
+}
+
+void MessageWrapper::LLtoUTM(double Lat, double Long, int zoneNumber, double &UTMNorthing, double &UTMEasting) const
+{
+  projectUTM(Lat, Long, sbgDegToRadD(computeMeridian(zoneNumber)), UTMNorthing, UTMEasting, nullptr);
+}
+
+sbg::SbgVector3d MessageWrapper::convertToEcef(double latitude, double longitude, double altitude) const
+{
+  //
+  // Conversion from Geodetic coordinates to ECEF is based on World Geodetic System 1984 (WGS84).
+  // Radius are expressed in meters, and latitude/longitude in radian.
+  //
+  double latitude_rad           = sbgDegToRadD(latitude);
+  double longitude_rad          = sbgDegToRadD(longitude);
+  double sin_latitude           = sin(latitude_rad);
+  double cos_latitude           = cos(latitude_rad);
+  double prime_vertical_radius  = WGS84_A / sqrt(1.0 - WGS84_E2 * sin_latitude * sin_latitude);
+
+  return SbgVector3d((prime_vertical_radius + altitude) * cos_latitude * cos(longitude_rad),
+                     (prime_vertical_radius + altitude) * cos_latitude * sin(longitude_rad),
+                     ((1.0 - WGS84_E2) * prime_vertical_radius + altitude) * sin_latitude);
+}
+
+void MessageWrapper::initENU(double latitude, double longitude, double altitude)
+{
+  double sin_latitude   = sin(sbgDegToRadD(latitude));
+  double cos_latitude   = cos(sbgDegToRadD(latitude));
+  double sin_longitude  = sin(sbgDegToRadD(longitude));
+  double cos_longitude  = cos(sbgDegToRadD(longitude));
+
+  m_ecef_origin_  = convertToEcef(latitude, longitude, altitude);
+  m_ecef_to_enu_  = SbgMatrix3d(-sin_longitude,                 cos_longitude,                  0.0,
+                                -sin_latitude * cos_longitude,  -sin_latitude * sin_longitude,  cos_latitude,
+                                cos_latitude * cos_longitude,   cos_latitude * sin_longitude,   sin_latitude);
+
+  m_enu_origin_valid_ = true;
+
+  RCLCPP_INFO(rclcpp::get_logger("Message wrapper"), "local tangent plane initialized from lat:%f long:%f alt:%f", latitude, longitude, altitude);
 }
 
 //---------------------------------------------------------------------//
@@ -553,6 +648,12 @@ void MessageWrapper::setUseEnu(bool enu)
   m_use_enu_ = enu;
 }
 
+void MessageWrapper::setReceptionStamp(const rclcpp::Time &ref_stamp)
+{
+  m_use_reception_stamp_  = true;
+  m_reception_stamp_      = ref_stamp;
+}
+
 void MessageWrapper::setOdomEnable(bool odom_enable)
 {
   m_odom_enable_ = odom_enable;
@@ -563,6 +664,11 @@ void MessageWrapper::setOdomPublishTf(bool publish_tf)
   m_odom_publish_tf_ = publish_tf;
 }
 
+void MessageWrapper::setOdomTfRate(uint32_t tf_rate)
+{
+  m_odom_tf_period_ = (tf_rate > 0) ? (1000000 / tf_rate) : 0;
+}
+
 void MessageWrapper::setOdomFrameId(const std::string &ref_frame_id)
 {
   m_odom_frame_id_ = ref_frame_id;
@@ -573,6 +679,11 @@ void MessageWrapper::setOdomBaseFrameId(const std::string &ref_frame_id)
   m_odom_base_frame_id_ = ref_frame_id;
 }
 
+void MessageWrapper::setOdomProjection(OdomProjection odom_projection)
+{
+  m_odom_projection_ = odom_projection;
+}
+
 void MessageWrapper::setOdomInitFrameId(const std::string &ref_frame_id)
 {
   m_odom_init_frame_id_ = ref_frame_id;
@@ -582,400 +693,357 @@ void MessageWrapper::setOdomInitFrameId(const std::string &ref_frame_id)
 //- Operations                                                        -//
 //---------------------------------------------------------------------//
 
-const sbg_driver::msg::SbgEkfEuler MessageWrapper::createSbgEkfEulerMessage(const SbgLogEkfEulerData& ref_log_ekf_euler) const
+void MessageWrapper::fillSbgEkfEulerMessage(const SbgLogEkfEulerData& ref_log_ekf_euler, sbg_driver::msg::SbgEkfEuler &ref_ekf_euler_message) const
 {
-  sbg_driver::msg::SbgEkfEuler ekf_euler_message;
-
-  ekf_euler_message.header      = createRosHeader(ref_log_ekf_euler.timeStamp);
-  ekf_euler_message.time_stamp  = ref_log_ekf_euler.timeStamp;
-  ekf_euler_message.status      = createEkfStatusMessage(ref_log_ekf_euler.status);
+  fillRosHeader(ref_log_ekf_euler.timeStamp, ref_ekf_euler_message.header);
+  ref_ekf_euler_message.time_stamp  = ref_log_ekf_euler.timeStamp;
+  ref_ekf_euler_message.status      = createEkfStatusMessage(ref_log_ekf_euler.status);
 
   if (m_use_enu_)
   {
-    ekf_euler_message.angle.x  = ref_log_ekf_euler.euler[0];
-    ekf_euler_message.angle.y  = -ref_log_ekf_euler.euler[1];
-    ekf_euler_message.angle.z  = wrapAngle2Pi((SBG_PI_F / 2.0f) - ref_log_ekf_euler.euler[2]);
+    ref_ekf_euler_message.angle.x  = ref_log_ekf_euler.euler[0];
+    ref_ekf_euler_message.angle.y  = -ref_log_ekf_euler.euler[1];
+    ref_ekf_euler_message.angle.z  = wrapAngle2Pi((SBG_PI_F / 2.0f) - ref_log_ekf_euler.euler[2]);
   }
   else
   {
-    ekf_euler_message.angle.x = ref_log_ekf_euler.euler[0];
-    ekf_euler_message.angle.y = ref_log_ekf_euler.euler[1];
-    ekf_euler_message.angle.z = ref_log_ekf_euler.euler[2];
+    ref_ekf_euler_message.angle.x = ref_log_ekf_euler.euler[0];
+    ref_ekf_euler_message.angle.y = ref_log_ekf_euler.euler[1];
+    ref_ekf_euler_message.angle.z = ref_log_ekf_euler.euler[2];
   }
 
-  ekf_euler_message.accuracy.x  = ref_log_ekf_euler.eulerStdDev[0];
-  ekf_euler_message.accuracy.y  = ref_log_ekf_euler.eulerStdDev[1];
-  ekf_euler_message.accuracy.z  = ref_log_ekf_euler.eulerStdDev[2];
-
-  return ekf_euler_message;
+  ref_ekf_euler_message.accuracy.x  = ref_log_ekf_euler.eulerStdDev[0];
+  ref_ekf_euler_message.accuracy.y  = ref_log_ekf_euler.eulerStdDev[1];
+  ref_ekf_euler_message.accuracy.z  = ref_log_ekf_euler.eulerStdDev[2];
 }
 
-const sbg_driver::msg::SbgEkfNav MessageWrapper::createSbgEkfNavMessage(const SbgLogEkfNavData& ref_log_ekf_nav) const
+void MessageWrapper::fillSbgEkfNavMessage(const SbgLogEkfNavData& ref_log_ekf_nav, sbg_driver::msg::SbgEkfNav &ref_ekf_nav_message) const
 {
-  sbg_driver::msg::SbgEkfNav ekf_nav_message;
-
-  ekf_nav_message.header            = createRosHeader(ref_log_ekf_nav.timeStamp);
-  ekf_nav_message.time_stamp        = ref_log_ekf_nav.timeStamp;
-  ekf_nav_message.status            = createEkfStatusMessage(ref_log_ekf_nav.status);
-  ekf_nav_message.undulation        = ref_log_ekf_nav.undulation;
+  fillRosHeader(ref_log_ekf_nav.timeStamp, ref_ekf_nav_message.header);
+  ref_ekf_nav_message.time_stamp        = ref_log_ekf_nav.timeStamp;
+  ref_ekf_nav_message.status            = createEkfStatusMessage(ref_log_ekf_nav.status);
+  ref_ekf_nav_message.undulation        = ref_log_ekf_nav.undulation;
 
-  ekf_nav_message.latitude  = ref_log_ekf_nav.position[0];
-  ekf_nav_message.longitude = ref_log_ekf_nav.position[1];
-  ekf_nav_message.altitude  = ref_log_ekf_nav.position[2];
+  ref_ekf_nav_message.latitude  = ref_log_ekf_nav.position[0];
+  ref_ekf_nav_message.longitude = ref_log_ekf_nav.position[1];
+  ref_ekf_nav_message.altitude  = ref_log_ekf_nav.position[2];
 
   if (m_use_enu_)
   {
-    ekf_nav_message.velocity.x = ref_log_ekf_nav.velocity[1];
-    ekf_nav_message.velocity.y = ref_log_ekf_nav.velocity[0];
-    ekf_nav_message.velocity.z = -ref_log_ekf_nav.velocity[2];
+    ref_ekf_nav_message.velocity.x = ref_log_ekf_nav.velocity[1];
+    ref_ekf_nav_message.velocity.y = ref_log_ekf_nav.velocity[0];
+    ref_ekf_nav_message.velocity.z = -ref_log_ekf_nav.velocity[2];
 
-    ekf_nav_message.velocity_accuracy.x = ref_log_ekf_nav.velocityStdDev[1];
-    ekf_nav_message.velocity_accuracy.y = ref_log_ekf_nav.velocityStdDev[0];
-    ekf_nav_message.velocity_accuracy.z = ref_log_ekf_nav.velocityStdDev[2];
+    ref_ekf_nav_message.velocity_accuracy.x = ref_log_ekf_nav.velocityStdDev[1];
+    ref_ekf_nav_message.velocity_accuracy.y = ref_log_ekf_nav.velocityStdDev[0];
+    ref_ekf_nav_message.velocity_accuracy.z = ref_log_ekf_nav.velocityStdDev[2];
 
-    ekf_nav_message.position_accuracy.x = ref_log_ekf_nav.positionStdDev[1];
-    ekf_nav_message.position_accuracy.y = ref_log_ekf_nav.positionStdDev[0];
-    ekf_nav_message.position_accuracy.z = ref_log_ekf_nav.positionStdDev[2];
+    ref_ekf_nav_message.position_accuracy.x = ref_log_ekf_nav.positionStdDev[1];
+    ref_ekf_nav_message.position_accuracy.y = ref_log_ekf_nav.positionStdDev[0];
+    ref_ekf_nav_message.position_accuracy.z = ref_log_ekf_nav.positionStdDev[2];
   }
   else
   {
-    ekf_nav_message.velocity.x = ref_log_ekf_nav.velocity[0];
-    ekf_nav_message.velocity.y = ref_log_ekf_nav.velocity[1];
-    ekf_nav_message.velocity.z = ref_log_ekf_nav.velocity[2];
+    ref_ekf_nav_message.velocity.x = ref_log_ekf_nav.velocity[0];
+    ref_ekf_nav_message.velocity.y = ref_log_ekf_nav.velocity[1];
+    ref_ekf_nav_message.velocity.z = ref_log_ekf_nav.velocity[2];
 
-    ekf_nav_message.velocity_accuracy.x = ref_log_ekf_nav.velocityStdDev[0];
-    ekf_nav_message.velocity_accuracy.y = ref_log_ekf_nav.velocityStdDev[1];
-    ekf_nav_message.velocity_accuracy.z = ref_log_ekf_nav.velocityStdDev[2];
+    ref_ekf_nav_message.velocity_accuracy.x = ref_log_ekf_nav.velocityStdDev[0];
+    ref_ekf_nav_message.velocity_accuracy.y = ref_log_ekf_nav.velocityStdDev[1];
+    ref_ekf_nav_message.velocity_accuracy.z = ref_log_ekf_nav.velocityStdDev[2];
 
-    ekf_nav_message.position_accuracy.x = ref_log_ekf_nav.positionStdDev[0];
-    ekf_nav_message.position_accuracy.y = ref_log_ekf_nav.positionStdDev[1];
-    ekf_nav_message.position_accuracy.z = ref_log_ekf_nav.positionStdDev[2];
+    ref_ekf_nav_message.position_accuracy.x = ref_log_ekf_nav.positionStdDev[0];
+    ref_ekf_nav_message.position_accuracy.y = ref_log_ekf_nav.positionStdDev[1];
+    ref_ekf_nav_message.position_accuracy.z = ref_log_ekf_nav.positionStdDev[2];
   }
-
-  return ekf_nav_message;
 }
 
-const sbg_driver::msg::SbgEkfQuat MessageWrapper::createSbgEkfQuatMessage(const SbgLogEkfQuatData& ref_log_ekf_quat) const
+void MessageWrapper::fillSbgEkfQuatMessage(const SbgLogEkfQuatData& ref_log_ekf_quat, sbg_driver::msg::SbgEkfQuat &ref_ekf_quat_message) const
 {
-  sbg_driver::msg::SbgEkfQuat  ekf_quat_message;
-
-  ekf_quat_message.header       = createRosHeader(ref_log_ekf_quat.timeStamp);
-  ekf_quat_message.time_stamp   = ref_log_ekf_quat.timeStamp;
-  ekf_quat_message.status       = createEkfStatusMessage(ref_log_ekf_quat.status);
+  fillRosHeader(ref_log_ekf_quat.timeStamp, ref_ekf_quat_message.header);
+  ref_ekf_quat_message.time_stamp   = ref_log_ekf_quat.timeStamp;
+  ref_ekf_quat_message.status       = createEkfStatusMessage(ref_log_ekf_quat.status);
 
-  ekf_quat_message.accuracy.x   = ref_log_ekf_quat.eulerStdDev[0];
-  ekf_quat_message.accuracy.y   = ref_log_ekf_quat.eulerStdDev[1];
-  ekf_quat_message.accuracy.z   = ref_log_ekf_quat.eulerStdDev[2];
+  ref_ekf_quat_message.accuracy.x   = ref_log_ekf_quat.eulerStdDev[0];
+  ref_ekf_quat_message.accuracy.y   = ref_log_ekf_quat.eulerStdDev[1];
+  ref_ekf_quat_message.accuracy.z   = ref_log_ekf_quat.eulerStdDev[2];
 
   if (m_use_enu_)
   {
-    ekf_quat_message.quaternion.x = ref_log_ekf_quat.quaternion[1];
-    ekf_quat_message.quaternion.y = -ref_log_ekf_quat.quaternion[2];
-    ekf_quat_message.quaternion.z = -ref_log_ekf_quat.quaternion[3];
-    ekf_quat_message.quaternion.w = ref_log_ekf_quat.quaternion[0];
+    ref_ekf_quat_message.quaternion.x = ref_log_ekf_quat.quaternion[1];
+    ref_ekf_quat_message.quaternion.y = -ref_log_ekf_quat.quaternion[2];
+    ref_ekf_quat_message.quaternion.z = -ref_log_ekf_quat.quaternion[3];
+    ref_ekf_quat_message.quaternion.w = ref_log_ekf_quat.quaternion[0];
   }
   else
   {
-    ekf_quat_message.quaternion.x = ref_log_ekf_quat.quaternion[1];
-    ekf_quat_message.quaternion.y = ref_log_ekf_quat.quaternion[2];
-    ekf_quat_message.quaternion.z = ref_log_ekf_quat.quaternion[3];
-    ekf_quat_message.quaternion.w = ref_log_ekf_quat.quaternion[0];
+    ref_ekf_quat_message.quaternion.x = ref_log_ekf_quat.quaternion[1];
+    ref_ekf_quat_message.quaternion.y = ref_log_ekf_quat.quaternion[2];
+    ref_ekf_quat_message.quaternion.z = ref_log_ekf_quat.quaternion[3];
+    ref_ekf_quat_message.quaternion.w = ref_log_ekf_quat.quaternion[0];
   }
-
-  return ekf_quat_message;
 }
 
-const sbg_driver::msg::SbgEvent MessageWrapper::createSbgEventMessage(const SbgLogEvent& ref_log_event) const
+void MessageWrapper::fillSbgEventMessage(const SbgLogEvent& ref_log_event, sbg_driver::msg::SbgEvent &ref_event_message) const
 {
-  sbg_driver::msg::SbgEvent event_message;
+  fillRosHeader(ref_log_event.timeStamp, ref_event_message.header);
+  ref_event_message.time_stamp  = ref_log_event.timeStamp;
 
-  event_message.header      = createRosHeader(ref_log_event.timeStamp);
-  event_message.time_stamp  = ref_log_event.timeStamp;
+  ref_event_message.overflow        = (ref_log_event.status & SBG_ECOM_EVENT_OVERFLOW) != 0;
+  ref_event_message.offset_0_valid  = (ref_log_event.status & SBG_ECOM_EVENT_OFFSET_0_VALID) != 0;
+  ref_event_message.offset_1_valid  = (ref_log_event.status & SBG_ECOM_EVENT_OFFSET_1_VALID) != 0;
+  ref_event_message.offset_2_valid  = (ref_log_event.status & SBG_ECOM_EVENT_OFFSET_2_VALID) != 0;
+  ref_event_message.offset_3_valid  = (ref_log_event.status & SBG_ECOM_EVENT_OFFSET_3_VALID) != 0;
 
-  event_message.overflow        = (ref_log_event.status & SBG_ECOM_EVENT_OVERFLOW) != 0;
-  event_message.offset_0_valid  = (ref_log_event.status & SBG_ECOM_EVENT_OFFSET_0_VALID) != 0;
-  event_message.offset_1_valid  = (ref_log_event.status & SBG_ECOM_EVENT_OFFSET_1_VALID) != 0;
-  event_message.offset_2_valid  = (ref_log_event.status & SBG_ECOM_EVENT_OFFSET_2_VALID) != 0;
-  event_message.offset_3_valid  = (ref_log_event.status & SBG_ECOM_EVENT_OFFSET_3_VALID) != 0;
+  ref_event_message.time_offset_0   = ref_log_event.timeOffset0;
+  ref_event_message.time_offset_1   = ref_log_event.timeOffset1;
+  ref_event_message.time_offset_2   = ref_log_event.timeOffset2;
+  ref_event_message.time_offset_3   = ref_log_event.timeOffset3;
+}
 
-  event_message.time_offset_0   = ref_log_event.timeOffset0;
-  event_message.time_offset_1   = ref_log_event.timeOffset1;
-  event_message.time_offset_2   = ref_log_event.timeOffset2;
-  event_message.time_offset_3   = ref_log_event.timeOffset3;
+void MessageWrapper::fillSbgEventPoseMessage(const PoseHistory::Pose &ref_pose, uint32_t time_stamp, uint8_t channel, uint8_t sub_event, sbg_driver::msg::SbgEventPose &ref_event_pose_message) const
+{
+  ref_event_pose_message.header.frame_id  = m_frame_id_;
+  ref_event_pose_message.header.stamp     = ref_pose.stamp;
+  ref_event_pose_message.time_stamp       = time_stamp;
+  ref_event_pose_message.channel          = channel;
+  ref_event_pose_message.sub_event        = sub_event;
 
-  return event_message;
+  ref_event_pose_message.latitude         = ref_pose.latitude;
+  ref_event_pose_message.longitude        = ref_pose.longitude;
+  ref_event_pose_message.altitude         = ref_pose.altitude;
+  ref_event_pose_message.velocity         = ref_pose.velocity;
+  ref_event_pose_message.quaternion       = ref_pose.quaternion;
 }
 
-const sbg_driver::msg::SbgGpsHdt MessageWrapper::createSbgGpsHdtMessage(const SbgLogGpsHdt& ref_log_gps_hdt) const
+void MessageWrapper::fillSbgGpsHdtMessage(const SbgLogGpsHdt& ref_log_gps_hdt, sbg_driver::msg::SbgGpsHdt &ref_gps_hdt_message) const
 {
-  sbg_driver::msg::SbgGpsHdt gps_hdt_message;
-
-  gps_hdt_message.header           = createRosHeader(ref_log_gps_hdt.timeStamp);
-  gps_hdt_message.time_stamp       = ref_log_gps_hdt.timeStamp;
-  gps_hdt_message.status           = ref_log_gps_hdt.status;
-  gps_hdt_message.tow              = ref_log_gps_hdt.timeOfWeek;
-  gps_hdt_message.true_heading_acc = ref_log_gps_hdt.headingAccuracy;
-  gps_hdt_message.pitch_acc        = ref_log_gps_hdt.pitchAccuracy;
-  gps_hdt_message.baseline         = ref_log_gps_hdt.baseline;
+  fillRosHeader(ref_log_gps_hdt.timeStamp, ref_gps_hdt_message.header);
+  ref_gps_hdt_message.time_stamp       = ref_log_gps_hdt.timeStamp;
+  ref_gps_hdt_message.status           = ref_log_gps_hdt.status;
+  ref_gps_hdt_message.tow              = ref_log_gps_hdt.timeOfWeek;
+  ref_gps_hdt_message.true_heading_acc = ref_log_gps_hdt.headingAccuracy;
+  ref_gps_hdt_message.pitch_acc        = ref_log_gps_hdt.pitchAccuracy;
+  ref_gps_hdt_message.baseline         = ref_log_gps_hdt.baseline;
 
   if (m_use_enu_)
   {
-    gps_hdt_message.true_heading = wrapAngle360(90.0f - ref_log_gps_hdt.heading);
-    gps_hdt_message.pitch        = -ref_log_gps_hdt.pitch;
+    ref_gps_hdt_message.true_heading = wrapAngle360(90.0f - ref_log_gps_hdt.heading);
+    ref_gps_hdt_message.pitch        = -ref_log_gps_hdt.pitch;
   }
   else
   {
-    gps_hdt_message.true_heading = ref_log_gps_hdt.heading;
-    gps_hdt_message.pitch        = ref_log_gps_hdt.pitch;
+    ref_gps_hdt_message.true_heading = ref_log_gps_hdt.heading;
+    ref_gps_hdt_message.pitch        = ref_log_gps_hdt.pitch;
   }
-
-  return gps_hdt_message;
 }
 
-const sbg_driver::msg::SbgGpsPos MessageWrapper::createSbgGpsPosMessage(const SbgLogGpsPos& ref_log_gps_pos) const
+void MessageWrapper::fillSbgGpsPosMessage(const SbgLogGpsPos& ref_log_gps_pos, sbg_driver::msg::SbgGpsPos &ref_gps_pos_message) const
 {
-  sbg_driver::msg::SbgGpsPos gps_pos_message;
+  fillRosHeader(ref_log_gps_pos.timeStamp, ref_gps_pos_message.header);
+  ref_gps_pos_message.time_stamp  = ref_log_gps_pos.timeStamp;
 
-  gps_pos_message.header      = createRosHeader(ref_log_gps_pos.timeStamp);
-  gps_pos_message.time_stamp  = ref_log_gps_pos.timeStamp;
+  ref_gps_pos_message.status              = createGpsPosStatusMessage(ref_log_gps_pos);
+  ref_gps_pos_message.gps_tow             = ref_log_gps_pos.timeOfWeek;
+  ref_gps_pos_message.undulation          = ref_log_gps_pos.undulation;
+  ref_gps_pos_message.num_sv_used         = ref_log_gps_pos.numSvUsed;
+  ref_gps_pos_message.base_station_id     = ref_log_gps_pos.baseStationId;
+  ref_gps_pos_message.diff_age            = ref_log_gps_pos.differentialAge;
 
-  gps_pos_message.status              = createGpsPosStatusMessage(ref_log_gps_pos);
-  gps_pos_message.gps_tow             = ref_log_gps_pos.timeOfWeek;
-  gps_pos_message.undulation          = ref_log_gps_pos.undulation;
-  gps_pos_message.num_sv_used         = ref_log_gps_pos.numSvUsed;
-  gps_pos_message.base_station_id     = ref_log_gps_pos.baseStationId;
-  gps_pos_message.diff_age            = ref_log_gps_pos.differentialAge;
-
-  gps_pos_message.latitude   = ref_log_gps_pos.latitude;
-  gps_pos_message.longitude  = ref_log_gps_pos.longitude;
-  gps_pos_message.altitude   = ref_log_gps_pos.altitude;
+  ref_gps_pos_message.latitude   = ref_log_gps_pos.latitude;
+  ref_gps_pos_message.longitude  = ref_log_gps_pos.longitude;
+  ref_gps_pos_message.altitude   = ref_log_gps_pos.altitude;
 
   if (m_use_enu_)
   {
-    gps_pos_message.position_accuracy.x = ref_log_gps_pos.longitudeAccuracy;
-    gps_pos_message.position_accuracy.y = ref_log_gps_pos.latitudeAccuracy;
-    gps_pos_message.position_accuracy.z = ref_log_gps_pos.altitudeAccuracy;
+    ref_gps_pos_message.position_accuracy.x = ref_log_gps_pos.longitudeAccuracy;
+    ref_gps_pos_message.position_accuracy.y = ref_log_gps_pos.latitudeAccuracy;
+    ref_gps_pos_message.position_accuracy.z = ref_log_gps_pos.altitudeAccuracy;
   }
   else
   {
-    gps_pos_message.position_accuracy.x = ref_log_gps_pos.latitudeAccuracy;
-    gps_pos_message.position_accuracy.y = ref_log_gps_pos.longitudeAccuracy;
-    gps_pos_message.position_accuracy.z = ref_log_gps_pos.altitudeAccuracy;
+    ref_gps_pos_message.position_accuracy.x = ref_log_gps_pos.latitudeAccuracy;
+    ref_gps_pos_message.position_accuracy.y = ref_log_gps_pos.longitudeAccuracy;
+    ref_gps_pos_message.position_accuracy.z = ref_log_gps_pos.altitudeAccuracy;
   }
-
-  return gps_pos_message;
 }
 
-const sbg_driver::msg::SbgGpsRaw MessageWrapper::createSbgGpsRawMessage(const SbgLogGpsRaw& ref_log_gps_raw) const
+void MessageWrapper::fillSbgGpsRawMessage(const SbgLogGpsRaw& ref_log_gps_raw, sbg_driver::msg::SbgGpsRaw &ref_gps_raw_message) const
 {
-  sbg_driver::msg::SbgGpsRaw gps_raw_message;
-
-  gps_raw_message.data.assign(ref_log_gps_raw.rawBuffer, ref_log_gps_raw.rawBuffer + ref_log_gps_raw.bufferSize);
-
-  return gps_raw_message;
+  ref_gps_raw_message.data.assign(ref_log_gps_raw.pRawBuffer, ref_log_gps_raw.pRawBuffer + ref_log_gps_raw.bufferSize);
 }
 
-const sbg_driver::msg::SbgGpsVel MessageWrapper::createSbgGpsVelMessage(const SbgLogGpsVel& ref_log_gps_vel) const
+void MessageWrapper::fillSbgGpsVelMessage(const SbgLogGpsVel& ref_log_gps_vel, sbg_driver::msg::SbgGpsVel &ref_gps_vel_message) const
 {
-  sbg_driver::msg::SbgGpsVel gps_vel_message;
-
-  gps_vel_message.header      = createRosHeader(ref_log_gps_vel.timeStamp);
-  gps_vel_message.time_stamp  = ref_log_gps_vel.timeStamp;
-  gps_vel_message.status      = createGpsVelStatusMessage(ref_log_gps_vel);
-  gps_vel_message.gps_tow     = ref_log_gps_vel.timeOfWeek;
-  gps_vel_message.course_acc  = ref_log_gps_vel.courseAcc;
+  fillRosHeader(ref_log_gps_vel.timeStamp, ref_gps_vel_message.header);
+  ref_gps_vel_message.time_stamp  = ref_log_gps_vel.timeStamp;
+  ref_gps_vel_message.status      = createGpsVelStatusMessage(ref_log_gps_vel);
+  ref_gps_vel_message.gps_tow     = ref_log_gps_vel.timeOfWeek;
+  ref_gps_vel_message.course_acc  = ref_log_gps_vel.courseAcc;
 
   if (m_use_enu_)
   {
-    gps_vel_message.velocity.x = ref_log_gps_vel.velocity[1];
-    gps_vel_message.velocity.y = ref_log_gps_vel.velocity[0];
-    gps_vel_message.velocity.z = -ref_log_gps_vel.velocity[2];
+    ref_gps_vel_message.velocity.x = ref_log_gps_vel.velocity[1];
+    ref_gps_vel_message.velocity.y = ref_log_gps_vel.velocity[0];
+    ref_gps_vel_message.velocity.z = -ref_log_gps_vel.velocity[2];
 
-    gps_vel_message.velocity_accuracy.x = ref_log_gps_vel.velocityAcc[1];
-    gps_vel_message.velocity_accuracy.y = ref_log_gps_vel.velocityAcc[0];
-    gps_vel_message.velocity_accuracy.z = ref_log_gps_vel.velocityAcc[2];
+    ref_gps_vel_message.velocity_accuracy.x = ref_log_gps_vel.velocityAcc[1];
+    ref_gps_vel_message.velocity_accuracy.y = ref_log_gps_vel.velocityAcc[0];
+    ref_gps_vel_message.velocity_accuracy.z = ref_log_gps_vel.velocityAcc[2];
 
-    gps_vel_message.course  = wrapAngle360(90.0f - ref_log_gps_vel.course);
+    ref_gps_vel_message.course  = wrapAngle360(90.0f - ref_log_gps_vel.course);
   }
   else
   {
-    gps_vel_message.velocity.x = ref_log_gps_vel.velocity[0];
-    gps_vel_message.velocity.y = ref_log_gps_vel.velocity[1];
-    gps_vel_message.velocity.z = ref_log_gps_vel.velocity[2];
+    ref_gps_vel_message.velocity.x = ref_log_gps_vel.velocity[0];
+    ref_gps_vel_message.velocity.y = ref_log_gps_vel.velocity[1];
+    ref_gps_vel_message.velocity.z = ref_log_gps_vel.velocity[2];
 
-    gps_vel_message.velocity_accuracy.x = ref_log_gps_vel.velocityAcc[0];
-    gps_vel_message.velocity_accuracy.y = ref_log_gps_vel.velocityAcc[1];
-    gps_vel_message.velocity_accuracy.z = ref_log_gps_vel.velocityAcc[2];
+    ref_gps_vel_message.velocity_accuracy.x = ref_log_gps_vel.velocityAcc[0];
+    ref_gps_vel_message.velocity_accuracy.y = ref_log_gps_vel.velocityAcc[1];
+    ref_gps_vel_message.velocity_accuracy.z = ref_log_gps_vel.velocityAcc[2];
 
-    gps_vel_message.course  = ref_log_gps_vel.course;
+    ref_gps_vel_message.course  = ref_log_gps_vel.course;
   }
-
-  return gps_vel_message;
 }
 
-const sbg_driver::msg::SbgImuData MessageWrapper::createSbgImuDataMessage(const SbgLogImuData& ref_log_imu_data) const
+void MessageWrapper::fillSbgImuDataMessage(const SbgLogImuData& ref_log_imu_data, sbg_driver::msg::SbgImuData &ref_imu_data_message) const
 {
-  sbg_driver::msg::SbgImuData  imu_data_message;
-
-  imu_data_message.header       = createRosHeader(ref_log_imu_data.timeStamp);
-  imu_data_message.time_stamp   = ref_log_imu_data.timeStamp;
-  imu_data_message.imu_status   = createImuStatusMessage(ref_log_imu_data.status);
-  imu_data_message.temp         = ref_log_imu_data.temperature;
+  fillRosHeader(ref_log_imu_data.timeStamp, ref_imu_data_message.header);
+  ref_imu_data_message.time_stamp   = ref_log_imu_data.timeStamp;
+  ref_imu_data_message.imu_status   = createImuStatusMessage(ref_log_imu_data.status);
+  ref_imu_data_message.temp         = ref_log_imu_data.temperature;
 
   if (m_use_enu_)
   {
-    imu_data_message.accel.x        = ref_log_imu_data.accelerometers[0];
-    imu_data_message.accel.y        = -ref_log_imu_data.accelerometers[1];
-    imu_data_message.accel.z        = -ref_log_imu_data.accelerometers[2];
+    ref_imu_data_message.accel.x        = ref_log_imu_data.accelerometers[0];
+    ref_imu_data_message.accel.y        = -ref_log_imu_data.accelerometers[1];
+    ref_imu_data_message.accel.z        = -ref_log_imu_data.accelerometers[2];
 
-    imu_data_message.gyro.x         = ref_log_imu_data.gyroscopes[0];
-    imu_data_message.gyro.y         = -ref_log_imu_data.gyroscopes[1];
-    imu_data_message.gyro.z         = -ref_log_imu_data.gyroscopes[2];
+    ref_imu_data_message.gyro.x         = ref_log_imu_data.gyroscopes[0];
+    ref_imu_data_message.gyro.y         = -ref_log_imu_data.gyroscopes[1];
+    ref_imu_data_message.gyro.z         = -ref_log_imu_data.gyroscopes[2];
 
-    imu_data_message.delta_vel.x    = ref_log_imu_data.deltaVelocity[0];
-    imu_data_message.delta_vel.y    = -ref_log_imu_data.deltaVelocity[1];
-    imu_data_message.delta_vel.z    = -ref_log_imu_data.deltaVelocity[2];
+    ref_imu_data_message.delta_vel.x    = ref_log_imu_data.deltaVelocity[0];
+    ref_imu_data_message.delta_vel.y    = -ref_log_imu_data.deltaVelocity[1];
+    ref_imu_data_message.delta_vel.z    = -ref_log_imu_data.deltaVelocity[2];
 
-    imu_data_message.delta_angle.x  = ref_log_imu_data.deltaAngle[0];
-    imu_data_message.delta_angle.y  = -ref_log_imu_data.deltaAngle[1];
-    imu_data_message.delta_angle.z  = -ref_log_imu_data.deltaAngle[2];
+    ref_imu_data_message.delta_angle.x  = ref_log_imu_data.deltaAngle[0];
+    ref_imu_data_message.delta_angle.y  = -ref_log_imu_data.deltaAngle[1];
+    ref_imu_data_message.delta_angle.z  = -ref_log_imu_data.deltaAngle[2];
   }
   else
   {
-    imu_data_message.accel.x       = ref_log_imu_data.accelerometers[0];
-    imu_data_message.accel.y       = ref_log_imu_data.accelerometers[1];
-    imu_data_message.accel.z       = ref_log_imu_data.accelerometers[2];
+    ref_imu_data_message.accel.x       = ref_log_imu_data.accelerometers[0];
+    ref_imu_data_message.accel.y       = ref_log_imu_data.accelerometers[1];
+    ref_imu_data_message.accel.z       = ref_log_imu_data.accelerometers[2];
 
-    imu_data_message.gyro.x        = ref_log_imu_data.gyroscopes[0];
-    imu_data_message.gyro.y        = ref_log_imu_data.gyroscopes[1];
-    imu_data_message.gyro.z        = ref_log_imu_data.gyroscopes[2];
+    ref_imu_data_message.gyro.x        = ref_log_imu_data.gyroscopes[0];
+    ref_imu_data_message.gyro.y        = ref_log_imu_data.gyroscopes[1];
+    ref_imu_data_message.gyro.z        = ref_log_imu_data.gyroscopes[2];
 
-    imu_data_message.delta_vel.x   = ref_log_imu_data.deltaVelocity[0];
-    imu_data_message.delta_vel.y   = ref_log_imu_data.deltaVelocity[1];
-    imu_data_message.delta_vel.z   = ref_log_imu_data.deltaVelocity[2];
+    ref_imu_data_message.delta_vel.x   = ref_log_imu_data.deltaVelocity[0];
+    ref_imu_data_message.delta_vel.y   = ref_log_imu_data.deltaVelocity[1];
+    ref_imu_data_message.delta_vel.z   = ref_log_imu_data.deltaVelocity[2];
 
-    imu_data_message.delta_angle.x = ref_log_imu_data.deltaAngle[0];
-    imu_data_message.delta_angle.y = ref_log_imu_data.deltaAngle[1];
-    imu_data_message.delta_angle.z = ref_log_imu_data.deltaAngle[2];
+    ref_imu_data_message.delta_angle.x = ref_log_imu_data.deltaAngle[0];
+    ref_imu_data_message.delta_angle.y = ref_log_imu_data.deltaAngle[1];
+    ref_imu_data_message.delta_angle.z = ref_log_imu_data.deltaAngle[2];
   }
-
-  return imu_data_message;
 }
 
-const sbg_driver::msg::SbgMag MessageWrapper::createSbgMagMessage(const SbgLogMag& ref_log_mag) const
+void MessageWrapper::fillSbgMagMessage(const SbgLogMag& ref_log_mag, sbg_driver::msg::SbgMag &ref_mag_message) const
 {
-  sbg_driver::msg::SbgMag  mag_message;
-
-  mag_message.header      = createRosHeader(ref_log_mag.timeStamp);
-  mag_message.time_stamp  = ref_log_mag.timeStamp;
-  mag_message.status      = createMagStatusMessage(ref_log_mag);
+  fillRosHeader(ref_log_mag.timeStamp, ref_mag_message.header);
+  ref_mag_message.time_stamp  = ref_log_mag.timeStamp;
+  ref_mag_message.status      = createMagStatusMessage(ref_log_mag);
 
   if (m_use_enu_)
   {
-    mag_message.mag.x   = ref_log_mag.magnetometers[0];
-    mag_message.mag.y   = -ref_log_mag.magnetometers[1];
-    mag_message.mag.z   = -ref_log_mag.magnetometers[2];
+    ref_mag_message.mag.x   = ref_log_mag.magnetometers[0];
+    ref_mag_message.mag.y   = -ref_log_mag.magnetometers[1];
+    ref_mag_message.mag.z   = -ref_log_mag.magnetometers[2];
 
-    mag_message.accel.x = ref_log_mag.accelerometers[0];
-    mag_message.accel.y = -ref_log_mag.accelerometers[1];
-    mag_message.accel.z = -ref_log_mag.accelerometers[2];
+    ref_mag_message.accel.x = ref_log_mag.accelerometers[0];
+    ref_mag_message.accel.y = -ref_log_mag.accelerometers[1];
+    ref_mag_message.accel.z = -ref_log_mag.accelerometers[2];
   }
   else
   {
-    mag_message.mag.x   = ref_log_mag.magnetometers[0];
-    mag_message.mag.y   = ref_log_mag.magnetometers[1];
-    mag_message.mag.z   = ref_log_mag.magnetometers[2];
+    ref_mag_message.mag.x   = ref_log_mag.magnetometers[0];
+    ref_mag_message.mag.y   = ref_log_mag.magnetometers[1];
+    ref_mag_message.mag.z   = ref_log_mag.magnetometers[2];
 
-    mag_message.accel.x = ref_log_mag.accelerometers[0];
-    mag_message.accel.y = ref_log_mag.accelerometers[1];
-    mag_message.accel.z = ref_log_mag.accelerometers[2];
+    ref_mag_message.accel.x = ref_log_mag.accelerometers[0];
+    ref_mag_message.accel.y = ref_log_mag.accelerometers[1];
+    ref_mag_message.accel.z = ref_log_mag.accelerometers[2];
   }
-
-  return mag_message;
 }
 
-const sbg_driver::msg::SbgMagCalib MessageWrapper::createSbgMagCalibMessage(const SbgLogMagCalib& ref_log_mag_calib) const
+void MessageWrapper::fillSbgMagCalibMessage(const SbgLogMagCalib& ref_log_mag_calib, sbg_driver::msg::SbgMagCalib &ref_mag_calib_message) const
 {
-  sbg_driver::msg::SbgMagCalib mag_calib_message;
-
   // TODO. SbgMagCalib is not implemented.
-  mag_calib_message.header = createRosHeader(ref_log_mag_calib.timeStamp);
-
-  return mag_calib_message;
+  fillRosHeader(ref_log_mag_calib.timeStamp, ref_mag_calib_message.header);
 }
 
-const sbg_driver::msg::SbgOdoVel MessageWrapper::createSbgOdoVelMessage(const SbgLogOdometerData& ref_log_odo) const
+void MessageWrapper::fillSbgOdoVelMessage(const SbgLogOdometerData& ref_log_odo, sbg_driver::msg::SbgOdoVel &ref_odo_vel_message) const
 {
-  sbg_driver::msg::SbgOdoVel odo_vel_message;
-
-  odo_vel_message.header      = createRosHeader(ref_log_odo.timeStamp);
-  odo_vel_message.time_stamp  = ref_log_odo.timeStamp;
-
-  odo_vel_message.status  = ref_log_odo.status;
-  odo_vel_message.vel     = ref_log_odo.velocity;
+  fillRosHeader(ref_log_odo.timeStamp, ref_odo_vel_message.header);
+  ref_odo_vel_message.time_stamp  = ref_log_odo.timeStamp;
 
-  return odo_vel_message;
+  ref_odo_vel_message.status  = ref_log_odo.status;
+  ref_odo_vel_message.vel     = ref_log_odo.velocity;
 }
 
-const sbg_driver::msg::SbgShipMotion MessageWrapper::createSbgShipMotionMessage(const SbgLogShipMotionData& ref_log_ship_motion) const
+void MessageWrapper::fillSbgShipMotionMessage(const SbgLogShipMotionData& ref_log_ship_motion, sbg_driver::msg::SbgShipMotion &ref_ship_motion_message) const
 {
-  sbg_driver::msg::SbgShipMotion ship_motion_message;
-
-  ship_motion_message.header        = createRosHeader(ref_log_ship_motion.timeStamp);
-  ship_motion_message.time_stamp    = ref_log_ship_motion.timeStamp;
-  ship_motion_message.status        = createShipMotionStatusMessage(ref_log_ship_motion);
-
-  ship_motion_message.ship_motion.x   = ref_log_ship_motion.shipMotion[0];
-  ship_motion_message.ship_motion.y   = ref_log_ship_motion.shipMotion[1];
-  ship_motion_message.ship_motion.z   = ref_log_ship_motion.shipMotion[2];
+  fillRosHeader(ref_log_ship_motion.timeStamp, ref_ship_motion_message.header);
+  ref_ship_motion_message.time_stamp    = ref_log_ship_motion.timeStamp;
+  ref_ship_motion_message.status        = createShipMotionStatusMessage(ref_log_ship_motion);
 
-  ship_motion_message.acceleration.x  = ref_log_ship_motion.shipAccel[0];
-  ship_motion_message.acceleration.y  = ref_log_ship_motion.shipAccel[1];
-  ship_motion_message.acceleration.z  = ref_log_ship_motion.shipAccel[2];
+  ref_ship_motion_message.ship_motion.x   = ref_log_ship_motion.shipMotion[0];
+  ref_ship_motion_message.ship_motion.y   = ref_log_ship_motion.shipMotion[1];
+  ref_ship_motion_message.ship_motion.z   = ref_log_ship_motion.shipMotion[2];
 
-  ship_motion_message.velocity.x      = ref_log_ship_motion.shipVel[0];
-  ship_motion_message.velocity.y      = ref_log_ship_motion.shipVel[1];
-  ship_motion_message.velocity.z      = ref_log_ship_motion.shipVel[2];
+  ref_ship_motion_message.acceleration.x  = ref_log_ship_motion.shipAccel[0];
+  ref_ship_motion_message.acceleration.y  = ref_log_ship_motion.shipAccel[1];
+  ref_ship_motion_message.acceleration.z  = ref_log_ship_motion.shipAccel[2];
 
-  return ship_motion_message;
+  ref_ship_motion_message.velocity.x      = ref_log_ship_motion.shipVel[0];
+  ref_ship_motion_message.velocity.y      = ref_log_ship_motion.shipVel[1];
+  ref_ship_motion_message.velocity.z      = ref_log_ship_motion.shipVel[2];
 }
 
-const sbg_driver::msg::SbgStatus MessageWrapper::createSbgStatusMessage(const SbgLogStatusData& ref_log_status) const
+void MessageWrapper::fillSbgStatusMessage(const SbgLogStatusData& ref_log_status, sbg_driver::msg::SbgStatus &ref_status_message) const
 {
-  sbg_driver::msg::SbgStatus status_message;
+  fillRosHeader(ref_log_status.timeStamp, ref_status_message.header);
+  ref_status_message.time_stamp   = ref_log_status.timeStamp;
 
-  status_message.header       = createRosHeader(ref_log_status.timeStamp);
-  status_message.time_stamp   = ref_log_status.timeStamp;
-
-  status_message.status_general = createStatusGeneralMessage(ref_log_status);
-  status_message.status_com     = createStatusComMessage(ref_log_status);
-  status_message.status_aiding  = createStatusAidingMessage(ref_log_status);
-
-  return status_message;
+  ref_status_message.status_general = createStatusGeneralMessage(ref_log_status);
+  ref_status_message.status_com     = createStatusComMessage(ref_log_status);
+  ref_status_message.status_aiding  = createStatusAidingMessage(ref_log_status);
 }
 
-const sbg_driver::msg::SbgUtcTime MessageWrapper::createSbgUtcTimeMessage(const SbgLogUtcData& ref_log_utc)
+void MessageWrapper::fillSbgUtcTimeMessage(const SbgLogUtcData& ref_log_utc, sbg_driver::msg::SbgUtcTime &ref_utc_time_message)
 {
-  sbg_driver::msg::SbgUtcTime utc_time_message;
-
-  utc_time_message.header     = createRosHeader(ref_log_utc.timeStamp);
-  utc_time_message.time_stamp = ref_log_utc.timeStamp;
+  fillRosHeader(ref_log_utc.timeStamp, ref_utc_time_message.header);
+  ref_utc_time_message.time_stamp = ref_log_utc.timeStamp;
 
-  utc_time_message.clock_status = createUtcStatusMessage(ref_log_utc);
-  utc_time_message.year         = ref_log_utc.year;
-  utc_time_message.month        = ref_log_utc.month;
-  utc_time_message.day          = ref_log_utc.day;
-  utc_time_message.hour         = ref_log_utc.hour;
-  utc_time_message.min          = ref_log_utc.minute;
-  utc_time_message.sec          = ref_log_utc.second;
-  utc_time_message.nanosec      = ref_log_utc.nanoSecond;
-  utc_time_message.gps_tow      = ref_log_utc.gpsTimeOfWeek;
+  ref_utc_time_message.clock_status = createUtcStatusMessage(ref_log_utc);
+  ref_utc_time_message.year         = ref_log_utc.year;
+  ref_utc_time_message.month        = ref_log_utc.month;
+  ref_utc_time_message.day          = ref_log_utc.day;
+  ref_utc_time_message.hour         = ref_log_utc.hour;
+  ref_utc_time_message.min          = ref_log_utc.minute;
+  ref_utc_time_message.sec          = ref_log_utc.second;
+  ref_utc_time_message.nanosec      = ref_log_utc.nanoSecond;
+  ref_utc_time_message.gps_tow      = ref_log_utc.gpsTimeOfWeek;
 
   if (!m_first_valid_utc_)
   {
-    if (utc_time_message.clock_status.clock_stable && utc_time_message.clock_status.clock_utc_sync)
+    if (ref_utc_time_message.clock_status.clock_stable && ref_utc_time_message.clock_status.clock_utc_sync)
     {
-      if (utc_time_message.clock_status.clock_status == SBG_ECOM_CLOCK_VALID)
+      if (ref_utc_time_message.clock_status.clock_status == SBG_ECOM_CLOCK_VALID)
       {
         m_first_valid_utc_ = true;
         RCLCPP_INFO(rclcpp::get_logger("Message wrapper"), "A full valid UTC log has been detected, timestamp will be synchronized with the UTC data.");
@@ -986,91 +1054,137 @@ const sbg_driver::msg::SbgUtcTime MessageWrapper::createSbgUtcTimeMessage(const
   //
   // Store the last UTC message.
   //
-  m_last_sbg_utc_ = utc_time_message;
+  m_last_sbg_utc_ = ref_utc_time_message;
+}
 
-  return utc_time_message;
+void MessageWrapper::fillSbgAirDataMessage(const SbgLogAirData& ref_air_data_log, sbg_driver::msg::SbgAirData &ref_air_data_message) const
+{
+  fillRosHeader(ref_air_data_log.timeStamp, ref_air_data_message.header);
+  ref_air_data_message.time_stamp       = ref_air_data_log.timeStamp;
+  ref_air_data_message.status           = createAirDataStatusMessage(ref_air_data_log);
+  ref_air_data_message.pressure_abs     = ref_air_data_log.pressureAbs;
+  ref_air_data_message.altitude         = ref_air_data_log.altitude;
+  ref_air_data_message.pressure_diff    = ref_air_data_log.pressureDiff;
+  ref_air_data_message.true_air_speed   = ref_air_data_log.trueAirspeed;
+  ref_air_data_message.air_temperature  = ref_air_data_log.airTemperature;
 }
 
-const sbg_driver::msg::SbgAirData MessageWrapper::createSbgAirDataMessage(const SbgLogAirData& ref_air_data_log) const
+void MessageWrapper::fillSbgDvlMessage(const SbgLogDvlData& ref_dvl_log, sbg_driver::msg::SbgDvl &ref_dvl_message) const
 {
-  sbg_driver::msg::SbgAirData air_data_message;
+  fillRosHeader(ref_dvl_log.timeStamp, ref_dvl_message.header);
+  ref_dvl_message.time_stamp  = ref_dvl_log.timeStamp;
+  ref_dvl_message.status      = createDvlStatusMessage(ref_dvl_log);
+
+  //
+  // The DVL instrument frame follows the device body frame convention.
+  //
+  if (m_use_enu_)
+  {
+    ref_dvl_message.velocity.x          = ref_dvl_log.velocity[0];
+    ref_dvl_message.velocity.y          = -ref_dvl_log.velocity[1];
+    ref_dvl_message.velocity.z          = -ref_dvl_log.velocity[2];
+  }
+  else
+  {
+    ref_dvl_message.velocity.x          = ref_dvl_log.velocity[0];
+    ref_dvl_message.velocity.y          = ref_dvl_log.velocity[1];
+    ref_dvl_message.velocity.z          = ref_dvl_log.velocity[2];
+  }
 
-  air_data_message.header           = createRosHeader(ref_air_data_log.timeStamp);
-  air_data_message.time_stamp       = ref_air_data_log.timeStamp;
-  air_data_message.status           = createAirDataStatusMessage(ref_air_data_log);
-  air_data_message.pressure_abs     = ref_air_data_log.pressureAbs;
-  air_data_message.altitude         = ref_air_data_log.altitude;
-  air_data_message.pressure_diff    = ref_air_data_log.pressureDiff;
-  air_data_message.true_air_speed   = ref_air_data_log.trueAirspeed;
-  air_data_message.air_temperature  = ref_air_data_log.airTemperature;
+  ref_dvl_message.velocity_quality.x  = ref_dvl_log.velocityQuality[0];
+  ref_dvl_message.velocity_quality.y  = ref_dvl_log.velocityQuality[1];
+  ref_dvl_message.velocity_quality.z  = ref_dvl_log.velocityQuality[2];
+}
 
-  return air_data_message;
+void MessageWrapper::fillSbgUsblMessage(const SbgLogUsblData& ref_usbl_log, sbg_driver::msg::SbgUsbl &ref_usbl_message) const
+{
+  fillRosHeader(ref_usbl_log.timeStamp, ref_usbl_message.header);
+  ref_usbl_message.time_stamp         = ref_usbl_log.timeStamp;
+  ref_usbl_message.status             = createUsblStatusMessage(ref_usbl_log);
+  ref_usbl_message.latitude           = ref_usbl_log.latitude;
+  ref_usbl_message.longitude          = ref_usbl_log.longitude;
+  ref_usbl_message.depth              = ref_usbl_log.depth;
+  ref_usbl_message.latitude_accuracy  = ref_usbl_log.latitudeAccuracy;
+  ref_usbl_message.longitude_accuracy = ref_usbl_log.longitudeAccuracy;
+  ref_usbl_message.depth_accuracy     = ref_usbl_log.depthAccuracy;
 }
 
-const sbg_driver::msg::SbgImuShort MessageWrapper::createSbgImuShortMessage(const SbgLogImuShort& ref_short_imu_log) const
+void MessageWrapper::fillSbgDepthMessage(const SbgLogDepth& ref_depth_log, sbg_driver::msg::SbgDepth &ref_depth_message) const
 {
-  sbg_driver::msg::SbgImuShort imu_short_message;
+  fillRosHeader(ref_depth_log.timeStamp, ref_depth_message.header);
+  ref_depth_message.time_stamp    = ref_depth_log.timeStamp;
+  ref_depth_message.status        = createDepthStatusMessage(ref_depth_log);
+  ref_depth_message.pressure_abs  = ref_depth_log.pressureAbs;
+  ref_depth_message.altitude      = ref_depth_log.altitude;
+}
 
-  imu_short_message.header          = createRosHeader(ref_short_imu_log.timeStamp);
-  imu_short_message.time_stamp      = ref_short_imu_log.timeStamp;
-  imu_short_message.imu_status      = createImuStatusMessage(ref_short_imu_log.status);
-  imu_short_message.temperature     = ref_short_imu_log.temperature;
+void MessageWrapper::fillSbgDiagMessage(const SbgLogDiagData& ref_diag_log, sbg_driver::msg::SbgDiag &ref_diag_message) const
+{
+  fillRosHeader(ref_diag_log.timestamp, ref_diag_message.header);
+  ref_diag_message.time_stamp = ref_diag_log.timestamp;
+  ref_diag_message.type       = static_cast<uint8_t>(ref_diag_log.type);
+  ref_diag_message.error_code = static_cast<uint8_t>(ref_diag_log.errorCode);
+
+  //
+  // The log string references the received payload, copy it before the payload is released.
+  //
+  ref_diag_message.message.assign(ref_diag_log.pString, ref_diag_log.stringLength);
+}
+
+void MessageWrapper::fillSbgImuShortMessage(const SbgLogImuShort& ref_short_imu_log, sbg_driver::msg::SbgImuShort &ref_imu_short_message) const
+{
+  fillRosHeader(ref_short_imu_log.timeStamp, ref_imu_short_message.header);
+  ref_imu_short_message.time_stamp      = ref_short_imu_log.timeStamp;
+  ref_imu_short_message.imu_status      = createImuStatusMessage(ref_short_imu_log.status);
+  ref_imu_short_message.temperature     = ref_short_imu_log.temperature;
 
   if (m_use_enu_)
   {
-    imu_short_message.delta_velocity.x  = ref_short_imu_log.deltaVelocity[0];
-    imu_short_message.delta_velocity.y  = -ref_short_imu_log.deltaVelocity[1];
-    imu_short_message.delta_velocity.z  = -ref_short_imu_log.deltaVelocity[2];
+    ref_imu_short_message.delta_velocity.x  = ref_short_imu_log.deltaVelocity[0];
+    ref_imu_short_message.delta_velocity.y  = -ref_short_imu_log.deltaVelocity[1];
+    ref_imu_short_message.delta_velocity.z  = -ref_short_imu_log.deltaVelocity[2];
 
-    imu_short_message.delta_angle.x     = ref_short_imu_log.deltaAngle[0];
-    imu_short_message.delta_angle.y     = -ref_short_imu_log.deltaAngle[1];
-    imu_short_message.delta_angle.z     = -ref_short_imu_log.deltaAngle[2];
+    ref_imu_short_message.delta_angle.x     = ref_short_imu_log.deltaAngle[0];
+    ref_imu_short_message.delta_angle.y     = -ref_short_imu_log.deltaAngle[1];
+    ref_imu_short_message.delta_angle.z     = -ref_short_imu_log.deltaAngle[2];
   }
   else
   {
-    imu_short_message.delta_velocity.x  = ref_short_imu_log.deltaVelocity[0];
-    imu_short_message.delta_velocity.y  = ref_short_imu_log.deltaVelocity[1];
-    imu_short_message.delta_velocity.z  = ref_short_imu_log.deltaVelocity[2];
+    ref_imu_short_message.delta_velocity.x  = ref_short_imu_log.deltaVelocity[0];
+    ref_imu_short_message.delta_velocity.y  = ref_short_imu_log.deltaVelocity[1];
+    ref_imu_short_message.delta_velocity.z  = ref_short_imu_log.deltaVelocity[2];
 
-    imu_short_message.delta_angle.x     = ref_short_imu_log.deltaAngle[0];
-    imu_short_message.delta_angle.y     = ref_short_imu_log.deltaAngle[1];
-    imu_short_message.delta_angle.z     = ref_short_imu_log.deltaAngle[2];
+    ref_imu_short_message.delta_angle.x     = ref_short_imu_log.deltaAngle[0];
+    ref_imu_short_message.delta_angle.y     = ref_short_imu_log.deltaAngle[1];
+    ref_imu_short_message.delta_angle.z     = ref_short_imu_log.deltaAngle[2];
   }
-
-  return imu_short_message;
 }
 
-sensor_msgs::msg::Imu MessageWrapper::createRosImuMessage(const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfQuat& ref_sbg_quat_msg)
+void MessageWrapper::fillRosImuMessage(const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfQuat& ref_sbg_quat_msg, sensor_msgs::msg::Imu &ref_imu_ros_message)
 {
-  sensor_msgs::msg::Imu imu_ros_message;
-
-  imu_ros_message.header = createRosHeaderSynced(ref_sbg_imu_msg.time_stamp);
+  fillRosHeaderSynced(ref_sbg_imu_msg.time_stamp, ref_imu_ros_message.header);
 
-  imu_ros_message.orientation                       = ref_sbg_quat_msg.quaternion;
-  imu_ros_message.angular_velocity          = ref_sbg_imu_msg.delta_angle;
-  imu_ros_message.linear_acceleration       = ref_sbg_imu_msg.delta_vel;
+  ref_imu_ros_message.orientation                       = ref_sbg_quat_msg.quaternion;
+  ref_imu_ros_message.angular_velocity          = ref_sbg_imu_msg.delta_angle;
+  ref_imu_ros_message.linear_acceleration       = ref_sbg_imu_msg.delta_vel;
 
-  imu_ros_message.orientation_covariance[0] = ref_sbg_quat_msg.accuracy.x * ref_sbg_quat_msg.accuracy.x;
-  imu_ros_message.orientation_covariance[4] = ref_sbg_quat_msg.accuracy.y * ref_sbg_quat_msg.accuracy.y;
-  imu_ros_message.orientation_covariance[8] = ref_sbg_quat_msg.accuracy.z * ref_sbg_quat_msg.accuracy.z;
+  ref_imu_ros_message.orientation_covariance[0] = ref_sbg_quat_msg.accuracy.x * ref_sbg_quat_msg.accuracy.x;
+  ref_imu_ros_message.orientation_covariance[4] = ref_sbg_quat_msg.accuracy.y * ref_sbg_quat_msg.accuracy.y;
+  ref_imu_ros_message.orientation_covariance[8] = ref_sbg_quat_msg.accuracy.z * ref_sbg_quat_msg.accuracy.z;
 
   //
   // Angular velocity and linear acceleration covariances are not provided.
   //
   for (size_t i = 0; i < 9; i++)
   {
-    imu_ros_message.angular_velocity_covariance[i]    = 0.0;
-    imu_ros_message.linear_acceleration_covariance[i] = 0.0;
+    ref_imu_ros_message.angular_velocity_covariance[i]    = 0.0;
+    ref_imu_ros_message.linear_acceleration_covariance[i] = 0.0;
   }
-
-  return imu_ros_message;
 }
 
-void MessageWrapper::fillTransform(const std::string &ref_parent_frame_id, const std::string &ref_child_frame_id, const geometry_msgs::msg::Pose &ref_pose, geometry_msgs::msg::TransformStamped &refTransformStamped)
+void MessageWrapper::fillTransform(const std::string &ref_parent_frame_id, const std::string &ref_child_frame_id, const builtin_interfaces::msg::Time &ref_stamp, const geometry_msgs::msg::Pose &ref_pose, geometry_msgs::msg::TransformStamped &refTransformStamped) const
 {
-  tf2::Quaternion q;
-
-  refTransformStamped.header.stamp = rclcpp::Clock().now();
+  refTransformStamped.header.stamp = ref_stamp;
   refTransformStamped.header.frame_id = ref_parent_frame_id;
   refTransformStamped.child_frame_id = ref_child_frame_id;
 
@@ -1081,127 +1195,163 @@ void MessageWrapper::fillTransform(const std::string &ref_parent_frame_id, const
   refTransformStamped.transform.rotation.y = ref_pose.orientation.y;
   refTransformStamped.transform.rotation.z = ref_pose.orientation.z;
   refTransformStamped.transform.rotation.w = ref_pose.orientation.w;
+}
+
+void MessageWrapper::publishOdomTransform(const nav_msgs::msg::Odometry &ref_odo_ros_msg, uint32_t device_timestamp)
+{
+  geometry_msgs::msg::TransformStamped transform;
 
-  m_tf_broadcaster_->sendTransform(refTransformStamped);
+  //
+  // Decimate the transforms on the device time stamp so the TF rate doesn't depend on the reception jitter.
+  //
+  if (m_odom_tf_sent_ && (m_odom_tf_period_ > 0))
+  {
+    if (static_cast<int32_t>(device_timestamp - m_last_odom_tf_timestamp_) < static_cast<int32_t>(m_odom_tf_period_))
+    {
+      return;
+    }
+  }
+
+  fillTransform(ref_odo_ros_msg.header.frame_id, m_odom_base_frame_id_, ref_odo_ros_msg.header.stamp, ref_odo_ros_msg.pose.pose, transform);
+  m_tf_broadcaster_->sendTransform(transform);
+
+  m_odom_tf_sent_             = true;
+  m_last_odom_tf_timestamp_   = device_timestamp;
 }
 
-const nav_msgs::msg::Odometry MessageWrapper::createRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_ekf_nav_msg, const sbg_driver::msg::SbgEkfQuat &ref_ekf_quat_msg, const sbg_driver::msg::SbgEkfEuler &ref_ekf_euler_msg)
+void MessageWrapper::fillRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_ekf_nav_msg, const sbg_driver::msg::SbgEkfQuat &ref_ekf_quat_msg, const sbg_driver::msg::SbgEkfEuler &ref_ekf_euler_msg, nav_msgs::msg::Odometry &ref_odo_ros_msg)
 {
   tf2::Quaternion orientation(ref_ekf_quat_msg.quaternion.x, ref_ekf_quat_msg.quaternion.y, ref_ekf_quat_msg.quaternion.z, ref_ekf_quat_msg.quaternion.w);
 
-  return createRosOdoMessage(ref_sbg_imu_msg, ref_ekf_nav_msg, orientation, ref_ekf_euler_msg);
+  fillRosOdoMessage(ref_sbg_imu_msg, ref_ekf_nav_msg, orientation, ref_ekf_euler_msg, ref_odo_ros_msg);
 }
 
-const nav_msgs::msg::Odometry MessageWrapper::createRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_ekf_nav_msg, const sbg_driver::msg::SbgEkfEuler &ref_ekf_euler_msg)
+void MessageWrapper::fillRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_ekf_nav_msg, const sbg_driver::msg::SbgEkfEuler &ref_ekf_euler_msg, nav_msgs::msg::Odometry &ref_odo_ros_msg)
 {
   tf2::Quaternion orientation;
 
   // Compute orientation quaternion from euler angles (already converted from NED to ENU if needed).
   orientation.setRPY(ref_ekf_euler_msg.angle.x, ref_ekf_euler_msg.angle.y, ref_ekf_euler_msg.angle.z);
 
-  return createRosOdoMessage(ref_sbg_imu_msg, ref_ekf_nav_msg, orientation, ref_ekf_euler_msg);
+  fillRosOdoMessage(ref_sbg_imu_msg, ref_ekf_nav_msg, orientation, ref_ekf_euler_msg, ref_odo_ros_msg);
 }
 
-const nav_msgs::msg::Odometry MessageWrapper::createRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_ekf_nav_msg, const tf2::Quaternion &ref_orientation, const sbg_driver::msg::SbgEkfEuler &ref_ekf_euler_msg)
+void MessageWrapper::fillRosOdoMessage(const sbg_driver::msg::SbgImuData &ref_sbg_imu_msg, const sbg_driver::msg::SbgEkfNav &ref_ekf_nav_msg, const tf2::Quaternion &ref_orientation, const sbg_driver::msg::SbgEkfEuler &ref_ekf_euler_msg, nav_msgs::msg::Odometry &ref_odo_ros_msg)
 {
-  nav_msgs::msg::Odometry odo_ros_msg;
   double utm_northing, utm_easting;
+  double convergence_angle;
+  double std_x, std_y;
   std::string utm_zone;
   geometry_msgs::msg::TransformStamped transform;
 
   // The pose message provides the position and orientation of the robot relative to the frame specified in header.frame_id
-  odo_ros_msg.header = createRosHeader(ref_sbg_imu_msg.time_stamp);
-  odo_ros_msg.header.frame_id = m_odom_frame_id_;
-  tf2::convert(ref_orientation, odo_ros_msg.pose.pose.orientation);
+  fillRosHeader(ref_sbg_imu_msg.time_stamp, ref_odo_ros_msg.header);
+  ref_odo_ros_msg.header.frame_id = m_odom_frame_id_;
+  tf2::convert(ref_orientation, ref_odo_ros_msg.pose.pose.orientation);
 
-  // Convert latitude and longitude to UTM coordinates.
-  if (m_utm0_.zone == 0)
+  if (m_odom_projection_ == OdomProjection::ENU)
   {
-    initUTM(ref_ekf_nav_msg.latitude, ref_ekf_nav_msg.longitude, ref_ekf_nav_msg.altitude);
+    // Project the position on the local tangent plane of the first valid position.
+    if (!m_enu_origin_valid_)
+    {
+      initENU(ref_ekf_nav_msg.latitude, ref_ekf_nav_msg.longitude, ref_ekf_nav_msg.altitude + ref_ekf_nav_msg.undulation);
 
-    if (m_odom_publish_tf_)
+      if (m_odom_publish_tf_)
+      {
+        // The local tangent plane origin is the odometry frame origin.
+        geometry_msgs::msg::Pose pose;
+        fillTransform(m_odom_init_frame_id_, m_odom_frame_id_, ref_odo_ros_msg.header.stamp, pose, transform);
+        m_static_tf_broadcaster_->sendTransform(transform);
+      }
+    }
+
+    const SbgVector3d ecef_position = convertToEcef(ref_ekf_nav_msg.latitude, ref_ekf_nav_msg.longitude, ref_ekf_nav_msg.altitude + ref_ekf_nav_msg.undulation);
+    const SbgVector3d enu_position  = m_ecef_to_enu_ * SbgVector3d(ecef_position(0) - m_ecef_origin_(0), ecef_position(1) - m_ecef_origin_(1), ecef_position(2) - m_ecef_origin_(2));
+
+    ref_odo_ros_msg.pose.pose.position.x = enu_position(0);
+    ref_odo_ros_msg.pose.pose.position.y = enu_position(1);
+    ref_odo_ros_msg.pose.pose.position.z = enu_position(2);
+
+    // Position standard deviations are given in the NED or ENU convention.
+    std_x = m_use_enu_ ? ref_ekf_nav_msg.position_accuracy.x : ref_ekf_nav_msg.position_accuracy.y;
+    std_y = m_use_enu_ ? ref_ekf_nav_msg.position_accuracy.y : ref_ekf_nav_msg.position_accuracy.x;
+  }
+  else
+  {
+    // Convert latitude and longitude to UTM coordinates.
+    if (m_utm0_.zone == 0)
     {
-      // Publish UTM initial transformation.
-      geometry_msgs::msg::Pose pose;
-      pose.position.x = m_utm0_.easting;
-      pose.position.y = m_utm0_.northing;
-      pose.position.z = m_utm0_.altitude;
-      fillTransform(m_odom_init_frame_id_, m_odom_frame_id_, pose, transform);
-      m_static_tf_broadcaster_->sendTransform(transform);
+      initUTM(ref_ekf_nav_msg.latitude, ref_ekf_nav_msg.longitude, ref_ekf_nav_msg.altitude);
+
+      if (m_odom_publish_tf_)
+      {
+        // Publish UTM initial transformation.
+        geometry_msgs::msg::Pose pose;
+        pose.position.x = m_utm0_.easting;
+        pose.position.y = m_utm0_.northing;
+        pose.position.z = m_utm0_.altitude;
+        fillTransform(m_odom_init_frame_id_, m_odom_frame_id_, ref_odo_ros_msg.header.stamp, pose, transform);
+        m_static_tf_broadcaster_->sendTransform(transform);
+      }
     }
+
+    // Convert latitude and longitude to UTM coordinates and compute the convergence angle.
+    projectUTM(ref_ekf_nav_msg.latitude, ref_ekf_nav_msg.longitude, m_utm0_.central_meridian, utm_northing, utm_easting, &convergence_angle);
+    ref_odo_ros_msg.pose.pose.position.x = utm_easting  - m_utm0_.easting;
+    ref_odo_ros_msg.pose.pose.position.y = utm_northing - m_utm0_.northing;
+    ref_odo_ros_msg.pose.pose.position.z = ref_ekf_nav_msg.altitude - m_utm0_.altitude;
+
+    // Convert position standard deviations to UTM frame.
+    double std_east  = ref_ekf_nav_msg.position_accuracy.x;
+    double std_north = ref_ekf_nav_msg.position_accuracy.y;
+    std_x = std_north * cos(convergence_angle) - std_east * sin(convergence_angle);
+    std_y = std_north * sin(convergence_angle) + std_east * cos(convergence_angle);
   }
 
-  LLtoUTM(ref_ekf_nav_msg.latitude, ref_ekf_nav_msg.longitude, m_utm0_.zone, utm_easting, utm_northing);
-  odo_ros_msg.pose.pose.position.x = utm_northing - m_utm0_.easting;
-  odo_ros_msg.pose.pose.position.y = utm_easting  - m_utm0_.northing;
-  odo_ros_msg.pose.pose.position.z = ref_ekf_nav_msg.altitude - m_utm0_.altitude;
-
-  // Compute convergence angle.
-  double longitudeRad      = sbgDegToRadD(ref_ekf_nav_msg.longitude);
-  double latitudeRad       = sbgDegToRadD(ref_ekf_nav_msg.latitude);
-  double central_meridian  = sbgDegToRadD(computeMeridian(m_utm0_.zone));
-  double convergence_angle = atan(tan(longitudeRad - central_meridian) * sin(latitudeRad));
-
-  // Convert position standard deviations to UTM frame.
-  double std_east  = ref_ekf_nav_msg.position_accuracy.x;
-  double std_north = ref_ekf_nav_msg.position_accuracy.y;
-  double std_x = std_north * cos(convergence_angle) - std_east * sin(convergence_angle);
-  double std_y = std_north * sin(convergence_angle) + std_east * cos(convergence_angle);
   double std_z = ref_ekf_nav_msg.position_accuracy.z;
-  odo_ros_msg.pose.covariance[0*6 + 0] = std_x * std_x;
-  odo_ros_msg.pose.covariance[1*6 + 1] = std_y * std_y;
-  odo_ros_msg.pose.covariance[2*6 + 2] = std_z * std_z;
-  odo_ros_msg.pose.covariance[3*6 + 3] = ref_ekf_euler_msg.accuracy.x * ref_ekf_euler_msg.accuracy.x;
-  odo_ros_msg.pose.covariance[4*6 + 4] = ref_ekf_euler_msg.accuracy.y * ref_ekf_euler_msg.accuracy.y;
-  odo_ros_msg.pose.covariance[5*6 + 5] = ref_ekf_euler_msg.accuracy.z * ref_ekf_euler_msg.accuracy.z;
+  ref_odo_ros_msg.pose.covariance[0*6 + 0] = std_x * std_x;
+  ref_odo_ros_msg.pose.covariance[1*6 + 1] = std_y * std_y;
+  ref_odo_ros_msg.pose.covariance[2*6 + 2] = std_z * std_z;
+  ref_odo_ros_msg.pose.covariance[3*6 + 3] = ref_ekf_euler_msg.accuracy.x * ref_ekf_euler_msg.accuracy.x;
+  ref_odo_ros_msg.pose.covariance[4*6 + 4] = ref_ekf_euler_msg.accuracy.y * ref_ekf_euler_msg.accuracy.y;
+  ref_odo_ros_msg.pose.covariance[5*6 + 5] = ref_ekf_euler_msg.accuracy.z * ref_ekf_euler_msg.accuracy.z;
 
   // The twist message gives the linear and angular velocity relative to the frame defined in child_frame_id
-  odo_ros_msg.child_frame_id            = m_frame_id_;
-  odo_ros_msg.twist.twist.linear.x      = ref_ekf_nav_msg.velocity.x;
-  odo_ros_msg.twist.twist.linear.y      = ref_ekf_nav_msg.velocity.y;
-  odo_ros_msg.twist.twist.linear.z      = ref_ekf_nav_msg.velocity.z;
-  odo_ros_msg.twist.twist.angular.x     = ref_sbg_imu_msg.gyro.x;
-  odo_ros_msg.twist.twist.angular.y     = ref_sbg_imu_msg.gyro.y;
-  odo_ros_msg.twist.twist.angular.z     = ref_sbg_imu_msg.gyro.z;
-  odo_ros_msg.twist.covariance[0*6 + 0] = ref_ekf_nav_msg.velocity_accuracy.x * ref_ekf_nav_msg.velocity_accuracy.x;
-  odo_ros_msg.twist.covariance[1*6 + 1] = ref_ekf_nav_msg.velocity_accuracy.y * ref_ekf_nav_msg.velocity_accuracy.y;
-  odo_ros_msg.twist.covariance[2*6 + 2] = ref_ekf_nav_msg.velocity_accuracy.z * ref_ekf_nav_msg.velocity_accuracy.z;
-  odo_ros_msg.twist.covariance[3*6 + 3] = 0;
-  odo_ros_msg.twist.covariance[4*6 + 4] = 0;
-  odo_ros_msg.twist.covariance[5*6 + 5] = 0;
+  ref_odo_ros_msg.child_frame_id            = m_frame_id_;
+  ref_odo_ros_msg.twist.twist.linear.x      = ref_ekf_nav_msg.velocity.x;
+  ref_odo_ros_msg.twist.twist.linear.y      = ref_ekf_nav_msg.velocity.y;
+  ref_odo_ros_msg.twist.twist.linear.z      = ref_ekf_nav_msg.velocity.z;
+  ref_odo_ros_msg.twist.twist.angular.x     = ref_sbg_imu_msg.gyro.x;
+  ref_odo_ros_msg.twist.twist.angular.y     = ref_sbg_imu_msg.gyro.y;
+  ref_odo_ros_msg.twist.twist.angular.z     = ref_sbg_imu_msg.gyro.z;
+  ref_odo_ros_msg.twist.covariance[0*6 + 0] = ref_ekf_nav_msg.velocity_accuracy.x * ref_ekf_nav_msg.velocity_accuracy.x;
+  ref_odo_ros_msg.twist.covariance[1*6 + 1] = ref_ekf_nav_msg.velocity_accuracy.y * ref_ekf_nav_msg.velocity_accuracy.y;
+  ref_odo_ros_msg.twist.covariance[2*6 + 2] = ref_ekf_nav_msg.velocity_accuracy.z * ref_ekf_nav_msg.velocity_accuracy.z;
+  ref_odo_ros_msg.twist.covariance[3*6 + 3] = 0;
+  ref_odo_ros_msg.twist.covariance[4*6 + 4] = 0;
+  ref_odo_ros_msg.twist.covariance[5*6 + 5] = 0;
 
   if (m_odom_publish_tf_)
   {
     // Publish odom transformation.
-    fillTransform(odo_ros_msg.header.frame_id, m_odom_base_frame_id_, odo_ros_msg.pose.pose, transform);
-    m_tf_broadcaster_->sendTransform(transform);
+    publishOdomTransform(ref_odo_ros_msg, ref_sbg_imu_msg.time_stamp);
   }
-
-  return odo_ros_msg;
 }
 
-const sensor_msgs::msg::Temperature MessageWrapper::createRosTemperatureMessage(const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg) const
+void MessageWrapper::fillRosTemperatureMessage(const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, sensor_msgs::msg::Temperature &ref_temperature_message) const
 {
-  sensor_msgs::msg::Temperature temperature_message;
-
-  temperature_message.header      = createRosHeader(ref_sbg_imu_msg.time_stamp);
-  temperature_message.temperature = ref_sbg_imu_msg.temp;
-  temperature_message.variance    = 0.0;
-
-  return temperature_message;
+  fillRosHeader(ref_sbg_imu_msg.time_stamp, ref_temperature_message.header);
+  ref_temperature_message.temperature = ref_sbg_imu_msg.temp;
+  ref_temperature_message.variance    = 0.0;
 }
 
-const sensor_msgs::msg::MagneticField MessageWrapper::createRosMagneticMessage(const sbg_driver::msg::SbgMag& ref_sbg_mag_msg) const
+void MessageWrapper::fillRosMagneticMessage(const sbg_driver::msg::SbgMag& ref_sbg_mag_msg, sensor_msgs::msg::MagneticField &ref_magnetic_message) const
 {
-  sensor_msgs::msg::MagneticField magnetic_message;
-
-  magnetic_message.header         = createRosHeader(ref_sbg_mag_msg.time_stamp);
-  magnetic_message.magnetic_field = ref_sbg_mag_msg.mag;
-
-  return magnetic_message;
+  fillRosHeader(ref_sbg_mag_msg.time_stamp, ref_magnetic_message.header);
+  ref_magnetic_message.magnetic_field = ref_sbg_mag_msg.mag;
 }
 
-const geometry_msgs::msg::TwistStamped MessageWrapper::createRosTwistStampedMessage(const sbg_driver::msg::SbgEkfEuler& ref_sbg_ekf_euler_msg, const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg) const
+void MessageWrapper::fillRosTwistStampedMessage(const sbg_driver::msg::SbgEkfEuler& ref_sbg_ekf_euler_msg, const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, geometry_msgs::msg::TwistStamped &ref_twist_stamped_message) const
 {
   sbg::SbgMatrix3f tdcm;
   tdcm.makeDcm(sbg::SbgVector3f(ref_sbg_ekf_euler_msg.angle.x, ref_sbg_ekf_euler_msg.angle.y, ref_sbg_ekf_euler_msg.angle.z));
@@ -1209,128 +1359,94 @@ const geometry_msgs::msg::TwistStamped MessageWrapper::createRosTwistStampedMess
 
   const sbg::SbgVector3f res = tdcm * sbg::SbgVector3f(ref_sbg_ekf_nav_msg.velocity.x, ref_sbg_ekf_nav_msg.velocity.y, ref_sbg_ekf_nav_msg.velocity.z);
 
-  return createRosTwistStampedMessage(res, ref_sbg_imu_msg);
+  fillRosTwistStampedMessage(res, ref_sbg_imu_msg, ref_twist_stamped_message);
 }
 
-const geometry_msgs::msg::TwistStamped MessageWrapper::createRosTwistStampedMessage(const sbg_driver::msg::SbgEkfQuat& ref_sbg_ekf_quat_msg, const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg) const
+void MessageWrapper::fillRosTwistStampedMessage(const sbg_driver::msg::SbgEkfQuat& ref_sbg_ekf_quat_msg, const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_nav_msg, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, geometry_msgs::msg::TwistStamped &ref_twist_stamped_message) const
 {
   sbg::SbgMatrix3f tdcm;
   tdcm.makeDcm(ref_sbg_ekf_quat_msg.quaternion.w, ref_sbg_ekf_quat_msg.quaternion.x, ref_sbg_ekf_quat_msg.quaternion.y, ref_sbg_ekf_quat_msg.quaternion.z);
   tdcm.transpose();
 
   const sbg::SbgVector3f res = tdcm * sbg::SbgVector3f(ref_sbg_ekf_nav_msg.velocity.x, ref_sbg_ekf_nav_msg.velocity.y, ref_sbg_ekf_nav_msg.velocity.z);
-  return createRosTwistStampedMessage(res, ref_sbg_imu_msg);
+  fillRosTwistStampedMessage(res, ref_sbg_imu_msg, ref_twist_stamped_message);
 }
 
-const geometry_msgs::msg::TwistStamped MessageWrapper::createRosTwistStampedMessage(const sbg::SbgVector3f& body_vel, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg) const
+void MessageWrapper::fillRosTwistStampedMessage(const sbg::SbgVector3f& body_vel, const sbg_driver::msg::SbgImuData& ref_sbg_imu_msg, geometry_msgs::msg::TwistStamped &ref_twist_stamped_message) const
 {
-  geometry_msgs::msg::TwistStamped twist_stamped_message;
-
-  twist_stamped_message.header        = createRosHeader(ref_sbg_imu_msg.time_stamp);
-  twist_stamped_message.twist.angular = ref_sbg_imu_msg.delta_angle;
-
-  twist_stamped_message.twist.linear.x = body_vel(0);
-  twist_stamped_message.twist.linear.y = body_vel(1);
-  twist_stamped_message.twist.linear.z = body_vel(2);
+  fillRosHeader(ref_sbg_imu_msg.time_stamp, ref_twist_stamped_message.header);
+  ref_twist_stamped_message.twist.angular = ref_sbg_imu_msg.delta_angle;
 
-  return twist_stamped_message;
+  ref_twist_stamped_message.twist.linear.x = body_vel(0);
+  ref_twist_stamped_message.twist.linear.y = body_vel(1);
+  ref_twist_stamped_message.twist.linear.z = body_vel(2);
 }
 
-const geometry_msgs::msg::PointStamped MessageWrapper::createRosPointStampedMessage(const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_msg) const
+void MessageWrapper::fillRosPointStampedMessage(const sbg_driver::msg::SbgEkfNav& ref_sbg_ekf_msg, geometry_msgs::msg::PointStamped &ref_point_stamped_message) const
 {
-  geometry_msgs::msg::PointStamped point_stamped_message;
-
-  point_stamped_message.header = createRosHeader(ref_sbg_ekf_msg.time_stamp);
+  fillRosHeader(ref_sbg_ekf_msg.time_stamp, ref_point_stamped_message.header);
 
   //
-  // Conversion from Geodetic coordinates to ECEF is based on World Geodetic System 1984 (WGS84).
-  // Radius are expressed in meters, and latitude/longitude in radian.
+  // The ECEF position uses the height above the WGS84 ellipsoid, the altitude is above the mean sea level.
   //
-  double equatorial_radius;
-  double polar_radius;
-  double prime_vertical_radius;
-  double eccentricity;
-  double latitude;
-  double longitude;
-
-  equatorial_radius = 6378137.0;
-  polar_radius      = 6356752.314245;
-  eccentricity      = 1 - pow(polar_radius, 2) / pow(equatorial_radius, 2);
-  latitude          = sbgDegToRadD(ref_sbg_ekf_msg.latitude);
-  longitude         = sbgDegToRadD(ref_sbg_ekf_msg.longitude);
-
-  prime_vertical_radius = equatorial_radius / sqrt(1.0 - pow(eccentricity, 2) * pow(sin(latitude), 2));
+  const SbgVector3d ecef_position = convertToEcef(ref_sbg_ekf_msg.latitude, ref_sbg_ekf_msg.longitude, ref_sbg_ekf_msg.altitude + ref_sbg_ekf_msg.undulation);
 
-  point_stamped_message.point.x = (prime_vertical_radius + ref_sbg_ekf_msg.altitude) * cos(latitude) * cos(longitude);
-  point_stamped_message.point.y = (prime_vertical_radius + ref_sbg_ekf_msg.altitude) * cos(latitude) * sin(longitude);
-  point_stamped_message.point.z = ((pow(polar_radius, 2) / pow(equatorial_radius, 2)) * prime_vertical_radius + ref_sbg_ekf_msg.altitude) * sin(latitude);
-
-  return point_stamped_message;
+  ref_point_stamped_message.point.x = ecef_position(0);
+  ref_point_stamped_message.point.y = ecef_position(1);
+  ref_point_stamped_message.point.z = ecef_position(2);
 }
 
-const sensor_msgs::msg::TimeReference MessageWrapper::createRosUtcTimeReferenceMessage(const sbg_driver::msg::SbgUtcTime& ref_sbg_utc_msg) const
+void MessageWrapper::fillRosUtcTimeReferenceMessage(const sbg_driver::msg::SbgUtcTime& ref_sbg_utc_msg, sensor_msgs::msg::TimeReference &ref_utc_reference_message) const
 {
-  sensor_msgs::msg::TimeReference utc_reference_message;
-
   //
   // This message is defined to have comparison between the System time and the Utc reference.
   // Header of the ROS message will always be the System time, and the source is the computed time from Utc data.
   //
-  utc_reference_message.header.stamp  = rclcpp::Clock().now();
-  utc_reference_message.time_ref      = convertInsTimeToUnix(ref_sbg_utc_msg.time_stamp);
-  utc_reference_message.source        = "UTC time from device converted to Epoch";
-
-  return utc_reference_message;
+  ref_utc_reference_message.header.stamp  = m_clock_->now();
+  ref_utc_reference_message.time_ref      = convertInsTimeToUnix(ref_sbg_utc_msg.time_stamp);
+  ref_utc_reference_message.source        = "UTC time from device converted to Epoch";
 }
 
-const sensor_msgs::msg::NavSatFix MessageWrapper::createRosNavSatFixMessage(const sbg_driver::msg::SbgGpsPos& ref_sbg_gps_msg) const
+void MessageWrapper::fillRosNavSatFixMessage(const sbg_driver::msg::SbgGpsPos& ref_sbg_gps_msg, sensor_msgs::msg::NavSatFix &ref_nav_sat_fix_message) const
 {
-  sensor_msgs::msg::NavSatFix nav_sat_fix_message;
-
-  nav_sat_fix_message.header = createRosHeader(ref_sbg_gps_msg.time_stamp);
+  fillRosHeader(ref_sbg_gps_msg.time_stamp, ref_nav_sat_fix_message.header);
 
   if (ref_sbg_gps_msg.status.type == SBG_ECOM_POS_NO_SOLUTION)
   {
-    nav_sat_fix_message.status.status = nav_sat_fix_message.status.STATUS_NO_FIX;
+    ref_nav_sat_fix_message.status.status = ref_nav_sat_fix_message.status.STATUS_NO_FIX;
   }
   else if (ref_sbg_gps_msg.status.type == SBG_ECOM_POS_SBAS)
   {
-    nav_sat_fix_message.status.status = nav_sat_fix_message.status.STATUS_SBAS_FIX;
+    ref_nav_sat_fix_message.status.status = ref_nav_sat_fix_message.status.STATUS_SBAS_FIX;
   }
   else
   {
-    nav_sat_fix_message.status.status = nav_sat_fix_message.status.STATUS_FIX;
+    ref_nav_sat_fix_message.status.status = ref_nav_sat_fix_message.status.STATUS_FIX;
   }
 
   if (ref_sbg_gps_msg.status.glo_l1_used || ref_sbg_gps_msg.status.glo_l2_used)
   {
-    nav_sat_fix_message.status.service = nav_sat_fix_message.status.SERVICE_GLONASS;
+    ref_nav_sat_fix_message.status.service = ref_nav_sat_fix_message.status.SERVICE_GLONASS;
   }
   else
   {
-    nav_sat_fix_message.status.service = nav_sat_fix_message.status.SERVICE_GPS;
+    ref_nav_sat_fix_message.status.service = ref_nav_sat_fix_message.status.SERVICE_GPS;
   }
 
-  nav_sat_fix_message.latitude  = ref_sbg_gps_msg.latitude;
-  nav_sat_fix_message.longitude = ref_sbg_gps_msg.longitude;
-  nav_sat_fix_message.altitude  = ref_sbg_gps_msg.altitude + ref_sbg_gps_msg.undulation;
-
-  nav_sat_fix_message.position_covariance[0] = ref_sbg_gps_msg.position_accuracy.x * ref_sbg_gps_msg.position_accuracy.x;
-  nav_sat_fix_message.position_covariance[4] = ref_sbg_gps_msg.position_accuracy.y * ref_sbg_gps_msg.position_accuracy.y;
-  nav_sat_fix_message.position_covariance[8] = ref_sbg_gps_msg.position_accuracy.z * ref_sbg_gps_msg.position_accuracy.z;
+  ref_nav_sat_fix_message.latitude  = ref_sbg_gps_msg.latitude;
+  ref_nav_sat_fix_message.longitude = ref_sbg_gps_msg.longitude;
+  ref_nav_sat_fix_message.altitude  = ref_sbg_gps_msg.altitude + ref_sbg_gps_msg.undulation;
 
-  nav_sat_fix_message.position_covariance_type = nav_sat_fix_message.COVARIANCE_TYPE_DIAGONAL_KNOWN;
+  ref_nav_sat_fix_message.position_covariance[0] = ref_sbg_gps_msg.position_accuracy.x * ref_sbg_gps_msg.position_accuracy.x;
+  ref_nav_sat_fix_message.position_covariance[4] = ref_sbg_gps_msg.position_accuracy.y * ref_sbg_gps_msg.position_accuracy.y;
+  ref_nav_sat_fix_message.position_covariance[8] = ref_sbg_gps_msg.position_accuracy.z * ref_sbg_gps_msg.position_accuracy.z;
 
-  return nav_sat_fix_message;
+  ref_nav_sat_fix_message.position_covariance_type = ref_nav_sat_fix_message.COVARIANCE_TYPE_DIAGONAL_KNOWN;
 }
 
-const sensor_msgs::msg::FluidPressure MessageWrapper::createRosFluidPressureMessage(const sbg_driver::msg::SbgAirData& ref_sbg_air_msg) const
+void MessageWrapper::fillRosFluidPressureMessage(const sbg_driver::msg::SbgAirData& ref_sbg_air_msg, sensor_msgs::msg::FluidPressure &ref_fluid_pressure_message) const
 {
-  sensor_msgs::msg::FluidPressure fluid_pressure_message;
-
-  fluid_pressure_message.header         = createRosHeader(ref_sbg_air_msg.time_stamp);
-  fluid_pressure_message.fluid_pressure = ref_sbg_air_msg.pressure_abs;
-  fluid_pressure_message.variance       = 0.0;
-
-  return fluid_pressure_message;
+  fillRosHeader(ref_sbg_air_msg.time_stamp, ref_fluid_pressure_message.header);
+  ref_fluid_pressure_message.fluid_pressure = ref_sbg_air_msg.pressure_abs;
+  ref_fluid_pressure_message.variance       = 0.0;
 }
@@ -0,0 +1,253 @@
+// File header
+#include "pose_history.h"
+
+// Standard headers
+#include <cmath>
+
+using sbg::PoseHistory;
+using sbg::AlignStatus;
+
+/*!
+ * Backward jump of the time stamps above which the device is considered to have restarted (us).
+ */
+#define SBG_POSE_HISTORY_RESET_THRESHOLD  (1000000)
+
+/*!
+ * Class to keep the recent EKF poses and interpolate them at a given time.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+PoseHistory::PoseHistory(void):
+m_max_gap_(50000),
+m_time_stamp_valid_(false),
+m_last_time_stamp_(0),
+m_last_device_time_(0)
+{
+}
+
+//---------------------------------------------------------------------//
+//- Private methods                                                   -//
+//---------------------------------------------------------------------//
+
+uint64_t PoseHistory::unwrapTimeStamp(uint32_t time_stamp, const rclcpp::Time &ref_stamp)
+{
+  int32_t time_difference;
+
+  //
+  // Start above 2^32 so logs slightly older than the first one can't underflow.
+  //
+  if (!m_time_stamp_valid_)
+  {
+    m_time_stamp_valid_ = true;
+    m_last_device_time_ = (static_cast<uint64_t>(1) << 32) + time_stamp;
+  }
+  else
+  {
+    time_difference = static_cast<int32_t>(time_stamp - m_last_time_stamp_);
+
+    if (time_difference < -SBG_POSE_HISTORY_RESET_THRESHOLD)
+    {
+      m_nav_channel_.clear();
+      m_quat_channel_.clear();
+      m_last_device_time_ = (static_cast<uint64_t>(1) << 32) + time_stamp;
+    }
+    else
+    {
+      m_last_device_time_ += time_difference;
+    }
+  }
+
+  m_last_time_stamp_  = time_stamp;
+  m_last_stamp_       = ref_stamp;
+
+  return m_last_device_time_;
+}
+
+AlignStatus PoseHistory::interpolatePose(uint64_t device_time, Pose &ref_pose) const
+{
+  AlignStatus                 nav_status;
+  AlignStatus                 quat_status;
+  size_t                      nav_index;
+  size_t                      quat_index;
+  double                      nav_ratio;
+  double                      quat_ratio;
+  sbg_driver::msg::SbgEkfQuat quat_before;
+  sbg_driver::msg::SbgEkfQuat quat_after;
+  sbg_driver::msg::SbgEkfQuat quat_interpolated;
+  double                      longitude_difference;
+
+  nav_status  = m_nav_channel_.find(device_time, m_max_gap_, nav_index, nav_ratio);
+  quat_status = m_quat_channel_.find(device_time, m_max_gap_, quat_index, quat_ratio);
+
+  if ((nav_status == AlignStatus::UNAVAILABLE) || (quat_status == AlignStatus::UNAVAILABLE))
+  {
+    return AlignStatus::UNAVAILABLE;
+  }
+  else if ((nav_status == AlignStatus::PENDING) || (quat_status == AlignStatus::PENDING))
+  {
+    return AlignStatus::PENDING;
+  }
+
+  ref_pose.device_time  = device_time;
+  ref_pose.stamp        = m_last_stamp_ + rclcpp::Duration(std::chrono::nanoseconds(static_cast<int64_t>(device_time - m_last_device_time_) * 1000));
+  ref_pose.latitude     = m_nav_channel_.interpolateValue(NAV_LATITUDE, nav_index, nav_ratio);
+  ref_pose.altitude     = m_nav_channel_.interpolateValue(NAV_ALTITUDE, nav_index, nav_ratio);
+  ref_pose.velocity.x   = m_nav_channel_.interpolateValue(NAV_VELOCITY_X, nav_index, nav_ratio);
+  ref_pose.velocity.y   = m_nav_channel_.interpolateValue(NAV_VELOCITY_Y, nav_index, nav_ratio);
+  ref_pose.velocity.z   = m_nav_channel_.interpolateValue(NAV_VELOCITY_Z, nav_index, nav_ratio);
+
+  //
+  // Interpolate the longitude along the shortest direction across the antimeridian.
+  //
+  ref_pose.longitude = m_nav_channel_.getValue(NAV_LONGITUDE, nav_index);
+
+  if (nav_ratio != 0.0)
+  {
+    longitude_difference  = std::remainder(m_nav_channel_.getValue(NAV_LONGITUDE, nav_index + 1) - ref_pose.longitude, 360.0);
+    ref_pose.longitude    = std::remainder(ref_pose.longitude + longitude_difference * nav_ratio, 360.0);
+  }
+
+  quat_before.quaternion.x  = m_quat_channel_.getValue(QUAT_X, quat_index);
+  quat_before.quaternion.y  = m_quat_channel_.getValue(QUAT_Y, quat_index);
+  quat_before.quaternion.z  = m_quat_channel_.getValue(QUAT_Z, quat_index);
+  quat_before.quaternion.w  = m_quat_channel_.getValue(QUAT_W, quat_index);
+
+  if (quat_ratio == 0.0)
+  {
+    ref_pose.quaternion = quat_before.quaternion;
+  }
+  else
+  {
+    quat_after.quaternion.x = m_quat_channel_.getValue(QUAT_X, quat_index + 1);
+    quat_after.quaternion.y = m_quat_channel_.getValue(QUAT_Y, quat_index + 1);
+    quat_after.quaternion.z = m_quat_channel_.getValue(QUAT_Z, quat_index + 1);
+    quat_after.quaternion.w = m_quat_channel_.getValue(QUAT_W, quat_index + 1);
+
+    interpolate(quat_before, quat_after, quat_ratio, quat_interpolated);
+    ref_pose.quaternion = quat_interpolated.quaternion;
+  }
+
+  return AlignStatus::ALIGNED;
+}
+
+bool PoseHistory::processPoseAtTime(const std::shared_ptr<sbg_driver::srv::SbgPoseAtTime::Request> ref_ros_request, std::shared_ptr<sbg_driver::srv::SbgPoseAtTime::Response> ref_ros_response)
+{
+  AlignStatus status;
+  Pose        pose;
+
+  if (ref_ros_request->use_device_time)
+  {
+    status = getPose(ref_ros_request->time_stamp, pose);
+  }
+  else
+  {
+    status = getPose(rclcpp::Time(ref_ros_request->stamp), pose);
+  }
+
+  if (status == AlignStatus::ALIGNED)
+  {
+    ref_ros_response->status          = sbg_driver::srv::SbgPoseAtTime::Response::STATUS_OK;
+    ref_ros_response->header.frame_id = m_frame_id_;
+    ref_ros_response->header.stamp    = pose.stamp;
+    ref_ros_response->time_stamp      = static_cast<uint32_t>(pose.device_time);
+    ref_ros_response->latitude        = pose.latitude;
+    ref_ros_response->longitude       = pose.longitude;
+    ref_ros_response->altitude        = pose.altitude;
+    ref_ros_response->velocity        = pose.velocity;
+    ref_ros_response->quaternion      = pose.quaternion;
+  }
+  else if (status == AlignStatus::PENDING)
+  {
+    ref_ros_response->status = sbg_driver::srv::SbgPoseAtTime::Response::STATUS_PENDING;
+  }
+  else
+  {
+    ref_ros_response->status = sbg_driver::srv::SbgPoseAtTime::Response::STATUS_UNAVAILABLE;
+  }
+
+  return true;
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+void PoseHistory::setCapacity(size_t capacity)
+{
+  std::lock_guard<std::mutex> lock(m_mutex_);
+
+  m_nav_channel_.setCapacity(capacity);
+  m_quat_channel_.setCapacity(capacity);
+  m_time_stamp_valid_ = false;
+}
+
+void PoseHistory::setMaxGap(uint32_t max_gap)
+{
+  std::lock_guard<std::mutex> lock(m_mutex_);
+
+  m_max_gap_ = max_gap;
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void PoseHistory::initService(rclcpp::Node &ref_ros_node_handle, const std::string &ref_frame_id)
+{
+  m_frame_id_             = ref_frame_id;
+  m_pose_at_time_service_ = ref_ros_node_handle.create_service<sbg_driver::srv::SbgPoseAtTime>("sbg/pose_at_time", std::bind(&PoseHistory::processPoseAtTime, this, std::placeholders::_1, std::placeholders::_2));
+}
+
+void PoseHistory::addNavigation(const sbg_driver::msg::SbgEkfNav &ref_ekf_nav)
+{
+  std::lock_guard<std::mutex> lock(m_mutex_);
+  uint64_t                    device_time;
+
+  device_time = unwrapTimeStamp(ref_ekf_nav.time_stamp, ref_ekf_nav.header.stamp);
+
+  m_nav_channel_.push(device_time, {{ ref_ekf_nav.latitude, ref_ekf_nav.longitude, ref_ekf_nav.altitude, ref_ekf_nav.velocity.x, ref_ekf_nav.velocity.y, ref_ekf_nav.velocity.z }});
+}
+
+void PoseHistory::addAttitude(const sbg_driver::msg::SbgEkfQuat &ref_ekf_quat)
+{
+  std::lock_guard<std::mutex> lock(m_mutex_);
+  uint64_t                    device_time;
+
+  device_time = unwrapTimeStamp(ref_ekf_quat.time_stamp, ref_ekf_quat.header.stamp);
+
+  m_quat_channel_.push(device_time, {{ ref_ekf_quat.quaternion.x, ref_ekf_quat.quaternion.y, ref_ekf_quat.quaternion.z, ref_ekf_quat.quaternion.w }});
+}
+
+AlignStatus PoseHistory::getPose(uint32_t time_stamp, Pose &ref_pose) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex_);
+
+  if (!m_time_stamp_valid_)
+  {
+    return AlignStatus::PENDING;
+  }
+
+  return interpolatePose(m_last_device_time_ + static_cast<int32_t>(time_stamp - m_last_time_stamp_), ref_pose);
+}
+
+AlignStatus PoseHistory::getPose(const rclcpp::Time &ref_stamp, Pose &ref_pose) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex_);
+  int64_t                     time_difference;
+
+  if (!m_time_stamp_valid_)
+  {
+    return AlignStatus::PENDING;
+  }
+
+  time_difference = (ref_stamp - m_last_stamp_).nanoseconds() / 1000;
+
+  if ((time_difference < 0) && (static_cast<uint64_t>(-time_difference) > m_last_device_time_))
+  {
+    return AlignStatus::UNAVAILABLE;
+  }
+
+  return interpolatePose(m_last_device_time_ + time_difference, ref_pose);
+}
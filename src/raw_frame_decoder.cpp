@@ -0,0 +1,88 @@
+// File header
+#include "raw_frame_decoder.h"
+
+using sbg::RawFrameDecoder;
+
+/*!
+ * Class to decode the raw frames of a device and publish its logs.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+RawFrameDecoder::RawFrameDecoder(rclcpp::Node& ref_node_handle):
+m_ref_node_(ref_node_handle),
+m_message_publisher_(ref_node_handle.get_namespace())
+{
+  loadParameters();
+
+  m_message_publisher_.initPublishers(m_ref_node_, m_config_store_);
+
+  m_raw_frames_sub_ = m_ref_node_.create_subscription<sbg_driver::msg::SbgRawFrames>("sbg/raw_frames", 10, std::bind(&RawFrameDecoder::processRawFrames, this, std::placeholders::_1));
+}
+
+//---------------------------------------------------------------------//
+//- Private  methods                                                  -//
+//---------------------------------------------------------------------//
+
+void RawFrameDecoder::loadParameters(void)
+{
+  //
+  // The parameters are loaded like in the device node, so the decoder can share its configuration file.
+  //
+  rclcpp::NodeOptions node_opt;
+  node_opt.automatically_declare_parameters_from_overrides(true);
+  rclcpp::Node n_private("npv", m_ref_node_.get_namespace(), node_opt);
+  m_config_store_.loadFromRosNodeHandle(n_private);
+}
+
+void RawFrameDecoder::processRawFrames(const sbg_driver::msg::SbgRawFrames::SharedPtr p_raw_frames)
+{
+  size_t frame_count;
+
+  frame_count = p_raw_frames->offsets.size();
+
+  if ((p_raw_frames->msg_class.size() != frame_count) || (p_raw_frames->msg_id.size() != frame_count) || (p_raw_frames->stamps.size() != frame_count))
+  {
+    RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER - [Decoder] Raw frames message with inconsistent sizes dropped.");
+    return;
+  }
+
+  for (size_t i = 0; i < frame_count; i++)
+  {
+    SbgEComClass      msg_class;
+    SbgEComMsgId      msg;
+    size_t            start;
+    size_t            end;
+    SbgBinaryLogData  log_data;
+    SbgErrorCode      error_code;
+
+    msg_class = static_cast<SbgEComClass>(p_raw_frames->msg_class[i]);
+    msg       = static_cast<SbgEComMsgId>(p_raw_frames->msg_id[i]);
+    start     = p_raw_frames->offsets[i];
+    end       = (i + 1 < frame_count) ? p_raw_frames->offsets[i + 1] : p_raw_frames->data.size();
+
+    if ((start > end) || (end > p_raw_frames->data.size()))
+    {
+      RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER - [Decoder] Raw frames message with invalid offsets dropped.");
+      return;
+    }
+
+    if (!sbgEComMsgClassIsALog(msg_class))
+    {
+      continue;
+    }
+
+    error_code = sbgEComBinaryLogParse(msg_class, msg, p_raw_frames->data.data() + start, end - start, &log_data);
+
+    if (error_code == SBG_NO_ERROR)
+    {
+      m_message_publisher_.setReceptionStamp(p_raw_frames->stamps[i]);
+      m_message_publisher_.publish(msg_class, msg, log_data);
+    }
+    else
+    {
+      RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER - [Decoder] Unable to parse log %u/%u - %s", msg_class, msg, sbgErrorCodeToString(error_code));
+    }
+  }
+}
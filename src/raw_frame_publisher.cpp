@@ -0,0 +1,86 @@
+// File header
+#include "raw_frame_publisher.h"
+
+using sbg::RawFramePublisher;
+
+/*!
+ * Class to publish the received log frames in batches.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+RawFramePublisher::RawFramePublisher(void):
+m_batch_size_(0)
+{
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+bool RawFramePublisher::isEnabled(void) const
+{
+  return static_cast<bool>(m_raw_frames_pub_);
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void RawFramePublisher::initPublisher(rclcpp::Node &ref_ros_node_handle, const std::string &ref_frame_id, uint32_t batch_size)
+{
+  m_clock_                              = ref_ros_node_handle.get_clock();
+  m_batch_size_                         = batch_size;
+  m_raw_frames_message_.header.frame_id = ref_frame_id;
+
+  //
+  // Reserve a full batch of typical frames, so the vectors are not reallocated for each message.
+  //
+  m_raw_frames_message_.msg_class.reserve(m_batch_size_);
+  m_raw_frames_message_.msg_id.reserve(m_batch_size_);
+  m_raw_frames_message_.offsets.reserve(m_batch_size_);
+  m_raw_frames_message_.stamps.reserve(m_batch_size_);
+  m_raw_frames_message_.data.reserve(m_batch_size_ * 128);
+
+  m_raw_frames_pub_ = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgRawFrames>("sbg/raw_frames", 10);
+}
+
+void RawFramePublisher::addFrame(SbgEComClass msg_class, SbgEComMsgId msg, const void *p_payload, size_t payload_size)
+{
+  const uint8_t *p_bytes;
+  rclcpp::Time  stamp;
+
+  p_bytes = static_cast<const uint8_t*>(p_payload);
+  stamp   = m_clock_->now();
+
+  if (m_raw_frames_message_.offsets.empty())
+  {
+    m_raw_frames_message_.header.stamp = stamp;
+  }
+
+  m_raw_frames_message_.msg_class.push_back(static_cast<uint8_t>(msg_class));
+  m_raw_frames_message_.msg_id.push_back(static_cast<uint8_t>(msg));
+  m_raw_frames_message_.offsets.push_back(static_cast<uint32_t>(m_raw_frames_message_.data.size()));
+  m_raw_frames_message_.stamps.push_back(stamp);
+  m_raw_frames_message_.data.insert(m_raw_frames_message_.data.end(), p_bytes, p_bytes + payload_size);
+
+  if (m_raw_frames_message_.offsets.size() >= m_batch_size_)
+  {
+    flush();
+  }
+}
+
+void RawFramePublisher::flush(void)
+{
+  if (m_raw_frames_pub_ && !m_raw_frames_message_.offsets.empty())
+  {
+    m_raw_frames_pub_->publish(m_raw_frames_message_);
+
+    m_raw_frames_message_.msg_class.clear();
+    m_raw_frames_message_.msg_id.clear();
+    m_raw_frames_message_.offsets.clear();
+    m_raw_frames_message_.stamps.clear();
+    m_raw_frames_message_.data.clear();
+  }
+}
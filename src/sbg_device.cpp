@@ -6,49 +6,12 @@
 #include <fstream>
 #include <ctime>
 
-// Boost headers
-#include <boost/lexical_cast.hpp>
-#include <boost/regex.hpp>
-#include <boost/thread/xtime.hpp>
-#include <boost/date_time/local_time/local_time.hpp>
-
 // SbgECom headers
 #include <version/sbgVersion.h>
 
 using namespace std;
 using sbg::SbgDevice;
 
-// From ros_com/recorder
-std::string timeToStr() //rclcpp::WallTimer<std::function<void()>> ros_t) //TODO: FIXME
-{
-    //(void)ros_t;
-    std::stringstream msg;
-    const boost::posix_time::ptime now = boost::posix_time::second_clock::local_time();
-    boost::posix_time::time_facet *const f = new boost::posix_time::time_facet("%Y-%m-%d-%H-%M-%S");
-    msg.imbue(std::locale(msg.getloc(),f));
-    msg << now;
-    return msg.str();
-}
-
-//
-// Static magnetometers maps definition.
-//
-std::map<SbgEComMagCalibQuality, std::string> SbgDevice::g_mag_calib_quality_ = { {SBG_ECOM_MAG_CALIB_QUAL_OPTIMAL, "Quality: optimal"},
-                                                                                  {SBG_ECOM_MAG_CALIB_QUAL_GOOD, "Quality: good"},
-                                                                                  {SBG_ECOM_MAG_CALIB_QUAL_POOR, "Quality: poor"},
-                                                                                  {SBG_ECOM_MAG_CALIB_QUAL_INVALID, "Quality: invalid"}};
-
-std::map<SbgEComMagCalibConfidence, std::string> SbgDevice::g_mag_calib_confidence_ = { {SBG_ECOM_MAG_CALIB_TRUST_HIGH, "Confidence: high"},
-                                                                                        {SBG_ECOM_MAG_CALIB_TRUST_MEDIUM, "Confidence: medium"},
-                                                                                        {SBG_ECOM_MAG_CALIB_TRUST_LOW, "Confidence: low"}};
-
-std::map<SbgEComMagCalibMode, std::string> SbgDevice::g_mag_calib_mode_ = { {SBG_ECOM_MAG_CALIB_MODE_2D, "Mode 2D"},
-                                                                            {SBG_ECOM_MAG_CALIB_MODE_3D, "Mode 3D"}};
-
-std::map<SbgEComMagCalibBandwidth, std::string> SbgDevice::g_mag_calib_bandwidth = {{SBG_ECOM_MAG_CALIB_HIGH_BW, "High Bandwidth"},
-                                                                                    {SBG_ECOM_MAG_CALIB_MEDIUM_BW, "Medium Bandwidth"},
-                                                                                    {SBG_ECOM_MAG_CALIB_LOW_BW, "Low Bandwidth"}};
-
 /*!
  * Class to handle a connected SBG device.
  */
@@ -58,8 +21,15 @@ std::map<SbgEComMagCalibBandwidth, std::string> SbgDevice::g_mag_calib_bandwidth
 
 SbgDevice::SbgDevice(rclcpp::Node& ref_node_handle):
 m_ref_node_(ref_node_handle),
-m_mag_calibration_ongoing_(false),
-m_mag_calibration_done_(false)
+m_message_publisher_(ref_node_handle.get_namespace()),
+m_rate_frequency_(0),
+m_log_filter_countdown_(0),
+m_status_countdown_(0),
+m_log_consumed_(),
+m_log_consumed_cached_(),
+m_last_link_stats_(),
+m_device_serial_number_(0),
+m_device_firmware_rev_(0)
 {
   loadParameters();
   connect();
@@ -111,20 +81,60 @@ SbgErrorCode SbgDevice::onLogReceivedCallback(SbgEComHandle* p_handle, SbgEComCl
 
 void SbgDevice::onLogReceived(SbgEComClass msg_class, SbgEComMsgId msg, const SbgBinaryLogData& ref_sbg_data)
 {
+  //
+  // Export the latest state first, the co-located readers don't wait for the ROS messages.
+  //
+  m_shared_state_writer_.write(msg_class, msg, ref_sbg_data);
+
   //
   // Publish the received SBG log.
   //
   m_message_publisher_.publish(msg_class, msg, ref_sbg_data);
+
+  if (m_config_store_.getLatencyDiagnostics())
+  {
+    m_latency_monitor_.onLogPublished(msg_class, msg, isLogConsumed(msg_class, msg));
+  }
+}
+
+bool SbgDevice::onFrameReceivedCallback(SbgEComHandle *p_handle, SbgEComClass msg_class, SbgEComMsgId msg, const void *p_payload, size_t payload_size, void *p_user_arg)
+{
+  assert(p_user_arg);
+
+  SBG_UNUSED_PARAMETER(p_handle);
+
+  SbgDevice *p_sbg_device;
+  p_sbg_device = static_cast<SbgDevice*>(p_user_arg);
+
+  return p_sbg_device->onFrameReceived(msg_class, msg, p_payload, payload_size);
+}
+
+bool SbgDevice::onFrameReceived(SbgEComClass msg_class, SbgEComMsgId msg, const void *p_payload, size_t payload_size)
+{
+  m_frame_relay_.relayFrame(msg_class, msg, p_payload, payload_size);
+
+  //
+  // The raw frames are decoded by another node, so they are not parsed here.
+  //
+  if (m_raw_frame_publisher_.isEnabled())
+  {
+    m_raw_frame_publisher_.addFrame(msg_class, msg, p_payload, payload_size);
+
+    return true;
+  }
+
+  return false;
 }
 
 void SbgDevice::loadParameters(void)
 {
   //
   // Get the ROS private nodeHandle, where the parameters are loaded from the launch file.
+  // It shares the device node namespace, so each device of a multi device process gets its own parameters.
   //
   rclcpp::NodeOptions node_opt;
   node_opt.automatically_declare_parameters_from_overrides(true);
-  rclcpp::Node n_private("npv", "", node_opt);
+  rclcpp::Node n_private("npv", m_ref_node_.get_namespace(), node_opt);
   m_config_store_.loadFromRosNodeHandle(n_private);
 }
 
@@ -147,6 +157,14 @@ void SbgDevice::connect(void)
 	sbgNetworkIpToString(m_config_store_.getIpAddress(), ip, sizeof(ip));
     RCLCPP_INFO(m_ref_node_.get_logger(), "SBG_DRIVER - UDP interface %s %d->%d", ip, m_config_store_.getInputPortAddress(), m_config_store_.getOutputPortAddress());
     error_code = sbgInterfaceUdpCreate(&m_sbg_interface_, m_config_store_.getIpAddress(), m_config_store_.getInputPortAddress(), m_config_store_.getOutputPortAddress());
+
+    //
+    // The frames relayed by another driver are received from a multicast group.
+    //
+    if ((error_code == SBG_NO_ERROR) && sbgIpAddressIsMulticast(m_config_store_.getIpAddress()))
+    {
+      error_code = sbgInterfaceUdpJoinMulticast(&m_sbg_interface_, m_config_store_.getIpAddress());
+    }
   }
   else
   {
@@ -165,7 +183,22 @@ void SbgDevice::connect(void)
     rclcpp::exceptions::throw_from_rcl_error(RCL_RET_ERROR, "SBG_DRIVER - [Init] Unable to initialize the SbgECom protocol - " + std::string(sbgErrorCodeToString(error_code)));
   }
 
-  readDeviceInfo();
+  //
+  // The command queue registers its receive command callback, so it is created once the protocol is initialized.
+  //
+  m_command_queue_ = std::make_unique<AsyncCommandQueue>(m_com_handle_);
+
+  //
+  // A multicast group only carries the relayed frames, the device can't answer commands.
+  //
+  if (m_config_store_.isInterfaceUdp() && sbgIpAddressIsMulticast(m_config_store_.getIpAddress()))
+  {
+    RCLCPP_INFO(m_ref_node_.get_logger(), "SBG_DRIVER - Receiving relayed frames, the device information isn't available.");
+  }
+  else
+  {
+    readDeviceInfo();
+  }
 }
 
 void SbgDevice::readDeviceInfo(void)
@@ -177,6 +210,9 @@ void SbgDevice::readDeviceInfo(void)
 
   if (error_code == SBG_NO_ERROR)
   {
+    m_device_serial_number_ = device_info.serialNumber;
+    m_device_firmware_rev_  = device_info.firmwareRev;
+
     RCLCPP_INFO(m_ref_node_.get_logger(), "SBG_DRIVER - productCode = %s", device_info.productCode);
     RCLCPP_INFO(m_ref_node_.get_logger(), "SBG_DRIVER - serialNumber = %u", device_info.serialNumber);
 
@@ -202,253 +238,184 @@ std::string SbgDevice::getVersionAsString(uint32 sbg_version_enc) const
 
 void SbgDevice::initPublishers(void)
 {
-  m_message_publisher_.initPublishers(m_ref_node_, m_config_store_);
-
-  m_rate_frequency_ = m_config_store_.getReadingRateFrequency();
-}
-
-void SbgDevice::configure(void)
-{
-  if (m_config_store_.checkConfigWithRos())
+  //
+  // The raw frames are decoded by another node, so the log publishers aren't created.
+  //
+  if (m_config_store_.getRawFrames())
   {
-    ConfigApplier configApplier(m_com_handle_);
-    configApplier.applyConfiguration(m_config_store_);
-  }
-}
-
-bool SbgDevice::processMagCalibration(const std::shared_ptr<std_srvs::srv::Trigger::Request> ref_ros_request, std::shared_ptr<std_srvs::srv::Trigger::Response> ref_ros_response)
-{
-  SBG_UNUSED_PARAMETER(ref_ros_request);
-
-  if (m_mag_calibration_ongoing_)
-  {
-    if (endMagCalibration())
-    {
-      ref_ros_response->success = true;
-      ref_ros_response->message = "Magnetometer calibration is finished. See the output console to get calibration informations.";
-    }
-    else
-    {
-      ref_ros_response->success = false;
-      ref_ros_response->message = "Unable to end the calibration.";
-    }
-
-    m_mag_calibration_ongoing_  = false;
-    m_mag_calibration_done_     = true;
+    m_raw_frame_publisher_.initPublisher(m_ref_node_, m_config_store_.getFrameId(), m_config_store_.getRawFramesBatchSize());
   }
   else
   {
-    if (startMagCalibration())
-    {
-      ref_ros_response->success = true;
-      ref_ros_response->message = "Magnetometer calibration process started.";
-    }
-    else
-    {
-      ref_ros_response->success = false;
-      ref_ros_response->message = "Unable to start magnetometers calibration.";
-    }
-
-    m_mag_calibration_ongoing_ = true;
+    m_message_publisher_.initPublishers(m_ref_node_, m_config_store_);
   }
 
-  return ref_ros_response->success;
+  m_rate_frequency_ = m_config_store_.getReadingRateFrequency();
 }
 
-bool SbgDevice::saveMagCalibration(const std::shared_ptr<std_srvs::srv::Trigger::Request> ref_ros_request, std::shared_ptr<std_srvs::srv::Trigger::Response> ref_ros_response)
+bool SbgDevice::isLogConsumed(SbgEComClass msg_class, SbgEComMsgId msg)
 {
-  SBG_UNUSED_PARAMETER(ref_ros_request);
+  size_t index;
 
-  if (m_mag_calibration_ongoing_)
+  if (msg_class == SBG_ECOM_CLASS_LOG_ECOM_0)
   {
-    ref_ros_response->success = false;
-    ref_ros_response->message = "Magnetometer calibration process is still ongoing, finish it before trying to save it.";
+    index = msg;
   }
-  else if (m_mag_calibration_done_)
+  else if (msg_class == SBG_ECOM_CLASS_LOG_ECOM_1)
   {
-    if (uploadMagCalibrationToDevice())
-    {
-      ref_ros_response->success = true;
-      ref_ros_response->message = "Magnetometer calibration has been uploaded to the device.";
-    }
-    else
-    {
-      ref_ros_response->success = false;
-      ref_ros_response->message = "Magnetometer calibration has not been uploaded to the device.";
-    }
+    index = 256 + msg;
   }
   else
   {
-    ref_ros_response->success = false;
-    ref_ros_response->message = "No magnetometer calibration has been done.";
+    return m_message_publisher_.isLogConsumed(msg_class, msg);
   }
 
-  return ref_ros_response->success;
+  //
+  // The subscription counts are read from the middleware, only once per handle call for each received log.
+  //
+  if (!m_log_consumed_cached_[index])
+  {
+    m_log_consumed_[index]        = m_message_publisher_.isLogConsumed(msg_class, msg);
+    m_log_consumed_cached_[index] = true;
+  }
+
+  return m_log_consumed_[index];
 }
 
-bool SbgDevice::startMagCalibration(void)
+void SbgDevice::updateLogFilter(void)
 {
-  SbgErrorCode              error_code;
-  SbgEComMagCalibMode       mag_calib_mode;
-  SbgEComMagCalibBandwidth  mag_calib_bandwidth;
-
-  mag_calib_mode      = m_config_store_.getMagnetometerCalibMode();
-  mag_calib_bandwidth = m_config_store_.getMagnetometerCalibBandwidth();
-
-  error_code = sbgEComCmdMagStartCalib(&m_com_handle_, mag_calib_mode, mag_calib_bandwidth);
+  //
+  // Publishers are only created for the logs enabled in the output configuration,
+  // so a log is parsed only if it feeds a publisher that currently has subscribers.
+  // The sequence diagnostics need the time stamp of every log, so all of them are parsed.
+  //
+  bool sequence_diagnostics = m_config_store_.getSequenceDiagnostics();
 
-  if (error_code != SBG_NO_ERROR)
+  for (uint32_t msg_id = 0; msg_id < SBG_ECOM_LOG_ECOM_NUM_MESSAGES; msg_id++)
   {
-    RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Unable to start the magnetometer calibration : %s", sbgErrorCodeToString(error_code));
-    return false;
+    sbgEComLogFilterSet(&m_com_handle_, SBG_ECOM_CLASS_LOG_ECOM_0, msg_id, sequence_diagnostics || m_message_publisher_.isLogConsumed(SBG_ECOM_CLASS_LOG_ECOM_0, msg_id) ||
+                        m_shared_state_writer_.isLogExported(SBG_ECOM_CLASS_LOG_ECOM_0, msg_id));
   }
-  else
+
+  for (uint32_t msg_id = 0; msg_id < SBG_ECOM_LOG_ECOM_1_NUM_MESSAGES; msg_id++)
   {
-    RCLCPP_INFO(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Start calibration");
-    RCLCPP_INFO(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Mode : %s", g_mag_calib_mode_[mag_calib_mode].c_str());
-    RCLCPP_INFO(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Bandwidth : %s", g_mag_calib_bandwidth[mag_calib_bandwidth].c_str());
-    return true;
+    sbgEComLogFilterSet(&m_com_handle_, SBG_ECOM_CLASS_LOG_ECOM_1, msg_id, sequence_diagnostics || m_message_publisher_.isLogConsumed(SBG_ECOM_CLASS_LOG_ECOM_1, msg_id));
   }
+
+  //
+  // Subscribers may come and go, refresh the filter about once per second.
+  //
+  m_log_filter_countdown_ = m_rate_frequency_;
 }
 
-bool SbgDevice::endMagCalibration(void)
+void SbgDevice::publishLinkStatus(void)
 {
-  SbgErrorCode error_code;
-
-  error_code = sbgEComCmdMagComputeCalib(&m_com_handle_, &m_magCalibResults);
+  sbg_driver::msg::SbgLinkStatus  link_status_message;
+  SbgEComProtocolStats            link_stats;
+  rclcpp::Time                    now;
+  double                          elapsed_s;
 
-  if (error_code != SBG_NO_ERROR)
+  if (!m_link_status_pub_)
   {
-    RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Unable to compute the magnetometer calibration results : %s", sbgErrorCodeToString(error_code));
-    return false;
+    return;
   }
-  else
+
+  now = m_ref_node_.now();
+  sbgEComProtocolGetStats(&m_com_handle_.protocolHandle, &link_stats);
+
+  //
+  // Counters are cumulative and wrap around, unsigned differences stay valid.
+  //
+  link_status_message.header.stamp       = now;
+  link_status_message.header.frame_id    = m_config_store_.getFrameId();
+  link_status_message.bytes_received     = link_stats.bytesReceived - m_last_link_stats_.bytesReceived;
+  link_status_message.bytes_discarded    = link_stats.bytesDiscarded - m_last_link_stats_.bytesDiscarded;
+  link_status_message.frames_received    = link_stats.framesReceived - m_last_link_stats_.framesReceived;
+  link_status_message.resyncs            = link_stats.resyncs - m_last_link_stats_.resyncs;
+  link_status_message.crc_errors         = link_stats.crcErrors - m_last_link_stats_.crcErrors;
+  link_status_message.invalid_frames     = link_stats.invalidFrames - m_last_link_stats_.invalidFrames;
+  link_status_message.oversize_payloads  = link_stats.oversizePayloads - m_last_link_stats_.oversizePayloads;
+  link_status_message.rx_buffer_full     = link_stats.rxBufferFull - m_last_link_stats_.rxBufferFull;
+
+  elapsed_s = (now - m_last_link_stats_time_).seconds();
+
+  if (elapsed_s > 0.0)
   {
-    displayMagCalibrationStatusResult();
-    exportMagCalibrationResults();
+    link_status_message.rx_rate = static_cast<float>(link_status_message.bytes_received / elapsed_s);
+  }
 
-    return true;
+  //
+  // A serial byte is sent with a start and a stop bit.
+  //
+  if (m_config_store_.isInterfaceSerial() && (m_config_store_.getBaudRate() > 0))
+  {
+    link_status_message.link_usage = link_status_message.rx_rate / (m_config_store_.getBaudRate() / 10.0f);
   }
+
+  m_link_status_pub_->publish(link_status_message);
+
+  m_last_link_stats_      = link_stats;
+  m_last_link_stats_time_ = now;
 }
 
-bool SbgDevice::uploadMagCalibrationToDevice(void)
+void SbgDevice::configure(void)
 {
-  SbgErrorCode error_code;
-
-  if (m_magCalibResults.quality != SBG_ECOM_MAG_CALIB_QUAL_INVALID)
+  if (m_config_store_.checkConfigWithRos())
   {
-    error_code = sbgEComCmdMagSetCalibData(&m_com_handle_, m_magCalibResults.offset, m_magCalibResults.matrix);
-
-    if (error_code != SBG_NO_ERROR)
+    ConfigApplier configApplier(m_com_handle_, *m_command_queue_);
+    bool          cache_enabled;
+    uint64_t      config_hash;
+    uint64_t      settings_hash;
+
+    //
+    // The cache is only trusted for a known device, and if its settings haven't been changed by another tool since.
+    //
+    cache_enabled = !m_config_store_.getConfigurationCacheFile().empty() && (m_device_serial_number_ != 0);
+    config_hash   = m_config_store_.computeDeviceConfigHash();
+
+    if (cache_enabled && configApplier.exportSettingsHash(settings_hash) && isConfigurationCached(config_hash, settings_hash))
     {
-      RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Unable to set the magnetometers calibration data to the device : %s", sbgErrorCodeToString(error_code));
-      return false;
+      RCLCPP_INFO(m_ref_node_.get_logger(), "SBG_DRIVER - [Config] Device already configured, configuration skipped.");
     }
     else
     {
-      RCLCPP_INFO(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Saving data to the device");
-      ConfigApplier configApplier(m_com_handle_);
-      configApplier.saveConfiguration();
-      return true;
+      configApplier.applyConfiguration(m_config_store_);
+
+      if (cache_enabled && configApplier.getAppliedSettingsHash(settings_hash))
+      {
+        storeConfigurationCache(config_hash, settings_hash);
+      }
     }
   }
-  else
-  {
-    RCLCPP_ERROR(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - The calibration was invalid, it can't be uploaded on the device.");
-    return false;
-  }
 }
 
-void SbgDevice::displayMagCalibrationStatusResult(void) const
+bool SbgDevice::isConfigurationCached(uint64_t config_hash, uint64_t settings_hash) const
 {
-  RCLCPP_INFO(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Quality of the calibration %s", g_mag_calib_quality_[m_magCalibResults.quality].c_str());
-  RCLCPP_INFO(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Calibration results confidence %s", g_mag_calib_confidence_[m_magCalibResults.confidence].c_str());
-
-  SbgEComMagCalibMode mag_calib_mode;
+  std::ifstream cache_file(m_config_store_.getConfigurationCacheFile());
+  uint32_t      serial_number;
+  uint32_t      firmware_rev;
+  uint64_t      cached_config_hash;
+  uint64_t      cached_settings_hash;
 
-  mag_calib_mode = m_config_store_.getMagnetometerCalibMode();
-
-  //
-  // Check the magnetometers calibration status and display the warnings.
-  //
-  if (m_magCalibResults.advancedStatus & SBG_ECOM_MAG_CALIB_NOT_ENOUGH_POINTS)
-  {
-    RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Not enough valid points. Maybe you are moving too fast");
-  }
-  if (m_magCalibResults.advancedStatus & SBG_ECOM_MAG_CALIB_TOO_MUCH_DISTORTIONS)
+  if (cache_file >> std::hex >> serial_number >> firmware_rev >> cached_config_hash >> cached_settings_hash)
   {
-    RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Unable to find a calibration solution. Maybe there are too much non static distortions");
-  }
-  if (m_magCalibResults.advancedStatus & SBG_ECOM_MAG_CALIB_ALIGNMENT_ISSUE)
-  {
-    RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - The magnetic calibration has troubles to correct the magnetometers and inertial frame alignment");
-  }
-  if (mag_calib_mode == SBG_ECOM_MAG_CALIB_MODE_2D)
-  {
-    if (m_magCalibResults.advancedStatus & SBG_ECOM_MAG_CALIB_X_MOTION_ISSUE)
-    {
-      RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Too much roll motion for a 2D magnetic calibration");
-    }
-    if (m_magCalibResults.advancedStatus & SBG_ECOM_MAG_CALIB_Y_MOTION_ISSUE)
-    {
-      RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Too much pitch motion for a 2D magnetic calibration");
-    }
-  }
-  else
-  {
-    if (m_magCalibResults.advancedStatus & SBG_ECOM_MAG_CALIB_X_MOTION_ISSUE)
-    {
-      RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Not enough roll motion for a 3D magnetic calibration");
-    }
-    if (m_magCalibResults.advancedStatus & SBG_ECOM_MAG_CALIB_Y_MOTION_ISSUE)
-    {
-      RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Not enough pitch motion for a 3D magnetic calibration.");
-    }
-  }
-  if (m_magCalibResults.advancedStatus & SBG_ECOM_MAG_CALIB_Z_MOTION_ISSUE)
-  {
-    RCLCPP_WARN(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Not enough yaw motion to compute a valid magnetic calibration");
+    return ((serial_number == m_device_serial_number_) && (firmware_rev == m_device_firmware_rev_) &&
+            (cached_config_hash == config_hash) && (cached_settings_hash == settings_hash));
   }
+
+  return false;
 }
 
-void SbgDevice::exportMagCalibrationResults(void) const
+void SbgDevice::storeConfigurationCache(uint64_t config_hash, uint64_t settings_hash) const
 {
-  SbgEComMagCalibMode       mag_calib_mode;
-  SbgEComMagCalibBandwidth  mag_calib_bandwidth;
-  ostringstream             mag_results_stream;
-  string                    output_filename;
-
-  mag_calib_mode      = m_config_store_.getMagnetometerCalibMode();
-  mag_calib_bandwidth = m_config_store_.getMagnetometerCalibBandwidth();
-
-  mag_results_stream << "SBG DRIVER [Mag Calib]" << endl;
-  mag_results_stream << "======= Parameters =======" << endl;
-  mag_results_stream << "* CALIB_MODE = " << g_mag_calib_mode_[mag_calib_mode] << endl;
-  mag_results_stream << "* CALIB_BW = " << g_mag_calib_bandwidth[mag_calib_bandwidth] << endl;
-
-  mag_results_stream << "======= Results =======" << endl;
-  mag_results_stream << g_mag_calib_quality_[m_magCalibResults.quality] << endl;
-  mag_results_stream << g_mag_calib_confidence_[m_magCalibResults.confidence] << endl;
-  mag_results_stream << "======= Infos =======" << endl;
-  mag_results_stream << "* Used points : " << m_magCalibResults.numPoints << "/" << m_magCalibResults.maxNumPoints << endl;
-  mag_results_stream << "* Mean, Std, Max" << endl;
-  mag_results_stream << "[Before]\t" << m_magCalibResults.beforeMeanError << "\t" <<  m_magCalibResults.beforeStdError << "\t" << m_magCalibResults.beforeMaxError << endl;
-  mag_results_stream << "[After]\t" << m_magCalibResults.afterMeanError << "\t" << m_magCalibResults.afterStdError << "\t" << m_magCalibResults.afterMaxError << endl;
-  mag_results_stream << "[Accuracy]\t" << sbgRadToDegF(m_magCalibResults.meanAccuracy) << "\t" << sbgRadToDegF(m_magCalibResults.stdAccuracy) << "\t" << sbgRadToDegF(m_magCalibResults.maxAccuracy) << endl;
-  mag_results_stream << "* Offset\t" << m_magCalibResults.offset[0] << "\t" << m_magCalibResults.offset[1] << "\t" << m_magCalibResults.offset[2] << endl;
-
-  mag_results_stream << "* Matrix" << endl;
-  mag_results_stream << m_magCalibResults.matrix[0] << "\t" << m_magCalibResults.matrix[1] << "\t" << m_magCalibResults.matrix[2] << endl;
-  mag_results_stream << m_magCalibResults.matrix[3] << "\t" << m_magCalibResults.matrix[4] << "\t" << m_magCalibResults.matrix[5] << endl;
-  mag_results_stream << m_magCalibResults.matrix[6] << "\t" << m_magCalibResults.matrix[7] << "\t" << m_magCalibResults.matrix[8] << endl;
-
-  output_filename = "mag_calib_" + timeToStr()/*(nullptrrclcpp::WallTimer::now())*/ + ".txt";
-  ofstream output_file(output_filename);
-  output_file << mag_results_stream.str();
-  output_file.close();
-
-  RCLCPP_INFO(m_ref_node_.get_logger(), "%s", mag_results_stream.str().c_str());
-  RCLCPP_INFO(m_ref_node_.get_logger(), "SBG DRIVER [Mag Calib] - Magnetometers calibration results saved to file %s", output_filename.c_str());
+  std::ofstream cache_file(m_config_store_.getConfigurationCacheFile(), std::ios::trunc);
+
+  cache_file << std::hex << m_device_serial_number_ << " " << m_device_firmware_rev_ << " " << config_hash << " " << settings_hash << std::endl;
+
+  if (!cache_file)
+  {
+    RCLCPP_WARN(m_ref_node_.get_logger(), "SBG_DRIVER - [Config] Unable to write the configuration cache %s", m_config_store_.getConfigurationCacheFile().c_str());
+  }
 }
 
 //---------------------------------------------------------------------//
@@ -476,17 +443,122 @@ void SbgDevice::initDeviceForReceivingData(void)
   {
     rclcpp::exceptions::throw_from_rcl_error(RCL_RET_ERROR, "SBG_DRIVER - [Init] Unable to set the callback function - " + std::string(sbgErrorCodeToString(error_code)));
   }
+
+  if (!m_config_store_.getSharedMemoryName().empty())
+  {
+    RCLCPP_INFO(m_ref_node_.get_logger(), "SBG_DRIVER - Export the latest state to the shared memory %s", m_config_store_.getSharedMemoryName().c_str());
+    m_shared_state_writer_.open(m_config_store_.getSharedMemoryName());
+  }
+
+  if (m_config_store_.isRelayEnabled())
+  {
+    char ip[16];
+    sbgNetworkIpToString(m_config_store_.getRelayAddress(), ip, sizeof(ip));
+    RCLCPP_INFO(m_ref_node_.get_logger(), "SBG_DRIVER - Relay frames to %s:%u", ip, m_config_store_.getRelayPort());
+    m_frame_relay_.open(m_config_store_.getRelayAddress(), m_config_store_.getRelayPort(), m_config_store_.getRelayMaxDatagramSize());
+  }
+
+  if (m_raw_frame_publisher_.isEnabled() || m_frame_relay_.isEnabled())
+  {
+    sbgEComSetReceiveFrameCallback(&m_com_handle_, onFrameReceivedCallback, this);
+  }
+
+  if (!m_raw_frame_publisher_.isEnabled() && m_config_store_.getLazyParsing())
+  {
+    //
+    // The frames dropped before the CRC check would not reach the relay.
+    //
+    if (m_config_store_.getFilterBeforeCrc() && !m_frame_relay_.isEnabled())
+    {
+      sbgEComLogFilterSetMode(&m_com_handle_, SBG_ECOM_LOG_FILTER_BEFORE_CRC);
+    }
+
+    updateLogFilter();
+  }
+
+  m_link_status_pub_      = m_ref_node_.create_publisher<sbg_driver::msg::SbgLinkStatus>("sbg/link_status", 10);
+  m_last_link_stats_time_ = m_ref_node_.now();
+  sbgEComProtocolGetStats(&m_com_handle_.protocolHandle, &m_last_link_stats_);
+
+  if (m_config_store_.getLatencyDiagnostics())
+  {
+    m_latency_monitor_.initPublisher(m_ref_node_);
+    sbgEComSetFrameStageCallback(&m_com_handle_, LatencyMonitor::onFrameStageCallback, &m_latency_monitor_);
+    sbgEComProtocolSetReadCallback(&m_com_handle_.protocolHandle, LatencyMonitor::onBytesReadCallback, &m_latency_monitor_);
+  }
 }
 
 void SbgDevice::initDeviceForMagCalibration(void)
 {
-  m_calib_service_      = m_ref_node_.create_service<std_srvs::srv::Trigger>("sbg/mag_calibration", std::bind(&SbgDevice::processMagCalibration, this, std::placeholders::_1, std::placeholders::_2));
-  m_calib_save_service_ = m_ref_node_.create_service<std_srvs::srv::Trigger>("sbg/mag_calibration_save", std::bind(&SbgDevice::saveMagCalibration, this, std::placeholders::_1, std::placeholders::_2));
+  SbgErrorCode error_code;
+
+  //
+  // The configured outputs are published during the calibration, the calibration commands don't stop the device loop.
+  //
+  initPublishers();
+
+  error_code = sbgEComSetReceiveLogCallback(&m_com_handle_, onLogReceivedCallback, this);
+
+  if (error_code != SBG_NO_ERROR)
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RCL_RET_ERROR, "SBG_DRIVER - [Init] Unable to set the callback function - " + std::string(sbgErrorCodeToString(error_code)));
+  }
+
+  m_mag_calibrator_ = std::make_unique<MagCalibrator>(m_com_handle_, *m_command_queue_);
+  m_mag_calibrator_->initServices(m_ref_node_, m_config_store_);
 
   RCLCPP_INFO(m_ref_node_.get_logger(), "SBG DRIVER [Init] - SBG device is initialized for magnetometers calibration.");
 }
 
 void SbgDevice::periodicHandle(void)
 {
-  sbgEComHandle(&m_com_handle_);
+  if (m_config_store_.getLazyParsing() && !m_raw_frame_publisher_.isEnabled())
+  {
+    if (m_log_filter_countdown_ == 0)
+    {
+      updateLogFilter();
+    }
+    else
+    {
+      m_log_filter_countdown_--;
+    }
+  }
+
+  m_log_consumed_cached_.reset();
+
+  //
+  // Receive the logs and the command answers, then report the completed commands.
+  //
+  m_command_queue_->handle();
+
+  //
+  // Publish the raw frames received during this call in a single message.
+  //
+  m_raw_frame_publisher_.flush();
+
+  //
+  // Send the frames received during this call, so the relay adds at most one period of latency.
+  //
+  m_frame_relay_.flush();
+
+  //
+  // Publish the driver status messages about once per second.
+  //
+  if (m_status_countdown_ == 0)
+  {
+    publishLinkStatus();
+
+    if (m_config_store_.getLatencyDiagnostics())
+    {
+      m_latency_monitor_.publishDiagnostics(m_ref_node_.now());
+    }
+
+    m_message_publisher_.publishSequenceDiagnostics(m_ref_node_.now());
+
+    m_status_countdown_ = m_rate_frequency_;
+  }
+  else
+  {
+    m_status_countdown_--;
+  }
 }
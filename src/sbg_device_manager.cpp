@@ -0,0 +1,127 @@
+// File header
+#include "sbg_device_manager.h"
+
+// Standard headers
+#include <algorithm>
+
+using sbg::SbgDeviceManager;
+using sbg::SbgDevice;
+
+/*!
+ * Class to handle several connected SBG devices.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+SbgDeviceManager::SbgDeviceManager(rclcpp::Node& ref_node_handle):
+m_ref_node_(ref_node_handle)
+{
+  loadParameters();
+  connectDevices();
+}
+
+//---------------------------------------------------------------------//
+//- Private  methods                                                  -//
+//---------------------------------------------------------------------//
+
+void SbgDeviceManager::loadParameters(void)
+{
+  m_ref_node_.get_parameter_or<std::vector<std::string>>("devices", m_device_namespaces_, std::vector<std::string>());
+
+  if (m_device_namespaces_.empty())
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - [Manager] No device defined, set the devices parameter.");
+  }
+}
+
+void SbgDeviceManager::connectDevices(void)
+{
+  for (const std::string &ref_device_namespace : m_device_namespaces_)
+  {
+    ManagedDevice managed_device;
+
+    managed_device.node = std::make_shared<rclcpp::Node>("sbg_device", ref_device_namespace);
+
+    try
+    {
+      RCLCPP_INFO(m_ref_node_.get_logger(), "SBG DRIVER - [Manager] Connect device %s", ref_device_namespace.c_str());
+      managed_device.device.reset(new SbgDevice(*managed_device.node));
+
+      m_executor_.add_node(managed_device.node);
+      m_devices_.push_back(std::move(managed_device));
+    }
+    catch (std::exception const& refE)
+    {
+      RCLCPP_ERROR(m_ref_node_.get_logger(), "SBG DRIVER - [Manager] Device %s skipped - %s", ref_device_namespace.c_str(), refE.what());
+    }
+  }
+
+  if (m_devices_.empty())
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - [Manager] Unable to connect any device.");
+  }
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+uint32_t SbgDeviceManager::getUpdateFrequency(void) const
+{
+  uint32_t update_frequency;
+
+  update_frequency = 0;
+
+  for (const ManagedDevice &ref_managed_device : m_devices_)
+  {
+    update_frequency = std::max(update_frequency, ref_managed_device.device->getUpdateFrequency());
+  }
+
+  return update_frequency;
+}
+
+size_t SbgDeviceManager::getDeviceCount(void) const
+{
+  return m_devices_.size();
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void SbgDeviceManager::initDevicesForReceivingData(void)
+{
+  auto it = m_devices_.begin();
+
+  while (it != m_devices_.end())
+  {
+    try
+    {
+      it->device->initDeviceForReceivingData();
+      ++it;
+    }
+    catch (std::exception const& refE)
+    {
+      RCLCPP_ERROR(m_ref_node_.get_logger(), "SBG DRIVER - [Manager] Device %s removed - %s", it->node->get_namespace(), refE.what());
+
+      m_executor_.remove_node(it->node);
+      it = m_devices_.erase(it);
+    }
+  }
+
+  if (m_devices_.empty())
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - [Manager] Unable to initialize any device.");
+  }
+}
+
+void SbgDeviceManager::periodicHandle(void)
+{
+  for (ManagedDevice &ref_managed_device : m_devices_)
+  {
+    ref_managed_device.device->periodicHandle();
+  }
+
+  m_executor_.spin_some();
+}
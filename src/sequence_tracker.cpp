@@ -0,0 +1,475 @@
+// File header
+#include "sequence_tracker.h"
+
+// Standard headers
+#include <algorithm>
+
+using sbg::SequenceTracker;
+
+/*!
+ * Backward jump of the time stamps above which the device is considered to have restarted (us).
+ */
+#define SBG_SEQUENCE_RESET_THRESHOLD  (1000000)
+
+/*!
+ * Class to track the device time stamps of each log and report the discontinuities.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+SequenceTracker::SequenceTracker(void):
+m_logs_(),
+m_enabled_(false),
+m_learn_new_data_(false)
+{
+  //
+  // Event logs are never periodic, even if their output mode isn't known.
+  //
+  for (size_t i = 0; i < 256; i++)
+  {
+    if (isEventLog(SBG_ECOM_CLASS_LOG_ECOM_0, static_cast<SbgEComMsgId>(i)))
+    {
+      m_logs_[i].configured = true;
+      m_logs_[i].periodic   = false;
+    }
+  }
+}
+
+//---------------------------------------------------------------------//
+//- Private methods                                                   -//
+//---------------------------------------------------------------------//
+
+SequenceTracker::LogSequence *SequenceTracker::getLogSequence(SbgEComClass msg_class, SbgEComMsgId msg)
+{
+  if (msg_class == SBG_ECOM_CLASS_LOG_ECOM_0)
+  {
+    return &m_logs_[msg];
+  }
+  else if (msg_class == SBG_ECOM_CLASS_LOG_ECOM_1)
+  {
+    return &m_logs_[256 + msg];
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+
+bool SequenceTracker::getTimeStamp(SbgEComClass msg_class, SbgEComMsgId msg, const SbgBinaryLogData &ref_sbg_log, uint32_t &ref_time_stamp)
+{
+  if (msg_class == SBG_ECOM_CLASS_LOG_ECOM_1)
+  {
+    if (msg == SBG_ECOM_LOG_FAST_IMU_DATA)
+    {
+      ref_time_stamp = ref_sbg_log.fastImuData.timeStamp;
+      return true;
+    }
+
+    return false;
+  }
+
+  switch (msg)
+  {
+  case SBG_ECOM_LOG_STATUS:
+    ref_time_stamp = ref_sbg_log.statusData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_UTC_TIME:
+    ref_time_stamp = ref_sbg_log.utcData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_IMU_DATA:
+    ref_time_stamp = ref_sbg_log.imuData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_IMU_SHORT:
+    ref_time_stamp = ref_sbg_log.imuShort.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_IMU_RAW_DATA:
+    ref_time_stamp = ref_sbg_log.imuRawData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_MAG:
+    ref_time_stamp = ref_sbg_log.magData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_MAG_CALIB:
+    ref_time_stamp = ref_sbg_log.magCalibData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_EKF_EULER:
+    ref_time_stamp = ref_sbg_log.ekfEulerData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_EKF_QUAT:
+    ref_time_stamp = ref_sbg_log.ekfQuatData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_EKF_NAV:
+    ref_time_stamp = ref_sbg_log.ekfNavData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_SHIP_MOTION:
+  case SBG_ECOM_LOG_SHIP_MOTION_HP:
+    ref_time_stamp = ref_sbg_log.shipMotionData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_ODO_VEL:
+    ref_time_stamp = ref_sbg_log.odometerData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_GPS1_VEL:
+  case SBG_ECOM_LOG_GPS2_VEL:
+    ref_time_stamp = ref_sbg_log.gpsVelData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_GPS1_POS:
+  case SBG_ECOM_LOG_GPS2_POS:
+    ref_time_stamp = ref_sbg_log.gpsPosData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_GPS1_HDT:
+  case SBG_ECOM_LOG_GPS2_HDT:
+    ref_time_stamp = ref_sbg_log.gpsHdtData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_DVL_BOTTOM_TRACK:
+  case SBG_ECOM_LOG_DVL_WATER_TRACK:
+    ref_time_stamp = ref_sbg_log.dvlData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_AIR_DATA:
+    ref_time_stamp = ref_sbg_log.airData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_USBL:
+    ref_time_stamp = ref_sbg_log.usblData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_DEPTH:
+    ref_time_stamp = ref_sbg_log.depthData.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_EVENT_A:
+  case SBG_ECOM_LOG_EVENT_B:
+  case SBG_ECOM_LOG_EVENT_C:
+  case SBG_ECOM_LOG_EVENT_D:
+  case SBG_ECOM_LOG_EVENT_E:
+  case SBG_ECOM_LOG_EVENT_OUT_A:
+  case SBG_ECOM_LOG_EVENT_OUT_B:
+    ref_time_stamp = ref_sbg_log.eventMarker.timeStamp;
+    return true;
+
+  case SBG_ECOM_LOG_DIAG:
+    ref_time_stamp = ref_sbg_log.diagData.timestamp;
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+bool SequenceTracker::isEventLog(SbgEComClass msg_class, SbgEComMsgId msg)
+{
+  if (msg_class != SBG_ECOM_CLASS_LOG_ECOM_0)
+  {
+    return false;
+  }
+
+  switch (msg)
+  {
+  case SBG_ECOM_LOG_EVENT_A:
+  case SBG_ECOM_LOG_EVENT_B:
+  case SBG_ECOM_LOG_EVENT_C:
+  case SBG_ECOM_LOG_EVENT_D:
+  case SBG_ECOM_LOG_EVENT_E:
+  case SBG_ECOM_LOG_EVENT_OUT_A:
+  case SBG_ECOM_LOG_EVENT_OUT_B:
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+uint32_t SequenceTracker::getNominalPeriod(SbgEComOutputMode output_mode)
+{
+  //
+  // Divided outputs are based on the 200 Hz main loop.
+  //
+  if ((output_mode >= SBG_ECOM_OUTPUT_MODE_MAIN_LOOP) && (output_mode <= SBG_ECOM_OUTPUT_MODE_DIV_200))
+  {
+    return static_cast<uint32_t>(output_mode) * 5000;
+  }
+  else if (output_mode == SBG_ECOM_OUTPUT_MODE_HIGH_FREQ_LOOP)
+  {
+    return 1000;
+  }
+  else if (output_mode == SBG_ECOM_OUTPUT_MODE_PPS)
+  {
+    return 1000000;
+  }
+  else
+  {
+    return 0;
+  }
+}
+
+uint32_t SequenceTracker::getExpectedPeriod(const LogSequence &ref_sequence)
+{
+  //
+  // Logs without a configured output mode are expected to be periodic and their period is learned.
+  //
+  if (ref_sequence.configured && !ref_sequence.periodic)
+  {
+    return 0;
+  }
+  else if (ref_sequence.nominal_period != 0)
+  {
+    return ref_sequence.nominal_period;
+  }
+  else
+  {
+    return ref_sequence.learned_period;
+  }
+}
+
+void SequenceTracker::learnPeriod(LogSequence &ref_sequence, uint32_t interval)
+{
+  if ((ref_sequence.learned_period == 0) || (interval < ref_sequence.learned_period / 2))
+  {
+    //
+    // First interval, or the log is now output at a higher rate.
+    //
+    ref_sequence.learned_period = interval;
+  }
+  else if (interval <= ref_sequence.learned_period + ref_sequence.learned_period / 2)
+  {
+    //
+    // Smooth the jitter out, intervals spanning missing samples are ignored.
+    //
+    int64_t error = static_cast<int64_t>(interval) - static_cast<int64_t>(ref_sequence.learned_period);
+
+    ref_sequence.learned_period = static_cast<uint32_t>(ref_sequence.learned_period + error / 8);
+  }
+}
+
+void SequenceTracker::publishGap(SbgEComClass msg_class, SbgEComMsgId msg, uint8_t type, const LogSequence &ref_sequence, uint32_t time_stamp, uint32_t missing_samples)
+{
+  sbg_driver::msg::SbgLogGap log_gap_message;
+
+  if (m_log_gap_pub_)
+  {
+    log_gap_message.header.stamp        = m_clock_->now();
+    log_gap_message.header.frame_id     = m_frame_id_;
+    log_gap_message.log_class           = msg_class;
+    log_gap_message.log_id              = msg;
+    log_gap_message.type                = type;
+    log_gap_message.previous_time_stamp = ref_sequence.last_time_stamp;
+    log_gap_message.time_stamp          = time_stamp;
+    log_gap_message.expected_period     = getExpectedPeriod(ref_sequence);
+    log_gap_message.missing_samples     = missing_samples;
+
+    m_log_gap_pub_->publish(log_gap_message);
+  }
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+bool SequenceTracker::isEnabled(void) const
+{
+  return m_enabled_;
+}
+
+void SequenceTracker::setOutputMode(SbgEComClass msg_class, SbgEComMsgId msg, SbgEComOutputMode output_mode)
+{
+  LogSequence *p_sequence = getLogSequence(msg_class, msg);
+
+  if (p_sequence)
+  {
+    p_sequence->configured      = true;
+    p_sequence->nominal_period  = getNominalPeriod(output_mode);
+
+    //
+    // Event markers and logs triggered by input events have no expected rate, only their ordering is checked.
+    // Logs output on new data follow their source, such as a GNSS receiver, and are only periodic on request.
+    //
+    if (isEventLog(msg_class, msg) || ((output_mode >= SBG_ECOM_OUTPUT_MODE_EVENT_IN_A) && (output_mode <= SBG_ECOM_OUTPUT_MODE_EVENT_IN_E)))
+    {
+      p_sequence->periodic = false;
+    }
+    else if (output_mode == SBG_ECOM_OUTPUT_MODE_NEW_DATA)
+    {
+      p_sequence->periodic = m_learn_new_data_;
+    }
+    else
+    {
+      p_sequence->periodic = true;
+    }
+  }
+}
+
+void SequenceTracker::setLearnNewData(bool learn_new_data)
+{
+  m_learn_new_data_ = learn_new_data;
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void SequenceTracker::initPublishers(rclcpp::Node &ref_ros_node_handle, const std::string &ref_frame_id)
+{
+  m_enabled_          = true;
+  m_frame_id_         = ref_frame_id;
+  m_clock_            = ref_ros_node_handle.get_clock();
+  m_log_gap_pub_      = ref_ros_node_handle.create_publisher<sbg_driver::msg::SbgLogGap>("sbg/log_gaps", 10);
+  m_diagnostics_pub_  = ref_ros_node_handle.create_publisher<diagnostic_msgs::msg::DiagnosticArray>("diagnostics", 10);
+}
+
+void SequenceTracker::update(SbgEComClass msg_class, SbgEComMsgId msg, const SbgBinaryLogData &ref_sbg_log)
+{
+  LogSequence *p_sequence;
+  uint32_t    time_stamp;
+
+  p_sequence = getLogSequence(msg_class, msg);
+
+  if (!p_sequence || !getTimeStamp(msg_class, msg, ref_sbg_log, time_stamp))
+  {
+    return;
+  }
+
+  p_sequence->received++;
+
+  if (p_sequence->time_stamp_valid)
+  {
+    //
+    // The difference is computed on 32 bits to handle the time stamp wrap around.
+    //
+    int32_t delta = static_cast<int32_t>(time_stamp - p_sequence->last_time_stamp);
+
+    if (delta == 0)
+    {
+      p_sequence->duplicates++;
+      publishGap(msg_class, msg, sbg_driver::msg::SbgLogGap::GAP_DUPLICATE, *p_sequence, time_stamp, 0);
+      return;
+    }
+    else if ((delta < 0) && (delta >= -SBG_SEQUENCE_RESET_THRESHOLD))
+    {
+      //
+      // Keep the newest time stamp as reference so the next logs are not reported as out of order.
+      //
+      p_sequence->out_of_order++;
+      publishGap(msg_class, msg, sbg_driver::msg::SbgLogGap::GAP_OUT_OF_ORDER, *p_sequence, time_stamp, 0);
+      return;
+    }
+    else if (delta > 0)
+    {
+      uint32_t interval         = static_cast<uint32_t>(delta);
+      uint32_t expected_period  = getExpectedPeriod(*p_sequence);
+
+      p_sequence->max_interval = std::max(p_sequence->max_interval, interval);
+
+      if (expected_period != 0)
+      {
+        uint32_t missing_samples = (interval + expected_period / 2) / expected_period;
+
+        if (missing_samples > 1)
+        {
+          missing_samples--;
+
+          p_sequence->gaps++;
+          p_sequence->missing += missing_samples;
+          publishGap(msg_class, msg, sbg_driver::msg::SbgLogGap::GAP_MISSING, *p_sequence, time_stamp, missing_samples);
+        }
+      }
+
+      learnPeriod(*p_sequence, interval);
+    }
+  }
+
+  p_sequence->time_stamp_valid  = true;
+  p_sequence->last_time_stamp   = time_stamp;
+}
+
+void SequenceTracker::publishDiagnostics(const rclcpp::Time &ref_stamp)
+{
+  diagnostic_msgs::msg::DiagnosticArray diagnostics;
+
+  diagnostics.header.stamp = ref_stamp;
+
+  for (size_t i = 0; i < m_logs_.size(); i++)
+  {
+    LogSequence &ref_sequence = m_logs_[i];
+
+    if (ref_sequence.time_stamp_valid)
+    {
+      diagnostic_msgs::msg::DiagnosticStatus  status;
+      diagnostic_msgs::msg::KeyValue          key_value;
+
+      status.name         = "sbg_driver: log sequence class " + std::to_string(i / 256) + " id " + std::to_string(i % 256);
+      status.hardware_id  = "sbg_device";
+
+      if ((ref_sequence.gaps != 0) || (ref_sequence.duplicates != 0) || (ref_sequence.out_of_order != 0))
+      {
+        status.level    = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+        status.message  = "Discontinuities in the device time stamps";
+      }
+      else
+      {
+        status.level    = diagnostic_msgs::msg::DiagnosticStatus::OK;
+        status.message  = "Device time stamps are continuous";
+      }
+
+      key_value.key   = "received";
+      key_value.value = std::to_string(ref_sequence.received);
+      status.values.push_back(key_value);
+
+      key_value.key   = "expected_period_us";
+      key_value.value = std::to_string(getExpectedPeriod(ref_sequence));
+      status.values.push_back(key_value);
+
+      key_value.key   = "learned_period_us";
+      key_value.value = std::to_string(ref_sequence.learned_period);
+      status.values.push_back(key_value);
+
+      key_value.key   = "gaps";
+      key_value.value = std::to_string(ref_sequence.gaps);
+      status.values.push_back(key_value);
+
+      key_value.key   = "missing";
+      key_value.value = std::to_string(ref_sequence.missing);
+      status.values.push_back(key_value);
+
+      key_value.key   = "duplicates";
+      key_value.value = std::to_string(ref_sequence.duplicates);
+      status.values.push_back(key_value);
+
+      key_value.key   = "out_of_order";
+      key_value.value = std::to_string(ref_sequence.out_of_order);
+      status.values.push_back(key_value);
+
+      key_value.key   = "max_interval_us";
+      key_value.value = std::to_string(ref_sequence.max_interval);
+      status.values.push_back(key_value);
+
+      ref_sequence.received     = 0;
+      ref_sequence.gaps         = 0;
+      ref_sequence.missing      = 0;
+      ref_sequence.duplicates   = 0;
+      ref_sequence.out_of_order = 0;
+      ref_sequence.max_interval = 0;
+
+      diagnostics.status.push_back(status);
+    }
+  }
+
+  if (m_diagnostics_pub_)
+  {
+    m_diagnostics_pub_->publish(diagnostics);
+  }
+}
@@ -0,0 +1,210 @@
+// File header
+#include "shared_state_writer.h"
+
+// Standard headers
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+
+using sbg::SharedStateWriter;
+
+/*!
+ * Class to write the latest device state in a shared memory segment.
+ */
+//---------------------------------------------------------------------//
+//- Constructor                                                       -//
+//---------------------------------------------------------------------//
+
+SharedStateWriter::SharedStateWriter(void):
+m_p_state_(nullptr)
+{
+}
+
+SharedStateWriter::~SharedStateWriter(void)
+{
+  if (m_p_state_)
+  {
+    munmap(m_p_state_, sizeof(SharedState));
+  }
+}
+
+//---------------------------------------------------------------------//
+//- Private methods                                                   -//
+//---------------------------------------------------------------------//
+
+uint64_t SharedStateWriter::getHostStamp(void)
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//---------------------------------------------------------------------//
+//- Parameters                                                        -//
+//---------------------------------------------------------------------//
+
+bool SharedStateWriter::isEnabled(void) const
+{
+  return m_p_state_ != nullptr;
+}
+
+bool SharedStateWriter::isLogExported(SbgEComClass msg_class, SbgEComMsgId msg) const
+{
+  if (!m_p_state_ || (msg_class != SBG_ECOM_CLASS_LOG_ECOM_0))
+  {
+    return false;
+  }
+
+  return ((msg == SBG_ECOM_LOG_IMU_DATA) || (msg == SBG_ECOM_LOG_EKF_QUAT) || (msg == SBG_ECOM_LOG_EKF_EULER) ||
+          (msg == SBG_ECOM_LOG_EKF_NAV) || (msg == SBG_ECOM_LOG_STATUS));
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void SharedStateWriter::open(const std::string &ref_name)
+{
+  void  *p_segment;
+  int   segment_fd;
+
+  segment_fd = shm_open(ref_name.c_str(), O_CREAT | O_RDWR, SBG_SHARED_STATE_WRITER_MODE);
+
+  if (segment_fd < 0)
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - [SharedState] Unable to open the shared memory " + ref_name + " - " + std::strerror(errno));
+  }
+
+  //
+  // The mode is only applied on creation and masked by the umask, a segment from a previous run keeps its own.
+  //
+  if (fchmod(segment_fd, SBG_SHARED_STATE_WRITER_MODE) != 0)
+  {
+    ::close(segment_fd);
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - [SharedState] Unable to set the mode of the shared memory " + ref_name + " - " + std::strerror(errno));
+  }
+
+  if (ftruncate(segment_fd, sizeof(SharedState)) != 0)
+  {
+    ::close(segment_fd);
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - [SharedState] Unable to size the shared memory " + ref_name + " - " + std::strerror(errno));
+  }
+
+  p_segment = mmap(nullptr, sizeof(SharedState), PROT_READ | PROT_WRITE, MAP_SHARED, segment_fd, 0);
+  ::close(segment_fd);
+
+  if (p_segment == MAP_FAILED)
+  {
+    rclcpp::exceptions::throw_from_rcl_error(RMW_RET_ERROR, "SBG DRIVER - [SharedState] Unable to map the shared memory " + ref_name + " - " + std::strerror(errno));
+  }
+
+  m_p_state_ = static_cast<SharedState*>(p_segment);
+
+  //
+  // The segment may come from a previous run, the readers only accept it again once all the records are reset.
+  //
+  m_p_state_->magic.store(0, std::memory_order_release);
+
+  m_p_state_->version = SBG_SHARED_STATE_VERSION;
+  m_p_state_->size    = sizeof(SharedState);
+
+  m_p_state_->imu.reset();
+  m_p_state_->ekf_quat.reset();
+  m_p_state_->ekf_euler.reset();
+  m_p_state_->ekf_nav.reset();
+  m_p_state_->status.reset();
+
+  m_p_state_->magic.store(SBG_SHARED_STATE_MAGIC, std::memory_order_release);
+}
+
+void SharedStateWriter::write(SbgEComClass msg_class, SbgEComMsgId msg, const SbgBinaryLogData &ref_sbg_data)
+{
+  if (!m_p_state_ || (msg_class != SBG_ECOM_CLASS_LOG_ECOM_0))
+  {
+    return;
+  }
+
+  switch (msg)
+  {
+    case SBG_ECOM_LOG_IMU_DATA:
+    {
+      SharedImuRecord record;
+
+      record.host_stamp   = getHostStamp();
+      record.time_stamp   = ref_sbg_data.imuData.timeStamp;
+      record.status       = ref_sbg_data.imuData.status;
+      record.temperature  = ref_sbg_data.imuData.temperature;
+      memcpy(record.accel, ref_sbg_data.imuData.accelerometers, sizeof(record.accel));
+      memcpy(record.gyro, ref_sbg_data.imuData.gyroscopes, sizeof(record.gyro));
+      memcpy(record.delta_velocity, ref_sbg_data.imuData.deltaVelocity, sizeof(record.delta_velocity));
+      memcpy(record.delta_angle, ref_sbg_data.imuData.deltaAngle, sizeof(record.delta_angle));
+
+      m_p_state_->imu.write(record);
+      break;
+    }
+
+    case SBG_ECOM_LOG_EKF_QUAT:
+    {
+      SharedEkfQuatRecord record;
+
+      record.host_stamp = getHostStamp();
+      record.time_stamp = ref_sbg_data.ekfQuatData.timeStamp;
+      record.status     = ref_sbg_data.ekfQuatData.status;
+      memcpy(record.quaternion, ref_sbg_data.ekfQuatData.quaternion, sizeof(record.quaternion));
+      memcpy(record.euler_std_dev, ref_sbg_data.ekfQuatData.eulerStdDev, sizeof(record.euler_std_dev));
+
+      m_p_state_->ekf_quat.write(record);
+      break;
+    }
+
+    case SBG_ECOM_LOG_EKF_EULER:
+    {
+      SharedEkfEulerRecord record;
+
+      record.host_stamp = getHostStamp();
+      record.time_stamp = ref_sbg_data.ekfEulerData.timeStamp;
+      record.status     = ref_sbg_data.ekfEulerData.status;
+      memcpy(record.euler, ref_sbg_data.ekfEulerData.euler, sizeof(record.euler));
+      memcpy(record.euler_std_dev, ref_sbg_data.ekfEulerData.eulerStdDev, sizeof(record.euler_std_dev));
+
+      m_p_state_->ekf_euler.write(record);
+      break;
+    }
+
+    case SBG_ECOM_LOG_EKF_NAV:
+    {
+      SharedEkfNavRecord record;
+
+      record.host_stamp = getHostStamp();
+      record.time_stamp = ref_sbg_data.ekfNavData.timeStamp;
+      record.status     = ref_sbg_data.ekfNavData.status;
+      record.undulation = ref_sbg_data.ekfNavData.undulation;
+      memcpy(record.position, ref_sbg_data.ekfNavData.position, sizeof(record.position));
+      memcpy(record.position_std_dev, ref_sbg_data.ekfNavData.positionStdDev, sizeof(record.position_std_dev));
+      memcpy(record.velocity, ref_sbg_data.ekfNavData.velocity, sizeof(record.velocity));
+      memcpy(record.velocity_std_dev, ref_sbg_data.ekfNavData.velocityStdDev, sizeof(record.velocity_std_dev));
+
+      m_p_state_->ekf_nav.write(record);
+      break;
+    }
+
+    case SBG_ECOM_LOG_STATUS:
+    {
+      SharedStatusRecord record;
+
+      record.host_stamp     = getHostStamp();
+      record.time_stamp     = ref_sbg_data.statusData.timeStamp;
+      record.general_status = ref_sbg_data.statusData.generalStatus;
+      record.com_status     = ref_sbg_data.statusData.comStatus;
+      record.aiding_status  = ref_sbg_data.statusData.aidingStatus;
+      record.up_time        = ref_sbg_data.statusData.uptime;
+
+      m_p_state_->status.write(record);
+      break;
+    }
+
+    default:
+      break;
+  }
+}
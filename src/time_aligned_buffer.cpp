@@ -0,0 +1,150 @@
+// File header
+#include "time_aligned_buffer.h"
+
+// Standard headers
+#include <cmath>
+
+// SbgECom headers
+#include <sbgCommon.h>
+
+/*!
+ * Interpolation of the logs stored in the time aligned buffers.
+ */
+//---------------------------------------------------------------------//
+//- Private functions                                                 -//
+//---------------------------------------------------------------------//
+
+namespace
+{
+/*!
+ * Linear interpolation of a vector.
+ *
+ * \param[in] ref_before        Vector before the interpolated time stamp.
+ * \param[in] ref_after         Vector after the interpolated time stamp.
+ * \param[in] ratio             Interpolation ratio, from 0 (before) to 1 (after).
+ * \return                      Interpolated vector.
+ */
+geometry_msgs::msg::Vector3 interpolateVector(const geometry_msgs::msg::Vector3 &ref_before, const geometry_msgs::msg::Vector3 &ref_after, double ratio)
+{
+  geometry_msgs::msg::Vector3 vector;
+
+  vector.x = ref_before.x + (ref_after.x - ref_before.x) * ratio;
+  vector.y = ref_before.y + (ref_after.y - ref_before.y) * ratio;
+  vector.z = ref_before.z + (ref_after.z - ref_before.z) * ratio;
+
+  return vector;
+}
+
+/*!
+ * Interpolation of an angle along the shortest direction.
+ *
+ * \param[in] before            Angle before the interpolated time stamp (rad).
+ * \param[in] after             Angle after the interpolated time stamp (rad).
+ * \param[in] ratio             Interpolation ratio, from 0 (before) to 1 (after).
+ * \return                      Interpolated angle (rad), in the same range as the before angle.
+ */
+double interpolateAngle(double before, double after, double ratio)
+{
+  return before + std::remainder(after - before, 2.0 * SBG_PI) * ratio;
+}
+
+/*!
+ * Copy the fields that can't be interpolated from the nearest log.
+ *
+ * \template  T                 Log message type.
+ * \param[in] ref_before        Log before the interpolated time stamp.
+ * \param[in] ref_after         Log after the interpolated time stamp.
+ * \param[in] ratio             Interpolation ratio, from 0 (before) to 1 (after).
+ * \return                      Nearest log.
+ */
+template <typename T>
+const T &getNearest(const T &ref_before, const T &ref_after, double ratio)
+{
+  return (ratio < 0.5) ? ref_before : ref_after;
+}
+}
+
+//---------------------------------------------------------------------//
+//- Operations                                                        -//
+//---------------------------------------------------------------------//
+
+void sbg::interpolate(const sbg_driver::msg::SbgEkfQuat &ref_before, const sbg_driver::msg::SbgEkfQuat &ref_after, double ratio, sbg_driver::msg::SbgEkfQuat &ref_sample)
+{
+  const geometry_msgs::msg::Quaternion  &ref_q0 = ref_before.quaternion;
+  geometry_msgs::msg::Quaternion        q1      = ref_after.quaternion;
+  double                                weight0;
+  double                                weight1;
+  double                                dot;
+  double                                norm;
+
+  ref_sample = getNearest(ref_before, ref_after, ratio);
+
+  //
+  // q and -q are the same rotation, take the shortest path.
+  //
+  dot = ref_q0.w * q1.w + ref_q0.x * q1.x + ref_q0.y * q1.y + ref_q0.z * q1.z;
+
+  if (dot < 0.0)
+  {
+    q1.w  = -q1.w;
+    q1.x  = -q1.x;
+    q1.y  = -q1.y;
+    q1.z  = -q1.z;
+    dot   = -dot;
+  }
+
+  //
+  // Close rotations are interpolated linearly to avoid a division by a vanishing sine.
+  //
+  if (dot > 0.9995)
+  {
+    weight0 = 1.0 - ratio;
+    weight1 = ratio;
+  }
+  else
+  {
+    double theta      = std::acos(dot);
+    double sin_theta  = std::sin(theta);
+
+    weight0 = std::sin((1.0 - ratio) * theta) / sin_theta;
+    weight1 = std::sin(ratio * theta) / sin_theta;
+  }
+
+  ref_sample.quaternion.w = weight0 * ref_q0.w + weight1 * q1.w;
+  ref_sample.quaternion.x = weight0 * ref_q0.x + weight1 * q1.x;
+  ref_sample.quaternion.y = weight0 * ref_q0.y + weight1 * q1.y;
+  ref_sample.quaternion.z = weight0 * ref_q0.z + weight1 * q1.z;
+
+  norm = std::sqrt(ref_sample.quaternion.w * ref_sample.quaternion.w + ref_sample.quaternion.x * ref_sample.quaternion.x
+                 + ref_sample.quaternion.y * ref_sample.quaternion.y + ref_sample.quaternion.z * ref_sample.quaternion.z);
+
+  ref_sample.quaternion.w /= norm;
+  ref_sample.quaternion.x /= norm;
+  ref_sample.quaternion.y /= norm;
+  ref_sample.quaternion.z /= norm;
+
+  ref_sample.accuracy = interpolateVector(ref_before.accuracy, ref_after.accuracy, ratio);
+}
+
+void sbg::interpolate(const sbg_driver::msg::SbgEkfEuler &ref_before, const sbg_driver::msg::SbgEkfEuler &ref_after, double ratio, sbg_driver::msg::SbgEkfEuler &ref_sample)
+{
+  ref_sample = getNearest(ref_before, ref_after, ratio);
+
+  ref_sample.angle.x  = interpolateAngle(ref_before.angle.x, ref_after.angle.x, ratio);
+  ref_sample.angle.y  = interpolateAngle(ref_before.angle.y, ref_after.angle.y, ratio);
+  ref_sample.angle.z  = interpolateAngle(ref_before.angle.z, ref_after.angle.z, ratio);
+  ref_sample.accuracy = interpolateVector(ref_before.accuracy, ref_after.accuracy, ratio);
+}
+
+void sbg::interpolate(const sbg_driver::msg::SbgEkfNav &ref_before, const sbg_driver::msg::SbgEkfNav &ref_after, double ratio, sbg_driver::msg::SbgEkfNav &ref_sample)
+{
+  ref_sample = getNearest(ref_before, ref_after, ratio);
+
+  ref_sample.velocity            = interpolateVector(ref_before.velocity, ref_after.velocity, ratio);
+  ref_sample.velocity_accuracy   = interpolateVector(ref_before.velocity_accuracy, ref_after.velocity_accuracy, ratio);
+  ref_sample.latitude            = ref_before.latitude + (ref_after.latitude - ref_before.latitude) * ratio;
+  ref_sample.longitude           = interpolateAngle(ref_before.longitude * SBG_PI / 180.0, ref_after.longitude * SBG_PI / 180.0, ratio) * 180.0 / SBG_PI;
+  ref_sample.altitude            = ref_before.altitude + (ref_after.altitude - ref_before.altitude) * ratio;
+  ref_sample.undulation          = ref_before.undulation + (ref_after.undulation - ref_before.undulation) * static_cast<float>(ratio);
+  ref_sample.position_accuracy   = interpolateVector(ref_before.position_accuracy, ref_after.position_accuracy, ratio);
+}
@@ -0,0 +1,247 @@
+// Standard headers
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+// Gtest headers
+#include <gtest/gtest.h>
+
+// Project headers
+#include <async_command_queue.h>
+
+using sbg::AsyncAnswerType;
+using sbg::AsyncCommandQueue;
+
+namespace
+{
+/*!
+ * In memory device, the frames it sends are read by the driver handle.
+ */
+class FakeDevice
+{
+private:
+
+  std::deque<uint8_t>   m_to_driver_;
+  SbgInterface          m_driver_interface_;
+  SbgInterface          m_device_interface_;
+  SbgEComProtocol       m_device_protocol_;
+
+  static SbgErrorCode onDriverWrite(SbgInterface *p_interface, const void *p_buffer, size_t bytes_to_write)
+  {
+    SBG_UNUSED_PARAMETER(p_interface);
+    SBG_UNUSED_PARAMETER(p_buffer);
+    SBG_UNUSED_PARAMETER(bytes_to_write);
+
+    return SBG_NO_ERROR;
+  }
+
+  static SbgErrorCode onDriverRead(SbgInterface *p_interface, void *p_buffer, size_t *p_read_bytes, size_t bytes_to_read)
+  {
+    std::deque<uint8_t> *p_bytes;
+
+    p_bytes       = static_cast<std::deque<uint8_t>*>(p_interface->handle);
+    *p_read_bytes = std::min(bytes_to_read, p_bytes->size());
+
+    std::copy_n(p_bytes->begin(), *p_read_bytes, static_cast<uint8_t*>(p_buffer));
+    p_bytes->erase(p_bytes->begin(), p_bytes->begin() + *p_read_bytes);
+
+    return SBG_NO_ERROR;
+  }
+
+  static SbgErrorCode onDeviceWrite(SbgInterface *p_interface, const void *p_buffer, size_t bytes_to_write)
+  {
+    std::deque<uint8_t> *p_bytes;
+    const uint8_t       *p_data;
+
+    p_bytes = static_cast<std::deque<uint8_t>*>(p_interface->handle);
+    p_data  = static_cast<const uint8_t*>(p_buffer);
+
+    p_bytes->insert(p_bytes->end(), p_data, p_data + bytes_to_write);
+
+    return SBG_NO_ERROR;
+  }
+
+public:
+
+  SbgEComHandle         m_com_handle;
+
+  FakeDevice(void)
+  {
+    sbgInterfaceZeroInit(&m_driver_interface_);
+    m_driver_interface_.handle      = &m_to_driver_;
+    m_driver_interface_.pWriteFunc  = onDriverWrite;
+    m_driver_interface_.pReadFunc   = onDriverRead;
+
+    sbgInterfaceZeroInit(&m_device_interface_);
+    m_device_interface_.handle      = &m_to_driver_;
+    m_device_interface_.pWriteFunc  = onDeviceWrite;
+
+    sbgEComProtocolInit(&m_device_protocol_, &m_device_interface_);
+    sbgEComInit(&m_com_handle, &m_driver_interface_);
+  }
+
+  /*!
+   * Send the answer to an output configuration get.
+   */
+  void sendOutputConf(uint8_t port, uint8_t msg, uint8_t msg_class, uint16_t mode)
+  {
+    uint8_t payload[5] = { port, msg, msg_class, static_cast<uint8_t>(mode), static_cast<uint8_t>(mode >> 8) };
+
+    sbgEComProtocolSend(&m_device_protocol_, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_OUTPUT_CONF, payload, sizeof(payload));
+  }
+
+  /*!
+   * Send an ACK frame for an output configuration command.
+   */
+  void sendOutputConfAck(SbgErrorCode error_code)
+  {
+    uint8_t payload[4] = { SBG_ECOM_CMD_OUTPUT_CONF, SBG_ECOM_CLASS_LOG_CMD_0, static_cast<uint8_t>(error_code), static_cast<uint8_t>(error_code >> 8) };
+
+    sbgEComProtocolSend(&m_device_protocol_, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ACK, payload, sizeof(payload));
+  }
+};
+
+/*!
+ * Completion of a command, as seen by its callback.
+ */
+struct Answer
+{
+  bool                  completed     = false;
+  SbgErrorCode          error_code    = SBG_NO_ERROR;
+  std::vector<uint8_t>  payload;
+};
+
+void onAnswer(SbgErrorCode error_code, const uint8_t *p_payload, size_t payload_size, void *p_user_arg)
+{
+  Answer *p_answer;
+
+  p_answer = static_cast<Answer*>(p_user_arg);
+
+  p_answer->completed   = true;
+  p_answer->error_code  = error_code;
+  p_answer->payload.assign(p_payload, p_payload + payload_size);
+}
+
+SbgErrorCode sendOutputGet(AsyncCommandQueue &ref_queue, uint8_t msg, uint8_t msg_class, uint32_t time_out, Answer &ref_answer)
+{
+  uint8_t payload[3] = { SBG_ECOM_OUTPUT_PORT_A, msg, msg_class };
+
+  return ref_queue.send(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_OUTPUT_CONF, payload, sizeof(payload), AsyncAnswerType::PAYLOAD, sizeof(payload), time_out, onAnswer, &ref_answer);
+}
+}
+
+TEST(AsyncCommandQueue, OutOfOrderAnswersCompleteTheirOwnCommand)
+{
+  FakeDevice        device;
+  AsyncCommandQueue queue(device.m_com_handle);
+  Answer            answers[3];
+
+  ASSERT_EQ(sendOutputGet(queue, SBG_ECOM_LOG_EKF_QUAT, SBG_ECOM_CLASS_LOG_ECOM_0, 1000, answers[0]), SBG_NO_ERROR);
+  ASSERT_EQ(sendOutputGet(queue, SBG_ECOM_LOG_EKF_NAV, SBG_ECOM_CLASS_LOG_ECOM_0, 1000, answers[1]), SBG_NO_ERROR);
+  ASSERT_EQ(sendOutputGet(queue, SBG_ECOM_LOG_IMU_DATA, SBG_ECOM_CLASS_LOG_ECOM_0, 1000, answers[2]), SBG_NO_ERROR);
+
+  device.sendOutputConf(SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_LOG_IMU_DATA, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_OUTPUT_MODE_DIV_8);
+  device.sendOutputConf(SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_LOG_EKF_QUAT, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_OUTPUT_MODE_DIV_4);
+  device.sendOutputConf(SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_LOG_EKF_NAV, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_OUTPUT_MODE_DIV_2);
+
+  queue.handle();
+
+  EXPECT_EQ(queue.getNumPending(), 0u);
+
+  for (const Answer &ref_answer : answers)
+  {
+    EXPECT_TRUE(ref_answer.completed);
+    EXPECT_EQ(ref_answer.error_code, SBG_NO_ERROR);
+    ASSERT_EQ(ref_answer.payload.size(), 5u);
+  }
+
+  EXPECT_EQ(answers[0].payload[1], SBG_ECOM_LOG_EKF_QUAT);
+  EXPECT_EQ(answers[0].payload[3], SBG_ECOM_OUTPUT_MODE_DIV_4);
+  EXPECT_EQ(answers[1].payload[1], SBG_ECOM_LOG_EKF_NAV);
+  EXPECT_EQ(answers[1].payload[3], SBG_ECOM_OUTPUT_MODE_DIV_2);
+  EXPECT_EQ(answers[2].payload[1], SBG_ECOM_LOG_IMU_DATA);
+  EXPECT_EQ(answers[2].payload[3], SBG_ECOM_OUTPUT_MODE_DIV_8);
+}
+
+TEST(AsyncCommandQueue, LateAnswerAfterTimeOutIsDropped)
+{
+  FakeDevice        device;
+  AsyncCommandQueue queue(device.m_com_handle);
+  Answer            expired_answer;
+  Answer            answer;
+
+  ASSERT_EQ(sendOutputGet(queue, SBG_ECOM_LOG_EKF_QUAT, SBG_ECOM_CLASS_LOG_ECOM_0, 0, expired_answer), SBG_NO_ERROR);
+
+  sbgSleep(2);
+  queue.handle();
+
+  EXPECT_TRUE(expired_answer.completed);
+  EXPECT_EQ(expired_answer.error_code, SBG_TIME_OUT);
+
+  ASSERT_EQ(sendOutputGet(queue, SBG_ECOM_LOG_EKF_NAV, SBG_ECOM_CLASS_LOG_ECOM_0, 1000, answer), SBG_NO_ERROR);
+
+  device.sendOutputConf(SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_LOG_EKF_QUAT, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_OUTPUT_MODE_DIV_4);
+
+  queue.handle();
+
+  EXPECT_FALSE(answer.completed);
+
+  device.sendOutputConf(SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_LOG_EKF_NAV, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_OUTPUT_MODE_DIV_2);
+
+  queue.handle();
+
+  ASSERT_TRUE(answer.completed);
+  EXPECT_EQ(answer.error_code, SBG_NO_ERROR);
+  ASSERT_EQ(answer.payload.size(), 5u);
+  EXPECT_EQ(answer.payload[1], SBG_ECOM_LOG_EKF_NAV);
+  EXPECT_EQ(answer.payload[3], SBG_ECOM_OUTPUT_MODE_DIV_2);
+}
+
+TEST(AsyncCommandQueue, NackCompletesTheOldestCommand)
+{
+  FakeDevice        device;
+  AsyncCommandQueue queue(device.m_com_handle);
+  Answer            answers[2];
+
+  ASSERT_EQ(sendOutputGet(queue, SBG_ECOM_LOG_EKF_QUAT, SBG_ECOM_CLASS_LOG_ECOM_0, 1000, answers[0]), SBG_NO_ERROR);
+  ASSERT_EQ(sendOutputGet(queue, SBG_ECOM_LOG_EKF_NAV, SBG_ECOM_CLASS_LOG_ECOM_0, 1000, answers[1]), SBG_NO_ERROR);
+
+  device.sendOutputConfAck(SBG_INVALID_PARAMETER);
+  device.sendOutputConf(SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_LOG_EKF_NAV, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_OUTPUT_MODE_DIV_2);
+
+  queue.handle();
+
+  EXPECT_EQ(answers[0].error_code, SBG_INVALID_PARAMETER);
+  EXPECT_TRUE(answers[0].payload.empty());
+  EXPECT_EQ(answers[1].error_code, SBG_NO_ERROR);
+  EXPECT_EQ(queue.getNumPending(), 0u);
+}
+
+TEST(AsyncCommandQueue, CompletionsAreOnlyCalledFromHandle)
+{
+  FakeDevice        device;
+  AsyncCommandQueue queue(device.m_com_handle);
+  Answer            answer;
+  SbgErrorCode      error_code;
+
+  ASSERT_EQ(sendOutputGet(queue, SBG_ECOM_LOG_EKF_QUAT, SBG_ECOM_CLASS_LOG_ECOM_0, 1000, answer), SBG_NO_ERROR);
+
+  //
+  // The asynchronous answer is received by the synchronous command, before its own ACK.
+  //
+  device.sendOutputConf(SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_LOG_EKF_QUAT, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_OUTPUT_MODE_DIV_4);
+  device.sendOutputConfAck(SBG_NO_ERROR);
+
+  error_code = sbgEComCmdOutputSetConf(&device.m_com_handle, SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_NAV, SBG_ECOM_OUTPUT_MODE_DIV_2);
+
+  EXPECT_EQ(error_code, SBG_NO_ERROR);
+  EXPECT_FALSE(answer.completed);
+  EXPECT_EQ(queue.getNumPending(), 1u);
+
+  queue.handle();
+
+  EXPECT_TRUE(answer.completed);
+  EXPECT_EQ(answer.error_code, SBG_NO_ERROR);
+  EXPECT_EQ(queue.getNumPending(), 0u);
+}
@@ -0,0 +1,363 @@
+// Standard headers
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Gtest headers
+#include <gtest/gtest.h>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+
+// Project headers
+#include <config_store.h>
+#include <imu_preintegrator.h>
+
+using sbg::ConfigStore;
+using sbg::ImuPreintegrator;
+
+namespace
+{
+typedef std::array<double, 3>   Vector3;
+typedef std::array<double, 9>   Matrix3;
+
+/*!
+ * IMU log period (us).
+ */
+const uint32_t  IMU_PERIOD          = 5000;
+
+/*!
+ * Preintegration interval (ms), 20 IMU logs.
+ */
+const int       INTERVAL_PERIOD     = 100;
+
+/*!
+ * Number of sub steps of each IMU period to compute the reference increments.
+ */
+const size_t    REFERENCE_SUB_STEPS = 200;
+
+Matrix3 multiply(const Matrix3 &ref_a, const Matrix3 &ref_b)
+{
+  Matrix3 result;
+
+  for (size_t i = 0; i < 3; i++)
+  {
+    for (size_t j = 0; j < 3; j++)
+    {
+      result[i * 3 + j] = ref_a[i * 3] * ref_b[j] + ref_a[i * 3 + 1] * ref_b[3 + j] + ref_a[i * 3 + 2] * ref_b[6 + j];
+    }
+  }
+
+  return result;
+}
+
+Vector3 multiply(const Matrix3 &ref_m, const Vector3 &ref_v)
+{
+  Vector3 result;
+
+  for (size_t i = 0; i < 3; i++)
+  {
+    result[i] = ref_m[i * 3] * ref_v[0] + ref_m[i * 3 + 1] * ref_v[1] + ref_m[i * 3 + 2] * ref_v[2];
+  }
+
+  return result;
+}
+
+Matrix3 transpose(const Matrix3 &ref_m)
+{
+  return {{ ref_m[0], ref_m[3], ref_m[6], ref_m[1], ref_m[4], ref_m[7], ref_m[2], ref_m[5], ref_m[8] }};
+}
+
+Matrix3 rotationX(double angle)
+{
+  return {{ 1.0, 0.0, 0.0, 0.0, std::cos(angle), -std::sin(angle), 0.0, std::sin(angle), std::cos(angle) }};
+}
+
+Matrix3 rotationZ(double angle)
+{
+  return {{ std::cos(angle), -std::sin(angle), 0.0, std::sin(angle), std::cos(angle), 0.0, 0.0, 0.0, 1.0 }};
+}
+
+/*!
+ * Rotation vector of a rotation matrix, for angles below pi.
+ */
+Vector3 logarithm(const Matrix3 &ref_m)
+{
+  double angle;
+  double factor;
+
+  angle = std::acos(std::max(-1.0, std::min(1.0, (ref_m[0] + ref_m[4] + ref_m[8] - 1.0) / 2.0)));
+
+  if (angle < 1e-9)
+  {
+    factor = 0.5;
+  }
+  else
+  {
+    factor = angle / (2.0 * std::sin(angle));
+  }
+
+  return {{ (ref_m[7] - ref_m[5]) * factor, (ref_m[2] - ref_m[6]) * factor, (ref_m[3] - ref_m[1]) * factor }};
+}
+
+/*!
+ * Rotation matrix of a quaternion.
+ */
+Matrix3 toMatrix(const geometry_msgs::msg::Quaternion &ref_q)
+{
+  return {{ 1.0 - 2.0 * (ref_q.y * ref_q.y + ref_q.z * ref_q.z), 2.0 * (ref_q.x * ref_q.y - ref_q.z * ref_q.w),       2.0 * (ref_q.x * ref_q.z + ref_q.y * ref_q.w),
+            2.0 * (ref_q.x * ref_q.y + ref_q.z * ref_q.w),       1.0 - 2.0 * (ref_q.x * ref_q.x + ref_q.z * ref_q.z), 2.0 * (ref_q.y * ref_q.z - ref_q.x * ref_q.w),
+            2.0 * (ref_q.x * ref_q.z - ref_q.y * ref_q.w),       2.0 * (ref_q.y * ref_q.z + ref_q.x * ref_q.w),       1.0 - 2.0 * (ref_q.x * ref_q.x + ref_q.y * ref_q.y) }};
+}
+
+/*!
+ * Reference increments of one preintegration interval.
+ */
+struct Reference
+{
+  Matrix3 delta_rotation;
+  Vector3 delta_velocity;
+  Vector3 delta_position;
+};
+
+class ImuPreintegratorTest : public ::testing::Test
+{
+protected:
+
+  rclcpp::Node::SharedPtr                                                   m_node_;
+  ConfigStore                                                               m_config_store_;
+  ImuPreintegrator                                                          m_preintegrator_;
+  rclcpp::Subscription<sbg_driver::msg::SbgImuPreintegration>::SharedPtr    m_subscription_;
+  std::vector<sbg_driver::msg::SbgImuPreintegration>                        m_received_;
+
+  static void SetUpTestCase(void)
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase(void)
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp(void) override
+  {
+    rclcpp::NodeOptions options;
+
+    options.automatically_declare_parameters_from_overrides(true);
+    options.parameter_overrides(
+    {
+      rclcpp::Parameter("uartConf.portName", "/dev/null"),
+      rclcpp::Parameter("imuPreintegration.trigger", "interval"),
+      rclcpp::Parameter("imuPreintegration.period", INTERVAL_PERIOD)
+    });
+
+    m_node_ = std::make_shared<rclcpp::Node>("imu_preintegrator_test", options);
+    m_config_store_.loadFromRosNodeHandle(*m_node_);
+
+    m_subscription_ = m_node_->create_subscription<sbg_driver::msg::SbgImuPreintegration>("sbg/imu_preintegration", 10,
+      [this](std::shared_ptr<sbg_driver::msg::SbgImuPreintegration> p_message) { m_received_.push_back(*p_message); });
+
+    m_preintegrator_.initPublishers(*m_node_, m_config_store_);
+  }
+
+  /*!
+   * Feed the IMU logs of a motion and wait for the first preintegration.
+   *
+   * The attitude and specific force functions give the body to reference rotation and the specific force in the body frame at a time (s).
+   * Each IMU log holds the compensated increments over its period, as output by the device.
+   */
+  Reference integrate(const std::function<Matrix3(double)> &ref_attitude, const std::function<Vector3(double)> &ref_specific_force)
+  {
+    rclcpp::executors::SingleThreadedExecutor executor;
+    Reference                                 reference;
+    double                                    dt;
+    double                                    sub_dt;
+    size_t                                    sample_count;
+
+    dt            = IMU_PERIOD * 1e-6;
+    sub_dt        = dt / REFERENCE_SUB_STEPS;
+    sample_count  = INTERVAL_PERIOD * 1000 / IMU_PERIOD;
+
+    reference.delta_rotation  = {{ 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 }};
+    reference.delta_velocity  = {{ 0.0, 0.0, 0.0 }};
+    reference.delta_position  = {{ 0.0, 0.0, 0.0 }};
+
+    executor.add_node(m_node_->get_node_base_interface());
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (m_node_->count_subscribers("sbg/imu_preintegration") == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+      executor.spin_some();
+    }
+
+    //
+    // The first log starts the interval, and the next ones cover it.
+    //
+    for (size_t i = 0; i <= sample_count; i++)
+    {
+      sbg_driver::msg::SbgImuData imu_data;
+      double                      start;
+      Matrix3                     start_attitude;
+      Vector3                     rotation;
+      Vector3                     velocity;
+
+      start           = (static_cast<double>(i) - 1.0) * dt;
+      start_attitude  = transpose(ref_attitude(start));
+      rotation        = logarithm(multiply(start_attitude, ref_attitude(start + dt)));
+      velocity        = {{ 0.0, 0.0, 0.0 }};
+
+      //
+      // Velocity increment in the body frame at the start of the period, with the Simpson rule.
+      //
+      for (size_t j = 0; j < REFERENCE_SUB_STEPS; j++)
+      {
+        double  t = start + j * sub_dt;
+        Vector3 f0 = multiply(multiply(start_attitude, ref_attitude(t)), ref_specific_force(t));
+        Vector3 f1 = multiply(multiply(start_attitude, ref_attitude(t + sub_dt / 2.0)), ref_specific_force(t + sub_dt / 2.0));
+        Vector3 f2 = multiply(multiply(start_attitude, ref_attitude(t + sub_dt)), ref_specific_force(t + sub_dt));
+
+        for (size_t k = 0; k < 3; k++)
+        {
+          velocity[k] += (f0[k] + 4.0 * f1[k] + f2[k]) * sub_dt / 6.0;
+        }
+      }
+
+      imu_data.time_stamp   = static_cast<uint32_t>(1000000 + i * IMU_PERIOD);
+      imu_data.delta_angle.x  = rotation[0] / dt;
+      imu_data.delta_angle.y  = rotation[1] / dt;
+      imu_data.delta_angle.z  = rotation[2] / dt;
+      imu_data.delta_vel.x    = velocity[0] / dt;
+      imu_data.delta_vel.y    = velocity[1] / dt;
+      imu_data.delta_vel.z    = velocity[2] / dt;
+
+      m_preintegrator_.addImuData(imu_data);
+    }
+
+    //
+    // Reference increments over the interval, in the body frame at its start.
+    //
+    {
+      Matrix3 start_attitude = transpose(ref_attitude(0.0));
+
+      reference.delta_rotation = multiply(start_attitude, ref_attitude(sample_count * dt));
+
+      for (size_t j = 0; j < sample_count * REFERENCE_SUB_STEPS; j++)
+      {
+        double  t = j * sub_dt;
+        Vector3 f0 = multiply(multiply(start_attitude, ref_attitude(t)), ref_specific_force(t));
+        Vector3 f1 = multiply(multiply(start_attitude, ref_attitude(t + sub_dt / 2.0)), ref_specific_force(t + sub_dt / 2.0));
+        Vector3 f2 = multiply(multiply(start_attitude, ref_attitude(t + sub_dt)), ref_specific_force(t + sub_dt));
+
+        for (size_t k = 0; k < 3; k++)
+        {
+          double velocity_increment = (f0[k] + 4.0 * f1[k] + f2[k]) * sub_dt / 6.0;
+
+          reference.delta_position[k] += reference.delta_velocity[k] * sub_dt + (f0[k] + 2.0 * f1[k]) * sub_dt * sub_dt / 6.0;
+          reference.delta_velocity[k] += velocity_increment;
+        }
+      }
+    }
+
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (m_received_.empty() && std::chrono::steady_clock::now() < deadline)
+    {
+      executor.spin_some();
+    }
+
+    return reference;
+  }
+
+  /*!
+   * Check the first preintegration against the reference increments.
+   *
+   * The rotation and velocity increments are exact sums of the IMU increments. The position assumes the
+   * velocity grows linearly over each IMU period, its error is about |d(R f)/dt| dt^3 / 12 for each log.
+   *
+   * \param[in] ref_reference           Reference increments.
+   * \param[in] specific_force_rate     Bound of the rate of change of the specific force in the start frame (m/s^3).
+   */
+  void checkPreintegration(const Reference &ref_reference, double specific_force_rate)
+  {
+    double  dt                  = IMU_PERIOD * 1e-6;
+    double  position_tolerance  = 2.0 * specific_force_rate * dt * dt * dt / 12.0 * (INTERVAL_PERIOD * 1000 / IMU_PERIOD);
+
+    ASSERT_FALSE(m_received_.empty());
+
+    const sbg_driver::msg::SbgImuPreintegration &ref_message = m_received_.front();
+
+    EXPECT_EQ(ref_message.sample_count, INTERVAL_PERIOD * 1000 / IMU_PERIOD);
+    EXPECT_EQ(ref_message.time_stamp - ref_message.time_stamp_start, static_cast<uint32_t>(INTERVAL_PERIOD * 1000));
+
+    Vector3 rotation_error = logarithm(multiply(transpose(ref_reference.delta_rotation), toMatrix(ref_message.delta_rotation)));
+
+    for (size_t i = 0; i < 3; i++)
+    {
+      EXPECT_NEAR(rotation_error[i], 0.0, 1e-9);
+    }
+
+    EXPECT_NEAR(ref_message.delta_velocity.x, ref_reference.delta_velocity[0], 1e-9);
+    EXPECT_NEAR(ref_message.delta_velocity.y, ref_reference.delta_velocity[1], 1e-9);
+    EXPECT_NEAR(ref_message.delta_velocity.z, ref_reference.delta_velocity[2], 1e-9);
+
+    EXPECT_NEAR(ref_message.delta_position.x, ref_reference.delta_position[0], position_tolerance);
+    EXPECT_NEAR(ref_message.delta_position.y, ref_reference.delta_position[1], position_tolerance);
+    EXPECT_NEAR(ref_message.delta_position.z, ref_reference.delta_position[2], position_tolerance);
+
+    for (size_t i = 0; i < 9; i++)
+    {
+      EXPECT_GT(ref_message.covariance[i * 9 + i], 0.0);
+
+      for (size_t j = 0; j < i; j++)
+      {
+        EXPECT_EQ(ref_message.covariance[i * 9 + j], ref_message.covariance[j * 9 + i]);
+      }
+    }
+  }
+};
+}
+
+TEST_F(ImuPreintegratorTest, ConstantRate)
+{
+  const double rate = 0.5;
+
+  Reference reference = integrate(
+    [rate](double t) { return rotationZ(rate * t); },
+    [](double) { return Vector3{{ 1.0, 0.0, 9.81 }}; });
+
+  checkPreintegration(reference, rate * 1.0);
+
+  //
+  // Constant rate about z with a constant specific force in the body frame.
+  //
+  double duration = INTERVAL_PERIOD * 1e-3;
+
+  EXPECT_NEAR(reference.delta_velocity[0], std::sin(rate * duration) / rate, 1e-12);
+  EXPECT_NEAR(reference.delta_velocity[1], (1.0 - std::cos(rate * duration)) / rate, 1e-12);
+  EXPECT_NEAR(reference.delta_velocity[2], 9.81 * duration, 1e-12);
+  EXPECT_NEAR(reference.delta_position[0], (1.0 - std::cos(rate * duration)) / (rate * rate), 1e-12);
+}
+
+TEST_F(ImuPreintegratorTest, ConingMotion)
+{
+  const double half_angle = 0.1;
+  const double frequency  = 2.0 * M_PI * 2.0;
+
+  //
+  // The body axis z describes a cone, the attitude rotates about a moving axis
+  // and the increments of two consecutive logs don't commute.
+  //
+  Reference reference = integrate(
+    [half_angle, frequency](double t) { return multiply(multiply(rotationZ(frequency * t), rotationX(half_angle)), rotationZ(-frequency * t)); },
+    [frequency](double t) { return Vector3{{ 0.5 * std::cos(frequency * t), 0.0, 9.81 }}; });
+
+  //
+  // The body rate is 2 sin(half_angle / 2) times the cone frequency.
+  //
+  checkPreintegration(reference, 2.0 * std::sin(half_angle / 2.0) * frequency * std::sqrt(0.5 * 0.5 + 9.81 * 9.81) + 0.5 * frequency);
+}
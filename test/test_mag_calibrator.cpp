@@ -0,0 +1,386 @@
+// Standard headers
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Gtest headers
+#include <gtest/gtest.h>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+
+// Project headers
+#include <config_store.h>
+#include <mag_calibrator.h>
+
+using sbg::AsyncCommandQueue;
+using sbg::ConfigStore;
+using sbg::MagCalibrator;
+
+namespace
+{
+/*!
+ * In memory device, the frames it sends are read by the driver handle and the commands of the driver are kept until read by the device.
+ */
+class FakeDevice
+{
+private:
+
+  std::deque<uint8_t>   m_to_driver_;
+  std::deque<uint8_t>   m_to_device_;
+  SbgInterface          m_driver_interface_;
+  SbgInterface          m_device_interface_;
+  SbgEComProtocol       m_device_protocol_;
+
+  static SbgErrorCode onWrite(SbgInterface *p_interface, const void *p_buffer, size_t bytes_to_write)
+  {
+    std::deque<uint8_t> *p_bytes;
+    const uint8_t       *p_data;
+
+    p_bytes = static_cast<std::deque<uint8_t>*>(p_interface->handle);
+    p_data  = static_cast<const uint8_t*>(p_buffer);
+
+    p_bytes->insert(p_bytes->end(), p_data, p_data + bytes_to_write);
+
+    return SBG_NO_ERROR;
+  }
+
+  static SbgErrorCode onDriverRead(SbgInterface *p_interface, void *p_buffer, size_t *p_read_bytes, size_t bytes_to_read)
+  {
+    FakeDevice *p_device;
+
+    p_device = static_cast<FakeDevice*>(p_interface->handle);
+
+    return read(p_device->m_to_driver_, p_buffer, p_read_bytes, bytes_to_read);
+  }
+
+  static SbgErrorCode onDriverWrite(SbgInterface *p_interface, const void *p_buffer, size_t bytes_to_write)
+  {
+    FakeDevice    *p_device;
+    const uint8_t *p_data;
+
+    p_device  = static_cast<FakeDevice*>(p_interface->handle);
+    p_data    = static_cast<const uint8_t*>(p_buffer);
+
+    p_device->m_to_device_.insert(p_device->m_to_device_.end(), p_data, p_data + bytes_to_write);
+
+    return SBG_NO_ERROR;
+  }
+
+  static SbgErrorCode onDeviceRead(SbgInterface *p_interface, void *p_buffer, size_t *p_read_bytes, size_t bytes_to_read)
+  {
+    FakeDevice *p_device;
+
+    p_device = static_cast<FakeDevice*>(p_interface->handle);
+
+    return read(p_device->m_to_device_, p_buffer, p_read_bytes, bytes_to_read);
+  }
+
+  static SbgErrorCode onDeviceWrite(SbgInterface *p_interface, const void *p_buffer, size_t bytes_to_write)
+  {
+    FakeDevice    *p_device;
+    const uint8_t *p_data;
+
+    p_device  = static_cast<FakeDevice*>(p_interface->handle);
+    p_data    = static_cast<const uint8_t*>(p_buffer);
+
+    p_device->m_to_driver_.insert(p_device->m_to_driver_.end(), p_data, p_data + bytes_to_write);
+
+    return SBG_NO_ERROR;
+  }
+
+  static SbgErrorCode read(std::deque<uint8_t> &ref_bytes, void *p_buffer, size_t *p_read_bytes, size_t bytes_to_read)
+  {
+    *p_read_bytes = std::min(bytes_to_read, ref_bytes.size());
+
+    std::copy_n(ref_bytes.begin(), *p_read_bytes, static_cast<uint8_t*>(p_buffer));
+    ref_bytes.erase(ref_bytes.begin(), ref_bytes.begin() + *p_read_bytes);
+
+    return SBG_NO_ERROR;
+  }
+
+public:
+
+  SbgEComHandle         m_com_handle;
+
+  FakeDevice(void)
+  {
+    sbgInterfaceZeroInit(&m_driver_interface_);
+    m_driver_interface_.handle      = this;
+    m_driver_interface_.pWriteFunc  = onDriverWrite;
+    m_driver_interface_.pReadFunc   = onDriverRead;
+
+    sbgInterfaceZeroInit(&m_device_interface_);
+    m_device_interface_.handle      = this;
+    m_device_interface_.pWriteFunc  = onDeviceWrite;
+    m_device_interface_.pReadFunc   = onDeviceRead;
+
+    sbgEComProtocolInit(&m_device_protocol_, &m_device_interface_);
+    sbgEComInit(&m_com_handle, &m_driver_interface_);
+  }
+
+  /*!
+   * Read the next command sent by the driver.
+   */
+  bool receiveCommand(uint8_t &ref_msg)
+  {
+    uint8_t   msg_class;
+    uint8_t   payload[SBG_ECOM_MAX_PAYLOAD_SIZE];
+    size_t    payload_size;
+
+    return (sbgEComProtocolReceive(&m_device_protocol_, &msg_class, &ref_msg, payload, &payload_size, sizeof(payload)) == SBG_NO_ERROR) &&
+           (msg_class == SBG_ECOM_CLASS_LOG_CMD_0);
+  }
+
+  /*!
+   * Send an IMU data log.
+   */
+  void sendImuData(uint32_t time_stamp)
+  {
+    uint8_t payload[58] = { static_cast<uint8_t>(time_stamp), static_cast<uint8_t>(time_stamp >> 8), static_cast<uint8_t>(time_stamp >> 16), static_cast<uint8_t>(time_stamp >> 24) };
+
+    sbgEComProtocolSend(&m_device_protocol_, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_DATA, payload, sizeof(payload));
+  }
+
+  /*!
+   * Send an ACK frame for a command.
+   */
+  void sendAck(uint8_t msg, SbgErrorCode error_code)
+  {
+    uint8_t payload[4] = { msg, SBG_ECOM_CLASS_LOG_CMD_0, static_cast<uint8_t>(error_code), static_cast<uint8_t>(error_code >> 8) };
+
+    sbgEComProtocolSend(&m_device_protocol_, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ACK, payload, sizeof(payload));
+  }
+
+  /*!
+   * Send the answer to a compute magnetometers calibration command.
+   */
+  void sendComputeAnswer(SbgEComMagCalibQuality quality)
+  {
+    uint8_t         payload[92];
+    SbgStreamBuffer output_stream;
+
+    sbgStreamBufferInitForWrite(&output_stream, payload, sizeof(payload));
+
+    sbgStreamBufferWriteUint8LE(&output_stream, quality);
+    sbgStreamBufferWriteUint8LE(&output_stream, SBG_ECOM_MAG_CALIB_TRUST_HIGH);
+    sbgStreamBufferWriteUint16LE(&output_stream, 0);
+
+    for (size_t i = 0; i < 9; i++)
+    {
+      sbgStreamBufferWriteFloatLE(&output_stream, 0.01f);
+    }
+
+    sbgStreamBufferWriteUint16LE(&output_stream, 400);
+    sbgStreamBufferWriteUint16LE(&output_stream, 500);
+
+    for (size_t i = 0; i < 12; i++)
+    {
+      sbgStreamBufferWriteFloatLE(&output_stream, (i % 4 == 3) ? 1.0f : 0.0f);
+    }
+
+    sbgEComProtocolSend(&m_device_protocol_, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_COMPUTE_MAG_CALIB, payload, sbgStreamBufferGetLength(&output_stream));
+  }
+};
+
+SbgErrorCode onLogReceived(SbgEComHandle *p_handle, SbgEComClass msg_class, SbgEComMsgId msg, const SbgBinaryLogData *p_log_data, void *p_user_arg)
+{
+  SBG_UNUSED_PARAMETER(p_handle);
+  SBG_UNUSED_PARAMETER(p_log_data);
+
+  if ((msg_class == SBG_ECOM_CLASS_LOG_ECOM_0) && (msg == SBG_ECOM_LOG_IMU_DATA))
+  {
+    (*static_cast<size_t*>(p_user_arg))++;
+  }
+
+  return SBG_NO_ERROR;
+}
+
+class MagCalibratorTest : public ::testing::Test
+{
+protected:
+
+  FakeDevice                                                                m_device_;
+  AsyncCommandQueue                                                         m_command_queue_;
+  MagCalibrator                                                             m_mag_calibrator_;
+  rclcpp::Node::SharedPtr                                                   m_node_;
+  rclcpp::Node::SharedPtr                                                   m_client_node_;
+  rclcpp::executors::SingleThreadedExecutor                                 m_executor_;
+  rclcpp::Subscription<diagnostic_msgs::msg::DiagnosticStatus>::SharedPtr   m_subscription_;
+  std::vector<diagnostic_msgs::msg::DiagnosticStatus>                       m_statuses_;
+  size_t                                                                    m_num_logs_;
+
+  static void SetUpTestCase(void)
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase(void)
+  {
+    rclcpp::shutdown();
+  }
+
+  MagCalibratorTest(void):
+  m_command_queue_(m_device_.m_com_handle),
+  m_mag_calibrator_(m_device_.m_com_handle, m_command_queue_),
+  m_num_logs_(0)
+  {
+  }
+
+  void SetUp(void) override
+  {
+    rclcpp::NodeOptions options;
+    ConfigStore         config_store;
+
+    options.automatically_declare_parameters_from_overrides(true);
+    options.parameter_overrides({ rclcpp::Parameter("uartConf.portName", "/dev/null") });
+
+    m_node_         = std::make_shared<rclcpp::Node>("sbg_device_mag", options);
+    m_client_node_  = std::make_shared<rclcpp::Node>("mag_calibration_client");
+    config_store.loadFromRosNodeHandle(*m_node_);
+
+    m_subscription_ = m_client_node_->create_subscription<diagnostic_msgs::msg::DiagnosticStatus>("sbg/mag_calibration_status", 10,
+      [this](std::shared_ptr<diagnostic_msgs::msg::DiagnosticStatus> p_message) { m_statuses_.push_back(*p_message); });
+
+    m_mag_calibrator_.initServices(*m_node_, config_store);
+    sbgEComSetReceiveLogCallback(&m_device_.m_com_handle, onLogReceived, &m_num_logs_);
+
+    m_executor_.add_node(m_node_->get_node_base_interface());
+    m_executor_.add_node(m_client_node_->get_node_base_interface());
+  }
+
+  /*!
+   * Call a calibration service, as a client spun with the device node.
+   */
+  std_srvs::srv::Trigger::Response callService(const std::string &ref_service_name)
+  {
+    rclcpp::Client<std_srvs::srv::Trigger>::SharedPtr client;
+
+    client = m_client_node_->create_client<std_srvs::srv::Trigger>(ref_service_name);
+
+    EXPECT_TRUE(client->wait_for_service(std::chrono::seconds(5)));
+
+    auto future = client->async_send_request(std::make_shared<std_srvs::srv::Trigger::Request>());
+
+    EXPECT_EQ(m_executor_.spin_until_future_complete(future, std::chrono::seconds(5)), rclcpp::FutureReturnCode::SUCCESS);
+
+    return *future.get();
+  }
+
+  /*!
+   * Run one device loop iteration and receive the published statuses.
+   */
+  void handle(void)
+  {
+    m_command_queue_.handle();
+    m_executor_.spin_some();
+  }
+};
+}
+
+TEST_F(MagCalibratorTest, LogsKeepFlowingWhileACommandIsPending)
+{
+  uint8_t msg;
+
+  ASSERT_TRUE(callService("sbg/mag_calibration").success);
+  ASSERT_TRUE(m_device_.receiveCommand(msg));
+  EXPECT_EQ(msg, SBG_ECOM_CMD_START_MAG_CALIB);
+
+  //
+  // The device hasn't answered yet, the logs are still received by each loop iteration.
+  //
+  for (uint32_t i = 0; i < 10; i++)
+  {
+    m_device_.sendImuData(i * 5000);
+    handle();
+
+    EXPECT_EQ(m_num_logs_, i + 1);
+  }
+
+  EXPECT_TRUE(m_mag_calibrator_.isCommandPending());
+  EXPECT_FALSE(m_mag_calibrator_.isCalibrationOngoing());
+  EXPECT_TRUE(m_statuses_.empty());
+  EXPECT_FALSE(callService("sbg/mag_calibration").success);
+
+  m_device_.sendImuData(50000);
+  m_device_.sendAck(SBG_ECOM_CMD_START_MAG_CALIB, SBG_NO_ERROR);
+  handle();
+
+  EXPECT_EQ(m_num_logs_, 11u);
+  EXPECT_FALSE(m_mag_calibrator_.isCommandPending());
+  EXPECT_TRUE(m_mag_calibrator_.isCalibrationOngoing());
+  ASSERT_EQ(m_statuses_.size(), 1u);
+  EXPECT_EQ(m_statuses_.back().level, diagnostic_msgs::msg::DiagnosticStatus::OK);
+}
+
+TEST_F(MagCalibratorTest, ComputesAndSavesTheCalibration)
+{
+  uint8_t msg;
+
+  ASSERT_TRUE(callService("sbg/mag_calibration").success);
+  ASSERT_TRUE(m_device_.receiveCommand(msg));
+  m_device_.sendAck(SBG_ECOM_CMD_START_MAG_CALIB, SBG_NO_ERROR);
+  handle();
+
+  //
+  // The computation is answered after a while, the logs are received meanwhile.
+  //
+  ASSERT_TRUE(callService("sbg/mag_calibration").success);
+  ASSERT_TRUE(m_device_.receiveCommand(msg));
+  EXPECT_EQ(msg, SBG_ECOM_CMD_COMPUTE_MAG_CALIB);
+
+  m_device_.sendImuData(0);
+  handle();
+
+  EXPECT_EQ(m_num_logs_, 1u);
+  EXPECT_TRUE(m_mag_calibrator_.isCommandPending());
+  EXPECT_FALSE(callService("sbg/mag_calibration_save").success);
+
+  m_device_.sendComputeAnswer(SBG_ECOM_MAG_CALIB_QUAL_GOOD);
+  handle();
+
+  EXPECT_FALSE(m_mag_calibrator_.isCalibrationOngoing());
+  EXPECT_TRUE(m_mag_calibrator_.isCalibrationDone());
+  ASSERT_EQ(m_statuses_.size(), 2u);
+  EXPECT_EQ(m_statuses_.back().level, diagnostic_msgs::msg::DiagnosticStatus::OK);
+  EXPECT_FALSE(m_statuses_.back().values.empty());
+
+  //
+  // The upload is followed by a settings save, each one waiting for its own ACK.
+  //
+  ASSERT_TRUE(callService("sbg/mag_calibration_save").success);
+  ASSERT_TRUE(m_device_.receiveCommand(msg));
+  EXPECT_EQ(msg, SBG_ECOM_CMD_SET_MAG_CALIB);
+
+  m_device_.sendAck(SBG_ECOM_CMD_SET_MAG_CALIB, SBG_NO_ERROR);
+  handle();
+
+  ASSERT_TRUE(m_device_.receiveCommand(msg));
+  EXPECT_EQ(msg, SBG_ECOM_CMD_SETTINGS_ACTION);
+  EXPECT_TRUE(m_mag_calibrator_.isCommandPending());
+
+  m_device_.sendAck(SBG_ECOM_CMD_SETTINGS_ACTION, SBG_NO_ERROR);
+  handle();
+
+  EXPECT_FALSE(m_mag_calibrator_.isCommandPending());
+  ASSERT_EQ(m_statuses_.size(), 3u);
+  EXPECT_EQ(m_statuses_.back().level, diagnostic_msgs::msg::DiagnosticStatus::OK);
+}
+
+TEST_F(MagCalibratorTest, UnansweredCommandIsReportedAfterItsTimeOut)
+{
+  m_device_.m_com_handle.cmdDefaultTimeOut = 0;
+
+  ASSERT_TRUE(callService("sbg/mag_calibration").success);
+
+  sbgSleep(2);
+  handle();
+
+  EXPECT_FALSE(m_mag_calibrator_.isCommandPending());
+  EXPECT_FALSE(m_mag_calibrator_.isCalibrationOngoing());
+  ASSERT_EQ(m_statuses_.size(), 1u);
+  EXPECT_EQ(m_statuses_.back().level, diagnostic_msgs::msg::DiagnosticStatus::ERROR);
+}
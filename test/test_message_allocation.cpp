@@ -0,0 +1,374 @@
+// Standard headers
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Gtest headers
+#include <gtest/gtest.h>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+
+// Project headers
+#include <decimation_filter.h>
+#include <message_wrapper.h>
+#include <time_aligned_buffer.h>
+
+using sbg::AlignStatus;
+using sbg::MessageDecimator;
+using sbg::MessageWrapper;
+using sbg::TimeAlignedBuffer;
+
+namespace
+{
+/*!
+ * True to count the calls to the global operator new.
+ */
+bool    g_count_allocations = false;
+
+/*!
+ * Number of calls to the global operator new while counting.
+ */
+size_t  g_allocation_count  = 0;
+
+/*!
+ * Frame ID longer than the short string buffer, so that copying it needs a heap buffer.
+ */
+const char  FRAME_ID[]      = "imu_link_of_the_survey_vessel";
+
+/*!
+ * IMU log period (us).
+ */
+const uint32_t  IMU_PERIOD  = 5000;
+
+/*!
+ * Count the global allocations made while it is in scope.
+ */
+class AllocationCounter
+{
+public:
+
+  AllocationCounter(void)
+  {
+    g_allocation_count  = 0;
+    g_count_allocations = true;
+  }
+
+  ~AllocationCounter(void)
+  {
+    g_count_allocations = false;
+  }
+
+  size_t getCount(void) const
+  {
+    return g_allocation_count;
+  }
+};
+
+/*!
+ * Logs of each type received from the device, with the EKF solution valid.
+ */
+struct DeviceLogs
+{
+  SbgLogImuData         imu;
+  SbgLogEkfQuatData     ekf_quat;
+  SbgLogEkfEulerData    ekf_euler;
+  SbgLogEkfNavData      ekf_nav;
+  SbgLogShipMotionData  ship_motion;
+  SbgLogMag             mag;
+  SbgLogMagCalib        mag_calib;
+  SbgLogGpsPos          gps_pos;
+  SbgLogGpsVel          gps_vel;
+  SbgLogGpsHdt          gps_hdt;
+  SbgLogGpsRaw          gps_raw;
+  SbgLogOdometerData    odometer;
+  SbgLogStatusData      status;
+  SbgLogUtcData         utc;
+  SbgLogEvent           event;
+  SbgLogAirData         air_data;
+  SbgLogDvlData         dvl;
+  SbgLogUsblData        usbl;
+  SbgLogDepth           depth;
+  SbgLogDiagData        diag;
+  SbgLogImuShort        imu_short;
+};
+
+/*!
+ * Set the time stamp of the logs.
+ */
+void setTimeStamp(DeviceLogs &ref_logs, uint32_t time_stamp)
+{
+  ref_logs.imu.timeStamp          = time_stamp;
+  ref_logs.ekf_quat.timeStamp     = time_stamp;
+  ref_logs.ekf_euler.timeStamp    = time_stamp;
+  ref_logs.ekf_nav.timeStamp      = time_stamp;
+  ref_logs.ship_motion.timeStamp  = time_stamp;
+  ref_logs.mag.timeStamp          = time_stamp;
+  ref_logs.mag_calib.timeStamp    = time_stamp;
+  ref_logs.gps_pos.timeStamp      = time_stamp;
+  ref_logs.gps_vel.timeStamp      = time_stamp;
+  ref_logs.gps_hdt.timeStamp      = time_stamp;
+  ref_logs.odometer.timeStamp     = time_stamp;
+  ref_logs.status.timeStamp       = time_stamp;
+  ref_logs.utc.timeStamp          = time_stamp;
+  ref_logs.event.timeStamp        = time_stamp;
+  ref_logs.air_data.timeStamp     = time_stamp;
+  ref_logs.dvl.timeStamp          = time_stamp;
+  ref_logs.usbl.timeStamp         = time_stamp;
+  ref_logs.depth.timeStamp        = time_stamp;
+  ref_logs.diag.timestamp         = time_stamp;
+  ref_logs.imu_short.timeStamp    = time_stamp;
+}
+
+/*!
+ * Messages published for the logs, kept from one log to the next one.
+ */
+struct PublishedMessages
+{
+  sbg_driver::msg::SbgImuData       imu;
+  sbg_driver::msg::SbgEkfQuat       ekf_quat;
+  sbg_driver::msg::SbgEkfEuler      ekf_euler;
+  sbg_driver::msg::SbgEkfNav        ekf_nav;
+  sbg_driver::msg::SbgShipMotion    ship_motion;
+  sbg_driver::msg::SbgMag           mag;
+  sbg_driver::msg::SbgMagCalib      mag_calib;
+  sbg_driver::msg::SbgGpsPos        gps_pos;
+  sbg_driver::msg::SbgGpsVel        gps_vel;
+  sbg_driver::msg::SbgGpsHdt        gps_hdt;
+  sbg_driver::msg::SbgGpsRaw        gps_raw;
+  sbg_driver::msg::SbgOdoVel        odo_vel;
+  sbg_driver::msg::SbgStatus        status;
+  sbg_driver::msg::SbgUtcTime       utc;
+  sbg_driver::msg::SbgEvent         event;
+  sbg_driver::msg::SbgAirData       air_data;
+  sbg_driver::msg::SbgDvl           dvl;
+  sbg_driver::msg::SbgUsbl          usbl;
+  sbg_driver::msg::SbgDepth         depth;
+  sbg_driver::msg::SbgDiag          diag;
+  sbg_driver::msg::SbgImuShort      imu_short;
+  sensor_msgs::msg::Imu             ros_imu;
+  sensor_msgs::msg::Temperature     temperature;
+  sensor_msgs::msg::MagneticField   magnetic;
+  sensor_msgs::msg::FluidPressure   fluid_pressure;
+  sensor_msgs::msg::TimeReference   utc_reference;
+  sensor_msgs::msg::NavSatFix       nav_sat_fix;
+  geometry_msgs::msg::PointStamped  pos_ecef;
+  geometry_msgs::msg::TwistStamped  velocity;
+  nav_msgs::msg::Odometry           odometry;
+};
+
+/*!
+ * Fill all the messages from the logs, as the message publisher does for each received log.
+ */
+void fillMessages(MessageWrapper &ref_message_wrapper, const DeviceLogs &ref_logs, PublishedMessages &ref_messages)
+{
+  ref_message_wrapper.fillSbgImuDataMessage(ref_logs.imu, ref_messages.imu);
+  ref_message_wrapper.fillSbgEkfQuatMessage(ref_logs.ekf_quat, ref_messages.ekf_quat);
+  ref_message_wrapper.fillSbgEkfEulerMessage(ref_logs.ekf_euler, ref_messages.ekf_euler);
+  ref_message_wrapper.fillSbgEkfNavMessage(ref_logs.ekf_nav, ref_messages.ekf_nav);
+  ref_message_wrapper.fillSbgShipMotionMessage(ref_logs.ship_motion, ref_messages.ship_motion);
+  ref_message_wrapper.fillSbgMagMessage(ref_logs.mag, ref_messages.mag);
+  ref_message_wrapper.fillSbgMagCalibMessage(ref_logs.mag_calib, ref_messages.mag_calib);
+  ref_message_wrapper.fillSbgGpsPosMessage(ref_logs.gps_pos, ref_messages.gps_pos);
+  ref_message_wrapper.fillSbgGpsVelMessage(ref_logs.gps_vel, ref_messages.gps_vel);
+  ref_message_wrapper.fillSbgGpsHdtMessage(ref_logs.gps_hdt, ref_messages.gps_hdt);
+  ref_message_wrapper.fillSbgGpsRawMessage(ref_logs.gps_raw, ref_messages.gps_raw);
+  ref_message_wrapper.fillSbgOdoVelMessage(ref_logs.odometer, ref_messages.odo_vel);
+  ref_message_wrapper.fillSbgStatusMessage(ref_logs.status, ref_messages.status);
+  ref_message_wrapper.fillSbgUtcTimeMessage(ref_logs.utc, ref_messages.utc);
+  ref_message_wrapper.fillSbgEventMessage(ref_logs.event, ref_messages.event);
+  ref_message_wrapper.fillSbgAirDataMessage(ref_logs.air_data, ref_messages.air_data);
+  ref_message_wrapper.fillSbgDvlMessage(ref_logs.dvl, ref_messages.dvl);
+  ref_message_wrapper.fillSbgUsblMessage(ref_logs.usbl, ref_messages.usbl);
+  ref_message_wrapper.fillSbgDepthMessage(ref_logs.depth, ref_messages.depth);
+  ref_message_wrapper.fillSbgDiagMessage(ref_logs.diag, ref_messages.diag);
+  ref_message_wrapper.fillSbgImuShortMessage(ref_logs.imu_short, ref_messages.imu_short);
+
+  ref_message_wrapper.fillRosImuMessage(ref_messages.imu, ref_messages.ekf_quat, ref_messages.ros_imu);
+  ref_message_wrapper.fillRosTemperatureMessage(ref_messages.imu, ref_messages.temperature);
+  ref_message_wrapper.fillRosMagneticMessage(ref_messages.mag, ref_messages.magnetic);
+  ref_message_wrapper.fillRosFluidPressureMessage(ref_messages.air_data, ref_messages.fluid_pressure);
+  ref_message_wrapper.fillRosUtcTimeReferenceMessage(ref_messages.utc, ref_messages.utc_reference);
+  ref_message_wrapper.fillRosNavSatFixMessage(ref_messages.gps_pos, ref_messages.nav_sat_fix);
+  ref_message_wrapper.fillRosPointStampedMessage(ref_messages.ekf_nav, ref_messages.pos_ecef);
+  ref_message_wrapper.fillRosTwistStampedMessage(ref_messages.ekf_quat, ref_messages.ekf_nav, ref_messages.imu, ref_messages.velocity);
+  ref_message_wrapper.fillRosOdoMessage(ref_messages.imu, ref_messages.ekf_nav, ref_messages.ekf_quat, ref_messages.ekf_euler, ref_messages.odometry);
+}
+
+class MessageAllocation : public ::testing::Test
+{
+protected:
+
+  static void SetUpTestCase(void)
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase(void)
+  {
+    rclcpp::shutdown();
+  }
+};
+}
+
+void *operator new(std::size_t size)
+{
+  void *p_memory;
+
+  if (g_count_allocations)
+  {
+    g_allocation_count++;
+  }
+
+  p_memory = std::malloc(size ? size : 1);
+
+  if (!p_memory)
+  {
+    throw std::bad_alloc();
+  }
+
+  return p_memory;
+}
+
+void operator delete(void *p_memory) noexcept
+{
+  std::free(p_memory);
+}
+
+void operator delete(void *p_memory, std::size_t) noexcept
+{
+  std::free(p_memory);
+}
+
+TEST_F(MessageAllocation, FillingTheMessagesDoesNotAllocateOnceWarmedUp)
+{
+  MessageWrapper          message_wrapper;
+  DeviceLogs              logs = {};
+  PublishedMessages       messages;
+  std::vector<uint8_t>    raw_buffer(SBG_ECOM_GPS_RAW_MAX_BUFFER_SIZE, 0xAA);
+  std::vector<char>       diag_string(SBG_ECOM_LOG_DIAG_MAX_STRING_SIZE, 'd');
+
+  message_wrapper.setFrameId(FRAME_ID);
+  message_wrapper.setOdomEnable(true);
+  message_wrapper.setOdomPublishTf(false);
+
+  logs.ekf_quat.quaternion[0] = 1.0f;
+  logs.ekf_nav.status         = SBG_ECOM_SOL_POSITION_VALID;
+  logs.ekf_nav.position[0]    = 48.0;
+  logs.ekf_nav.position[1]    = 2.0;
+  logs.gps_raw.pRawBuffer     = raw_buffer.data();
+  logs.diag.pString           = diag_string.data();
+
+  //
+  // The first logs size the strings and arrays of the messages, to their largest size.
+  //
+  logs.gps_raw.bufferSize   = raw_buffer.size();
+  logs.diag.stringLength    = diag_string.size() - 1;
+  setTimeStamp(logs, IMU_PERIOD);
+  fillMessages(message_wrapper, logs, messages);
+
+  logs.gps_raw.bufferSize   = raw_buffer.size() / 2;
+  logs.diag.stringLength    = diag_string.size() / 2;
+
+  {
+    AllocationCounter allocation_counter;
+
+    for (uint32_t i = 2; i < 100; i++)
+    {
+      setTimeStamp(logs, i * IMU_PERIOD);
+      fillMessages(message_wrapper, logs, messages);
+    }
+
+    EXPECT_EQ(allocation_counter.getCount(), 0u);
+  }
+
+  EXPECT_EQ(messages.imu.header.frame_id, FRAME_ID);
+  EXPECT_EQ(messages.odometry.child_frame_id, FRAME_ID);
+  EXPECT_EQ(messages.gps_raw.data.size(), raw_buffer.size() / 2);
+  EXPECT_EQ(messages.diag.message.size(), diag_string.size() / 2);
+}
+
+TEST_F(MessageAllocation, AligningAndDecimatingDoNotAllocateOnceWarmedUp)
+{
+  MessageWrapper                                                                  message_wrapper;
+  TimeAlignedBuffer<sbg_driver::msg::SbgImuData, 64>                              imu_buffer;
+  TimeAlignedBuffer<sbg_driver::msg::SbgEkfQuat, 64>                              ekf_quat_buffer;
+  MessageDecimator<sbg_driver::msg::SbgImuData, SBG_DECIMATION_IMU_DATA_VALUES>   imu_decimator;
+  SbgLogImuData                                                                   imu_log = {};
+  SbgLogEkfQuatData                                                               ekf_quat_log = {};
+  sbg_driver::msg::SbgImuData                                                     imu_message;
+  sbg_driver::msg::SbgImuData                                                     imu_decimated_message;
+  sbg_driver::msg::SbgEkfQuat                                                     ekf_quat_message;
+  sbg_driver::msg::SbgEkfQuat                                                     ekf_quat_aligned_message;
+  size_t                                                                          aligned_count = 0;
+  size_t                                                                          decimated_count = 0;
+
+  message_wrapper.setFrameId(FRAME_ID);
+  imu_decimator.setFactor(4, 100000000);
+  ekf_quat_log.quaternion[0] = 1.0f;
+
+  auto process = [&](uint32_t i)
+  {
+    //
+    // The EKF logs come at half the IMU rate, between two IMU logs.
+    //
+    imu_log.timeStamp = i * IMU_PERIOD;
+    message_wrapper.fillSbgImuDataMessage(imu_log, imu_message);
+    imu_buffer.push(imu_message);
+
+    if (i % 2)
+    {
+      ekf_quat_log.timeStamp = i * IMU_PERIOD + IMU_PERIOD / 2;
+      message_wrapper.fillSbgEkfQuatMessage(ekf_quat_log, ekf_quat_message);
+      ekf_quat_buffer.push(ekf_quat_message);
+    }
+
+    if (imu_decimator.push(imu_message, imu_decimated_message))
+    {
+      decimated_count++;
+    }
+
+    while (!imu_buffer.isEmpty())
+    {
+      AlignStatus status = ekf_quat_buffer.getSample(imu_buffer.getOldest().time_stamp, IMU_PERIOD * 4, ekf_quat_aligned_message);
+
+      if (status == AlignStatus::PENDING)
+      {
+        break;
+      }
+      if (status == AlignStatus::ALIGNED)
+      {
+        aligned_count++;
+      }
+
+      ekf_quat_buffer.discardBefore(imu_buffer.getOldest().time_stamp);
+      imu_buffer.popOldest();
+    }
+  };
+
+  //
+  // Fill all the slots of the buffers and the decimator delay line once.
+  //
+  for (uint32_t i = 1; i < 200; i++)
+  {
+    process(i);
+  }
+
+  aligned_count   = 0;
+  decimated_count = 0;
+
+  {
+    AllocationCounter allocation_counter;
+
+    for (uint32_t i = 200; i < 1000; i++)
+    {
+      process(i);
+    }
+
+    EXPECT_EQ(allocation_counter.getCount(), 0u);
+  }
+
+  EXPECT_GT(aligned_count, 700u);
+  EXPECT_EQ(decimated_count, 200u);
+  EXPECT_EQ(ekf_quat_aligned_message.header.frame_id, FRAME_ID);
+}
@@ -0,0 +1,114 @@
+// Standard headers
+#include <chrono>
+#include <memory>
+
+// Gtest headers
+#include <gtest/gtest.h>
+
+// ROS headers
+#include <rclcpp/rclcpp.hpp>
+
+// Project headers
+#include <pose_history.h>
+
+using sbg::PoseHistory;
+
+namespace
+{
+/*!
+ * Create an EKF nav log.
+ */
+sbg_driver::msg::SbgEkfNav createEkfNav(uint32_t time_stamp, double latitude)
+{
+  sbg_driver::msg::SbgEkfNav ekf_nav_message;
+
+  ekf_nav_message.header.stamp  = rclcpp::Time(100, time_stamp * 1000);
+  ekf_nav_message.time_stamp    = time_stamp;
+  ekf_nav_message.latitude      = latitude;
+  ekf_nav_message.longitude     = 2.0;
+  ekf_nav_message.altitude      = 100.0;
+
+  return ekf_nav_message;
+}
+
+/*!
+ * Create an EKF quaternion log, with the identity orientation.
+ */
+sbg_driver::msg::SbgEkfQuat createEkfQuat(uint32_t time_stamp)
+{
+  sbg_driver::msg::SbgEkfQuat ekf_quat_message;
+
+  ekf_quat_message.header.stamp   = rclcpp::Time(100, time_stamp * 1000);
+  ekf_quat_message.time_stamp     = time_stamp;
+  ekf_quat_message.quaternion.w   = 1.0;
+
+  return ekf_quat_message;
+}
+
+class PoseHistoryService : public ::testing::Test
+{
+protected:
+
+  static void SetUpTestCase(void)
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase(void)
+  {
+    rclcpp::shutdown();
+  }
+};
+}
+
+TEST_F(PoseHistoryService, AnswersThePoseAtTime)
+{
+  rclcpp::Node::SharedPtr                                     device_node = std::make_shared<rclcpp::Node>("sbg_device");
+  rclcpp::Node::SharedPtr                                     client_node = std::make_shared<rclcpp::Node>("pose_client");
+  rclcpp::executors::SingleThreadedExecutor                   executor;
+  PoseHistory                                                 pose_history;
+  rclcpp::Client<sbg_driver::srv::SbgPoseAtTime>::SharedPtr   client;
+
+  pose_history.setCapacity(16);
+  pose_history.setMaxGap(50000);
+  pose_history.initService(*device_node, "imu_link");
+
+  pose_history.addNavigation(createEkfNav(10000, 48.0));
+  pose_history.addAttitude(createEkfQuat(10000));
+  pose_history.addNavigation(createEkfNav(20000, 49.0));
+  pose_history.addAttitude(createEkfQuat(20000));
+
+  //
+  // The device node is spun as in the sbg_device main loop.
+  //
+  executor.add_node(device_node->get_node_base_interface());
+  executor.add_node(client_node->get_node_base_interface());
+
+  client = client_node->create_client<sbg_driver::srv::SbgPoseAtTime>("sbg/pose_at_time");
+
+  ASSERT_TRUE(client->wait_for_service(std::chrono::seconds(5)));
+
+  auto request = std::make_shared<sbg_driver::srv::SbgPoseAtTime::Request>();
+
+  request->use_device_time  = true;
+  request->time_stamp       = 15000;
+
+  auto future = client->async_send_request(request);
+
+  ASSERT_EQ(executor.spin_until_future_complete(future, std::chrono::seconds(5)), rclcpp::FutureReturnCode::SUCCESS);
+
+  auto response = future.get();
+
+  EXPECT_EQ(response->status, sbg_driver::srv::SbgPoseAtTime::Response::STATUS_OK);
+  EXPECT_EQ(response->header.frame_id, "imu_link");
+  EXPECT_EQ(response->time_stamp, 15000u);
+  EXPECT_NEAR(response->latitude, 48.5, 1e-9);
+  EXPECT_NEAR(response->quaternion.w, 1.0, 1e-9);
+
+  request->time_stamp = 30000;
+  future              = client->async_send_request(request);
+
+  ASSERT_EQ(executor.spin_until_future_complete(future, std::chrono::seconds(5)), rclcpp::FutureReturnCode::SUCCESS);
+
+  EXPECT_EQ(future.get()->status, sbg_driver::srv::SbgPoseAtTime::Response::STATUS_PENDING);
+}